@@ -0,0 +1,709 @@
+/**
+ * @file batchMode.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the non-interactive batch mode of the set manager.<br/>
+ *
+ * This file contains a small tokenizer that reads the script in large blocks and
+ * parses words and integers straight out of the buffer, and the loop that runs one
+ * command per line. Failed commands are reported on stderr with their line number
+ * and the script carries on with the next line.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// include module header files
+#include "batchMode.h"
+#include "orderedSet.h"
+#include "setSnapshot.h"
+#include "setExpression.h"
+#include "setRegistry.h"
+#include "instrumentation.h"
+
+// Longest command word
+#define BATCH_WORD_SIZE 16
+
+// Longest file name argument
+#define BATCH_PATH_SIZE 260
+
+// Longest set expression argument
+#define BATCH_EXPRESSION_SIZE 1024
+
+// Size of the buffer a set name is read into
+#define BATCH_NAME_SIZE (REGISTRY_MAX_NAME + 1)
+
+// Initial number of values an add or remove line is read into (the buffer grows as needed)
+#define BATCH_VALUES_SIZE 64
+
+// Batch reader structure
+/**
+ * @brief Structure holding the input buffer of a batch script.
+ *
+ * - 'buffer' holds 'length' bytes read from 'file'; 'pos' is the next unread byte.
+ * - 'eof': set once 'file' has no more data.
+ * - 'line': number of the line being read, for error messages.
+ */
+struct BatchReader
+{
+    FILE* file;
+    char buffer[BATCH_BUFFER_SIZE];
+    size_t pos;
+    size_t length;
+    int eof;
+    long line;
+};
+
+// Function to look at the next character of the script
+/**
+ * @brief Returns the next unread character without consuming it, refilling the buffer when it is empty.
+ *
+ * @param reader The batch reader.
+ * @return int The next character or EOF.
+ */
+static int peekChar(struct BatchReader* reader) {
+    if (reader->pos == reader->length) {
+        if (reader->eof) return EOF;
+        reader->length = fread(reader->buffer, 1, sizeof(reader->buffer), reader->file);
+        reader->pos = 0;
+        if (reader->length == 0) {
+            reader->eof = 1;
+            return EOF;
+        }
+    }
+    return (unsigned char)reader->buffer[reader->pos];
+}
+
+// Function to skip spaces and comments
+/**
+ * @brief Skips blanks and, if a '#' follows, the rest of the line, stopping before the newline.
+ *
+ * @param reader The batch reader.
+ * @return int The next character (a newline, EOF or the start of a token).
+ */
+static int skipBlanks(struct BatchReader* reader) {
+    int c = peekChar(reader);
+    while (c == ' ' || c == '\t' || c == '\r') {
+        reader->pos++;
+        c = peekChar(reader);
+    }
+    if (c == '#') {
+        while (c != '\n' && c != EOF) {
+            reader->pos++;
+            c = peekChar(reader);
+        }
+    }
+    return c;
+}
+
+// Function to move to the next line
+/**
+ * @brief Consumes the rest of the current line, including its newline.
+ *
+ * @param reader The batch reader.
+ */
+static void skipLine(struct BatchReader* reader) {
+    int c = peekChar(reader);
+    while (c != '\n' && c != EOF) {
+        reader->pos++;
+        c = peekChar(reader);
+    }
+    if (c == '\n') reader->pos++;
+    reader->line++;
+}
+
+// Function to read a word
+/**
+ * @brief Reads the next whitespace separated word of the current line, up to a comment.
+ *
+ * @param reader The batch reader.
+ * @param word Receives the word, truncated to 'size' - 1 characters.
+ * @param size Size of 'word'.
+ * @return size_t Length of the word, 0 at the end of the line.
+ */
+static size_t readWord(struct BatchReader* reader, char* word, size_t size) {
+    size_t length = 0;
+    int c = skipBlanks(reader);
+    while (c != EOF && c != ' ' && c != '\t' && c != '\r' && c != '\n' && c != '#') {
+        if (length + 1 < size) word[length] = (char)c;
+        length++;
+        reader->pos++;
+        c = peekChar(reader);
+    }
+    word[length < size ? length : size - 1] = '\0';
+    return length;
+}
+
+// Function to read the rest of a line
+/**
+ * @brief Reads the rest of the current line, up to a comment, without leading or trailing blanks.
+ *
+ * @param reader The batch reader.
+ * @param text Receives the text, truncated to 'size' - 1 characters.
+ * @param size Size of 'text'.
+ * @return size_t Length of the text, which may exceed 'size' - 1.
+ */
+static size_t readRest(struct BatchReader* reader, char* text, size_t size) {
+    size_t length = 0;
+    size_t kept = 0;
+    int c = skipBlanks(reader);
+    while (c != EOF && c != '\n' && c != '#') {
+        if (length + 1 < size) text[length] = (char)c;
+        length++;
+        if (c != ' ' && c != '\t' && c != '\r') kept = length;
+        reader->pos++;
+        c = peekChar(reader);
+    }
+    text[kept < size ? kept : size - 1] = '\0';
+    return kept;
+}
+
+// Function to read an integer
+/**
+ * @brief Reads the next integer of the current line, parsing the digits directly from the buffer.
+ *
+ * @param reader The batch reader.
+ * @param value Receives the integer.
+ * @return int 1 if an integer was read, 0 at the end of the line, -1 if the token is not an int.
+ */
+static int readInt(struct BatchReader* reader, int* value) {
+    int c = skipBlanks(reader);
+    if (c == '\n' || c == EOF) return 0;
+
+    int negative = 0;
+    if (c == '-' || c == '+') {
+        negative = c == '-';
+        reader->pos++;
+        c = peekChar(reader);
+    }
+
+    long long result = 0;
+    int digits = 0;
+    while (c >= '0' && c <= '9') {
+        result = result * 10 + (c - '0');
+        if (result > (long long)INT_MAX + 1) return -1;
+        digits++;
+        reader->pos++;
+        c = peekChar(reader);
+    }
+    if (negative) result = -result;
+    if (!digits || result > INT_MAX || (c != EOF && c != ' ' && c != '\t' && c != '\r' && c != '\n' && c != '#')) {
+        return -1;
+    }
+    *value = (int)result;
+    return 1;
+}
+
+// Function to report a failed command
+/**
+ * @brief Writes an error message for the current line to stderr.
+ *
+ * @param reader The batch reader.
+ * @param message Description of the error.
+ * @return int Always 0, so callers can return it as the command result.
+ */
+static int batchError(const struct BatchReader* reader, const char* message) {
+    fprintf(stderr, "line %ld: %s\n", reader->line, message);
+    return 0;
+}
+
+// Function to read a set name
+/**
+ * @brief Reads a set name and checks its length.
+ *
+ * @param reader The batch reader.
+ * @param name Receives the name (room for BATCH_NAME_SIZE characters).
+ * @return int 1 if a valid name was read, 0 otherwise (an error has been reported).
+ */
+static int readName(struct BatchReader* reader, char* name) {
+    size_t length = readWord(reader, name, BATCH_NAME_SIZE);
+    if (length == 0) return batchError(reader, "Expected a set name.");
+    if (length >= BATCH_NAME_SIZE) return batchError(reader, "Set name too long.");
+    return 1;
+}
+
+// Function to read a name that no set has yet
+/**
+ * @brief Reads the name of a set to be created and checks that it is free.
+ *
+ * @return int 1 if a free name was read, 0 otherwise (an error has been reported).
+ */
+static int readNewName(struct BatchReader* reader, SetRegistry* registry, char* name) {
+    if (!readName(reader, name)) return 0;
+    if (findSet(registry, name)) return batchError(reader, "A set with this name already exists.");
+    return 1;
+}
+
+// Function to read the name of an existing set
+/**
+ * @brief Reads a set name and looks its set up.
+ *
+ * @return OrderedIntSet* The set, or NULL if the name is invalid or unused (an error has been reported).
+ */
+static OrderedIntSet* readSet(struct BatchReader* reader, SetRegistry* registry) {
+    char name[BATCH_NAME_SIZE];
+    if (!readName(reader, name)) return NULL;
+    OrderedIntSet* set = findSet(registry, name);
+    if (!set) batchError(reader, "No set has this name.");
+    return set;
+}
+
+// Function to register a new set
+/**
+ * @brief Registers a set created by a command, deleting it if that fails.
+ *
+ * @return int 1 on success, 0 if 'set' is NULL or memory allocation failed (an error has been reported).
+ */
+static int storeSet(struct BatchReader* reader, SetRegistry* registry, const char* name, OrderedIntSet* set) {
+    if (set && registerSet(registry, name, set) >= 0) return 1;
+    deleteOrderedSet(set);
+    return batchError(reader, "Memory allocation failed.");
+}
+
+// Function to resolve a set name of an expression
+/**
+ * @brief SetNameLookup over the registry given as context.
+ */
+static OrderedIntSet* lookupName(void* context, const char* name, size_t length) {
+    char copy[BATCH_NAME_SIZE];
+    if (length >= sizeof(copy)) return NULL;
+    memcpy(copy, name, length);
+    copy[length] = '\0';
+    return findSet((const SetRegistry*)context, copy);
+}
+
+// Function to parse a backend name
+/**
+ * @brief Maps a backend name of the create command to its SetBackend.
+ *
+ * @return int 1 if the name is known, 0 otherwise.
+ */
+static int parseBackend(const char* name, SetBackend* backend) {
+    for (int i = SET_BACKEND_LINKED_LIST; i <= SET_BACKEND_ADAPTIVE; i++) {
+        if (strcmp(name, setBackendName((SetBackend)i)) == 0) {
+            *backend = (SetBackend)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Function to print the backend statistics of a set
+/**
+ * @brief Prints the name, size, backend and adaptive counters of a set on one line.
+ */
+static void printSetStats(const char* name, const OrderedIntSet* set) {
+    printf("%s %d %s %s %zu %zu %zu\n", name, set->count, setBackendName(set->backend),
+           set->adaptive ? "adaptive" : "fixed", set->mutations, set->lookups, set->conversions);
+}
+
+// Function to run the tune command
+/**
+ * @brief Runs tune: prints every adaptive threshold, or sets the one named by the first word to the integer after it.
+ *
+ * @return int 1 on success, 0 if the command failed.
+ */
+static int runTuneCommand(struct BatchReader* reader) {
+    AdaptiveThresholds limits;
+    getAdaptiveThresholds(&limits);
+    const char* keys[] = { "small", "bitmapspan", "packedcount", "packedmutations", "listcount", "listmutations", "interval" };
+    size_t* values[] = { &limits.smallCount, &limits.bitmapSpan, &limits.packedCount, &limits.packedMutationPercent,
+                         &limits.listCount, &limits.listMutationPercent, &limits.checkInterval };
+    const int keyCount = (int)(sizeof(keys) / sizeof(keys[0]));
+
+    char key[BATCH_WORD_SIZE];
+    if (readWord(reader, key, sizeof(key)) == 0) {
+        for (int i = 0; i < keyCount; i++) {
+            printf("%s %zu\n", keys[i], *values[i]);
+        }
+        return 1;
+    }
+    for (int i = 0; i < keyCount; i++) {
+        if (strcmp(key, keys[i]) == 0) {
+            int value;
+            if (readInt(reader, &value) != 1 || value < 0) return batchError(reader, "Expected a non-negative integer.");
+            *values[i] = (size_t)value;
+            setAdaptiveThresholds(&limits);
+            return 1;
+        }
+    }
+    return batchError(reader, "Unknown threshold.");
+}
+
+// Function to run the element commands
+/**
+ * @brief Runs add or remove: applies the operation to every value up to the end of the line.
+ *
+ * The values are all read before the set is changed, so a line with a token that is not an
+ * integer leaves the set as it was.
+ *
+ * @return int 1 on success, 0 if the command failed.
+ */
+static int runElementCommand(struct BatchReader* reader, SetRegistry* registry, int add) {
+    OrderedIntSet* set = readSet(reader, registry);
+    if (!set) return 0;
+
+    int* values = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    int value;
+    int status;
+    while ((status = readInt(reader, &value)) == 1) {
+        if (count == capacity) {
+            size_t grown = capacity ? 2 * capacity : BATCH_VALUES_SIZE;
+            int* buffer = (int*)realloc(values, grown * sizeof(int));
+            if (!buffer) {
+                free(values);
+                return batchError(reader, "Memory allocation failed.");
+            }
+            values = buffer;
+            capacity = grown;
+        }
+        values[count++] = value;
+    }
+    if (status < 0) {
+        free(values);
+        return batchError(reader, "Expected an integer.");
+    }
+
+    int ok = 1;
+    for (size_t i = 0; ok && i < count; i++) {
+        SetStatus result = add ? addElement(set, values[i]) : removeElement(set, values[i]);
+        ok = result != ALLOCATION_ERROR;
+    }
+    free(values);
+    return ok ? 1 : batchError(reader, "Memory allocation failed.");
+}
+
+// Function to run a set operation over more than two sets
+/**
+ * @brief Finishes a union or intersection line that names more than three sets: every name but
+ * the last is an operand, and the result is registered under the last one.
+ *
+ * @param s1 The first operand.
+ * @param s2 The second operand.
+ * @param name The name read after s2, which turned out to be an operand too.
+ * @return int 1 on success, 0 if the command failed.
+ */
+static int runManySetOperation(struct BatchReader* reader, SetRegistry* registry,
+                               OrderedIntSet* (*operation)(OrderedIntSet**, size_t),
+                               OrderedIntSet* s1, OrderedIntSet* s2, char* name) {
+    size_t capacity = 8;
+    size_t count = 2;
+    OrderedIntSet** sets = (OrderedIntSet**)malloc(capacity * sizeof(OrderedIntSet*));
+    if (!sets) return batchError(reader, "Memory allocation failed.");
+    sets[0] = s1;
+    sets[1] = s2;
+
+    int ok = 1;
+    int c;
+    while (ok && (c = skipBlanks(reader)) != '\n' && c != EOF) {
+        // Another name follows, so the one read last is an operand
+        OrderedIntSet* set = findSet(registry, name);
+        if (!set) {
+            ok = batchError(reader, "No set has this name.");
+            break;
+        }
+        if (count == capacity) {
+            OrderedIntSet** grown = (OrderedIntSet**)realloc(sets, 2 * capacity * sizeof(OrderedIntSet*));
+            if (!grown) {
+                ok = batchError(reader, "Memory allocation failed.");
+                break;
+            }
+            sets = grown;
+            capacity *= 2;
+        }
+        sets[count++] = set;
+        ok = readName(reader, name);
+    }
+    if (ok && findSet(registry, name)) ok = batchError(reader, "A set with this name already exists.");
+    if (ok) ok = storeSet(reader, registry, name, operation(sets, count));
+    free(sets);
+    return ok;
+}
+
+// Function to run a set operation command
+/**
+ * @brief Runs intersection, union or difference of the sets n1 and n2 and registers the result as n3.
+ *
+ * Union and intersection also take more sets (n1 n2 ... nk result), which are combined in one
+ * pass by 'many'; difference passes NULL.
+ *
+ * @return int 1 on success, 0 if the command failed.
+ */
+static int runSetOperation(struct BatchReader* reader, SetRegistry* registry,
+                           OrderedIntSet* (*operation)(OrderedIntSet*, OrderedIntSet*),
+                           OrderedIntSet* (*many)(OrderedIntSet**, size_t)) {
+    OrderedIntSet* s1 = readSet(reader, registry);
+    if (!s1) return 0;
+    OrderedIntSet* s2 = readSet(reader, registry);
+    if (!s2) return 0;
+    char name[BATCH_NAME_SIZE];
+    if (!readName(reader, name)) return 0;
+    int c = skipBlanks(reader);
+    if (many && c != '\n' && c != EOF) return runManySetOperation(reader, registry, many, s1, s2, name);
+    if (findSet(registry, name)) return batchError(reader, "A set with this name already exists.");
+    return storeSet(reader, registry, name, operation(s1, s2));
+}
+
+// Function to run an expression command
+/**
+ * @brief Runs eval (register the value of an expression under a name) or evalcount (print its size).
+ *
+ * @return int 1 on success, 0 if the command failed.
+ */
+static int runExpressionCommand(struct BatchReader* reader, SetRegistry* registry, int store) {
+    char name[BATCH_NAME_SIZE];
+    if (store && !readNewName(reader, registry, name)) return 0;
+
+    char text[BATCH_EXPRESSION_SIZE];
+    size_t length = readRest(reader, text, sizeof(text));
+    if (length == 0) return batchError(reader, "Expected an expression.");
+    if (length >= sizeof(text)) return batchError(reader, "Expression too long.");
+
+    const char* error = "Memory allocation failed.";
+    SetExpression* expr = parseNamedSetExpression(text, lookupName, registry, &error);
+    if (!expr) return batchError(reader, error);
+
+    int ok;
+    if (store) {
+        OrderedIntSet* result = evaluateSetExpression(expr);
+        deleteSetExpression(expr);
+        return storeSet(reader, registry, name, result);
+    }
+    size_t count;
+    ok = countSetExpression(expr, &count);
+    if (ok) printf("%zu\n", count);
+    deleteSetExpression(expr);
+    return ok ? 1 : batchError(reader, "Memory allocation failed.");
+}
+
+// Function to run one command
+/**
+ * @brief Parses the arguments of one command and runs it.
+ *
+ * @param reader The batch reader, positioned after the command word.
+ * @param command The command word.
+ * @param registry The sets the commands refer to by name.
+ * @return int 1 on success, 0 if the command failed.
+ */
+static int runCommand(struct BatchReader* reader, const char* command, SetRegistry* registry) {
+    char name[BATCH_NAME_SIZE];
+    OrderedIntSet* set;
+
+    if (strcmp(command, "add") == 0) return runElementCommand(reader, registry, 1);
+    if (strcmp(command, "remove") == 0) return runElementCommand(reader, registry, 0);
+    if (strcmp(command, "intersection") == 0) return runSetOperation(reader, registry, setIntersection, setIntersectionMany);
+    if (strcmp(command, "union") == 0) return runSetOperation(reader, registry, setUnion, setUnionMany);
+    if (strcmp(command, "difference") == 0) return runSetOperation(reader, registry, setDifference, NULL);
+    if (strcmp(command, "eval") == 0) return runExpressionCommand(reader, registry, 1);
+    if (strcmp(command, "evalcount") == 0) return runExpressionCommand(reader, registry, 0);
+    if (strcmp(command, "tune") == 0) return runTuneCommand(reader);
+
+    if (strcmp(command, "opstats") == 0) {
+        char option[BATCH_WORD_SIZE];
+        if (readWord(reader, option, sizeof(option)) == 0) dumpInstrumentation(stdout, 0);
+        else if (strcmp(option, "json") == 0) dumpInstrumentation(stdout, 1);
+        else if (strcmp(option, "reset") == 0) resetInstrumentation();
+        else return batchError(reader, "Unknown opstats option.");
+        return 1;
+    }
+
+    if (strcmp(command, "create") == 0) {
+        if (!readNewName(reader, registry, name)) return 0;
+        SetBackend backend = SET_BACKEND_ADAPTIVE;
+        char backendName[BATCH_WORD_SIZE];
+        if (readWord(reader, backendName, sizeof(backendName)) > 0 && !parseBackend(backendName, &backend)) {
+            return batchError(reader, "Unknown backend.");
+        }
+        return storeSet(reader, registry, name, createOrderedSetWithBackend(backend));
+    }
+
+    if (strcmp(command, "delete") == 0) {
+        if (!readName(reader, name)) return 0;
+        if (!dropSet(registry, name)) return batchError(reader, "No set has this name.");
+        return 1;
+    }
+
+    if (strcmp(command, "drop") == 0) {
+        if (!readName(reader, name)) return 0;
+        size_t length = strlen(name);
+        if (name[length - 1] != '*') return batchError(reader, "Expected a name prefix ending in '*'.");
+        name[length - 1] = '\0';
+        dropSetsWithPrefix(registry, name);
+        return 1;
+    }
+
+    if (strcmp(command, "list") == 0) {
+        for (int id = registryNextId(registry, -1); id >= 0; id = registryNextId(registry, id)) {
+            printf("%s %d %zu\n", getSetName(registry, id), getSetById(registry, id)->count,
+                   registrySetMemory(registry, id));
+        }
+        return 1;
+    }
+
+    if (strcmp(command, "stats") == 0) {
+        size_t length = readWord(reader, name, sizeof(name));
+        if (length == 0) {
+            for (int id = registryNextId(registry, -1); id >= 0; id = registryNextId(registry, id)) {
+                printSetStats(getSetName(registry, id), getSetById(registry, id));
+            }
+            return 1;
+        }
+        if (length >= sizeof(name)) return batchError(reader, "Set name too long.");
+        if (!(set = findSet(registry, name))) return batchError(reader, "No set has this name.");
+        printSetStats(name, set);
+        return 1;
+    }
+
+    if (strcmp(command, "memory") == 0) {
+        size_t length = readWord(reader, name, sizeof(name));
+        if (length == 0) {
+            printf("%zu\n", registryMemoryUsage(registry));
+            return 1;
+        }
+        if (length >= sizeof(name)) return batchError(reader, "Set name too long.");
+        int id = findSetId(registry, name);
+        if (id < 0) return batchError(reader, "No set has this name.");
+        printf("%zu\n", registrySetMemory(registry, id));
+        return 1;
+    }
+
+    if (strcmp(command, "contains") == 0) {
+        int value;
+        if (!(set = readSet(reader, registry))) return 0;
+        if (readInt(reader, &value) != 1) return batchError(reader, "Expected an integer.");
+        printf("%d\n", containsElement(set, value));
+        return 1;
+    }
+
+    if (strcmp(command, "count") == 0) {
+        if (!(set = readSet(reader, registry))) return 0;
+        printf("%d\n", set->count);
+        return 1;
+    }
+
+    if (strcmp(command, "print") == 0) {
+        if (!(set = readSet(reader, registry))) return 0;
+        printToStdout(set);
+        return 1;
+    }
+
+    if (strcmp(command, "rank") == 0) {
+        int value;
+        if (!(set = readSet(reader, registry))) return 0;
+        if (readInt(reader, &value) != 1) return batchError(reader, "Expected an integer.");
+        printf("%zu\n", setRank(set, value));
+        return 1;
+    }
+
+    if (strcmp(command, "select") == 0) {
+        int k;
+        int value;
+        if (!(set = readSet(reader, registry))) return 0;
+        if (readInt(reader, &k) != 1 || k < 0) return batchError(reader, "Expected a position.");
+        if (!setSelect(set, (size_t)k, &value)) return batchError(reader, "Position out of range.");
+        printf("%d\n", value);
+        return 1;
+    }
+
+    if (strcmp(command, "range") == 0 || strcmp(command, "rangecount") == 0) {
+        int lo;
+        int hi;
+        if (!(set = readSet(reader, registry))) return 0;
+        if (readInt(reader, &lo) != 1 || readInt(reader, &hi) != 1) return batchError(reader, "Expected two integers.");
+        if (strcmp(command, "rangecount") == 0) {
+            printf("%zu\n", rangeCount(set, lo, hi));
+            return 1;
+        }
+        SetCursor cursor;
+        const char* separator = "";
+        printf("{");
+        for (setCursorSeek(&cursor, set, lo); setCursorValid(&cursor) && setCursorValue(&cursor) < hi; setCursorNext(&cursor)) {
+            printf("%s%d", separator, setCursorValue(&cursor));
+            separator = ", ";
+        }
+        printf("}\n");
+        return 1;
+    }
+
+    if (strcmp(command, "save") == 0 || strcmp(command, "load") == 0) {
+        char path[BATCH_PATH_SIZE];
+        char option[BATCH_WORD_SIZE];
+        size_t length = readWord(reader, path, sizeof(path));
+        if (length == 0) return batchError(reader, "Expected a file name.");
+        if (length >= sizeof(path)) return batchError(reader, "File name too long.");
+        int hasOption = readWord(reader, option, sizeof(option)) > 0;
+
+        if (command[0] == 's') {
+            SnapshotEncoding encoding = SNAPSHOT_RAW;
+            if (hasOption && strcmp(option, "varint") == 0) encoding = SNAPSHOT_DELTA_VARINT;
+            else if (hasOption && strcmp(option, "raw") != 0) return batchError(reader, "Unknown encoding.");
+            if (!saveSetRegistry(registry, path, encoding)) return batchError(reader, "Saving failed.");
+        } else {
+            if (hasOption && strcmp(option, "copy") != 0) return batchError(reader, "Unknown load option.");
+            if (!loadSetRegistry(registry, path, !hasOption)) return batchError(reader, "Loading failed.");
+        }
+        return 1;
+    }
+
+    return batchError(reader, "Unknown command.");
+}
+
+// Function to run a batch script
+/**
+ * @brief Runs every command of a script, one per line, until the end of the input or "quit".
+ *
+ * The loop is iterative and never prompts, so scripts of any length run in constant stack space.
+ * A failed command is reported on stderr and does not stop the script.
+ *
+ * @param input The script, for example a file or stdin.
+ * @param registry The sets the commands refer to by name.
+ *
+ * @return int Number of commands that failed (-1 if the reader cannot be allocated).
+ */
+int runBatch(FILE* input, SetRegistry* registry) {
+    struct BatchReader* reader = (struct BatchReader*)malloc(sizeof(struct BatchReader));
+    if (!reader) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return -1;
+    }
+    reader->file = input;
+    reader->pos = 0;
+    reader->length = 0;
+    reader->eof = 0;
+    reader->line = 1;
+
+    int failures = 0;
+    char command[BATCH_WORD_SIZE];
+    while (peekChar(reader) != EOF) {
+        if (readWord(reader, command, sizeof(command)) > 0) {
+            if (strcmp(command, "quit") == 0) break;
+            if (!runCommand(reader, command, registry)) {
+                failures++;
+            } else if (skipBlanks(reader) != '\n' && peekChar(reader) != EOF) {
+                failures++;
+                batchError(reader, "Unexpected text at the end of the command.");
+            }
+        }
+        skipLine(reader);
+    }
+
+    free(reader);
+    return failures;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file batchMode.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the non-interactive batch mode of the set manager.<br/>
+ *
+ * This header file declares the function that runs a script of set commands read
+ * from a file or a pipe. Commands are one per line, with no prompts; output is only
+ * written by the commands that ask for it. Sets are addressed by name (see setRegistry.h).
+ * The grammar is:
+ *
+ * - create n [list|array|skip|bitmap|packed|adaptive]   (adaptive by default)
+ * - delete n
+ * - drop prefix*          (deletes every set whose name starts with 'prefix'; "drop *" deletes all)
+ * - add n v1 v2 ...       (any number of values, to the end of the line; none is applied if one is not an integer)
+ * - remove n v1 v2 ...
+ * - contains n v          (prints 1 or 0)
+ * - count n               (prints the number of elements)
+ * - print n               (prints the set as {v1, v2, ...})
+ * - intersection n1 n2 n3, union n1 n2 n3, difference n1 n2 n3   (result registered as n3)
+ * - eval n expr           (registers the value of a set expression such as "(a | b) & (c - d)" as n)
+ * - evalcount expr        (prints the number of elements of a set expression)
+ * - list                  (prints "name count bytes" for every set)
+ * - memory [n]            (prints the bytes used by set n, or by all sets and the registry)
+ * - stats [n]             (prints "name count backend adaptive|fixed mutations lookups conversions" for n or every set)
+ * - tune [key value]      (prints the adaptive thresholds, or sets one; see AdaptiveThresholds)
+ * - opstats [json|reset]  (prints the operation statistics as a table or as JSON, or clears them; see instrumentation.h)
+ * - save file [raw|varint]  (writes every set and its name to a snapshot, raw by default)
+ * - load file [copy]        (replaces every set with a snapshot, mapped in place unless "copy")
+ * - quit
+ *
+ * A name is any word without blanks; names used in expressions may only contain letters,
+ * digits, '_', '.' and ':'. Numbers are names too, so "create 0" and "0 | 1" work as before.
+ * Blank lines are ignored and '#' starts a comment that runs to the end of the line.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef BATCH_MODE_H
+#define BATCH_MODE_H
+
+#include <stdio.h>
+
+#include "setRegistry.h"
+
+// Size of the input buffer of the batch reader
+#define BATCH_BUFFER_SIZE 65536
+
+// Runs every command of 'input' on the sets of 'registry'; returns the number of commands that failed
+int runBatch(FILE* input, SetRegistry* registry);
+
+#endif // BATCH_MODE_H
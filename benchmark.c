@@ -0,0 +1,1297 @@
+/**
+ * @file benchmark.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Benchmark program for the Ordered Set operations.<br/>
+ *
+ * This program times every Ordered Set operation on every backend: addElement with sorted,
+ * reverse and random insertion orders, removeElement, containsElement, setRank, setSelect, deleteOrderedSet, copyElements and
+ * the three set operations at several size ratios and overlap densities, and the union and
+ * intersection of many sets at once against chains of the pairwise operations. It also times set
+ * union and set difference of sorted array sets through the scalar, SSE4.2 and AVX2 kernels
+ * and on all cores, registers, looks up and drops sets by name in the set registry, and stresses the concurrent set with readers and writers, checking that
+ * every answer is consistent. Each result is reported in ns/op and operations per second together with
+ * the peak resident set size. Results can be written as JSON and compared against a JSON file
+ * from an earlier run, so that regressions are caught. It is built as a separate executable
+ * from main.c and the set modules.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+#if defined(_MSC_VER) && defined(__STDC_NO_ATOMICS__)
+// MSVC without C11 atomics: an aligned long is read and written atomically on x86/x64
+typedef volatile long atomic_int;
+#define atomic_load_explicit(object, order) (*(object))
+#define atomic_store_explicit(object, value, order) InterlockedExchange((object), (value))
+#else
+#include <stdatomic.h>
+#endif
+
+// include module header files
+#include "orderedSet.h"
+#include "setKernels.h"
+#include "parallelSetOps.h"
+#include "concurrentSet.h"
+#include "setRegistry.h"
+#include "logging.h"
+
+// Default number of elements in each input of the set operation benchmarks
+#define BENCH_SET_SIZE 1000000
+
+// Default number of elements added, looked up and removed one at a time
+#define BENCH_ELEMENT_SIZE 20000
+
+// Default number of times each measurement is repeated (the best run is kept)
+#define BENCH_REPEATS 5
+
+// Default slowdown, in percent, above which a result counts as a regression
+#define BENCH_TOLERANCE 10.0
+
+// Largest number of results one run records
+#define BENCH_MAX_RESULTS 512
+
+// Longest result name
+#define BENCH_NAME_SIZE 64
+
+// Largest number of reader threads in the concurrent set stress run
+#define BENCH_MAX_READERS 16
+
+// One measurement
+/**
+ * @brief Structure holding the outcome of one benchmark.
+ *
+ * - 'name': "operation/backend[/parameters]", unique within a run and stable between runs.
+ * - 'ops': number of operations one run performs (elements for bulk operations).
+ * - 'nsPerOp': best time of a run divided by 'ops'.
+ * - 'peakRssKiB': peak resident set size of the process after the benchmark.
+ */
+struct BenchResult
+{
+    char name[BENCH_NAME_SIZE];
+    size_t ops;
+    double nsPerOp;
+    size_t peakRssKiB;
+};
+
+// Benchmark settings, taken from the command line
+/**
+ * @brief Structure holding the options of a benchmark run.
+ */
+struct BenchOptions
+{
+    size_t setSize;
+    size_t elementSize;
+    int repeats;
+    double tolerance;
+    const char* jsonPath;
+    const char* baselinePath;
+};
+
+static struct BenchResult results[BENCH_MAX_RESULTS];
+static int resultCount = 0;
+
+static const SetBackend backends[] = {
+    SET_BACKEND_LINKED_LIST, SET_BACKEND_SORTED_ARRAY, SET_BACKEND_SKIP_LIST, SET_BACKEND_BITMAP, SET_BACKEND_PACKED,
+    SET_BACKEND_ADAPTIVE
+};
+static const char* backendNames[] = { "linked_list", "sorted_array", "skip_list", "bitmap", "packed", "adaptive" };
+// Number of backends benchmarked
+#define BENCH_BACKENDS ((int)(sizeof(backends) / sizeof(backends[0])))
+
+// Function to read a monotonic timestamp
+/**
+ * @brief Returns the current time in seconds from a clock that never steps back.
+ *
+ * @return double Seconds since an arbitrary epoch.
+ */
+static double now() {
+#if defined(_WIN32)
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Function to read the peak memory use of the process
+/**
+ * @brief Returns the peak resident set size (peak working set on Windows) of the process.
+ *
+ * @return size_t Peak resident set size in KiB, or 0 if it cannot be read.
+ */
+static size_t peakRssKiB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return (size_t)(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return (size_t)usage.ru_maxrss / 1024;  // Reported in bytes
+#else
+    return (size_t)usage.ru_maxrss;  // Reported in KiB
+#endif
+#endif
+}
+
+// Function to draw a random number
+/**
+ * @brief Advances a xorshift32 generator and returns its new state.
+ *
+ * @param seed State of the random generator (advanced).
+ * @return unsigned int A random number.
+ */
+static unsigned int nextRandom(unsigned int* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    return *seed;
+}
+
+// Function to generate random input values
+/**
+ * @brief Fills a buffer with random values in [0, range).
+ *
+ * @param data The buffer to fill.
+ * @param n Number of values.
+ * @param range Upper bound of the values.
+ * @param seed State of the random generator (advanced).
+ */
+static void randomValues(int* data, size_t n, unsigned int range, unsigned int* seed) {
+    for (size_t i = 0; i < n; i++) {
+        data[i] = (int)(nextRandom(seed) % range);
+    }
+}
+
+// Function to shuffle a buffer
+/**
+ * @brief Puts the values of a buffer in random order (Fisher-Yates).
+ *
+ * @param data The buffer to shuffle.
+ * @param n Number of values.
+ * @param seed State of the random generator (advanced).
+ */
+static void shuffleValues(int* data, size_t n, unsigned int* seed) {
+    for (size_t i = n; i > 1; i--) {
+        size_t j = nextRandom(seed) % i;
+        int swap = data[i - 1];
+        data[i - 1] = data[j];
+        data[j] = swap;
+    }
+}
+
+// Function to store a measurement
+/**
+ * @brief Records a result and prints it as one row of the results table.
+ *
+ * @param name Name of the benchmark.
+ * @param ops Number of operations one run performed.
+ * @param seconds Best time of a run in seconds.
+ */
+static void recordResult(const char* name, size_t ops, double seconds) {
+    if (resultCount == BENCH_MAX_RESULTS) return;
+
+    struct BenchResult* result = &results[resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->ops = ops;
+    result->nsPerOp = ops ? seconds * 1e9 / (double)ops : 0.0;
+    result->peakRssKiB = peakRssKiB();
+    printf("%-48s %10zu %12.2f %14.0f %10zu\n", result->name, ops, result->nsPerOp,
+           result->nsPerOp > 0 ? 1e9 / result->nsPerOp : 0.0, result->peakRssKiB);
+}
+
+// Function to print a section heading
+/**
+ * @brief Prints a heading followed by the column titles of the results table.
+ *
+ * @param title Title of the section.
+ */
+static void printHeading(const char* title) {
+    printf("\n%s\n", title);
+    printf("%-48s %10s %12s %14s %10s\n", "benchmark", "ops", "ns/op", "ops/s", "peak KiB");
+}
+
+// Function to time building a set one element at a time
+/**
+ * @brief Creates an empty set and adds 'values' to it with addElement, keeping the best of several runs.
+ *
+ * @return double Best time of a run in seconds, or -1 if memory allocation failed.
+ */
+static double timeAdd(SetBackend backend, const int* values, size_t n, int repeats) {
+    double best = -1;
+    for (int r = 0; r < repeats; r++) {
+        OrderedIntSet* set = createOrderedSetWithBackend(backend);
+        if (!set) return -1;
+        double start = now();
+        for (size_t i = 0; i < n; i++) {
+            addElement(set, values[i]);
+        }
+        double elapsed = now() - start;
+        deleteOrderedSet(set);
+        if (best < 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+// Function to time removing elements one at a time
+/**
+ * @brief Builds a set from 'initial' and removes 'values' from it with removeElement, keeping the best of several runs.
+ *
+ * @return double Best time of a run in seconds, or -1 if memory allocation failed.
+ */
+static double timeRemove(SetBackend backend, const int* initial, const int* values, size_t n, int repeats) {
+    double best = -1;
+    for (int r = 0; r < repeats; r++) {
+        OrderedIntSet* set = createOrderedSetFromArrayWithBackend(initial, n, backend);
+        if (!set) return -1;
+        double start = now();
+        for (size_t i = 0; i < n; i++) {
+            removeElement(set, values[i]);
+        }
+        double elapsed = now() - start;
+        deleteOrderedSet(set);
+        if (best < 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+// Function to time membership tests
+/**
+ * @brief Looks up every value of 'probes' in 'set' with containsElement, keeping the best of several runs.
+ *
+ * @param hits Receives the number of probes found, so the lookups cannot be optimised away.
+ * @return double Best time of a run in seconds.
+ */
+static double timeContains(OrderedIntSet* set, const int* probes, size_t n, int repeats, size_t* hits) {
+    double best = -1;
+    for (int r = 0; r < repeats; r++) {
+        size_t found = 0;
+        double start = now();
+        for (size_t i = 0; i < n; i++) {
+            found += containsElement(set, probes[i]);
+        }
+        double elapsed = now() - start;
+        *hits = found;
+        if (best < 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+// Function to time rank and select queries
+/**
+ * @brief Asks 'set' for the rank of every value of 'probes', or selects the element at every
+ * probe position modulo the set size, keeping the best of several runs.
+ *
+ * @param selecting 0 to time setRank, 1 to time setSelect.
+ * @param checksum Receives the sum of the answers, so the queries cannot be optimised away.
+ * @return double Best time of a run in seconds.
+ */
+static double timeOrderQueries(const OrderedIntSet* set, const int* probes, size_t n, int selecting, int repeats,
+                               size_t* checksum) {
+    double best = -1;
+    for (int r = 0; r < repeats; r++) {
+        size_t sum = 0;
+        double start = now();
+        for (size_t i = 0; i < n; i++) {
+            if (selecting) {
+                int value = 0;
+                setSelect(set, (size_t)probes[i] % (size_t)set->count, &value);
+                sum += (size_t)value;
+            } else {
+                sum += setRank(set, probes[i]);
+            }
+        }
+        double elapsed = now() - start;
+        *checksum = sum;
+        if (best < 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+// Function to time deleting a whole set
+/**
+ * @brief Builds a set from 'values' and times deleteOrderedSet on it, keeping the best of several runs.
+ *
+ * @return double Best time of a run in seconds, or -1 if memory allocation failed.
+ */
+static double timeDelete(SetBackend backend, const int* values, size_t n, int repeats) {
+    double best = -1;
+    for (int r = 0; r < repeats; r++) {
+        OrderedIntSet* set = createOrderedSetFromArrayWithBackend(values, n, backend);
+        if (!set) return -1;
+        double start = now();
+        deleteOrderedSet(set);
+        double elapsed = now() - start;
+        if (best < 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+// Function to time copying a whole set out
+/**
+ * @brief Builds a set from 'values' and times copyElements on it, keeping the best of several runs.
+ *
+ * @return double Best time of a run in seconds, or -1 if memory allocation failed.
+ */
+static double timeCopy(SetBackend backend, const int* values, size_t n, int repeats) {
+    OrderedIntSet* set = createOrderedSetFromArrayWithBackend(values, n, backend);
+    int* out = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!set || !out) {
+        deleteOrderedSet(set);
+        free(out);
+        return -1;
+    }
+    double best = -1;
+    for (int r = 0; r < repeats; r++) {
+        double start = now();
+        copyElements(set, out);
+        double elapsed = now() - start;
+        if (best < 0 || elapsed < best) best = elapsed;
+    }
+    deleteOrderedSet(set);
+    free(out);
+    return best;
+}
+
+// Function to time one set operation
+/**
+ * @brief Runs a set operation several times and returns the best time per run.
+ *
+ * @param operation The set operation to time.
+ * @param s1 First operand.
+ * @param s2 Second operand.
+ * @param repeats Number of runs.
+ * @param count Receives the size of the result.
+ * @return double Best time of a single run in seconds.
+ */
+static double timeOperation(OrderedIntSet* (*operation)(OrderedIntSet*, OrderedIntSet*),
+                            OrderedIntSet* s1, OrderedIntSet* s2, int repeats, int* count) {
+    double best = -1;
+    for (int r = 0; r < repeats; r++) {
+        double start = now();
+        OrderedIntSet* result = operation(s1, s2);
+        double elapsed = now() - start;
+        if (best < 0 || elapsed < best) best = elapsed;
+        *count = result ? result->count : -1;
+        deleteOrderedSet(result);
+    }
+    return best;
+}
+
+// Function to time one cardinality query
+/**
+ * @brief Runs a count-only query several times and returns the best time per run.
+ *
+ * @param query The query to time, for example intersectionCount.
+ * @param s1 First operand.
+ * @param s2 Second operand.
+ * @param repeats Number of runs.
+ * @param count Receives the result of the query.
+ * @return double Best time of a single run in seconds.
+ */
+static double timeCount(size_t (*query)(const OrderedIntSet*, const OrderedIntSet*),
+                        OrderedIntSet* s1, OrderedIntSet* s2, int repeats, size_t* count) {
+    double best = -1;
+    for (int r = 0; r < repeats; r++) {
+        double start = now();
+        *count = query(s1, s2);
+        double elapsed = now() - start;
+        if (best < 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+// Function to time one in-place set operation
+/**
+ * @brief Runs an in-place operation on fresh copies of the first operand and returns the best time per run.
+ *
+ * Building the copy is not timed.
+ *
+ * @param operation The operation to time, for example unionInto.
+ * @param backend Backend of the copies.
+ * @param a Values of the first operand.
+ * @param na Number of values in 'a'.
+ * @param s2 Second operand.
+ * @param repeats Number of runs.
+ * @param count Receives the size of the result (-1 if an operation failed).
+ * @return double Best time of a single run in seconds.
+ */
+static double timeInPlace(int (*operation)(OrderedIntSet*, const OrderedIntSet*), SetBackend backend,
+                          const int* a, size_t na, OrderedIntSet* s2, int repeats, int* count) {
+    double best = -1;
+    *count = -1;
+    for (int r = 0; r < repeats; r++) {
+        OrderedIntSet* dst = createOrderedSetFromArrayWithBackend(a, na, backend);
+        if (!dst) return best;
+        double start = now();
+        int ok = operation(dst, s2);
+        double elapsed = now() - start;
+        if (best < 0 || elapsed < best) best = elapsed;
+        *count = ok ? dst->count : -1;
+        deleteOrderedSet(dst);
+        if (!ok) break;
+    }
+    return best;
+}
+
+// Function to benchmark adding, looking up, removing and deleting
+/**
+ * @brief Times the element operations on every backend.
+ *
+ * addElement is timed with sorted, reverse sorted and random insertion orders. containsElement
+ * is timed with random probes of which half are in the set, and setRank and setSelect with the
+ * same probes as values and as positions. removeElement removes every element
+ * in random order, and deleteOrderedSet deletes and copyElements copies out a set of
+ * 'setSize' elements.
+ *
+ * @param options The benchmark settings.
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int benchmarkElementOperations(const struct BenchOptions* options) {
+    size_t n = options->elementSize;
+    int* sorted = (int*)malloc(n * sizeof(int));
+    int* reverse = (int*)malloc(n * sizeof(int));
+    int* shuffled = (int*)malloc(n * sizeof(int));
+    int* probes = (int*)malloc(n * sizeof(int));
+    int* large = (int*)malloc(options->setSize * sizeof(int));
+    if (!sorted || !reverse || !shuffled || !probes || !large) {
+        free(sorted);
+        free(reverse);
+        free(shuffled);
+        free(probes);
+        free(large);
+        return 0;
+    }
+
+    // Even values are inserted, so odd probes are misses
+    unsigned int seed = 2463534242u;
+    for (size_t i = 0; i < n; i++) {
+        sorted[i] = (int)(2 * i);
+        reverse[i] = (int)(2 * (n - 1 - i));
+        shuffled[i] = (int)(2 * i);
+        probes[i] = (int)(nextRandom(&seed) % (2 * n));
+    }
+    shuffleValues(shuffled, n, &seed);
+    randomValues(large, options->setSize, 8u * (unsigned int)options->setSize, &seed);
+
+    printHeading("Element operations");
+    int ok = 1;
+    char name[BENCH_NAME_SIZE];
+    for (int b = 0; ok && b < BENCH_BACKENDS; b++) {
+        static const char* orders[] = { "add_sorted", "add_reverse", "add_random" };
+        const int* inputs[] = { sorted, reverse, shuffled };
+        for (int o = 0; ok && o < 3; o++) {
+            double seconds = timeAdd(backends[b], inputs[o], n, options->repeats);
+            snprintf(name, sizeof(name), "%s/%s", orders[o], backendNames[b]);
+            if (seconds < 0) ok = 0;
+            else recordResult(name, n, seconds);
+        }
+
+        OrderedIntSet* set = ok ? createOrderedSetFromArrayWithBackend(sorted, n, backends[b]) : NULL;
+        if (set) {
+            size_t hits;
+            double seconds = timeContains(set, probes, n, options->repeats, &hits);
+            snprintf(name, sizeof(name), "contains/%s", backendNames[b]);
+            recordResult(name, n, seconds);
+            for (int selecting = 0; selecting < 2; selecting++) {
+                seconds = timeOrderQueries(set, probes, n, selecting, options->repeats, &hits);
+                snprintf(name, sizeof(name), "%s/%s", selecting ? "select" : "rank", backendNames[b]);
+                recordResult(name, n, seconds);
+            }
+            deleteOrderedSet(set);
+        } else {
+            ok = 0;
+        }
+
+        double seconds = ok ? timeRemove(backends[b], sorted, shuffled, n, options->repeats) : -1;
+        snprintf(name, sizeof(name), "remove_random/%s", backendNames[b]);
+        if (seconds < 0) ok = 0;
+        else recordResult(name, n, seconds);
+
+        seconds = ok ? timeDelete(backends[b], large, options->setSize, options->repeats) : -1;
+        snprintf(name, sizeof(name), "delete/%s", backendNames[b]);
+        if (seconds < 0) ok = 0;
+        else recordResult(name, options->setSize, seconds);
+
+        seconds = ok ? timeCopy(backends[b], large, options->setSize, options->repeats) : -1;
+        snprintf(name, sizeof(name), "copy/%s", backendNames[b]);
+        if (seconds < 0) ok = 0;
+        else recordResult(name, options->setSize, seconds);
+    }
+
+    free(sorted);
+    free(reverse);
+    free(shuffled);
+    free(probes);
+    free(large);
+    return ok;
+}
+
+// Function to generate a pair of inputs with a given size ratio and overlap
+/**
+ * @brief Fills 'a' with 'na' ascending values and 'b' with 'nb' values spread over the same range.
+ *
+ * Consecutive values of 'a' are 2 to 7 apart, so value + 1 is never in 'a'. Each value of 'b'
+ * picks a random element of 'a' and, with probability 'overlapPercent' / 100, takes it as it is,
+ * otherwise adds one to it.
+ */
+static void overlappingValues(int* a, size_t na, int* b, size_t nb, int overlapPercent, unsigned int* seed) {
+    int value = 0;
+    for (size_t i = 0; i < na; i++) {
+        value += 2 + (int)(nextRandom(seed) % 6);
+        a[i] = value;
+    }
+    for (size_t i = 0; i < nb; i++) {
+        int shared = (int)(nextRandom(seed) % 100) < overlapPercent;
+        b[i] = a[nextRandom(seed) % na] + (shared ? 0 : 1);
+    }
+}
+
+// Function to benchmark the set operations
+/**
+ * @brief Times intersection, union, difference, unionInto and intersectionCount on every backend.
+ *
+ * The first operand has 'setSize' elements; the second is 1, 10 or 100 times smaller and
+ * shares 0, 50 or 100 percent of its elements with the first. The operation count of a run
+ * is the combined size of both operands, so ns/op is the time per input element.
+ *
+ * @param options The benchmark settings.
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int benchmarkSetOperations(const struct BenchOptions* options) {
+    static const int ratios[] = { 1, 10, 100 };
+    static const int overlaps[] = { 0, 50, 100 };
+    static const char* operationNames[] = { "intersection", "union", "difference" };
+    static OrderedIntSet* (*const operations[])(OrderedIntSet*, OrderedIntSet*) = { setIntersection, setUnion, setDifference };
+
+    size_t na = options->setSize;
+    int* a = (int*)malloc(na * sizeof(int));
+    int* b = (int*)malloc(na * sizeof(int));
+    if (!a || !b) {
+        free(a);
+        free(b);
+        return 0;
+    }
+
+    printHeading("Set operations (ops = elements of both operands)");
+    unsigned int seed = 88675123u;
+    char name[BENCH_NAME_SIZE];
+    int ok = 1;
+    for (int r = 0; ok && r < 3; r++) {
+        size_t nb = na / ratios[r] > 0 ? na / ratios[r] : 1;
+        for (int o = 0; ok && o < 3; o++) {
+            overlappingValues(a, na, b, nb, overlaps[o], &seed);
+            for (int k = 0; ok && k < BENCH_BACKENDS; k++) {
+                OrderedIntSet* s1 = createOrderedSetFromArrayWithBackend(a, na, backends[k]);
+                OrderedIntSet* s2 = createOrderedSetFromArrayWithBackend(b, nb, backends[k]);
+                if (!s1 || !s2) ok = 0;
+                for (int op = 0; ok && op < 3; op++) {
+                    int count;
+                    double seconds = timeOperation(operations[op], s1, s2, options->repeats, &count);
+                    snprintf(name, sizeof(name), "%s/%s/ratio%d/overlap%d",
+                             operationNames[op], backendNames[k], ratios[r], overlaps[o]);
+                    if (count < 0) ok = 0;
+                    else recordResult(name, (size_t)s1->count + s2->count, seconds);
+                }
+                if (ok) {
+                    int count;
+                    double seconds = timeInPlace(unionInto, backends[k], a, na, s2, options->repeats, &count);
+                    snprintf(name, sizeof(name), "union_into/%s/ratio%d/overlap%d",
+                             backendNames[k], ratios[r], overlaps[o]);
+                    if (count < 0) ok = 0;
+                    else recordResult(name, (size_t)s1->count + s2->count, seconds);
+                }
+                if (ok) {
+                    size_t common;
+                    double seconds = timeCount(intersectionCount, s1, s2, options->repeats, &common);
+                    snprintf(name, sizeof(name), "intersection_count/%s/ratio%d/overlap%d",
+                             backendNames[k], ratios[r], overlaps[o]);
+                    recordResult(name, (size_t)s1->count + s2->count, seconds);
+                }
+                deleteOrderedSet(s1);
+                deleteOrderedSet(s2);
+            }
+        }
+    }
+
+    free(a);
+    free(b);
+    return ok;
+}
+
+// Function to combine many sets with a pairwise operation
+/**
+ * @brief Folds 'sets' with a pairwise set operation, building one intermediate set per step.
+ *
+ * @return OrderedIntSet* The result, or NULL if memory allocation failed.
+ */
+static OrderedIntSet* chainOperation(OrderedIntSet* (*operation)(OrderedIntSet*, OrderedIntSet*),
+                                     OrderedIntSet** sets, size_t k) {
+    OrderedIntSet* result = operation(sets[0], sets[1]);
+    for (size_t i = 2; result && i < k; i++) {
+        OrderedIntSet* next = operation(result, sets[i]);
+        deleteOrderedSet(result);
+        result = next;
+    }
+    return result;
+}
+
+// Function to time one operation over many sets
+/**
+ * @brief Runs a k-way operation, or a chain of the pairwise one if 'many' is NULL, several
+ * times and returns the best time per run.
+ *
+ * @param many The k-way operation, for example setUnionMany, or NULL.
+ * @param pairwise The pairwise operation chained when 'many' is NULL.
+ * @param sets The operands.
+ * @param k Number of operands (at least 2).
+ * @param repeats Number of runs.
+ * @param count Receives the size of the result (-1 if an operation failed).
+ * @return double Best time of a single run in seconds.
+ */
+static double timeManyOperation(OrderedIntSet* (*many)(OrderedIntSet**, size_t),
+                                OrderedIntSet* (*pairwise)(OrderedIntSet*, OrderedIntSet*),
+                                OrderedIntSet** sets, size_t k, int repeats, int* count) {
+    double best = -1;
+    for (int r = 0; r < repeats; r++) {
+        double start = now();
+        OrderedIntSet* result = many ? many(sets, k) : chainOperation(pairwise, sets, k);
+        double elapsed = now() - start;
+        if (best < 0 || elapsed < best) best = elapsed;
+        *count = result ? result->count : -1;
+        deleteOrderedSet(result);
+    }
+    return best;
+}
+
+// Function to benchmark the operations over many sets
+/**
+ * @brief Times setUnionMany and setIntersectionMany against chains of setUnion and setIntersection.
+ *
+ * 'setSize' random values are spread over 16 or 256 sets, all drawn from the same range of twice
+ * 'setSize' values, so the union keeps growing with every set while few values are in all of them. The operation count of a run is the
+ * combined size of all operands.
+ *
+ * @param options The benchmark settings.
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int benchmarkManySets(const struct BenchOptions* options) {
+    static const size_t setCounts[] = { 16, 256 };
+
+    printHeading("Operations over many sets (ops = elements of all operands)");
+    unsigned int seed = 521288629u;
+    char name[BENCH_NAME_SIZE];
+    int ok = 1;
+    for (int c = 0; ok && c < 2; c++) {
+        size_t k = setCounts[c];
+        size_t n = options->setSize / k > 0 ? options->setSize / k : 1;
+        int* values = (int*)malloc(n * sizeof(int));
+        OrderedIntSet** sets = (OrderedIntSet**)calloc(k, sizeof(OrderedIntSet*));
+        if (!values || !sets) ok = 0;
+
+        for (int b = 0; ok && b < BENCH_BACKENDS; b++) {
+            size_t total = 0;
+            for (size_t i = 0; ok && i < k; i++) {
+                randomValues(values, n, (unsigned int)(2 * n * k), &seed);
+                sets[i] = createOrderedSetFromArrayWithBackend(values, n, backends[b]);
+                if (!sets[i]) ok = 0;
+                else total += (size_t)sets[i]->count;
+            }
+            for (int op = 0; ok && op < 2; op++) {
+                OrderedIntSet* (*many)(OrderedIntSet**, size_t) = op == 0 ? setUnionMany : setIntersectionMany;
+                OrderedIntSet* (*pairwise)(OrderedIntSet*, OrderedIntSet*) = op == 0 ? setUnion : setIntersection;
+                const char* operationName = op == 0 ? "union" : "intersection";
+                int manyCount, chainCount;
+                double seconds = timeManyOperation(many, pairwise, sets, k, options->repeats, &manyCount);
+                snprintf(name, sizeof(name), "%s_many/%s/k%zu", operationName, backendNames[b], k);
+                recordResult(name, total, seconds);
+                seconds = timeManyOperation(NULL, pairwise, sets, k, options->repeats, &chainCount);
+                snprintf(name, sizeof(name), "%s_chain/%s/k%zu", operationName, backendNames[b], k);
+                recordResult(name, total, seconds);
+                if (manyCount < 0 || chainCount < 0) ok = 0;
+                else if (manyCount != chainCount) printf("%s over %zu sets: results differ\n", operationName, k);
+            }
+            for (size_t i = 0; i < k; i++) {
+                deleteOrderedSet(sets[i]);
+                sets[i] = NULL;
+            }
+        }
+        free(values);
+        free(sets);
+    }
+    return ok;
+}
+
+// Function to benchmark the kernels and the parallel operations
+/**
+ * @brief Times union and difference of two random sorted array sets on each kernel level and on all cores.
+ *
+ * @param label Short name of the input density.
+ * @param a Values of the first set.
+ * @param b Values of the second set.
+ * @param n Number of values in each buffer.
+ * @param repeats Number of runs per measurement.
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int benchmarkKernels(const char* label, const int* a, const int* b, size_t n, int repeats) {
+    OrderedIntSet* arrayA = createOrderedSetFromArray(a, n);
+    OrderedIntSet* arrayB = createOrderedSetFromArray(b, n);
+    if (!arrayA || !arrayB) {
+        deleteOrderedSet(arrayA);
+        deleteOrderedSet(arrayB);
+        return 0;
+    }
+
+    int count;
+    char name[BENCH_NAME_SIZE];
+    size_t ops = (size_t)arrayA->count + arrayB->count;
+    SetKernelLevel best = detectSetKernelLevel();
+    for (int level = SET_KERNEL_SCALAR; level <= (int)best; level++) {
+        setSetKernelLevel((SetKernelLevel)level);
+        snprintf(name, sizeof(name), "union/kernel_%s/%s", setKernelLevelName((SetKernelLevel)level), label);
+        recordResult(name, ops, timeOperation(setUnion, arrayA, arrayB, repeats, &count));
+        snprintf(name, sizeof(name), "difference/kernel_%s/%s", setKernelLevelName((SetKernelLevel)level), label);
+        recordResult(name, ops, timeOperation(setDifference, arrayA, arrayB, repeats, &count));
+    }
+    setSetKernelLevel(best);
+
+    snprintf(name, sizeof(name), "union/parallel/%s", label);
+    recordResult(name, ops, timeOperation(parallelSetUnion, arrayA, arrayB, repeats, &count));
+    snprintf(name, sizeof(name), "difference/parallel/%s", label);
+    recordResult(name, ops, timeOperation(parallelSetDifference, arrayA, arrayB, repeats, &count));
+
+    deleteOrderedSet(arrayA);
+    deleteOrderedSet(arrayB);
+    return 1;
+}
+
+// Function to run the kernel benchmarks on inputs of several densities
+/**
+ * @brief Runs benchmarkKernels on random inputs of high, medium and low density.
+ *
+ * @param options The benchmark settings.
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int benchmarkKernelLevels(const struct BenchOptions* options) {
+    size_t n = options->setSize;
+    int* a = (int*)malloc(n * sizeof(int));
+    int* b = (int*)malloc(n * sizeof(int));
+    if (!a || !b) {
+        free(a);
+        free(b);
+        return 0;
+    }
+
+    char title[96];
+    snprintf(title, sizeof(title), "Sorted array kernels (detected: %s, parallel: %d threads)",
+             setKernelLevelName(detectSetKernelLevel()), getParallelThreadCount());
+    printHeading(title);
+
+    unsigned int seed = 521288629u;
+    static const unsigned int factors[] = { 2, 8, 64 };
+    static const char* labels[] = { "range2n", "range8n", "range64n" };
+    int ok = 1;
+    for (int k = 0; ok && k < 3; k++) {
+        randomValues(a, n, factors[k] * (unsigned int)n, &seed);
+        randomValues(b, n, factors[k] * (unsigned int)n, &seed);
+        ok = benchmarkKernels(labels[k], a, b, n, options->repeats);
+    }
+
+    free(a);
+    free(b);
+    return ok;
+}
+
+// Function to time the set registry
+/**
+ * @brief Registers setSize / 4 empty sets by name, looks every name up in random order and drops them all.
+ *
+ * Besides the average cost of each step, the slowest single registration of the last run is
+ * recorded, which shows whether growing the hash table ever stalls a registration.
+ *
+ * @param options The benchmark settings.
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int benchmarkRegistry(const struct BenchOptions* options) {
+    size_t n = options->setSize / 4 > 0 ? options->setSize / 4 : 1;
+    char* names = (char*)malloc(n * BENCH_NAME_SIZE);
+    int* order = (int*)malloc(n * sizeof(int));
+    if (!names || !order) {
+        free(names);
+        free(order);
+        return 0;
+    }
+    unsigned int seed = 2463534242u;
+    for (size_t i = 0; i < n; i++) {
+        snprintf(names + i * BENCH_NAME_SIZE, BENCH_NAME_SIZE, "tenant%zu.set%u", i % 97, nextRandom(&seed));
+        order[i] = (int)i;
+    }
+    shuffleValues(order, n, &seed);
+
+    printHeading("Set registry");
+    double bestRegister = -1, bestFind = -1, bestDrop = -1, worstRegister = 0;
+    size_t found = 0;
+    int ok = 1;
+    for (int r = 0; ok && r < options->repeats; r++) {
+        SetRegistry* registry = createSetRegistry();
+        if (!registry) {
+            ok = 0;
+            break;
+        }
+        worstRegister = 0;
+        double start = now();
+        for (size_t i = 0; ok && i < n; i++) {
+            double before = now();
+            OrderedIntSet* set = createOrderedSetWithBackend(SET_BACKEND_SORTED_ARRAY);
+            const char* name = names + i * BENCH_NAME_SIZE;
+            // Random names may repeat; a repeated one is simply not registered again
+            if (!set || (registerSet(registry, name, set) < 0 && (deleteOrderedSet(set), !findSet(registry, name)))) {
+                ok = 0;
+            }
+            double elapsed = now() - before;
+            if (elapsed > worstRegister) worstRegister = elapsed;
+        }
+        double seconds = now() - start;
+        if (bestRegister < 0 || seconds < bestRegister) bestRegister = seconds;
+
+        found = 0;
+        start = now();
+        for (size_t i = 0; i < n; i++) {
+            found += findSet(registry, names + (size_t)order[i] * BENCH_NAME_SIZE) != NULL;
+        }
+        seconds = now() - start;
+        if (bestFind < 0 || seconds < bestFind) bestFind = seconds;
+
+        start = now();
+        dropSetsWithPrefix(registry, "");
+        seconds = now() - start;
+        if (bestDrop < 0 || seconds < bestDrop) bestDrop = seconds;
+        deleteSetRegistry(registry);
+    }
+
+    if (ok) {
+        recordResult("registry/register", n, bestRegister);
+        recordResult("registry/find", n, bestFind);
+        recordResult("registry/drop_all", n, bestDrop);
+        recordResult("registry/register_worst", 1, worstRegister);
+    }
+    free(names);
+    free(order);
+    return ok && found == n;
+}
+
+// Shared state of the concurrent set stress run
+/**
+ * @brief Structure shared by the threads of benchmarkConcurrentSet.
+ *
+ * - 'set': the set under test.
+ * - 'stable': the even keys below 'stable' are added before the threads start and never removed.
+ * - 'writers': number of churn writers; writer w adds and removes the odd keys k below 'stable'
+ *   with (k / 2) % writers == w.
+ * - 'sequenceBase': the sequence writer adds sequenceBase, sequenceBase + 1, ... in order.
+ * - 'rounds': operations per writer.
+ * - 'done': set once every writer has finished, to stop the readers.
+ */
+struct StressShared
+{
+    struct ConcurrentSet* set;
+    int stable;
+    int writers;
+    int sequenceBase;
+    int rounds;
+    atomic_int done;
+};
+
+// Per thread state of the concurrent set stress run
+/**
+ * @brief Structure holding the arguments and results of one stress thread.
+ *
+ * - 'id': writer number, or -1 for the sequence writer (unused by readers).
+ * - 'ops': operations performed.
+ * - 'failures': checks that failed.
+ */
+struct StressThread
+{
+    struct StressShared* shared;
+    ThreadHandle handle;
+    int id;
+    unsigned int seed;
+    size_t ops;
+    size_t failures;
+};
+
+// Function to run a churn or sequence writer
+/**
+ * @brief Adds and removes random keys of one writer, then checks the set holds exactly the keys it expects.
+ *
+ * The sequence writer (id -1) instead adds increasing keys, which the readers use to check
+ * that elements become visible in the order they were added.
+ */
+static void stressWriter(void* arg) {
+    struct StressThread* thread = (struct StressThread*)arg;
+    struct StressShared* shared = thread->shared;
+
+    if (thread->id < 0) {
+        for (int i = 0; i < shared->rounds; i++) {
+            if (concurrentAddElement(shared->set, shared->sequenceBase + i) != NUMBER_ADDED) thread->failures++;
+        }
+        thread->ops = (size_t)shared->rounds;
+        return;
+    }
+
+    int slots = (shared->stable / 2 + shared->writers - 1 - thread->id) / shared->writers;
+    unsigned char* present = (unsigned char*)calloc(slots > 0 ? slots : 1, 1);
+    if (!present) {
+        thread->failures++;
+        return;
+    }
+    for (int i = 0; slots > 0 && i < shared->rounds; i++) {
+        int slot = (int)(nextRandom(&thread->seed) % (unsigned int)slots);
+        int key = 2 * (slot * shared->writers + thread->id) + 1;
+        SetStatus status = present[slot] ? concurrentRemoveElement(shared->set, key)
+                                         : concurrentAddElement(shared->set, key);
+        if (status != (present[slot] ? NUMBER_REMOVED : NUMBER_ADDED)) thread->failures++;
+        present[slot] = !present[slot];
+    }
+    for (int slot = 0; slot < slots; slot++) {
+        int key = 2 * (slot * shared->writers + thread->id) + 1;
+        if (concurrentContainsElement(shared->set, key) != present[slot]) thread->failures++;
+    }
+    thread->ops = (size_t)shared->rounds;
+    free(present);
+}
+
+// Function to check a snapshot
+/**
+ * @brief Checks that a snapshot ascends, holds every stable key and a gap free prefix of the sequence.
+ *
+ * @return int 1 if the snapshot is consistent, 0 otherwise.
+ */
+static int checkSnapshot(const OrderedIntSet* snapshot, const struct StressShared* shared) {
+    const int* data = snapshot->array->data;
+    size_t n = snapshot->array->size;
+    size_t stableSeen = 0;
+    int expectedSequence = shared->sequenceBase;
+    for (size_t i = 0; i < n; i++) {
+        if (i > 0 && data[i] <= data[i - 1]) return 0;
+        if (data[i] >= shared->sequenceBase) {
+            if (data[i] != expectedSequence++) return 0;
+        } else if (data[i] % 2 == 0) {
+            stableSeen++;
+        }
+    }
+    return stableSeen == (size_t)(shared->stable + 1) / 2;
+}
+
+// Function to run a reader
+/**
+ * @brief Looks keys up while the writers run and checks every answer that is known in advance.
+ *
+ * Stable keys must always be found and keys between 'stable' and 'sequenceBase' never. If
+ * sequence key i is found, every earlier sequence key must be found afterwards. Every 256th round
+ * also takes a snapshot, which must pass checkSnapshot.
+ */
+static void stressReader(void* arg) {
+    struct StressThread* thread = (struct StressThread*)arg;
+    struct StressShared* shared = thread->shared;
+
+    while (!atomic_load_explicit(&shared->done, memory_order_acquire)) {
+        unsigned int r = nextRandom(&thread->seed);
+        int stableKey = (int)(r % (unsigned int)shared->stable) & ~1;
+        if (!concurrentContainsElement(shared->set, stableKey)) thread->failures++;
+        if (concurrentContainsElement(shared->set, shared->stable + 1 + (int)(r % 1024))) thread->failures++;
+
+        int i = (int)(nextRandom(&thread->seed) % (unsigned int)shared->rounds);
+        if (concurrentContainsElement(shared->set, shared->sequenceBase + i)) {
+            int earlier = (int)(nextRandom(&thread->seed) % (unsigned int)(i + 1));
+            if (!concurrentContainsElement(shared->set, shared->sequenceBase + earlier)) thread->failures++;
+        }
+        thread->ops += 4;
+
+        if ((thread->ops & 1023) == 0) {
+            OrderedIntSet* snapshot = concurrentSetSnapshot(shared->set);
+            if (!snapshot || !checkSnapshot(snapshot, shared)) thread->failures++;
+            deleteOrderedSet(snapshot);
+        }
+    }
+}
+
+// Function to stress the concurrent set
+/**
+ * @brief Runs readers against churn and sequence writers on one concurrent set and checks the results.
+ *
+ * Reader and writer throughput are recorded. Every check described at stressWriter,
+ * stressReader and checkSnapshot must pass; a failure means an operation was not
+ * linearizable (or a snapshot not atomic) and makes the benchmark fail.
+ *
+ * @param options The benchmark settings.
+ * @return int 1 if every check passed, 0 otherwise.
+ */
+static int benchmarkConcurrentSet(const struct BenchOptions* options) {
+    int readers = threadHardwareConcurrency() - 3;
+    if (readers < 2) readers = 2;
+    if (readers > BENCH_MAX_READERS) readers = BENCH_MAX_READERS;
+
+    struct StressShared shared;
+    shared.set = createConcurrentSet();
+    shared.stable = (int)options->elementSize * 2;
+    shared.writers = 2;
+    shared.sequenceBase = 1 << 28;
+    shared.rounds = (int)options->elementSize * 4;
+    atomic_store_explicit(&shared.done, 0, memory_order_relaxed);
+    if (!shared.set) return 0;
+    for (int key = 0; key < shared.stable; key += 2) {
+        if (concurrentAddElement(shared.set, key) != NUMBER_ADDED) {
+            deleteConcurrentSet(shared.set);
+            return 0;
+        }
+    }
+
+    char title[96];
+    snprintf(title, sizeof(title), "Concurrent set (%d readers, %d churn writers, 1 sequence writer)",
+             readers, shared.writers);
+    printHeading(title);
+
+    struct StressThread threads[BENCH_MAX_READERS + 3];
+    int threadCount = readers + shared.writers + 1;
+    int started = 0;
+    double start = now();
+    for (int t = 0; t < threadCount; t++) {
+        threads[t].shared = &shared;
+        threads[t].id = t < shared.writers ? t : (t == shared.writers ? -1 : 0);
+        threads[t].seed = 2463534242u + 7919u * (unsigned int)t;
+        threads[t].ops = 0;
+        threads[t].failures = 0;
+        ThreadStart entry = t <= shared.writers ? stressWriter : stressReader;
+        if (!threadCreate(&threads[t].handle, entry, &threads[t])) break;
+        started++;
+    }
+    for (int t = 0; t < started && t <= shared.writers; t++) {
+        threadJoin(threads[t].handle);
+    }
+    double writeSeconds = now() - start;
+    atomic_store_explicit(&shared.done, 1, memory_order_release);
+    for (int t = shared.writers + 1; t < started; t++) {
+        threadJoin(threads[t].handle);
+    }
+    double readSeconds = now() - start;
+
+    size_t writeOps = 0, readOps = 0, failures = 0;
+    for (int t = 0; t < started; t++) {
+        failures += threads[t].failures;
+        if (t <= shared.writers) writeOps += threads[t].ops;
+        else readOps += threads[t].ops;
+    }
+    recordResult("concurrent/add_remove", writeOps, writeSeconds);
+    recordResult("concurrent/contains", readOps, readSeconds);
+
+    OrderedIntSet* snapshot = concurrentSetSnapshot(shared.set);
+    if (!snapshot || !checkSnapshot(snapshot, &shared) || snapshot->count != (int)concurrentSetCount(shared.set) ||
+        (int)snapshot->array->size - shared.rounds < shared.stable / 2) {
+        failures++;
+    }
+    deleteOrderedSet(snapshot);
+    deleteConcurrentSet(shared.set);
+
+    if (started < threadCount) {
+        printf("Could not start the stress threads.\n");
+        return 0;
+    }
+    if (failures > 0) {
+        printf("Concurrent set check failed: %zu inconsistent results.\n", failures);
+        return 0;
+    }
+    return 1;
+}
+
+// Function to write the results as JSON
+/**
+ * @brief Writes the settings and every result to a JSON file, one result object per line.
+ *
+ * @param path File to write.
+ * @param options The benchmark settings.
+ * @return int 1 on success, 0 if the file cannot be written.
+ */
+static int writeJson(const char* path, const struct BenchOptions* options) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        printf("Cannot write %s.\n", path);
+        return 0;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"setSize\": %zu,\n", options->setSize);
+    fprintf(file, "  \"elementSize\": %zu,\n", options->elementSize);
+    fprintf(file, "  \"repeats\": %d,\n", options->repeats);
+    fprintf(file, "  \"kernelLevel\": \"%s\",\n", setKernelLevelName(detectSetKernelLevel()));
+    fprintf(file, "  \"threads\": %d,\n", getParallelThreadCount());
+    fprintf(file, "  \"peakRssKiB\": %zu,\n", peakRssKiB());
+    fprintf(file, "  \"results\": [\n");
+    for (int i = 0; i < resultCount; i++) {
+        const struct BenchResult* result = &results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"ops\": %zu, \"nsPerOp\": %.4f, \"opsPerSecond\": %.1f, \"peakRssKiB\": %zu}%s\n",
+                result->name, result->ops, result->nsPerOp, result->nsPerOp > 0 ? 1e9 / result->nsPerOp : 0.0,
+                result->peakRssKiB, i + 1 < resultCount ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+
+    int ok = !ferror(file);
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) printf("Cannot write %s.\n", path);
+    return ok;
+}
+
+// Function to compare the results with an earlier run
+/**
+ * @brief Reads a JSON file written by writeJson and compares its ns/op with this run.
+ *
+ * Only the "name" and "nsPerOp" fields of each result line are read. Benchmarks missing from
+ * either run are skipped.
+ *
+ * @param path The baseline file.
+ * @param tolerance Slowdown in percent above which a result counts as a regression.
+ * @return int Number of regressions, or -1 if the baseline cannot be read.
+ */
+static int compareBaseline(const char* path, double tolerance) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        printf("Cannot read baseline %s.\n", path);
+        return -1;
+    }
+
+    printf("\nComparison with %s (regression above +%.1f%%)\n", path, tolerance);
+    printf("%-48s %12s %12s %9s\n", "benchmark", "base ns/op", "ns/op", "change");
+
+    int compared = 0;
+    int regressions = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), file)) {
+        const char* nameField = strstr(line, "\"name\": \"");
+        const char* timeField = strstr(line, "\"nsPerOp\": ");
+        if (!nameField || !timeField) continue;
+
+        char name[BENCH_NAME_SIZE];
+        nameField += strlen("\"name\": \"");
+        size_t length = strcspn(nameField, "\"");
+        if (length >= sizeof(name)) continue;
+        memcpy(name, nameField, length);
+        name[length] = '\0';
+        double baseline = strtod(timeField + strlen("\"nsPerOp\": "), NULL);
+
+        for (int i = 0; i < resultCount; i++) {
+            if (strcmp(results[i].name, name) != 0 || baseline <= 0) continue;
+            double change = (results[i].nsPerOp - baseline) * 100.0 / baseline;
+            int regressed = change > tolerance;
+            printf("%-48s %12.2f %12.2f %+8.1f%%%s\n", name, baseline, results[i].nsPerOp, change,
+                   regressed ? "  REGRESSION" : "");
+            regressions += regressed;
+            compared++;
+            break;
+        }
+    }
+    fclose(file);
+
+    printf("%d benchmarks compared, %d regressions.\n", compared, regressions);
+    return regressions;
+}
+
+// Function to read the command line
+/**
+ * @brief Fills in the benchmark settings from the command line.
+ *
+ * @return int 1 if the options are valid, 0 otherwise.
+ */
+static int parseOptions(int argc, char* argv[], struct BenchOptions* options) {
+    options->setSize = BENCH_SET_SIZE;
+    options->elementSize = BENCH_ELEMENT_SIZE;
+    options->repeats = BENCH_REPEATS;
+    options->tolerance = BENCH_TOLERANCE;
+    options->jsonPath = NULL;
+    options->baselinePath = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 == argc) return 0;  // Every option takes a value
+        const char* value = argv[++i];
+        if (strcmp(argv[i - 1], "--set-size") == 0) options->setSize = (size_t)strtoul(value, NULL, 10);
+        else if (strcmp(argv[i - 1], "--element-size") == 0) options->elementSize = (size_t)strtoul(value, NULL, 10);
+        else if (strcmp(argv[i - 1], "--repeats") == 0) options->repeats = atoi(value);
+        else if (strcmp(argv[i - 1], "--tolerance") == 0) options->tolerance = strtod(value, NULL);
+        else if (strcmp(argv[i - 1], "--json") == 0) options->jsonPath = value;
+        else if (strcmp(argv[i - 1], "--baseline") == 0) options->baselinePath = value;
+        else return 0;
+    }
+    return options->setSize >= 100 && options->elementSize > 0 && options->repeats > 0;
+}
+
+/**
+ * @brief Main function of the benchmark program.
+ *
+ * Options:
+ * - "--set-size n": elements in the operands of the set operations (default 1000000).
+ * - "--element-size n": elements added, looked up and removed one at a time (default 20000).
+ * - "--repeats n": runs per measurement, the best one is reported (default 5).
+ * - "--json file": writes the results as JSON.
+ * - "--baseline file": compares the results with a JSON file from an earlier run.
+ * - "--tolerance p": slowdown in percent that counts as a regression (default 10).
+ *
+ * @return int Returns 0 on success, 1 on bad options, memory allocation failure or when a regression is found.
+ */
+int main(int argc, char* argv[]) {
+    setLogLevel(LOG_LEVEL_ERROR);
+
+    struct BenchOptions options;
+    if (!parseOptions(argc, argv, &options)) {
+        printf("Usage: %s [--set-size n] [--element-size n] [--repeats n] [--json file] [--baseline file] [--tolerance percent]\n",
+               argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("Ordered Set benchmark, best of %d runs, %zu element operations, %zu element set operations\n",
+           options.repeats, options.elementSize, options.setSize);
+
+    int ok = benchmarkElementOperations(&options) &&
+             benchmarkSetOperations(&options) &&
+             benchmarkManySets(&options) &&
+             benchmarkKernelLevels(&options) &&
+             benchmarkRegistry(&options);
+    shutdownParallelSetOps();
+    if (!ok) {
+        printf("Memory allocation failed.\n");
+        return EXIT_FAILURE;
+    }
+    if (!benchmarkConcurrentSet(&options)) return EXIT_FAILURE;
+    printf("\nPeak resident set size: %zu KiB\n", peakRssKiB());
+
+    if (options.jsonPath && !writeJson(options.jsonPath, &options)) return EXIT_FAILURE;
+    if (options.baselinePath && compareBaseline(options.baselinePath, options.tolerance) != 0) return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,511 @@
+/**
+ * @file concurrentSet.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for an ordered integer set shared between threads.<br/>
+ *
+ * This file contains the skip list behind the concurrent set, the atomic loads and stores
+ * it is built on, and the reclamation of unlinked nodes. Links are read with acquire loads
+ * and written with release stores, so a reader that reaches a node also sees its value and
+ * links. Counters that decide when memory may be freed use sequentially consistent
+ * operations. On MSVC the links rely on plain x86/x64 loads and stores already having
+ * acquire and release semantics, and the counters use the Interlocked functions.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif !defined(_WIN32)
+#include <sched.h>
+#endif
+
+// include module header files
+#include "concurrentSet.h"
+#include "logging.h"
+
+// One node in CONCURRENT_FANOUT is promoted to each next level
+#define CONCURRENT_FANOUT 4
+
+// Number of lock-free attempts a snapshot makes before it takes the writer lock
+#define CONCURRENT_SNAPSHOT_ATTEMPTS 4
+
+// Storage class of the reader slot of each thread
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+// Slot the calling thread counts itself in as a reader, -1 until its first read
+static THREAD_LOCAL int readerSlot = -1;
+
+// Number of reader slots handed out so far
+static volatile long readerSlotsAssigned = 0;
+
+// Function to read a link
+/**
+ * @brief Loads a link with acquire semantics.
+ */
+static struct ConcurrentNode* loadLink(struct ConcurrentNode* volatile* link) {
+#if defined(_MSC_VER)
+    struct ConcurrentNode* node = *link;
+    _ReadWriteBarrier();
+    return node;
+#else
+    return __atomic_load_n(link, __ATOMIC_ACQUIRE);
+#endif
+}
+
+// Function to write a link
+/**
+ * @brief Stores a link with release semantics, publishing everything written before it.
+ */
+static void storeLink(struct ConcurrentNode* volatile* link, struct ConcurrentNode* node) {
+#if defined(_MSC_VER)
+    _ReadWriteBarrier();
+    *link = node;
+#else
+    __atomic_store_n(link, node, __ATOMIC_RELEASE);
+#endif
+}
+
+// Functions to read, write and step the shared counters (sequentially consistent)
+static long loadCounter(volatile long* counter) {
+#if defined(_MSC_VER)
+    long value = *counter;
+    _ReadWriteBarrier();
+    return value;
+#else
+    return __atomic_load_n(counter, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static void storeCounter(volatile long* counter, long value) {
+#if defined(_MSC_VER)
+    InterlockedExchange(counter, value);
+#else
+    __atomic_store_n(counter, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static void incrementCounter(volatile long* counter) {
+#if defined(_MSC_VER)
+    InterlockedIncrement(counter);
+#else
+    __atomic_add_fetch(counter, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static void decrementCounter(volatile long* counter) {
+#if defined(_MSC_VER)
+    InterlockedDecrement(counter);
+#else
+    __atomic_sub_fetch(counter, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static long fetchIncrementCounter(volatile long* counter) {
+#if defined(_MSC_VER)
+    return InterlockedIncrement(counter) - 1;
+#else
+    return __atomic_fetch_add(counter, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Function to let other threads run while waiting
+static void yieldThread() {
+#if defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+// Function to enter a read side critical section
+/**
+ * @brief Registers the calling thread as a reader of the current epoch.
+ *
+ * The reader counts itself in the counter of the epoch it saw, in its own slot, and then
+ * checks that the epoch has not moved on; if it has, a writer may already have stopped
+ * waiting for that counter, so the reader backs out and tries again. A thread is given
+ * its slot on its first read, round robin, so the counter it steps is normally on a cache
+ * line no other thread writes.
+ *
+ * @param set The concurrent set.
+ * @return volatile long* The counter to release with readEnd.
+ */
+static volatile long* readBegin(struct ConcurrentSet* set) {
+    if (readerSlot < 0) {
+        readerSlot = (int)(fetchIncrementCounter(&readerSlotsAssigned) % CONCURRENT_READER_SLOTS);
+    }
+    struct ConcurrentReaderSlot* slot = &set->slots[readerSlot];
+    for (;;) {
+        long epoch = loadCounter(&set->epoch);
+        incrementCounter(&slot->readers[epoch & 1]);
+        if (loadCounter(&set->epoch) == epoch) return &slot->readers[epoch & 1];
+        decrementCounter(&slot->readers[epoch & 1]);
+    }
+}
+
+// Function to leave a read side critical section
+static void readEnd(volatile long* counter) {
+    decrementCounter(counter);
+}
+
+// Function to free the retired nodes
+/**
+ * @brief Frees every node retired so far, once no reader can still be standing on one.
+ *
+ * The caller holds the writer lock. The nodes are unreachable from the head, so only
+ * readers that entered before the epoch is advanced can hold them; the writer waits for
+ * the counter of the old epoch to drain in every slot. Readers entering afterwards use the
+ * other counter.
+ *
+ * @param set The concurrent set.
+ */
+static void reclaimRetired(struct ConcurrentSet* set) {
+    struct ConcurrentNode* node = set->retiredList;
+    set->retiredList = NULL;
+    set->retiredCount = 0;
+
+    long epoch = loadCounter(&set->epoch);
+    storeCounter(&set->epoch, epoch + 1);
+    for (int s = 0; s < CONCURRENT_READER_SLOTS; s++) {
+        while (loadCounter(&set->slots[s].readers[epoch & 1]) != 0) {
+            yieldThread();
+        }
+    }
+
+    while (node) {
+        struct ConcurrentNode* next = node->retired;
+        free(node);
+        node = next;
+    }
+}
+
+// Function to allocate a node
+/**
+ * @brief Allocates a node with 'height' links, all set to NULL.
+ *
+ * @return struct ConcurrentNode* The new node or NULL if memory allocation fails.
+ */
+static struct ConcurrentNode* createNode(int value, int height) {
+    struct ConcurrentNode* node = (struct ConcurrentNode*)malloc(sizeof(struct ConcurrentNode) +
+                                                                 height * sizeof(struct ConcurrentNode*));
+    if (!node) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    node->value = value;
+    node->height = height;
+    node->retired = NULL;
+    for (int l = 0; l < height; l++) {
+        node->next[l] = NULL;
+    }
+    return node;
+}
+
+// Function to choose the height of a new node
+/**
+ * @brief Draws a random node height in 1..CONCURRENT_MAX_LEVEL (the caller holds the writer lock).
+ */
+static int randomHeight(struct ConcurrentSet* set) {
+    int height = 1;
+    while (height < CONCURRENT_MAX_LEVEL) {
+        // xorshift32
+        set->seed ^= set->seed << 13;
+        set->seed ^= set->seed >> 17;
+        set->seed ^= set->seed << 5;
+        if (set->seed % CONCURRENT_FANOUT != 0) break;
+        height++;
+    }
+    return height;
+}
+
+// Function to find the nodes before a value on every level
+/**
+ * @brief Fills preds[l] with the last node on level l whose value is < 'value' (the caller holds the writer lock).
+ *
+ * @return struct ConcurrentNode* The first node with a value >= 'value', or NULL.
+ */
+static struct ConcurrentNode* findPredecessors(struct ConcurrentSet* set, int value,
+                                               struct ConcurrentNode** preds) {
+    struct ConcurrentNode* x = set->head;
+    for (int l = CONCURRENT_MAX_LEVEL - 1; l >= 0; l--) {
+        while (x->next[l] && x->next[l]->value < value) {
+            x = x->next[l];
+        }
+        preds[l] = x;
+    }
+    return x->next[0];
+}
+
+// Function to mark the start of a change
+static void beginWrite(struct ConcurrentSet* set) {
+    storeCounter(&set->version, set->version + 1);
+}
+
+// Function to mark the end of a change
+static void endWrite(struct ConcurrentSet* set) {
+    storeCounter(&set->version, set->version + 1);
+}
+
+// Function to create an empty concurrent set
+/**
+ * @brief Creates a new empty concurrent set.
+ *
+ * @return struct ConcurrentSet* Pointer to the new set or NULL if memory allocation fails.
+ */
+struct ConcurrentSet* createConcurrentSet() {
+    struct ConcurrentSet* set = (struct ConcurrentSet*)malloc(sizeof(struct ConcurrentSet));
+    if (!set) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    set->head = createNode(0, CONCURRENT_MAX_LEVEL);
+    if (!set->head) {
+        free(set);
+        return NULL;
+    }
+    threadMutexInit(&set->writeLock);
+    set->level = 1;
+    set->count = 0;
+    set->version = 0;
+    set->epoch = 0;
+    for (int s = 0; s < CONCURRENT_READER_SLOTS; s++) {
+        set->slots[s].readers[0] = 0;
+        set->slots[s].readers[1] = 0;
+    }
+    set->retiredList = NULL;
+    set->retiredCount = 0;
+    set->seed = 2463534242u;
+    return set;
+}
+
+// Function to delete a concurrent set
+/**
+ * @brief Frees a concurrent set, its nodes and its retired nodes.
+ *
+ * No other thread may be using the set.
+ *
+ * @param set Pointer to the set to delete.
+ */
+void deleteConcurrentSet(struct ConcurrentSet* set) {
+    if (!set) return;
+
+    struct ConcurrentNode* node = set->head;
+    while (node) {
+        struct ConcurrentNode* next = node->next[0];
+        free(node);
+        node = next;
+    }
+    node = set->retiredList;
+    while (node) {
+        struct ConcurrentNode* next = node->retired;
+        free(node);
+        node = next;
+    }
+    threadMutexDestroy(&set->writeLock);
+    free(set);
+}
+
+// Function to add an element to a concurrent set
+/**
+ * @brief Adds an element, linking the new node in from the bottom level up.
+ *
+ * The node is fully built before it is published, and each level is linked with one
+ * release store, so readers see either no node or a complete one. The element is in the
+ * set from the moment the bottom level link is stored.
+ *
+ * @param set The concurrent set.
+ * @param elem The element to add.
+ *
+ * @return SetStatus NUMBER_ADDED, NUMBER_ALREADY_IN_SET or ALLOCATION_ERROR.
+ */
+SetStatus concurrentAddElement(struct ConcurrentSet* set, int elem) {
+    if (!set) return ALLOCATION_ERROR;
+
+    struct ConcurrentNode* preds[CONCURRENT_MAX_LEVEL];
+    threadMutexLock(&set->writeLock);
+    struct ConcurrentNode* next = findPredecessors(set, elem, preds);
+    if (next && next->value == elem) {
+        threadMutexUnlock(&set->writeLock);
+        return NUMBER_ALREADY_IN_SET;
+    }
+
+    int height = randomHeight(set);
+    struct ConcurrentNode* node = createNode(elem, height);
+    if (!node) {
+        threadMutexUnlock(&set->writeLock);
+        return ALLOCATION_ERROR;
+    }
+    for (int l = 0; l < height; l++) {
+        node->next[l] = preds[l]->next[l];
+    }
+    if (height > set->level) storeCounter(&set->level, height);
+
+    beginWrite(set);
+    for (int l = 0; l < height; l++) {
+        storeLink(&preds[l]->next[l], node);
+    }
+    storeCounter(&set->count, set->count + 1);
+    endWrite(set);
+
+    threadMutexUnlock(&set->writeLock);
+    return NUMBER_ADDED;
+}
+
+// Function to remove an element from a concurrent set
+/**
+ * @brief Removes an element, unlinking its node from the top level down and retiring it.
+ *
+ * The node keeps its own links, so readers standing on it carry on to its successors.
+ * It is freed by a later reclamation, after those readers have finished. The element
+ * leaves the set when the bottom level link is stored.
+ *
+ * @param set The concurrent set.
+ * @param elem The element to remove.
+ *
+ * @return SetStatus NUMBER_REMOVED, NUMBER_NOT_IN_SET or ALLOCATION_ERROR if 'set' is NULL.
+ */
+SetStatus concurrentRemoveElement(struct ConcurrentSet* set, int elem) {
+    if (!set) return ALLOCATION_ERROR;
+
+    struct ConcurrentNode* preds[CONCURRENT_MAX_LEVEL];
+    threadMutexLock(&set->writeLock);
+    struct ConcurrentNode* node = findPredecessors(set, elem, preds);
+    if (!node || node->value != elem) {
+        threadMutexUnlock(&set->writeLock);
+        return NUMBER_NOT_IN_SET;
+    }
+
+    beginWrite(set);
+    for (int l = node->height - 1; l >= 0; l--) {
+        storeLink(&preds[l]->next[l], node->next[l]);
+    }
+    storeCounter(&set->count, set->count - 1);
+    endWrite(set);
+
+    node->retired = set->retiredList;
+    set->retiredList = node;
+    if (++set->retiredCount >= CONCURRENT_RETIRE_BATCH) reclaimRetired(set);
+
+    threadMutexUnlock(&set->writeLock);
+    return NUMBER_REMOVED;
+}
+
+// Function to check whether an element is in a concurrent set
+/**
+ * @brief Searches the skip list for an element without taking a lock.
+ *
+ * @param set The concurrent set.
+ * @param elem The element to look for.
+ * @return int 1 if the element is in the set, 0 otherwise.
+ */
+int concurrentContainsElement(struct ConcurrentSet* set, int elem) {
+    if (!set) return 0;
+
+    volatile long* reader = readBegin(set);
+    struct ConcurrentNode* x = set->head;
+    struct ConcurrentNode* next = NULL;
+    for (int l = (int)loadCounter(&set->level) - 1; l >= 0; l--) {
+        next = loadLink(&x->next[l]);
+        while (next && next->value < elem) {
+            x = next;
+            next = loadLink(&x->next[l]);
+        }
+    }
+    int found = next && next->value == elem;
+    readEnd(reader);
+    return found;
+}
+
+// Function to count the elements of a concurrent set
+/**
+ * @brief Returns the number of elements, without taking a lock.
+ */
+size_t concurrentSetCount(struct ConcurrentSet* set) {
+    return set ? (size_t)loadCounter(&set->count) : 0;
+}
+
+// Function to copy the bottom level of the skip list
+/**
+ * @brief Copies up to 'capacity' elements into 'out' in ascending order.
+ *
+ * @return size_t The number of elements copied, or capacity + 1 if the set holds more.
+ */
+static size_t copyLevel(struct ConcurrentSet* set, int* out, size_t capacity) {
+    size_t n = 0;
+    for (struct ConcurrentNode* node = loadLink(&set->head->next[0]); node; node = loadLink(&node->next[0])) {
+        if (n == capacity) return capacity + 1;
+        out[n++] = node->value;
+    }
+    return n;
+}
+
+// Function to take a snapshot of a concurrent set
+/**
+ * @brief Copies the elements the set holds at one instant into a new sorted array set.
+ *
+ * The copy is made without a lock and kept only if 'version' was even and unchanged
+ * around it, meaning no writer touched the set meanwhile. After
+ * CONCURRENT_SNAPSHOT_ATTEMPTS failed attempts the copy is made under the writer lock,
+ * so a steady stream of writers cannot starve the snapshot.
+ *
+ * @param set The concurrent set.
+ * @return OrderedIntSet* The snapshot or NULL if memory allocation fails.
+ */
+OrderedIntSet* concurrentSetSnapshot(struct ConcurrentSet* set) {
+    if (!set) return NULL;
+
+    struct SortedArray* array = NULL;
+    for (int attempt = 0; attempt <= CONCURRENT_SNAPSHOT_ATTEMPTS; attempt++) {
+        size_t expected = (size_t)loadCounter(&set->count);
+        size_t capacity = expected + expected / 8 + 16;   // Room for elements added while copying
+        if (!array) array = createSortedArray(capacity);
+        if (!array || !reserveSortedArray(array, capacity)) {
+            deleteSortedArray(array);
+            return NULL;
+        }
+
+        if (attempt == CONCURRENT_SNAPSHOT_ATTEMPTS) {
+            threadMutexLock(&set->writeLock);
+            if (!reserveSortedArray(array, (size_t)set->count)) {
+                threadMutexUnlock(&set->writeLock);
+                deleteSortedArray(array);
+                return NULL;
+            }
+            array->size = copyLevel(set, array->data, array->capacity);
+            threadMutexUnlock(&set->writeLock);
+            break;
+        }
+
+        long version = loadCounter(&set->version);
+        if (version & 1) {
+            yieldThread();
+            continue;
+        }
+        volatile long* reader = readBegin(set);
+        size_t n = copyLevel(set, array->data, array->capacity);
+        readEnd(reader);
+        if (n <= array->capacity && loadCounter(&set->version) == version) {
+            array->size = n;
+            break;
+        }
+    }
+    return createOrderedSetFromSortedArray(array);
+}
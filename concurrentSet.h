@@ -0,0 +1,139 @@
+/**
+ * @file concurrentSet.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for an ordered integer set shared between threads.<br/>
+ *
+ * This header file declares a concurrent ordered set built as a skip list. Any number
+ * of threads may look elements up, count them or take snapshots while other threads
+ * add and remove elements. Lookups and counts never take a lock and never wait for a
+ * writer: writers link a fully built node in with one atomic pointer store per level and
+ * unlink nodes the same way, so a reader always follows valid pointers. Writers are
+ * serialised by a mutex. Snapshots are the exception: see below.
+ *
+ * Unlinked nodes are not freed straight away, because a reader may still be standing on
+ * one. They are retired and freed in batches once every reader that could have seen them
+ * has finished (epoch based reclamation with two reader counters). The counters are split
+ * into CONCURRENT_READER_SLOTS slots on cache lines of their own and each thread counts
+ * itself in its own slot, so readers on different cores do not contend for one line.
+ *
+ * Every operation is linearizable: an add takes effect when its node is linked into the
+ * bottom level, a remove when it is unlinked from it. A snapshot is an ordinary sorted
+ * array set holding the elements at one instant. It is read without a lock and retried
+ * if a writer changed the set meanwhile. After CONCURRENT_SNAPSHOT_ATTEMPTS failed
+ * attempts it takes the writer lock for the copy, so a snapshot taken while writers are
+ * busy may wait for the current writer and holds the next ones off until the copy is
+ * done. Snapshots are the way to iterate over the set or to combine it with other sets.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef CONCURRENT_SET_H
+#define CONCURRENT_SET_H
+
+#include <stddef.h>
+
+#include "orderedSet.h"
+#include "threadPool.h"
+
+// Maximum number of levels of the skip list
+#define CONCURRENT_MAX_LEVEL 16
+
+// Number of retired nodes collected before they are freed
+#define CONCURRENT_RETIRE_BATCH 64
+
+// Number of reader counter slots; threads beyond this many share slots
+#define CONCURRENT_READER_SLOTS 16
+
+// Size of a cache line, the distance between two reader slots
+#define CONCURRENT_CACHE_LINE 64
+
+// Concurrent node structure
+/**
+ * @brief Structure representing one element of a concurrent set.
+ *
+ * - 'value': the element; never changes once the node is linked in.
+ * - 'height': number of levels the node is linked into.
+ * - 'retired': next node waiting to be freed, once the node has been unlinked.
+ * - 'next': next[l] is the following node on level l. A node keeps its links after it is
+ *   unlinked, so a reader standing on it can still move on.
+ */
+struct ConcurrentNode
+{
+    int value;
+    int height;
+    struct ConcurrentNode* retired;
+    struct ConcurrentNode* volatile next[];
+};
+
+// Reader slot structure
+/**
+ * @brief Structure holding the reader counters of the threads assigned to one slot.
+ *
+ * - 'readers': readers[e & 1] counts the readers of this slot that entered during epoch e.
+ */
+struct ConcurrentReaderSlot
+{
+    volatile long readers[2];
+    char padding[CONCURRENT_CACHE_LINE - 2 * sizeof(long)];
+};
+
+// Concurrent set structure
+/**
+ * @brief Structure representing an ordered integer set that threads can share.
+ *
+ * - 'writeLock': held by the thread adding or removing an element.
+ * - 'head': sentinel node of height CONCURRENT_MAX_LEVEL before every element.
+ * - 'level': number of levels in use.
+ * - 'count': number of elements.
+ * - 'version': incremented before and after every change, so it is odd while a change is in progress.
+ * - 'epoch' / 'slots': reclamation state; the readers that entered during epoch e are counted in
+ *   the readers[e & 1] counters of the slots.
+ * - 'retiredList' / 'retiredCount': nodes unlinked since the last reclamation.
+ * - 'seed': state of the random generator that chooses node heights.
+ */
+struct ConcurrentSet
+{
+    ThreadMutex writeLock;
+    struct ConcurrentNode* head;
+    volatile long level;
+    volatile long count;
+    volatile long version;
+    volatile long epoch;
+    struct ConcurrentReaderSlot slots[CONCURRENT_READER_SLOTS];
+    struct ConcurrentNode* retiredList;
+    int retiredCount;
+    unsigned int seed;
+};
+
+// Function declarations
+/**
+ * @brief Function declarations for concurrent set operations.
+ *
+ * - 'createConcurrentSet' / 'deleteConcurrentSet': create an empty set, free a set (no other thread may use it).
+ * - 'concurrentAddElement' / 'concurrentRemoveElement': writers; return the same SetStatus values as addElement
+ *   and removeElement.
+ * - 'concurrentContainsElement': returns 1 if the element is in the set, without locking.
+ * - 'concurrentSetCount': number of elements, without locking.
+ * - 'concurrentSetSnapshot': new sorted array set with the elements at one instant, or NULL if memory
+ *   allocation fails.
+ */
+struct ConcurrentSet* createConcurrentSet();
+void deleteConcurrentSet(struct ConcurrentSet* set);
+SetStatus concurrentAddElement(struct ConcurrentSet* set, int elem);
+SetStatus concurrentRemoveElement(struct ConcurrentSet* set, int elem);
+int concurrentContainsElement(struct ConcurrentSet* set, int elem);
+size_t concurrentSetCount(struct ConcurrentSet* set);
+OrderedIntSet* concurrentSetSnapshot(struct ConcurrentSet* set);
+
+#endif // CONCURRENT_SET_H
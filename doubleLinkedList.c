@@ -24,25 +24,58 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-// include module header file
+// include module header files
 #include "doubleLinkedList.h"
+#include "logging.h"
+#include "instrumentation.h"
 
 // Function to create an empty double linked list
 /**
  * @brief Creates a new empty Double Linked List, consisting only of head and tail
  *
+ * The list gets a Node Pool of its own, which is deleted together with the list.
+ *
  * @return struct DoubleLinkedList* Pointer to the newly created Double Linked List.
  * 
  */
 struct DoubleLinkedList* createDoubleLinkedList() {
+    struct NodePool* pool = createNodePool(0);
+    if (!pool) return NULL;
+
+    struct DoubleLinkedList* list = createDoubleLinkedListWithPool(pool);
+    if (!list) {
+        deleteNodePool(pool);
+        return NULL;
+    }
+    list->ownsPool = 1;
+    return list;
+}
+
+// Function to create an empty double linked list on a shared pool
+/**
+ * @brief Creates a new empty Double Linked List whose nodes come from an existing Node Pool.
+ *
+ * The pool may be shared by several lists and is not deleted with the list.
+ *
+ * @param pool The Node Pool to allocate nodes from.
+ * @return struct DoubleLinkedList* Pointer to the newly created Double Linked List.
+ */
+struct DoubleLinkedList* createDoubleLinkedListWithPool(struct NodePool* pool) {
+    if (!pool) {
+        LOG_ERROR("Invalid node pool.");
+        return NULL;
+    }
     struct DoubleLinkedList* list = (struct DoubleLinkedList*)malloc(sizeof(struct DoubleLinkedList));
     if (!list) {
-        printf("Memory allocation failed.\n");
+        LOG_ERROR("Memory allocation failed.");
         return NULL;
     }
+    INSTR_COUNT_ALLOC(sizeof(struct DoubleLinkedList));
     list->head = NULL;
     list->tail = NULL;
-    printf("Empty double linked list created.\n");
+    list->pool = pool;
+    list->ownsPool = 0;
+    LOG_INFO("Empty double linked list created.");
     return list;
 }
 
@@ -50,25 +83,33 @@ struct DoubleLinkedList* createDoubleLinkedList() {
 /**
  * @brief Deletes an entire Double Linked List and frees its memory.
  *
+ * When the list owns its Node Pool the whole pool is released at once, one slab at a time.
+ * Nodes of a shared pool are returned to the pool's free list instead.
+ *
  * @param list Pointer to the Double Linked List to delete.
  * 
  */
 void deleteDoubleLinkedList(struct DoubleLinkedList* list) {
     if (!list) return;
 
-    struct Node* currentNode = list->head;
-    struct Node* nextNode;
+    if (list->ownsPool) {
+        deleteNodePool(list->pool);
+    } else {
+        struct Node* currentNode = list->head;
+        struct Node* nextNode;
 
-    while (currentNode != NULL) {
-        nextNode = currentNode->next;
-        free(currentNode);
-        currentNode = nextNode;
+        while (currentNode != NULL) {
+            nextNode = currentNode->next;
+            releaseNode(list->pool, currentNode);
+            currentNode = nextNode;
+        }
     }
 
     list->head = NULL;
     list->tail = NULL;
+    list->pool = NULL;
     free(list);
-    printf("The entire list is deleted.\n");
+    LOG_INFO("The entire list is deleted.");
 }
 
 // Function to print the double linked list
@@ -107,7 +148,7 @@ void printDoubleLinkedList(struct DoubleLinkedList* list) {
  */
 void removeNode(struct DoubleLinkedList* list, struct Node* current) {
     if (!list || !current) {
-        printf("Invalid node or list.\n");
+        LOG_ERROR("Invalid node or list.");
         return;
     }
 
@@ -123,8 +164,8 @@ void removeNode(struct DoubleLinkedList* list, struct Node* current) {
         list->tail = current->prev;  // Update tail if removing the last node
     }
 
-    free(current);
-    printf("Node removed successfully.\n");
+    releaseNode(list->pool, current);
+    LOG_DEBUG("Node removed successfully.");
 }
 
 // Function to append a node to the end of the list
@@ -133,18 +174,19 @@ void removeNode(struct DoubleLinkedList* list, struct Node* current) {
  *
  * @param list Pointer to the Double Linked List.
  * @param newdata The data to store in the new node.
+ * @return struct Node* The new node, or NULL if the list is invalid or memory allocation fails.
  * @details If the list is empty, the new node becomes both the head and tail.
  */
-void appendNode(struct DoubleLinkedList* list, int newdata) {
+struct Node* appendNode(struct DoubleLinkedList* list, int newdata) {
     if (!list) {
-        printf("Invalid list.\n");
-        return;
+        LOG_ERROR("Invalid list.");
+        return NULL;
     }
 
-    struct Node* newNode = (struct Node*)malloc(sizeof(struct Node));
+    struct Node* newNode = allocateNode(list->pool);
     if (!newNode) {
-        printf("Memory allocation failed.\n");
-        return;
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
     }
 
     newNode->data = newdata;
@@ -157,6 +199,7 @@ void appendNode(struct DoubleLinkedList* list, int newdata) {
         list->head = newNode;
     }
     list->tail = newNode;
+    return newNode;
 }
 
 // Function to insert a node before a given node
@@ -166,18 +209,19 @@ void appendNode(struct DoubleLinkedList* list, int newdata) {
  * @param list Pointer to the Double Linked List.
  * @param current Pointer to the node before which the new node will be inserted.
  * @param newdata The data to store in the new node.
+ * @return struct Node* The new node, or NULL if the arguments are invalid or memory allocation fails.
  * @details Updates the head pointer if the insertion is at the start of the list.
  */
-void insertBefore(struct DoubleLinkedList* list, struct Node* current, int newdata) {
+struct Node* insertBefore(struct DoubleLinkedList* list, struct Node* current, int newdata) {
     if (!current || !list) {
-        printf("Cannot insert before a NULL node or in an invalid list.\n");
-        return;
+        LOG_ERROR("Cannot insert before a NULL node or in an invalid list.");
+        return NULL;
     }
 
-    struct Node* newNode = (struct Node*)malloc(sizeof(struct Node));
+    struct Node* newNode = allocateNode(list->pool);
     if (!newNode) {
-        printf("Memory allocation failed.\n");
-        return;
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
     }
 
     newNode->data = newdata;
@@ -190,4 +234,5 @@ void insertBefore(struct DoubleLinkedList* list, struct Node* current, int newda
         list->head = newNode;  // Update head if inserting at the start
     }
     current->prev = newNode;
+    return newNode;
 }
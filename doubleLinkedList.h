@@ -24,6 +24,8 @@
 #ifndef DOUBLE_LINKED_LIST_H
 #define DOUBLE_LINKED_LIST_H
 
+#include "nodePool.h"
+
 // Node structure
 /**
  * @brief Structure representing a node in the double linked list.
@@ -43,15 +45,19 @@ struct Node
 /**
  * @brief Structure representing a double linked list.
  *
- * This structure holds two pointers:
+ * This structure holds:
  * - 'head': points to the first node of the list.
  * - 'tail': points to the last node of the list.
+ * - 'pool': the Node Pool the nodes of the list are allocated from.
+ * - 'ownsPool': 1 if the pool belongs to this list alone and is deleted with it.
  *
  */
 struct DoubleLinkedList
 {
     struct Node* head;
     struct Node* tail;
+    struct NodePool* pool;
+    int ownsPool;
 };
 
 // Function declarations
@@ -60,18 +66,22 @@ struct DoubleLinkedList
  *
  * These functions enable the creation, deletion, and manipulation of a Double Linked List.
  *
- * - 'createDoubleLinkedList': Creates a new empty Double Linked List.
+ * - 'createDoubleLinkedList': Creates a new empty Double Linked List with its own Node Pool.
+ * - 'createDoubleLinkedListWithPool': Creates a new empty Double Linked List that allocates from a shared Node Pool.
  * - 'deleteDoubleLinkedList': Deletes an entire Double Linked List and frees its memory.
  * - 'printDoubleLinkedList': Prints the contents of the Double Linked List.
  * - 'removeNode': Removes a specific node from the Double Linked List.
- * - 'insertBefore': Inserts a new node before a specific node in the Double Linked List.
- * - 'appendNode': Appends a new node to the end of the Double Linked List.
+ * - 'insertBefore': Inserts a new node before a specific node in the Double Linked List; returns the new
+ *   node, or NULL if memory allocation fails.
+ * - 'appendNode': Appends a new node to the end of the Double Linked List; returns the new node, or NULL if
+ *   memory allocation fails.
  */
 struct DoubleLinkedList* createDoubleLinkedList();
+struct DoubleLinkedList* createDoubleLinkedListWithPool(struct NodePool* pool);
 void deleteDoubleLinkedList(struct DoubleLinkedList* list);
 void printDoubleLinkedList(struct DoubleLinkedList* list);
 void removeNode(struct DoubleLinkedList* list, struct Node* current);  // Declaration for removeNode
-void insertBefore(struct DoubleLinkedList* list, struct Node* current, int newdata);
-void appendNode(struct DoubleLinkedList* list, int newdata);
+struct Node* insertBefore(struct DoubleLinkedList* list, struct Node* current, int newdata);
+struct Node* appendNode(struct DoubleLinkedList* list, int newdata);
 
 #endif // DOUBLE_LINKED_LIST_H
@@ -0,0 +1,468 @@
+/**
+ * @file externalSetOps.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the set operations over sorted integer files.<br/>
+ *
+ * This file contains a block reader that parses text or binary integers out of a
+ * large buffer, a block writer, and the forward merge shared by intersection, union
+ * and difference. The files are opened unbuffered so that each block goes straight
+ * between the file and our buffer without a copy through stdio, and the inputs are
+ * flagged for sequential read-ahead where the platform supports it.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <sys/stat.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#endif
+
+// include module header files
+#include "externalSetOps.h"
+#include "logging.h"
+
+// Longest text token: "-2147483648" plus a separator
+#define EXTERNAL_TOKEN_MAX 12
+
+// Enumeration for the streaming operations
+typedef enum
+{
+    EXTERNAL_INTERSECTION,
+    EXTERNAL_UNION,
+    EXTERNAL_DIFFERENCE
+} ExternalOperation;
+
+// Sorted file reader structure
+/**
+ * @brief Structure reading ascending integers from a file one block at a time.
+ *
+ * - 'buffer' holds 'length' bytes, of which those before 'pos' have been consumed.
+ * - 'eof': the file has no more data beyond 'buffer'.
+ * - 'valid' / 'value': the current element, once the reader has been advanced.
+ * - 'started': at least one element has been read, so 'value' can be compared with the next one.
+ * - 'failed': a read error or a malformed or unsorted input was found.
+ */
+struct SortedFileReader
+{
+    FILE* file;
+    const char* path;
+    SortedFileFormat format;
+    unsigned char* buffer;
+    size_t capacity;
+    size_t pos;
+    size_t length;
+    int eof;
+    int valid;
+    int value;
+    int started;
+    int failed;
+};
+
+// Sorted file writer structure
+/**
+ * @brief Structure writing integers to a file one block at a time.
+ *
+ * - 'buffer' holds 'length' bytes not yet written.
+ * - 'count': number of values written.
+ * - 'failed': a write error occurred.
+ */
+struct SortedFileWriter
+{
+    FILE* file;
+    SortedFileFormat format;
+    unsigned char* buffer;
+    size_t capacity;
+    size_t length;
+    size_t count;
+    int failed;
+};
+
+static size_t externalBufferSize = EXTERNAL_DEFAULT_BUFFER;
+
+// Function to set the block size
+/**
+ * @brief Sets the size of the block buffer of each file. Three buffers are used per operation.
+ *
+ * @param bytes Buffer size in bytes (raised to EXTERNAL_MIN_BUFFER), or 0 for EXTERNAL_DEFAULT_BUFFER.
+ */
+void setExternalBufferSize(size_t bytes) {
+    if (bytes == 0) bytes = EXTERNAL_DEFAULT_BUFFER;
+    externalBufferSize = bytes < EXTERNAL_MIN_BUFFER ? EXTERNAL_MIN_BUFFER : bytes;
+}
+
+// Function to read the block size
+/**
+ * @brief Returns the size of the block buffer of each file.
+ */
+size_t getExternalBufferSize() {
+    return externalBufferSize;
+}
+
+// Function to open a file for block I/O
+/**
+ * @brief Opens a file without a stdio buffer; inputs are flagged for sequential reading.
+ *
+ * @return FILE* The open file or NULL.
+ */
+static FILE* openBlockFile(const char* path, const char* mode) {
+    FILE* file = fopen(path, mode);
+    if (!file) {
+        LOG_ERROR("Cannot open %s.", path);
+        return NULL;
+    }
+    setvbuf(file, NULL, _IONBF, 0);
+#if defined(POSIX_FADV_SEQUENTIAL)
+    if (mode[0] == 'r') posix_fadvise(fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    return file;
+}
+
+// Function to check whether two paths name the same file
+/**
+ * @brief Returns whether two paths name the same file.
+ *
+ * Equal paths always match. Otherwise, on POSIX both files must exist with the same device and
+ * inode, which also catches links and different spellings of one path; Windows does not report
+ * inode numbers, so there the two absolute paths are compared ignoring case.
+ *
+ * @return int 1 if the paths name the same file, 0 otherwise.
+ */
+static int isSameFile(const char* pathA, const char* pathB) {
+    if (strcmp(pathA, pathB) == 0) return 1;
+#if defined(_WIN32)
+    char fullA[_MAX_PATH];
+    char fullB[_MAX_PATH];
+    return _fullpath(fullA, pathA, _MAX_PATH) && _fullpath(fullB, pathB, _MAX_PATH) &&
+           _stricmp(fullA, fullB) == 0;
+#else
+    struct stat statA;
+    struct stat statB;
+    return stat(pathA, &statA) == 0 && stat(pathB, &statB) == 0 &&
+           statA.st_dev == statB.st_dev && statA.st_ino == statB.st_ino;
+#endif
+}
+
+// Function to refill the buffer of a reader
+/**
+ * @brief Moves the unread bytes to the front of the buffer and fills the rest from the file.
+ *
+ * @param reader The reader.
+ */
+static void fillReader(struct SortedFileReader* reader) {
+    size_t left = reader->length - reader->pos;
+    if (left > 0 && reader->pos > 0) memmove(reader->buffer, reader->buffer + reader->pos, left);
+    reader->pos = 0;
+    reader->length = left;
+    if (reader->eof) return;
+
+    size_t read = fread(reader->buffer + left, 1, reader->capacity - left, reader->file);
+    reader->length += read;
+    if (read < reader->capacity - left) {
+        if (ferror(reader->file)) {
+            LOG_ERROR("Cannot read %s.", reader->path);
+            reader->failed = 1;
+        }
+        reader->eof = 1;
+    }
+}
+
+// Function to report a malformed input
+/**
+ * @brief Logs a format error in the input of a reader and marks the reader as failed.
+ *
+ * @return int Always 0.
+ */
+static int readerError(struct SortedFileReader* reader, const char* message) {
+    LOG_ERROR("%s: %s", reader->path, message);
+    reader->failed = 1;
+    return 0;
+}
+
+// Function to read the next binary value
+/**
+ * @brief Reads the next 32-bit int of a binary file.
+ *
+ * @return int 1 if a value was read, 0 at the end of the file or on an error.
+ */
+static int readBinary(struct SortedFileReader* reader, int* value) {
+    if (reader->length - reader->pos < sizeof(int)) {
+        fillReader(reader);
+        if (reader->length - reader->pos < sizeof(int)) {
+            if (reader->length > reader->pos) return readerError(reader, "file size is not a multiple of 4 bytes.");
+            return 0;
+        }
+    }
+    memcpy(value, reader->buffer + reader->pos, sizeof(int));
+    reader->pos += sizeof(int);
+    return 1;
+}
+
+// Function to check for a text separator
+static int isSeparator(unsigned char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+}
+
+// Function to read the next text value
+/**
+ * @brief Parses the next decimal integer of a text file straight from the buffer.
+ *
+ * @return int 1 if a value was read, 0 at the end of the file or on an error.
+ */
+static int readText(struct SortedFileReader* reader, int* value) {
+    for (;;) {
+        while (reader->pos < reader->length && isSeparator(reader->buffer[reader->pos])) {
+            reader->pos++;
+        }
+        if (reader->pos < reader->length) break;
+        if (reader->eof) return 0;
+        fillReader(reader);
+    }
+
+    // Make sure a whole token is in the buffer
+    if (reader->length - reader->pos < EXTERNAL_TOKEN_MAX && !reader->eof) fillReader(reader);
+
+    const unsigned char* p = reader->buffer + reader->pos;
+    const unsigned char* end = reader->buffer + reader->length;
+    int negative = 0;
+    if (*p == '-' || *p == '+') negative = *p++ == '-';
+
+    long long result = 0;
+    const unsigned char* digits = p;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10 + (*p++ - '0');
+        if (result > (long long)INT_MAX + 1) return readerError(reader, "value out of range.");
+    }
+    if (negative) result = -result;
+    if (p == end && !reader->eof) return readerError(reader, "token too long.");
+    if (p == digits || (p < end && !isSeparator(*p))) return readerError(reader, "not an integer.");
+    if (result > INT_MAX) return readerError(reader, "value out of range.");
+
+    reader->pos = (size_t)(p - reader->buffer);
+    *value = (int)result;
+    return 1;
+}
+
+// Function to move a reader to the next element
+/**
+ * @brief Reads the next value larger than the current one, skipping repeats.
+ *
+ * Clears 'valid' at the end of the file. A value smaller than the current one is an error.
+ *
+ * @param reader The reader.
+ */
+static void advanceReader(struct SortedFileReader* reader) {
+    int value;
+    reader->valid = 0;
+    while (!reader->failed &&
+           (reader->format == SORTED_FILE_BINARY ? readBinary(reader, &value) : readText(reader, &value))) {
+        if (reader->started && value == reader->value) continue;
+        if (reader->started && value < reader->value) {
+            readerError(reader, "values are not in ascending order.");
+            return;
+        }
+        reader->value = value;
+        reader->valid = 1;
+        reader->started = 1;
+        return;
+    }
+}
+
+// Function to write out the buffer of a writer
+/**
+ * @brief Writes the buffered bytes to the file.
+ *
+ * @param writer The writer.
+ */
+static void flushWriter(struct SortedFileWriter* writer) {
+    if (writer->length > 0 && !writer->failed &&
+        fwrite(writer->buffer, 1, writer->length, writer->file) != writer->length) {
+        writer->failed = 1;
+    }
+    writer->length = 0;
+}
+
+// Function to write one value
+/**
+ * @brief Appends a value to the output, as text on its own line or as a native int.
+ *
+ * @param writer The writer.
+ * @param value The value.
+ */
+static void writeValue(struct SortedFileWriter* writer, int value) {
+    if (writer->capacity - writer->length < EXTERNAL_TOKEN_MAX) flushWriter(writer);
+    unsigned char* out = writer->buffer + writer->length;
+
+    if (writer->format == SORTED_FILE_BINARY) {
+        memcpy(out, &value, sizeof(int));
+        writer->length += sizeof(int);
+    } else {
+        unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+        char digits[10];
+        int n = 0;
+        do {
+            digits[n++] = (char)('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0) *out++ = '-';
+        while (n > 0) *out++ = (unsigned char)digits[--n];
+        *out++ = '\n';
+        writer->length = (size_t)(out - writer->buffer);
+    }
+    writer->count++;
+}
+
+// Function to run a streaming set operation
+/**
+ * @brief Merges two sorted files into an output file in one forward pass.
+ *
+ * The merge follows the in-memory set operations. When the operation fails the output file is
+ * removed. The output must not be one of the inputs: opening it would truncate that input, so
+ * this is checked before any file is opened.
+ *
+ * @return int 1 on success, 0 if the output is one of the inputs, a file cannot be read or
+ * written, an input is malformed or unsorted, or memory allocation fails.
+ */
+static int runExternal(const char* path1, const char* path2, const char* outPath,
+                       SortedFileFormat format, size_t* count, ExternalOperation operation) {
+    if (count) *count = 0;
+    if (!path1 || !path2 || !outPath) return 0;
+    if (isSameFile(outPath, path1) || isSameFile(outPath, path2)) {
+        LOG_ERROR("Output %s is also an input.", outPath);
+        return 0;
+    }
+
+    size_t size = externalBufferSize;
+    unsigned char* buffers = (unsigned char*)malloc(3 * size);
+    if (!buffers) {
+        LOG_ERROR("Memory allocation failed.");
+        return 0;
+    }
+
+    struct SortedFileReader a = { 0 };
+    struct SortedFileReader b = { 0 };
+    struct SortedFileWriter out = { 0 };
+    a.path = path1;
+    b.path = path2;
+    a.format = b.format = out.format = format;
+    a.buffer = buffers;
+    b.buffer = buffers + size;
+    out.buffer = buffers + 2 * size;
+    a.capacity = b.capacity = out.capacity = size;
+
+    a.file = openBlockFile(path1, "rb");
+    b.file = a.file ? openBlockFile(path2, "rb") : NULL;
+    out.file = b.file ? openBlockFile(outPath, "wb") : NULL;
+    int ok = out.file != NULL;
+
+    if (ok) {
+        advanceReader(&a);
+        advanceReader(&b);
+    }
+    while (ok && a.valid && b.valid) {
+        if (a.value < b.value) {
+            if (operation != EXTERNAL_INTERSECTION) writeValue(&out, a.value);
+            advanceReader(&a);
+        } else if (b.value < a.value) {
+            if (operation == EXTERNAL_UNION) writeValue(&out, b.value);
+            advanceReader(&b);
+        } else {
+            if (operation != EXTERNAL_DIFFERENCE) writeValue(&out, a.value);
+            advanceReader(&a);
+            advanceReader(&b);
+        }
+        ok = !a.failed && !b.failed && !out.failed;
+    }
+
+    // Copy what is left of the inputs that still contribute
+    while (ok && a.valid && operation != EXTERNAL_INTERSECTION) {
+        writeValue(&out, a.value);
+        advanceReader(&a);
+        ok = !a.failed && !out.failed;
+    }
+    while (ok && b.valid && operation == EXTERNAL_UNION) {
+        writeValue(&out, b.value);
+        advanceReader(&b);
+        ok = !b.failed && !out.failed;
+    }
+
+    if (out.file) {
+        flushWriter(&out);
+        if (fclose(out.file) != 0) out.failed = 1;
+        if (out.failed) LOG_ERROR("Cannot write %s.", outPath);
+        ok = ok && !a.failed && !b.failed && !out.failed;
+        if (!ok) remove(outPath);
+    }
+    if (a.file) fclose(a.file);
+    if (b.file) fclose(b.file);
+    free(buffers);
+
+    if (ok && count) *count = out.count;
+    return ok;
+}
+
+// Function to intersect two sorted files
+/**
+ * @brief Writes the values that are in both sorted files to 'outPath'.
+ *
+ * @param path1 The first sorted file.
+ * @param path2 The second sorted file.
+ * @param outPath The output file (must not be one of the inputs).
+ * @param format Format of the inputs and the output.
+ * @param count Receives the number of values written (may be NULL).
+ *
+ * @return int 1 on success, 0 on failure.
+ */
+int externalSetIntersection(const char* path1, const char* path2, const char* outPath,
+                            SortedFileFormat format, size_t* count) {
+    return runExternal(path1, path2, outPath, format, count, EXTERNAL_INTERSECTION);
+}
+
+// Function to unite two sorted files
+/**
+ * @brief Writes the values that are in either sorted file to 'outPath'.
+ *
+ * @param path1 The first sorted file.
+ * @param path2 The second sorted file.
+ * @param outPath The output file (must not be one of the inputs).
+ * @param format Format of the inputs and the output.
+ * @param count Receives the number of values written (may be NULL).
+ *
+ * @return int 1 on success, 0 on failure.
+ */
+int externalSetUnion(const char* path1, const char* path2, const char* outPath,
+                     SortedFileFormat format, size_t* count) {
+    return runExternal(path1, path2, outPath, format, count, EXTERNAL_UNION);
+}
+
+// Function to subtract one sorted file from another
+/**
+ * @brief Writes the values of the first sorted file that are not in the second to 'outPath'.
+ *
+ * @param path1 The first sorted file.
+ * @param path2 The second sorted file.
+ * @param outPath The output file (must not be one of the inputs).
+ * @param format Format of the inputs and the output.
+ * @param count Receives the number of values written (may be NULL).
+ *
+ * @return int 1 on success, 0 on failure.
+ */
+int externalSetDifference(const char* path1, const char* path2, const char* outPath,
+                          SortedFileFormat format, size_t* count) {
+    return runExternal(path1, path2, outPath, format, count, EXTERNAL_DIFFERENCE);
+}
@@ -0,0 +1,73 @@
+/**
+ * @file externalSetOps.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the set operations over sorted integer files.<br/>
+ *
+ * This header file declares streaming versions of set intersection, union and
+ * difference whose inputs and output are files of integers in ascending order,
+ * so sets far larger than memory can be combined. The files are read and written
+ * in large blocks and merged in one forward pass; memory use is three blocks,
+ * whatever the size of the files.
+ *
+ * Text files hold decimal integers separated by whitespace. Binary files hold
+ * 32-bit ints in the byte order of the machine, with no header. Repeated values
+ * in an input are treated as one element; a value smaller than the one before
+ * it is an error. The output file must differ from both inputs; an output that
+ * names an input, directly or through a link, is rejected before anything is
+ * opened, since writing it would destroy that input.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef EXTERNAL_SET_OPS_H
+#define EXTERNAL_SET_OPS_H
+
+#include <stddef.h>
+
+// Default size in bytes of the block buffer of each file
+#define EXTERNAL_DEFAULT_BUFFER (4 * 1024 * 1024)
+
+// Smallest block buffer accepted
+#define EXTERNAL_MIN_BUFFER 4096
+
+// Enumeration for sorted file formats
+/**
+ * @enum SortedFileFormat
+ * @brief Enum for the layout of a sorted integer file.
+ */
+typedef enum
+{
+    SORTED_FILE_TEXT,     // Decimal integers separated by whitespace (the output has one per line)
+    SORTED_FILE_BINARY    // Native 32-bit ints, no header
+} SortedFileFormat;
+
+// Sets the size in bytes of the block buffer used for each file (0 restores the default)
+void setExternalBufferSize(size_t bytes);
+
+// Returns the size in bytes of the block buffer used for each file
+size_t getExternalBufferSize();
+
+// Writes the values in both sorted files to 'outPath'; 'count' (may be NULL) receives the output size
+int externalSetIntersection(const char* path1, const char* path2, const char* outPath,
+                            SortedFileFormat format, size_t* count);
+
+// Writes the values in either sorted file to 'outPath'; 'count' (may be NULL) receives the output size
+int externalSetUnion(const char* path1, const char* path2, const char* outPath,
+                     SortedFileFormat format, size_t* count);
+
+// Writes the values of 'path1' that are not in 'path2' to 'outPath'; 'count' (may be NULL) receives the output size
+int externalSetDifference(const char* path1, const char* path2, const char* outPath,
+                          SortedFileFormat format, size_t* count);
+
+#endif // EXTERNAL_SET_OPS_H
@@ -0,0 +1,324 @@
+/**
+ * @file instrumentation.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the optional instrumentation of the set operations.<br/>
+ *
+ * This file holds the running counters and the statistics of every operation, records
+ * measured calls into them and writes them out as a text table or as JSON. It is always
+ * built, so the dumps work either way; without SET_INSTRUMENTATION nothing calls the
+ * recording functions and the dumps report that the instrumentation is compiled out.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <string.h>
+#include <time.h>
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+// include module header file
+#include "instrumentation.h"
+
+uint64_t instrNodes = 0;
+uint64_t instrAllocations = 0;
+uint64_t instrBytes = 0;
+
+static OperationStats operationStats[INSTR_OPERATIONS];
+
+// Function to read the clock
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ *
+ * The clock never steps back, so the difference of two readings cannot underflow when the
+ * wall clock is adjusted during a measured call.
+ *
+ * @return uint64_t Nanoseconds since an arbitrary epoch.
+ */
+static uint64_t nowNanos() {
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000000u +
+        (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000000u / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// Function to count the significant bits of a value
+/**
+ * @brief Returns the position of the highest set bit plus one, 0 for 0.
+ *
+ * @param value The value.
+ * @return int Number of significant bits, 0 to 64.
+ */
+static int significantBits(uint64_t value) {
+    int bits = 0;
+    while (value) {
+        value >>= 1;
+        bits++;
+    }
+    return bits;
+}
+
+// Function to find the histogram bucket of a latency
+/**
+ * @brief Maps a latency to its histogram bucket.
+ *
+ * Latencies below INSTR_SUB_BUCKETS get a bucket each. Above, a latency with its highest bit
+ * at position e falls in one of the INSTR_SUB_BUCKETS equal slices of [2^e, 2^(e+1)), picked
+ * by its four bits below the highest one. Latencies of 2^(INSTR_MAX_EXPONENT + 1) or more
+ * share the last bucket.
+ *
+ * @param nanos The latency.
+ * @return size_t The bucket, below INSTR_HISTOGRAM_BUCKETS.
+ */
+static size_t histogramBucket(uint64_t nanos) {
+    if (nanos < INSTR_SUB_BUCKETS) return (size_t)nanos;
+    int exponent = significantBits(nanos) - 1;
+    if (exponent > INSTR_MAX_EXPONENT) return INSTR_HISTOGRAM_BUCKETS - 1;
+    size_t slice = (size_t)(nanos >> (exponent - 4)) - INSTR_SUB_BUCKETS;
+    return (size_t)(exponent - 3) * INSTR_SUB_BUCKETS + slice;
+}
+
+// Function to find the largest latency of a histogram bucket
+/**
+ * @brief Returns the largest latency that falls in a bucket.
+ *
+ * @param bucket The bucket.
+ * @return uint64_t The largest latency of the bucket.
+ */
+static uint64_t bucketHighest(size_t bucket) {
+    if (bucket < INSTR_SUB_BUCKETS) return bucket;
+    int exponent = (int)(bucket / INSTR_SUB_BUCKETS) + 3;
+    uint64_t slice = bucket % INSTR_SUB_BUCKETS + INSTR_SUB_BUCKETS;
+    return ((slice + 1) << (exponent - 4)) - 1;
+}
+
+// Function to start a measured call
+/**
+ * @brief Remembers the clock, the running counters and the set size at the start of a call.
+ *
+ * @param probe Receives the start of the call.
+ * @param size Number of elements the call operates on.
+ */
+void instrumentationBegin(InstrumentationProbe* probe, size_t size) {
+    probe->nodes = instrNodes;
+    probe->allocations = instrAllocations;
+    probe->bytes = instrBytes;
+    probe->size = size;
+    probe->startNanos = nowNanos();
+}
+
+// Function to end a measured call
+/**
+ * @brief Adds a finished call, and the counts made since it started, to the statistics of an operation.
+ *
+ * @param probe The start of the call.
+ * @param operation The operation called.
+ */
+void instrumentationEnd(const InstrumentationProbe* probe, InstrumentedOperation operation) {
+    uint64_t nanos = nowNanos() - probe->startNanos;
+    if (operation < 0 || operation >= INSTR_OPERATIONS) return;
+
+    OperationStats* stats = &operationStats[operation];
+    if (stats->calls == 0 || nanos < stats->minNanos) stats->minNanos = nanos;
+    if (nanos > stats->maxNanos) stats->maxNanos = nanos;
+    stats->calls++;
+    stats->nodes += instrNodes - probe->nodes;
+    stats->allocations += instrAllocations - probe->allocations;
+    stats->bytes += instrBytes - probe->bytes;
+    stats->totalNanos += nanos;
+    stats->histogram[histogramBucket(nanos)]++;
+
+    int sizeClass = significantBits((uint64_t)probe->size);
+    if (sizeClass >= INSTR_SIZE_CLASSES) sizeClass = INSTR_SIZE_CLASSES - 1;
+    stats->sizeCalls[sizeClass]++;
+    stats->sizeNanos[sizeClass] += nanos;
+}
+
+// Function to check whether the instrumentation is compiled in
+/**
+ * @brief Tells whether the set modules were built with SET_INSTRUMENTATION.
+ *
+ * Only this file's own setting is visible here, so build every module with the same flag.
+ *
+ * @return int 1 if the instrumentation is compiled in, 0 otherwise.
+ */
+int instrumentationEnabled() {
+    return SET_INSTRUMENTATION;
+}
+
+// Function to read the statistics of an operation
+/**
+ * @brief Copies the statistics recorded for one operation.
+ *
+ * @param operation The operation.
+ * @param stats Receives the statistics.
+ * @return int 1 on success, 0 if 'operation' is out of range or 'stats' is NULL.
+ */
+int getOperationStats(InstrumentedOperation operation, OperationStats* stats) {
+    if (!stats || operation < 0 || operation >= INSTR_OPERATIONS) return 0;
+    *stats = operationStats[operation];
+    return 1;
+}
+
+// Function to name an operation
+/**
+ * @brief Returns the short name of an operation, as used in the dumps.
+ *
+ * @param operation The operation.
+ * @return const char* The name, or "unknown".
+ */
+const char* instrumentedOperationName(InstrumentedOperation operation) {
+    static const char* names[] = {
+        "add", "remove", "contains", "intersection", "union", "difference", "intersect_into",
+        "union_into", "subtract_into", "intersection_many", "union_many", "convert"
+    };
+    if (operation < 0 || operation >= INSTR_OPERATIONS) return "unknown";
+    return names[operation];
+}
+
+// Function to read a quantile of a latency histogram
+/**
+ * @brief Returns the latency below which a share of the calls fall.
+ *
+ * The result is the largest latency of the bucket holding the call at that rank, so it is
+ * at most 1/16 above the true quantile, and never above the largest latency recorded.
+ *
+ * @param stats The statistics of an operation.
+ * @param quantile The share of calls, 0 to 1 (0.99 for the 99th percentile).
+ * @return uint64_t The latency in nanoseconds, 0 if no call was recorded.
+ */
+uint64_t operationLatencyQuantile(const OperationStats* stats, double quantile) {
+    if (!stats || stats->calls == 0) return 0;
+    if (quantile < 0) quantile = 0;
+    if (quantile > 1) quantile = 1;
+    uint64_t rank = (uint64_t)(quantile * (double)stats->calls + 0.5);
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < INSTR_HISTOGRAM_BUCKETS; bucket++) {
+        seen += stats->histogram[bucket];
+        if (seen >= rank) {
+            uint64_t highest = bucketHighest(bucket);
+            return highest < stats->maxNanos ? highest : stats->maxNanos;
+        }
+    }
+    return stats->maxNanos;
+}
+
+// Function to clear the statistics
+/**
+ * @brief Clears the statistics of every operation and the running counters.
+ */
+void resetInstrumentation() {
+    memset(operationStats, 0, sizeof(operationStats));
+    instrNodes = 0;
+    instrAllocations = 0;
+    instrBytes = 0;
+}
+
+// Function to write the statistics as a text table
+/**
+ * @brief Writes one line per operation that was called, each followed by one line per size class.
+ *
+ * @param out The stream to write to.
+ */
+static void dumpText(FILE* out) {
+    fprintf(out, "%-18s %10s %12s %10s %12s %10s %10s %10s %10s %10s %10s\n", "operation", "calls", "nodes",
+            "allocs", "bytes", "mean_ns", "p50_ns", "p90_ns", "p99_ns", "p999_ns", "max_ns");
+    for (int op = 0; op < INSTR_OPERATIONS; op++) {
+        const OperationStats* stats = &operationStats[op];
+        if (stats->calls == 0) continue;
+        fprintf(out, "%-18s %10llu %12llu %10llu %12llu %10llu %10llu %10llu %10llu %10llu %10llu\n",
+                instrumentedOperationName((InstrumentedOperation)op), (unsigned long long)stats->calls,
+                (unsigned long long)stats->nodes, (unsigned long long)stats->allocations,
+                (unsigned long long)stats->bytes, (unsigned long long)(stats->totalNanos / stats->calls),
+                (unsigned long long)operationLatencyQuantile(stats, 0.5),
+                (unsigned long long)operationLatencyQuantile(stats, 0.9),
+                (unsigned long long)operationLatencyQuantile(stats, 0.99),
+                (unsigned long long)operationLatencyQuantile(stats, 0.999), (unsigned long long)stats->maxNanos);
+        for (int c = 0; c < INSTR_SIZE_CLASSES; c++) {
+            if (stats->sizeCalls[c] == 0) continue;
+            unsigned long long low = c == 0 ? 0 : 1ull << (c - 1);
+            unsigned long long high = c == 0 ? 0 : (1ull << c) - 1;
+            fprintf(out, "  size %llu-%llu: %llu calls, mean %llu ns\n", low, high,
+                    (unsigned long long)stats->sizeCalls[c],
+                    (unsigned long long)(stats->sizeNanos[c] / stats->sizeCalls[c]));
+        }
+    }
+}
+
+// Function to write the statistics as JSON
+/**
+ * @brief Writes an object with an "operations" array holding every operation that was called.
+ *
+ * @param out The stream to write to.
+ */
+static void dumpJson(FILE* out) {
+    const char* separator = "";
+    fprintf(out, "{\"enabled\": %s, \"operations\": [", SET_INSTRUMENTATION ? "true" : "false");
+    for (int op = 0; op < INSTR_OPERATIONS; op++) {
+        const OperationStats* stats = &operationStats[op];
+        if (stats->calls == 0) continue;
+        fprintf(out, "%s\n  {\"name\": \"%s\", \"calls\": %llu, \"nodes\": %llu, \"allocations\": %llu, \"bytes\": %llu,",
+                separator, instrumentedOperationName((InstrumentedOperation)op), (unsigned long long)stats->calls,
+                (unsigned long long)stats->nodes, (unsigned long long)stats->allocations,
+                (unsigned long long)stats->bytes);
+        fprintf(out, " \"latency_ns\": {\"min\": %llu, \"mean\": %llu, \"p50\": %llu, \"p90\": %llu, \"p99\": %llu, "
+                "\"p999\": %llu, \"max\": %llu},", (unsigned long long)stats->minNanos,
+                (unsigned long long)(stats->totalNanos / stats->calls),
+                (unsigned long long)operationLatencyQuantile(stats, 0.5),
+                (unsigned long long)operationLatencyQuantile(stats, 0.9),
+                (unsigned long long)operationLatencyQuantile(stats, 0.99),
+                (unsigned long long)operationLatencyQuantile(stats, 0.999), (unsigned long long)stats->maxNanos);
+        fprintf(out, " \"sizes\": [");
+        const char* sizeSeparator = "";
+        for (int c = 0; c < INSTR_SIZE_CLASSES; c++) {
+            if (stats->sizeCalls[c] == 0) continue;
+            fprintf(out, "%s{\"min\": %llu, \"max\": %llu, \"calls\": %llu, \"mean_ns\": %llu}", sizeSeparator,
+                    c == 0 ? 0ull : 1ull << (c - 1), c == 0 ? 0ull : (1ull << c) - 1,
+                    (unsigned long long)stats->sizeCalls[c],
+                    (unsigned long long)(stats->sizeNanos[c] / stats->sizeCalls[c]));
+            sizeSeparator = ", ";
+        }
+        fprintf(out, "]}");
+        separator = ",";
+    }
+    fprintf(out, "\n]}\n");
+}
+
+// Function to write the statistics
+/**
+ * @brief Writes the statistics of every operation that was called since the last reset.
+ *
+ * @param out The stream to write to.
+ * @param json 1 for JSON, 0 for a text table.
+ */
+void dumpInstrumentation(FILE* out, int json) {
+    if (json) {
+        dumpJson(out);
+    } else if (!SET_INSTRUMENTATION) {
+        fprintf(out, "Instrumentation is compiled out; build with -DSET_INSTRUMENTATION=1.\n");
+    } else {
+        dumpText(out);
+    }
+}
@@ -0,0 +1,160 @@
+/**
+ * @file instrumentation.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the optional instrumentation of the set operations.<br/>
+ *
+ * This header file defines the operations that are measured and the INSTR_* macros the set
+ * modules use to measure them. For every operation it keeps the number of calls, the list
+ * and skip list nodes traversed, the heap allocations made and the bytes they added (the
+ * growth, for a reallocation), a latency histogram and the calls and time per set size
+ * class. The histogram has 16 linear sub-buckets per power of two of nanoseconds, so every
+ * recorded latency is exact to within 1/16 (about 6 %) over the whole range, as in an HDR
+ * histogram.
+ *
+ * Instrumentation is compiled out unless SET_INSTRUMENTATION is defined as 1: the macros then
+ * expand to nothing and cost nothing. The counters are plain globals, so counts made by
+ * threads running set operations at the same time may be lost.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// 1 to compile the instrumentation in (override with -DSET_INSTRUMENTATION=1)
+#ifndef SET_INSTRUMENTATION
+#define SET_INSTRUMENTATION 0
+#endif
+
+// Linear sub-buckets per power of two of a latency histogram
+#define INSTR_SUB_BUCKETS 16
+
+// Largest power of two of nanoseconds a histogram tells apart (about 18 minutes)
+#define INSTR_MAX_EXPONENT 40
+
+// Number of buckets of a latency histogram
+#define INSTR_HISTOGRAM_BUCKETS ((INSTR_MAX_EXPONENT - 3) * INSTR_SUB_BUCKETS + INSTR_SUB_BUCKETS)
+
+// Number of set size classes: class c holds sizes with c significant bits (0, 1, 2-3, 4-7, ...)
+#define INSTR_SIZE_CLASSES 33
+
+// Enumeration of the measured operations
+/**
+ * @enum InstrumentedOperation
+ * @brief The set operations the instrumentation keeps statistics for.
+ */
+typedef enum
+{
+    INSTR_ADD,                 // addElement
+    INSTR_REMOVE,              // removeElement
+    INSTR_CONTAINS,            // containsElement
+    INSTR_INTERSECTION,        // setIntersection
+    INSTR_UNION,               // setUnion
+    INSTR_DIFFERENCE,          // setDifference
+    INSTR_INTERSECT_INTO,      // intersectInto
+    INSTR_UNION_INTO,          // unionInto
+    INSTR_SUBTRACT_INTO,       // subtractInto
+    INSTR_INTERSECTION_MANY,   // setIntersectionMany
+    INSTR_UNION_MANY,          // setUnionMany
+    INSTR_CONVERT,             // an adaptive set switching backend
+    INSTR_OPERATIONS           // Number of operations
+} InstrumentedOperation;
+
+// Statistics of one operation
+/**
+ * @brief Structure holding everything recorded for one operation since the last reset.
+ *
+ * - 'calls', 'nodes', 'allocations', 'bytes': totals over all calls. Operations that call other
+ *   measured operations include their counts, and time, in their own.
+ * - 'totalNanos', 'minNanos', 'maxNanos': latency totals and extremes.
+ * - 'histogram': number of calls per latency bucket.
+ * - 'sizeCalls', 'sizeNanos': calls and total latency per size class of the set operated on
+ *   (the sum of the sizes of all operands for operations on several sets).
+ */
+typedef struct
+{
+    uint64_t calls;
+    uint64_t nodes;
+    uint64_t allocations;
+    uint64_t bytes;
+    uint64_t totalNanos;
+    uint64_t minNanos;
+    uint64_t maxNanos;
+    uint64_t histogram[INSTR_HISTOGRAM_BUCKETS];
+    uint64_t sizeCalls[INSTR_SIZE_CLASSES];
+    uint64_t sizeNanos[INSTR_SIZE_CLASSES];
+} OperationStats;
+
+// Start of one measured call
+/**
+ * @brief Structure remembering the clock and the counters when a measured call started.
+ */
+typedef struct
+{
+    uint64_t startNanos;
+    uint64_t nodes;
+    uint64_t allocations;
+    uint64_t bytes;
+    size_t size;
+} InstrumentationProbe;
+
+// Running counters, read by the INSTR_* macros
+extern uint64_t instrNodes;
+extern uint64_t instrAllocations;
+extern uint64_t instrBytes;
+
+// Starts a measured call on a set of 'size' elements
+void instrumentationBegin(InstrumentationProbe* probe, size_t size);
+
+// Ends a measured call and adds it to the statistics of 'operation'
+void instrumentationEnd(const InstrumentationProbe* probe, InstrumentedOperation operation);
+
+// Returns 1 if the instrumentation is compiled in, 0 otherwise
+int instrumentationEnabled();
+
+// Copies the statistics of one operation; returns 0 if 'operation' is out of range
+int getOperationStats(InstrumentedOperation operation, OperationStats* stats);
+
+// Returns the short name of an operation, as used in the dumps
+const char* instrumentedOperationName(InstrumentedOperation operation);
+
+// Returns the latency below which 'quantile' (0 to 1) of the calls of 'stats' fall, to within 1/16
+uint64_t operationLatencyQuantile(const OperationStats* stats, double quantile);
+
+// Clears every statistic
+void resetInstrumentation();
+
+// Writes the statistics of every operation that was called as a text table, or as JSON if 'json' is 1
+void dumpInstrumentation(FILE* out, int json);
+
+// Instrumentation macros, compiled out unless SET_INSTRUMENTATION is 1
+#if SET_INSTRUMENTATION
+#define INSTR_BEGIN(probe, size) \
+    InstrumentationProbe probe; \
+    instrumentationBegin(&probe, (size))
+#define INSTR_END(probe, operation) instrumentationEnd(&probe, (operation))
+#define INSTR_COUNT_NODES(n) (instrNodes += (uint64_t)(n))
+#define INSTR_COUNT_ALLOC(size) (instrAllocations++, instrBytes += (uint64_t)(size))
+#else
+#define INSTR_BEGIN(probe, size) ((void)0)
+#define INSTR_END(probe, operation) ((void)0)
+#define INSTR_COUNT_NODES(n) ((void)0)
+#define INSTR_COUNT_ALLOC(size) ((void)0)
+#endif
+
+#endif // INSTRUMENTATION_H
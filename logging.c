@@ -0,0 +1,101 @@
+/**
+ * @file logging.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the logging facility used by the set modules.<br/>
+ *
+ * This file holds the run time logging threshold and the installed callback,
+ * and formats messages before handing them to that callback.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdarg.h>
+
+// include module header file
+#include "logging.h"
+
+// Longest message passed to the callback; longer messages are truncated
+#define LOG_MESSAGE_SIZE 256
+
+LogLevel logRuntimeLevel = LOG_LEVEL_ERROR;
+
+// Function used when no callback is installed
+/**
+ * @brief Default callback, writes the message to stderr prefixed with its level.
+ *
+ * @param level Severity of the message.
+ * @param message The formatted message.
+ * @param context Unused.
+ */
+static void defaultLogCallback(LogLevel level, const char* message, void* context) {
+    static const char* names[] = { "", "error", "warning", "info", "debug" };
+    (void)context;
+    fprintf(stderr, "[%s] %s\n", level <= LOG_LEVEL_DEBUG ? names[level] : "log", message);
+}
+
+static LogCallback logCallback = defaultLogCallback;
+static void* logContext = NULL;
+
+// Function to set the logging threshold
+/**
+ * @brief Sets the run time threshold. Messages with a level above it are dropped.
+ *
+ * @param level The new threshold (LOG_LEVEL_NONE turns logging off).
+ */
+void setLogLevel(LogLevel level) {
+    logRuntimeLevel = level;
+}
+
+// Function to read the logging threshold
+/**
+ * @brief Returns the run time threshold.
+ *
+ * @return LogLevel The current threshold.
+ */
+LogLevel getLogLevel() {
+    return logRuntimeLevel;
+}
+
+// Function to install a log callback
+/**
+ * @brief Installs the callback that receives log messages.
+ *
+ * @param callback The callback, or NULL to restore the default one that writes to stderr.
+ * @param context Pointer passed back to the callback with every message.
+ */
+void setLogCallback(LogCallback callback, void* context) {
+    logCallback = callback ? callback : defaultLogCallback;
+    logContext = callback ? context : NULL;
+}
+
+// Function to format and dispatch a log message
+/**
+ * @brief Formats a message and passes it to the installed callback.
+ *
+ * @param level Severity of the message.
+ * @param format printf style format string.
+ */
+void logMessage(LogLevel level, const char* format, ...) {
+    if (level <= LOG_LEVEL_NONE || level > logRuntimeLevel) return;
+
+    char message[LOG_MESSAGE_SIZE];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    logCallback(level, message, logContext);
+}
@@ -0,0 +1,100 @@
+/**
+ * @file logging.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the logging facility used by the set modules.<br/>
+ *
+ * This header file defines log levels, the callback type that receives log
+ * messages and the LOG_ERROR, LOG_WARNING, LOG_INFO and LOG_DEBUG macros.
+ * Messages above LOG_COMPILE_LEVEL are removed by the preprocessor; the rest
+ * are filtered at run time against the level set with setLogLevel(), so a
+ * disabled message costs a single comparison and never formats its arguments.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef LOGGING_H
+#define LOGGING_H
+
+// Enumeration for log levels
+/**
+ * @enum LogLevel
+ * @brief Enum for the severity of a log message, also used as the logging threshold.
+ */
+typedef enum
+{
+    LOG_LEVEL_NONE = 0,      // Nothing is logged
+    LOG_LEVEL_ERROR = 1,     // Failures such as memory allocation errors
+    LOG_LEVEL_WARNING = 2,   // Unexpected but recoverable situations
+    LOG_LEVEL_INFO = 3,      // Progress messages such as lists being created or deleted
+    LOG_LEVEL_DEBUG = 4      // Per element details
+} LogLevel;
+
+// Highest level compiled into the program (override with -DLOG_COMPILE_LEVEL=n)
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 3
+#endif
+
+/**
+ * @brief Callback receiving every message that passes the logging threshold.
+ *
+ * @param level Severity of the message.
+ * @param message The formatted message, without a trailing newline.
+ * @param context The pointer given to setLogCallback().
+ */
+typedef void (*LogCallback)(LogLevel level, const char* message, void* context);
+
+// Current run time threshold, read by the logging macros
+extern LogLevel logRuntimeLevel;
+
+// Sets the run time threshold; messages above it are dropped (default LOG_LEVEL_ERROR)
+void setLogLevel(LogLevel level);
+
+// Returns the run time threshold
+LogLevel getLogLevel();
+
+// Installs the callback for log messages (NULL restores the default, which writes to stderr)
+void setLogCallback(LogCallback callback, void* context);
+
+// Formats a message and passes it to the callback; use the LOG_* macros instead of calling this directly
+void logMessage(LogLevel level, const char* format, ...);
+
+// Logging macros, compiled out above LOG_COMPILE_LEVEL
+#define LOG_AT(level, ...) \
+    do { if (logRuntimeLevel >= (level)) logMessage((level), __VA_ARGS__); } while (0)
+
+#if LOG_COMPILE_LEVEL >= 1
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL >= 2
+#define LOG_WARNING(...) LOG_AT(LOG_LEVEL_WARNING, __VA_ARGS__)
+#else
+#define LOG_WARNING(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL >= 3
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL >= 4
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#endif // LOGGING_H
@@ -7,8 +7,8 @@
  *
  * @brief A text menu-driven application for managing Ordered Sets.
  *
- * This application maintains an array of up to 10 Ordered Sets and allows users
- * to perform various set operations, such as adding elements, removing elements,
+ * This application maintains a registry of Ordered Sets addressed by name and allows
+ * users to perform various set operations, such as adding elements, removing elements,
  * and computing set intersections, unions and differences.
  *
  * @author
@@ -24,39 +24,43 @@
  // include system header files
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-// include module header file
+// include module header files
+#include "main.h"
 #include "orderedSet.h"
+#include "batchMode.h"
+#include "setSnapshot.h"
+#include "setRegistry.h"
+#include "logging.h"
+#include "instrumentation.h"
 
-// Maximum number of sets
-#define MAX_SETS 10
+// Longest snapshot file name read from the menu
+#define MAX_PATH_LENGTH 260
 
-OrderedIntSet* SetsArray[MAX_SETS] = { NULL };
+// Size of the buffer a set name is read into
+#define MAX_NAME_LENGTH (REGISTRY_MAX_NAME + 1)
 
-// Helper function to validate index
+SetRegistry* Registry = NULL;
+
+// Helper function to read a set name
 /**
- * @brief Checks if the given index is valid (0-9).
+ * @brief Reads a whitespace separated set name from stdin.
  *
- * @param index The index to validate.
- * @return int Returns 1 if the index is valid, 0 otherwise.
+ * @param name Receives the name (room for MAX_NAME_LENGTH characters).
+ * @return int Returns 1 if a name was read, 0 otherwise.
  */
-int isValidIndex(int index) {
-    return index >= 0 && index < MAX_SETS;
+static int readName(char* name) {
+    return scanf_s("%255s", name, (unsigned)MAX_NAME_LENGTH) == 1;
 }
 
 // Function to clean up all sets on program exit
 /**
- * @brief Cleans up all sets in the SetsArray.
- *
- * Frees memory for all allocated sets in the SetsArray and sets their pointers to NULL.
+ * @brief Deletes the Registry and every set in it.
  */
 void cleanup() {
-    for (int i = 0; i < MAX_SETS; i++) {
-        if (SetsArray[i]) {
-            deleteOrderedSet(SetsArray[i]);
-            SetsArray[i] = NULL;
-        }
-    }
+    deleteSetRegistry(Registry);
+    Registry = NULL;
 }
 
 // Function to process menu choices
@@ -65,100 +69,109 @@ void cleanup() {
  *
  * This function handles user input to choose operations such as creating, deleting,
  * adding/removing elements, performing set operations (intersection, union, difference),
- * and exiting the program. It is recursive and will prompt the user for another choice
- * after each operation.
+ * saving and loading all sets, and exiting the program. The caller loops over it until it returns 0, so a long session
+ * does not grow the stack.
+ *
+ * @return int 1 to ask for another choice, 0 when the program should terminate.
  */
-void processMenuChoice() {
-    int choice, index, elem, i1, i2, i3;
+int processMenuChoice() {
+    int choice = 0, elem;
+    char path[MAX_PATH_LENGTH];
+    char name[MAX_NAME_LENGTH], name2[MAX_NAME_LENGTH], name3[MAX_NAME_LENGTH];
+    OrderedIntSet* set;
 
     printf("Enter your choice: ");
-    scanf_s("%d", &choice);
+    if (scanf_s("%d", &choice) != 1) {
+        if (feof(stdin)) choice = 8;  // End of input terminates like option 8
+        else scanf_s("%*s");          // Discard the token that is not a number; 0 is an invalid choice
+    }
 
     switch (choice) {
     case 1: // Create an Ordered Set
         /**
-         * @brief Creates a new ordered set at the specified index.
+         * @brief Creates a new ordered set under the specified name.
          *
-         * Prompts the user to specify an index. If the index is valid and the set
-         * doesn't already exist, an ordered set is created at that index.
+         * Prompts the user to specify a name. If no set has that name yet, an
+         * ordered set is created and registered under it.
          */
-        printf("Enter index (0-%d): ", MAX_SETS - 1);
-        scanf_s("%d", &index);
-        if (isValidIndex(index) && !SetsArray[index]) {
-            SetsArray[index] = createOrderedSet();
-            if (SetsArray[index]) {
-                printf("Ordered set created at index %d.\n", index);
+        printf("Enter set name: ");
+        if (readName(name) && !findSet(Registry, name)) {
+            set = createOrderedSetWithBackend(SET_BACKEND_ADAPTIVE);
+            if (set && registerSet(Registry, name, set) >= 0) {
+                printf("Ordered set %s created.\n", name);
             } else {
+                deleteOrderedSet(set);
                 printf("Memory allocation failed.\n");
             }
         } else {
-            printf("Invalid index or set already exists.\n");
+            printf("Invalid name or set already exists.\n");
         }
         break;
 
     case 2: // Delete an Ordered Set
         /**
-         * @brief Deletes an ordered set at the specified index.
+         * @brief Deletes the ordered set with the specified name.
          *
-         * Prompts the user to specify an index. If the index is valid and the set
-         * exists, the set is deleted and the index is set to NULL.
+         * Prompts the user to specify a name. If a set has that name, the set is
+         * deleted and the name becomes free.
          */
-        printf("Enter index (0-%d): ", MAX_SETS - 1);
-        scanf_s("%d", &index);
-        if (isValidIndex(index) && SetsArray[index]) {
-            deleteOrderedSet(SetsArray[index]);
-            SetsArray[index] = NULL;
-            printf("Ordered set at index %d deleted.\n", index);
+        printf("Enter set name: ");
+        if (readName(name) && dropSet(Registry, name)) {
+            printf("Ordered set %s deleted.\n", name);
         } else {
-            printf("Invalid index or no set exists.\n");
+            printf("Invalid name or no set exists.\n");
         }
         break;
 
     case 3: // Add Elements to Ordered Set
         /**
-       * @brief Adds elements to the ordered set at the specified index.
+       * @brief Adds elements to the ordered set with the specified name.
        *
-       * Prompts the user to specify an index. If the index is valid and the set
-       * exists, the user can enter elements to add to the set. The operation stops
-       * when the user enters a negative number.
+       * Prompts the user to specify a name. If a set has that name, the user can
+       * enter elements to add to the set. The operation stops when the user enters
+       * a negative number or anything that is not a number.
        */
-        printf("Enter index (0-%d): ", MAX_SETS - 1);
-        scanf_s("%d", &index);
-        if (isValidIndex(index) && SetsArray[index]) {
+        printf("Enter set name: ");
+        if (readName(name) && (set = findSet(Registry, name)) != NULL) {
             printf("Enter elements to add (negative to stop): ");
             while (1) {
-                scanf_s("%d", &elem);
+                if (scanf_s("%d", &elem) != 1) {
+                    if (!feof(stdin)) scanf_s("%*s");  // Discard the token that is not a number
+                    break;
+                }
                 if (elem < 0) break;
-                SetStatus status = addElement(SetsArray[index], elem);
+                SetStatus status = addElement(set, elem);
                 printf(status == NUMBER_ADDED ? "Added %d.\n" : "Already in set: %d.\n", elem);
             }
-            printToStdout(SetsArray[index]);
+            printToStdout(set);
         } else {
-            printf("Invalid index or no set exists.\n");
+            printf("Invalid name or no set exists.\n");
         }
         break;
 
     case 4: // Remove Elements from Ordered Set
         /**
-       * @brief Removes elements from the ordered set at the specified index.
+       * @brief Removes elements from the ordered set with the specified name.
        *
-       * Prompts the user to specify an index. If the index is valid and the set
-       * exists, the user can enter elements to remove from the set. The operation stops
-       * when the user enters a negative number.
+       * Prompts the user to specify a name. If a set has that name, the user can
+       * enter elements to remove from the set. The operation stops when the user
+       * enters a negative number or anything that is not a number.
        */
-        printf("Enter index (0-%d): ", MAX_SETS - 1);
-        scanf_s("%d", &index);
-        if (isValidIndex(index) && SetsArray[index]) {
+        printf("Enter set name: ");
+        if (readName(name) && (set = findSet(Registry, name)) != NULL) {
             printf("Enter elements to remove (negative to stop): ");
             while (1) {
-                scanf_s("%d", &elem);
+                if (scanf_s("%d", &elem) != 1) {
+                    if (!feof(stdin)) scanf_s("%*s");  // Discard the token that is not a number
+                    break;
+                }
                 if (elem < 0) break;
-                SetStatus status = removeElement(SetsArray[index], elem);
+                SetStatus status = removeElement(set, elem);
                 printf(status == NUMBER_REMOVED ? "Removed %d.\n" : "Not in set: %d.\n", elem);
             }
-            printToStdout(SetsArray[index]);
+            printToStdout(set);
         } else {
-            printf("Invalid index or no set exists.\n");
+            printf("Invalid name or no set exists.\n");
         }
         break;
 
@@ -167,30 +180,89 @@ void processMenuChoice() {
     case 7: // Set Difference
         /**
          * @brief Performs set operations (intersection, union or difference)
-         * on the ordered sets at the specified indices and stores the result.
+         * on the ordered sets with the specified names and stores the result.
          *
-         * Prompts the user for indices. If the indices are valid and sets are present
-         * at the first two indices, the specified set operation is performed and the
-         * result is stored in the third index.
+         * Prompts the user for three names. If sets have the first two names and the
+         * third is free, the specified set operation is performed and the result is
+         * registered under the third name.
          */
-        printf("Enter indices i1, i2, i3: ");
-        scanf_s("%d %d %d", &i1, &i2, &i3);
-        if (isValidIndex(i1) && isValidIndex(i2) && isValidIndex(i3) &&
-            SetsArray[i1] && SetsArray[i2] && !SetsArray[i3]) {
+        printf("Enter names n1, n2, n3: ");
+        if (readName(name) && readName(name2) && readName(name3) &&
+            findSet(Registry, name) && findSet(Registry, name2) && !findSet(Registry, name3)) {
+            OrderedIntSet* s1 = findSet(Registry, name);
+            OrderedIntSet* s2 = findSet(Registry, name2);
             OrderedIntSet* result = NULL;
-            if (choice == 5) result = setIntersection(SetsArray[i1], SetsArray[i2]);
-            if (choice == 6) result = setUnion(SetsArray[i1], SetsArray[i2]);
-            if (choice == 7) result = setDifference(SetsArray[i1], SetsArray[i2]);
+            if (choice == 5) result = setIntersection(s1, s2);
+            if (choice == 6) result = setUnion(s1, s2);
+            if (choice == 7) result = setDifference(s1, s2);
 
-            SetsArray[i3] = result;
-            if (result) {
-                printf("Operation successful. Result stored at index %d.\n", i3);
+            if (result && registerSet(Registry, name3, result) >= 0) {
+                printf("Operation successful. Result stored as %s.\n", name3);
                 printToStdout(result);
             } else {
+                deleteOrderedSet(result);
                 printf("Memory allocation failed.\n");
             }
         } else {
-            printf("Invalid indices or sets.\n");
+            printf("Invalid names or sets.\n");
+        }
+        break;
+
+    case 9: // Save all Ordered Sets
+        /**
+         * @brief Saves every set of the Registry and its name to a snapshot file.
+         *
+         * Prompts the user for a file name. The sets are stored as raw sorted ints so that
+         * loading can use them in place from the mapped file.
+         */
+        printf("Enter file name: ");
+        if (scanf_s("%259s", path, (unsigned)sizeof(path)) == 1 && saveSetRegistry(Registry, path, SNAPSHOT_RAW)) {
+            printf("All sets saved to %s.\n", path);
+        } else {
+            printf("Saving failed.\n");
+        }
+        break;
+
+    case 10: // Load all Ordered Sets
+        /**
+         * @brief Replaces every set of the Registry with the sets of a snapshot file.
+         *
+         * Prompts the user for a file name. The current sets are only deleted if the whole
+         * snapshot loads.
+         */
+        printf("Enter file name: ");
+        if (scanf_s("%259s", path, (unsigned)sizeof(path)) == 1 && loadSetRegistry(Registry, path, 1)) {
+            printf("Sets loaded from %s.\n", path);
+        } else {
+            printf("Loading failed. The sets are unchanged.\n");
+        }
+        break;
+
+    case 11: // List all Ordered Sets
+        /**
+         * @brief Lists the name, size, backend and memory use of every set, and the memory use of the whole Registry.
+         */
+        for (int id = registryNextId(Registry, -1); id >= 0; id = registryNextId(Registry, id)) {
+            OrderedIntSet* listed = getSetById(Registry, id);
+            printf("%s: %d elements, %s, %zu bytes\n", getSetName(Registry, id), listed->count,
+                   setBackendName(listed->backend), registrySetMemory(Registry, id));
+        }
+        printf("%zu sets, %zu bytes in total.\n", registryCount(Registry), registryMemoryUsage(Registry));
+        break;
+
+    case 12: // Show operation statistics
+        /**
+         * @brief Prints the calls, counts and latencies recorded for every set operation as a
+         * table or as JSON, or clears them.
+         */
+        printf("Enter format (text, json or reset): ");
+        if (readName(name)) {
+            if (strcmp(name, "reset") == 0) {
+                resetInstrumentation();
+                printf("Operation statistics cleared.\n");
+            } else {
+                dumpInstrumentation(stdout, strcmp(name, "json") == 0);
+            }
         }
         break;
 
@@ -203,24 +275,19 @@ void processMenuChoice() {
        */
         printf("Exiting program. Cleaning up memory.\n");
         cleanup();
-        return;
+        return 0;
 
     default:
-        printf("Invalid choice! Please enter a number between 1 and 8.\n");
+        printf("Invalid choice! Please enter a number between 1 and 12.\n");
     }
-
-    // Call recursively for the next choice
-    processMenuChoice();
+    return 1;
 }
 
+// Function to run the interactive menu
 /**
- * @brief Main function to start the program.
- *
- * Displays the menu once and begins recursive processing of choices.
- *
- * @return int Returns 0 to indicate successful program termination.
+ * @brief Displays the menu once and processes choices until the user terminates the program.
  */
-int main() {
+void menu() {
     printf("\nMenu Options:\n");
     printf("1. Create an empty Ordered Set\n");
     printf("2. Delete an Ordered Set\n");
@@ -230,9 +297,72 @@ int main() {
     printf("6. Set Union\n");
     printf("7. Set Difference\n");
     printf("8. Terminate Program\n");
+    printf("9. Save all Ordered Sets to a file\n");
+    printf("10. Load all Ordered Sets from a file\n");
+    printf("11. List all Ordered Sets\n");
+    printf("12. Show operation statistics\n");
+
+    while (processMenuChoice()) {
+    }
+}
+
+// Function to run a command script
+/**
+ * @brief Runs a batch script from a file, or from stdin when 'path' is NULL, on the Registry.
+ *
+ * Output is fully buffered since nothing is read from the user between commands.
+ *
+ * @param path The script file or NULL.
+ * @return int EXIT_SUCCESS if every command succeeded, EXIT_FAILURE otherwise.
+ */
+static int batch(const char* path) {
+    FILE* input = path ? fopen(path, "r") : stdin;
+    if (!input) {
+        fprintf(stderr, "Cannot open %s.\n", path);
+        return EXIT_FAILURE;
+    }
+    setvbuf(stdout, NULL, _IOFBF, BATCH_BUFFER_SIZE);
+
+    int failures = runBatch(input, Registry);
+    if (path) fclose(input);
+    cleanup();
+    fflush(stdout);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Main function to start the program.
+ *
+ * Runs the interactive menu, or a batch script when "--batch" is given.
+ * The option "--log-level n" (0 none, 1 errors, 2 warnings, 3 info, 4 debug) sets how much
+ * the set modules log to stderr; by default only errors are reported.
+ * The option "--batch [file]" runs the commands of 'file', or of stdin when no file is named,
+ * without prompts (see batchMode.h for the command grammar).
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @return int Returns 0 on success, 1 if a batch command failed.
+ */
+int main(int argc, char* argv[]) {
+    int batchMode = 0;
+    const char* script = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--log-level") == 0 && i + 1 < argc) {
+            setLogLevel((LogLevel)atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--batch") == 0) {
+            batchMode = 1;
+            if (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) script = argv[++i];
+        }
+    }
+
+    Registry = createSetRegistry();
+    if (!Registry) return EXIT_FAILURE;
+
+    if (batchMode) return batch(script);
 
     // Start processing menu choices
-    processMenuChoice();
+    menu();
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,234 @@
+/**
+ * @file nodeHash.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for a hash table from values to the nodes of a Double Linked List.<br/>
+ *
+ * This file contains the functions to create, query, update and delete a node hash.
+ * Values are spread over the slots by multiplying them with a large odd constant and
+ * keeping the top bits. Collisions are resolved by linear probing, and removals shift
+ * the following entries of the probe run back, so the table never holds tombstones.
+ * The table doubles in size whenever it would become more than half full.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+
+// include module header files
+#include "nodeHash.h"
+#include "logging.h"
+#include "instrumentation.h"
+
+// Function to find the home slot of a value
+/**
+ * @brief Returns the slot a value is placed in when there is no collision.
+ *
+ * @param hash Pointer to the node hash.
+ * @param value The value.
+ * @return size_t The slot index.
+ */
+static size_t homeSlot(const struct NodeHash* hash, int value) {
+    return (size_t)(((unsigned int)value * 2654435769u) >> hash->shift);
+}
+
+// Function to allocate the slots of a node hash
+/**
+ * @brief Gives a node hash 'capacity' empty slots.
+ *
+ * @param hash Pointer to the node hash.
+ * @param capacity Number of slots, a power of two of at least NODE_HASH_MIN_CAPACITY.
+ * @return int 1 on success, 0 if memory allocation fails (the hash is unchanged).
+ */
+static int allocateSlots(struct NodeHash* hash, size_t capacity) {
+    struct NodeHashSlot* slots = (struct NodeHashSlot*)calloc(capacity, sizeof(struct NodeHashSlot));
+    if (!slots) {
+        LOG_ERROR("Memory allocation failed.");
+        return 0;
+    }
+    INSTR_COUNT_ALLOC(capacity * sizeof(struct NodeHashSlot));
+    int bits = 0;
+    while (((size_t)1 << bits) < capacity) {
+        bits++;
+    }
+    hash->slots = slots;
+    hash->capacity = capacity;
+    hash->shift = 32 - bits;
+    return 1;
+}
+
+// Function to create a node hash
+/**
+ * @brief Creates an empty node hash large enough for 'expected' nodes.
+ *
+ * @param expected Number of nodes the table should hold without growing.
+ * @return struct NodeHash* Pointer to the new node hash or NULL if memory allocation fails.
+ */
+struct NodeHash* createNodeHash(size_t expected) {
+    struct NodeHash* hash = (struct NodeHash*)malloc(sizeof(struct NodeHash));
+    if (!hash) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    INSTR_COUNT_ALLOC(sizeof(struct NodeHash));
+    size_t capacity = NODE_HASH_MIN_CAPACITY;
+    while (capacity < 2 * expected) {
+        capacity *= 2;
+    }
+    hash->count = 0;
+    if (!allocateSlots(hash, capacity)) {
+        free(hash);
+        return NULL;
+    }
+    return hash;
+}
+
+// Function to delete a node hash
+/**
+ * @brief Frees a node hash. The nodes it points to are left alone.
+ *
+ * @param hash Pointer to the node hash to free (may be NULL).
+ */
+void deleteNodeHash(struct NodeHash* hash) {
+    if (!hash) {
+        return;
+    }
+    free(hash->slots);
+    free(hash);
+}
+
+// Function to find the node holding a value
+/**
+ * @brief Looks a value up.
+ *
+ * @param hash Pointer to the node hash.
+ * @param value The value to look for.
+ * @return struct Node* The node holding 'value' or NULL if it is not in the table.
+ */
+struct Node* nodeHashFind(const struct NodeHash* hash, int value) {
+    size_t mask = hash->capacity - 1;
+    for (size_t i = homeSlot(hash, value); hash->slots[i].node; i = (i + 1) & mask) {
+        if (hash->slots[i].value == value) {
+            return hash->slots[i].node;
+        }
+    }
+    return NULL;
+}
+
+// Function to place a node in the first free slot of its probe run
+/**
+ * @brief Stores a node without checking the load of the table.
+ *
+ * @param hash Pointer to the node hash (with at least one free slot).
+ * @param value The value of the node.
+ * @param node The node.
+ */
+static void placeNode(struct NodeHash* hash, int value, struct Node* node) {
+    size_t mask = hash->capacity - 1;
+    size_t i = homeSlot(hash, value);
+    while (hash->slots[i].node) {
+        i = (i + 1) & mask;
+    }
+    hash->slots[i].value = value;
+    hash->slots[i].node = node;
+}
+
+// Function to double the number of slots
+/**
+ * @brief Moves every node into a table twice the size.
+ *
+ * @param hash Pointer to the node hash.
+ * @return int 1 on success, 0 if memory allocation fails (the hash is unchanged).
+ */
+static int growNodeHash(struct NodeHash* hash) {
+    struct NodeHashSlot* oldSlots = hash->slots;
+    size_t oldCapacity = hash->capacity;
+    int oldShift = hash->shift;
+    if (!allocateSlots(hash, 2 * oldCapacity)) {
+        hash->slots = oldSlots;
+        hash->capacity = oldCapacity;
+        hash->shift = oldShift;
+        return 0;
+    }
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i].node) {
+            placeNode(hash, oldSlots[i].value, oldSlots[i].node);
+        }
+    }
+    free(oldSlots);
+    return 1;
+}
+
+// Function to add a node
+/**
+ * @brief Adds a node whose value is not in the table yet, growing the table if needed.
+ *
+ * @param hash Pointer to the node hash.
+ * @param node The node to add.
+ * @return int 1 on success, 0 if memory allocation fails (the node is not added).
+ */
+int nodeHashInsert(struct NodeHash* hash, struct Node* node) {
+    if (2 * (hash->count + 1) > hash->capacity && !growNodeHash(hash)) {
+        return 0;
+    }
+    placeNode(hash, node->data, node);
+    hash->count++;
+    return 1;
+}
+
+// Function to remove the node holding a value
+/**
+ * @brief Removes a value from the table and shifts the rest of its probe run back.
+ *
+ * An entry after the freed slot moves into it unless its home slot lies cyclically
+ * after the freed slot, in which case moving it would put it before its home.
+ *
+ * @param hash Pointer to the node hash.
+ * @param value The value to remove; nothing happens if it is not in the table.
+ */
+void nodeHashRemove(struct NodeHash* hash, int value) {
+    size_t mask = hash->capacity - 1;
+    size_t i = homeSlot(hash, value);
+    while (hash->slots[i].node && hash->slots[i].value != value) {
+        i = (i + 1) & mask;
+    }
+    if (!hash->slots[i].node) {
+        return;
+    }
+    for (size_t j = (i + 1) & mask; hash->slots[j].node; j = (j + 1) & mask) {
+        size_t home = homeSlot(hash, hash->slots[j].value);
+        int stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays) {
+            hash->slots[i] = hash->slots[j];
+            i = j;
+        }
+    }
+    hash->slots[i].node = NULL;
+    hash->count--;
+}
+
+// Function to get the memory used by a node hash
+/**
+ * @brief Returns the heap bytes used by a node hash.
+ *
+ * @param hash Pointer to the node hash (may be NULL).
+ * @return size_t Bytes used by the structure and its slots.
+ */
+size_t nodeHashSizeInBytes(const struct NodeHash* hash) {
+    if (!hash) {
+        return 0;
+    }
+    return sizeof(struct NodeHash) + hash->capacity * sizeof(struct NodeHashSlot);
+}
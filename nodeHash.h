@@ -0,0 +1,84 @@
+/**
+ * @file nodeHash.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for a hash table from values to the nodes of a Double Linked List.<br/>
+ *
+ * This header file defines the structures and function prototypes for an open addressing
+ * hash table with linear probing that maps each value of a Double Linked List to the
+ * 'struct Node' holding it. A linked list set keeps one next to its list once it grows
+ * large, so that looking an element up, finding a duplicate and finding the node to
+ * remove take O(1) expected time instead of a walk along the list. Each slot keeps the
+ * value next to the node pointer, so a lookup never has to visit the nodes themselves.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef NODE_HASH_H
+#define NODE_HASH_H
+
+#include <stddef.h>
+
+#include "doubleLinkedList.h"
+
+// Smallest number of slots of a node hash
+#define NODE_HASH_MIN_CAPACITY 16
+
+// Node hash slot structure
+/**
+ * @brief Structure representing one slot of a node hash.
+ *
+ * - 'value': the value of 'node'.
+ * - 'node': the list node holding 'value', NULL for an empty slot.
+ */
+struct NodeHashSlot
+{
+    int value;
+    struct Node* node;
+};
+
+// Node hash structure
+/**
+ * @brief Structure representing a hash table from values to list nodes.
+ *
+ * - 'slots': 'capacity' slots, a power of two; at most half of them are in use.
+ * - 'count': number of nodes in the table.
+ * - 'shift': 32 minus the number of bits of a slot index, used to reduce a hash to an index.
+ */
+struct NodeHash
+{
+    struct NodeHashSlot* slots;
+    size_t capacity;
+    size_t count;
+    int shift;
+};
+
+// Function declarations
+/**
+ * @brief Function declarations for node hash operations.
+ *
+ * - 'createNodeHash': creates an empty table with room for 'expected' nodes, NULL if memory allocation fails.
+ * - 'deleteNodeHash': frees a table (the nodes belong to the list and are not touched).
+ * - 'nodeHashFind': the node holding 'value', NULL if there is none.
+ * - 'nodeHashInsert': adds a node whose value is not in the table yet; returns 0 if memory allocation fails.
+ * - 'nodeHashRemove': removes the node holding 'value', if there is one.
+ * - 'nodeHashSizeInBytes': heap bytes used by the table.
+ */
+struct NodeHash* createNodeHash(size_t expected);
+void deleteNodeHash(struct NodeHash* hash);
+struct Node* nodeHashFind(const struct NodeHash* hash, int value);
+int nodeHashInsert(struct NodeHash* hash, struct Node* node);
+void nodeHashRemove(struct NodeHash* hash, int value);
+size_t nodeHashSizeInBytes(const struct NodeHash* hash);
+
+#endif // NODE_HASH_H
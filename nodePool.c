@@ -0,0 +1,168 @@
+/**
+ * @file nodePool.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the Node Pool allocator of the Double Linked List.<br/>
+ *
+ * This file contains the functions to create and delete a pool of nodes, to take
+ * nodes from it and give them back, and to report pool statistics. Slabs double in
+ * size up to NODE_POOL_MAX_SLAB nodes, so a pool needs O(log n) slabs and deleting
+ * it costs one free() per slab rather than one per node.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+
+// include module header files
+#include "nodePool.h"
+#include "doubleLinkedList.h"
+#include "logging.h"
+#include "instrumentation.h"
+
+// Number of nodes in the first slab when no capacity is requested
+#define NODE_POOL_DEFAULT_SLAB 16
+
+// Largest number of nodes in a single slab
+#define NODE_POOL_MAX_SLAB 65536
+
+// Function to create a node pool
+/**
+ * @brief Creates an empty Node Pool. No slab is allocated until the first node is requested.
+ *
+ * @param initialCapacity Number of nodes in the first slab (0 selects NODE_POOL_DEFAULT_SLAB).
+ * @return struct NodePool* Pointer to the new pool or NULL if memory allocation fails.
+ */
+struct NodePool* createNodePool(size_t initialCapacity) {
+    struct NodePool* pool = (struct NodePool*)malloc(sizeof(struct NodePool));
+    if (!pool) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    INSTR_COUNT_ALLOC(sizeof(struct NodePool));
+    pool->slabs = NULL;
+    pool->used = 0;
+    pool->freeList = NULL;
+    pool->nextCapacity = initialCapacity ? initialCapacity : NODE_POOL_DEFAULT_SLAB;
+    pool->liveNodes = 0;
+    pool->freeNodes = 0;
+    pool->slabCount = 0;
+    pool->bytesReserved = 0;
+    return pool;
+}
+
+// Function to delete a node pool
+/**
+ * @brief Deletes a Node Pool and frees all of its slabs.
+ *
+ * Every node handed out by the pool is released with it, so this costs one free() per slab.
+ *
+ * @param pool Pointer to the pool to delete.
+ */
+void deleteNodePool(struct NodePool* pool) {
+    if (!pool) return;
+
+    struct NodeSlab* slab = pool->slabs;
+    while (slab) {
+        struct NodeSlab* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    free(pool);
+}
+
+// Function to add a slab to a pool
+/**
+ * @brief Allocates a new slab with room for 'nextCapacity' nodes and makes it current.
+ *
+ * The slab header and its nodes are allocated together in one block.
+ *
+ * @param pool Pointer to the pool.
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int addSlab(struct NodePool* pool) {
+    size_t capacity = pool->nextCapacity;
+    size_t bytes = sizeof(struct NodeSlab) + capacity * sizeof(struct Node);
+    struct NodeSlab* slab = (struct NodeSlab*)malloc(bytes);
+    if (!slab) {
+        LOG_ERROR("Memory allocation failed.");
+        return 0;
+    }
+    INSTR_COUNT_ALLOC(bytes);
+    slab->next = pool->slabs;
+    slab->capacity = capacity;
+    slab->nodes = (struct Node*)(slab + 1);
+
+    pool->slabs = slab;
+    pool->used = 0;
+    pool->slabCount++;
+    pool->bytesReserved += bytes;
+    if (pool->nextCapacity < NODE_POOL_MAX_SLAB) pool->nextCapacity *= 2;
+    return 1;
+}
+
+// Function to take a node from a pool
+/**
+ * @brief Takes a node from the pool. Released nodes are reused before new slab space.
+ *
+ * @param pool Pointer to the pool.
+ * @return struct Node* An uninitialised node or NULL if memory allocation fails.
+ */
+struct Node* allocateNode(struct NodePool* pool) {
+    struct Node* node;
+
+    if (pool->freeList) {
+        node = pool->freeList;
+        pool->freeList = node->next;
+        pool->freeNodes--;
+    } else {
+        if (!pool->slabs || pool->used == pool->slabs->capacity) {
+            if (!addSlab(pool)) return NULL;
+        }
+        node = &pool->slabs->nodes[pool->used++];
+    }
+    pool->liveNodes++;
+    return node;
+}
+
+// Function to give a node back to a pool
+/**
+ * @brief Puts a node on the free list of its pool so a later allocation can reuse it.
+ *
+ * @param pool Pointer to the pool the node came from.
+ * @param node The node to release.
+ */
+void releaseNode(struct NodePool* pool, struct Node* node) {
+    node->next = pool->freeList;
+    node->prev = NULL;
+    pool->freeList = node;
+    pool->freeNodes++;
+    pool->liveNodes--;
+}
+
+// Function to report pool statistics
+/**
+ * @brief Fills in the statistics of a Node Pool.
+ *
+ * @param pool Pointer to the pool (NULL reports all zeros).
+ * @param stats Receives the statistics.
+ */
+void getNodePoolStats(const struct NodePool* pool, struct NodePoolStats* stats) {
+    if (!stats) return;
+    stats->liveNodes = pool ? pool->liveNodes : 0;
+    stats->freeNodes = pool ? pool->freeNodes : 0;
+    stats->slabs = pool ? pool->slabCount : 0;
+    stats->bytesReserved = pool ? pool->bytesReserved : 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file nodePool.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the Node Pool allocator of the Double Linked List.<br/>
+ *
+ * This header file defines the structures and function prototypes for a slab
+ * allocator that hands out 'struct Node' objects. Nodes are carved out of large
+ * slabs instead of being allocated one by one, and released nodes are kept on an
+ * intrusive free list for reuse. A pool can belong to a single list or be shared
+ * by several lists. Pools are not thread safe.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <stddef.h>
+
+struct Node;
+
+// Node slab structure
+/**
+ * @brief Structure representing one contiguous block of nodes.
+ *
+ * - 'next': the previously allocated slab of the same pool.
+ * - 'capacity': number of nodes in 'nodes'.
+ * - 'nodes': storage for the nodes (allocated together with the slab header).
+ */
+struct NodeSlab
+{
+    struct NodeSlab* next;
+    size_t capacity;
+    struct Node* nodes;
+};
+
+// Node pool structure
+/**
+ * @brief Structure representing a pool of nodes.
+ *
+ * - 'slabs': most recently allocated slab (the one being carved up), linked to older slabs.
+ * - 'used': number of nodes already carved out of the newest slab.
+ * - 'freeList': released nodes, chained through their 'next' pointers.
+ * - 'nextCapacity': number of nodes the next slab will hold (grows geometrically).
+ * - 'liveNodes', 'freeNodes', 'slabCount', 'bytesReserved': bookkeeping for statistics.
+ */
+struct NodePool
+{
+    struct NodeSlab* slabs;
+    size_t used;
+    struct Node* freeList;
+    size_t nextCapacity;
+    size_t liveNodes;
+    size_t freeNodes;
+    size_t slabCount;
+    size_t bytesReserved;
+};
+
+// Node pool statistics structure
+/**
+ * @brief Structure reporting the state of a pool, used to size pools.
+ *
+ * - 'liveNodes': nodes currently handed out.
+ * - 'freeNodes': released nodes waiting on the free list.
+ * - 'slabs': number of slabs allocated.
+ * - 'bytesReserved': total bytes allocated for slabs.
+ */
+struct NodePoolStats
+{
+    size_t liveNodes;
+    size_t freeNodes;
+    size_t slabs;
+    size_t bytesReserved;
+};
+
+// Function declarations
+/**
+ * @brief Function declarations for Node Pool operations.
+ *
+ * - 'createNodePool': Creates an empty pool whose first slab will hold 'initialCapacity' nodes (0 for the default).
+ * - 'deleteNodePool': Frees every slab of the pool at once; all nodes from the pool become invalid.
+ * - 'allocateNode': Takes a node from the free list or the current slab, allocating a new slab if needed.
+ * - 'releaseNode': Returns a node to the free list of its pool.
+ * - 'getNodePoolStats': Fills in the statistics of a pool.
+ */
+struct NodePool* createNodePool(size_t initialCapacity);
+void deleteNodePool(struct NodePool* pool);
+struct Node* allocateNode(struct NodePool* pool);
+void releaseNode(struct NodePool* pool, struct Node* node);
+void getNodePoolStats(const struct NodePool* pool, struct NodePoolStats* stats);
+
+#endif // NODE_POOL_H
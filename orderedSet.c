@@ -8,7 +8,7 @@
  * @brief Implementation of functions to manage an Ordered Set using a Double Linked List.<br/>
  *
  * This file contains functions to create, manipulate, and manage an ordered set of integers.
- * The set is backed by a double linked list and includes operations to add, remove and perform set operations like union, intersection and difference.
+ * The set is backed by a double linked list or a sorted array and includes operations to add, remove and perform set operations like union, intersection and difference.
  *
  * @author
  *  - Lewis Ubebe (23327944)
@@ -21,12 +21,518 @@
  */
 
  // Include system header files
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 // Include module header files
 #include "orderedSet.h"
 #include "doubleLinkedList.h"
+#include "sortedArray.h"
+#include "skipIndex.h"
+#include "roaringBitmap.h"
+#include "nodeHash.h"
+#include "packedArray.h"
+#include "setKernels.h"
+#include "setSnapshot.h"
+#include "instrumentation.h"
+
+// Number of elements from which a linked list set builds its membership hash (0 never builds one)
+static size_t listHashThreshold = LIST_HASH_THRESHOLD;
+
+// Limits at which adaptive sets switch backend
+static AdaptiveThresholds adaptiveThresholds = {
+    ADAPTIVE_SMALL_COUNT, ADAPTIVE_BITMAP_SPAN, ADAPTIVE_PACKED_COUNT, ADAPTIVE_PACKED_MUTATIONS,
+    ADAPTIVE_LIST_COUNT, ADAPTIVE_LIST_MUTATIONS, ADAPTIVE_CHECK_INTERVAL
+};
+
+// Mutation rate of an adaptive set that has not been used enough to measure one
+#define MUTATION_RATE_UNKNOWN ((size_t)-1)
+
+static void adaptSet(OrderedIntSet* set);
+
+#if SET_INSTRUMENTATION
+// Function to size the operands of a measured call on two sets
+/**
+ * @brief Returns the combined size of two sets, counting a NULL set as empty.
+ */
+static size_t pairSize(const OrderedIntSet* s1, const OrderedIntSet* s2) {
+    return (size_t)(s1 ? s1->count : 0) + (size_t)(s2 ? s2->count : 0);
+}
+
+// Function to size the operands of a measured call on many sets
+/**
+ * @brief Returns the combined size of k sets, counting NULL sets as empty.
+ */
+static size_t totalSize(OrderedIntSet** sets, size_t k) {
+    size_t total = 0;
+    for (size_t i = 0; sets && i < k; i++) {
+        if (sets[i]) total += (size_t)sets[i]->count;
+    }
+    return total;
+}
+#endif
+
+// Function to decode the next block of a packed set into an iterator
+/**
+ * @brief Decodes block 'block' of a packed set into the buffer of an iterator.
+ *
+ * @param it The iterator.
+ * @param block Index of the block.
+ * @param value Values of the block before its last mark <= value are skipped (INT_MIN decodes all).
+ */
+static void loadIteratorBlock(SetIterator* it, size_t block, int value) {
+    int n = packedArrayDecode(it->packed, block, value, it->buffer, NULL);
+    it->data = it->buffer;
+    it->end = it->buffer + n;
+    it->block = block + 1;
+}
+
+// Function to position an iterator on the smallest element of a set
+/**
+ * @brief Initialises an iterator at the first element of the set.
+ *
+ * @param it The iterator to initialise.
+ * @param set The set to iterate over.
+ */
+void setIteratorInit(SetIterator* it, const OrderedIntSet* set) {
+    it->node = NULL;
+    it->data = NULL;
+    it->end = NULL;
+    it->useBitmap = 0;
+    it->packed = NULL;
+    it->block = 0;
+    if (set->backend == SET_BACKEND_BITMAP) {
+        it->useBitmap = 1;
+        roaringIteratorInit(&it->bitmap, set->bitmap);
+    } else if (set->backend == SET_BACKEND_PACKED) {
+        it->packed = set->packed;
+        it->data = it->buffer;
+        it->end = it->buffer;
+        if (set->packed->blockCount > 0) loadIteratorBlock(it, 0, INT_MIN);
+    } else if (set->backend == SET_BACKEND_SORTED_ARRAY) {
+        it->data = set->array->data;
+        it->end = set->array->data + set->array->size;
+    } else {
+        it->node = set->list->head;
+    }
+}
+
+// Function to check whether an iterator still refers to an element
+/**
+ * @brief Checks whether the iterator has not run past the last element.
+ *
+ * @param it The iterator.
+ * @return int 1 if the iterator refers to an element, 0 otherwise.
+ */
+int setIteratorValid(const SetIterator* it) {
+    if (it->useBitmap) return it->bitmap.valid;
+    return it->node != NULL || it->data != it->end;
+}
+
+// Function to read the element an iterator refers to
+/**
+ * @brief Returns the element the iterator currently refers to.
+ *
+ * @param it A valid iterator.
+ * @return int The current element.
+ */
+int setIteratorValue(const SetIterator* it) {
+    if (it->useBitmap) return it->bitmap.value;
+    return it->node ? it->node->data : *it->data;
+}
+
+// Function to move an iterator to the next element
+/**
+ * @brief Moves the iterator to the next larger element.
+ *
+ * @param it A valid iterator.
+ */
+void setIteratorAdvance(SetIterator* it) {
+    if (it->useBitmap) {
+        roaringIteratorAdvance(&it->bitmap);
+    } else if (it->node) {
+        it->node = it->node->next;
+        INSTR_COUNT_NODES(1);
+    } else if (++it->data == it->end && it->packed && it->block < it->packed->blockCount) {
+        loadIteratorBlock(it, it->block, INT_MIN);
+    }
+}
+
+// Function to move an iterator forward to a value
+/**
+ * @brief Moves the iterator to the first element >= 'value'; an iterator already there does not move.
+ *
+ * Sorted arrays gallop forward from the current element, bitmaps skip whole chunks and lists
+ * walk their nodes, so a sequence of seeks to ascending values costs no more than one pass.
+ * Packed sets binary search the blocks for a value past the decoded one and decode the block
+ * found from its nearest mark.
+ *
+ * @param it A valid or exhausted iterator.
+ * @param value The value to move to.
+ */
+void setIteratorSeek(SetIterator* it, int value) {
+    if (it->useBitmap) {
+        roaringIteratorSeek(&it->bitmap, value);
+    } else if (it->node) {
+        while (it->node && it->node->data < value) {
+            it->node = it->node->next;
+            INSTR_COUNT_NODES(1);
+        }
+    } else if (it->data != it->end && *it->data < value) {
+        if (it->packed && it->end[-1] < value) {
+            size_t block = packedArrayFindBlock(it->packed, value);
+            if (block == it->packed->blockCount) {
+                it->data = it->end;
+                return;
+            }
+            loadIteratorBlock(it, block, value);
+        }
+        // Gallop: double the step until it passes the value, then binary search the last step
+        size_t n = (size_t)(it->end - it->data);
+        size_t low = 0;
+        size_t high = 1;
+        while (high < n && it->data[high] < value) {
+            low = high;
+            high = high * 2 < n ? high * 2 : n;
+        }
+        if (high > n) high = n;
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            if (it->data[mid] < value) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        it->data += low;
+    }
+}
+
+// Function to find the first node of a plain list not smaller than a value
+/**
+ * @brief Walks a sorted list from whichever end lies nearer to 'value' to its first node >= value.
+ *
+ * Which end is nearer is guessed from the values at the head and tail; walking back from the
+ * tail follows the 'prev' links.
+ *
+ * @param set A list based set.
+ * @param value The value searched for.
+ * @param rank Receives the number of nodes before the node found.
+ * @return struct Node* The first node with data >= value or NULL if all nodes are smaller.
+ */
+static struct Node* walkToLowerBound(const OrderedIntSet* set, int value, size_t* rank) {
+    struct DoubleLinkedList* list = set->list;
+    if (!list->tail || list->tail->data < value) {
+        *rank = (size_t)set->count;
+        return NULL;
+    }
+    if ((long long)value - list->head->data <= (long long)list->tail->data - value) {
+        size_t before = 0;
+        struct Node* current = list->head;
+        while (current->data < value) {
+            current = current->next;
+            before++;
+        }
+        INSTR_COUNT_NODES(before);
+        *rank = before;
+        return current;
+    }
+    size_t notBefore = 1;
+    struct Node* current = list->tail;
+    while (current->prev && current->prev->data >= value) {
+        current = current->prev;
+        notBefore++;
+    }
+    INSTR_COUNT_NODES(notBefore);
+    *rank = (size_t)set->count - notBefore;
+    return current;
+}
+
+// Function to decode a block of a packed set into a cursor
+/**
+ * @brief Decodes the whole of block 'block' of a packed set into the buffer of a cursor.
+ *
+ * @param cursor The cursor.
+ * @param block Index of the block.
+ */
+static void loadCursorBlock(SetCursor* cursor, size_t block) {
+    cursor->bufferCount = packedArrayDecode(cursor->set->packed, block, INT_MIN, cursor->buffer, NULL);
+    cursor->block = block;
+}
+
+// Function to position a cursor on the first element not smaller than a value
+/**
+ * @brief Positions a cursor on the first element >= 'value', or makes it invalid if there is none.
+ *
+ * Sorted arrays binary search, skip lists descend their index, bitmaps skip whole chunks,
+ * packed sets binary search their blocks and plain lists walk from the nearer end.
+ *
+ * @param cursor The cursor to position.
+ * @param set The set to move over.
+ * @param value The value to move to.
+ */
+void setCursorSeek(SetCursor* cursor, const OrderedIntSet* set, int value) {
+    cursor->set = set;
+    cursor->node = NULL;
+    cursor->position = 0;
+    if (set->backend == SET_BACKEND_BITMAP) {
+        roaringIteratorInit(&cursor->bitmap, set->bitmap);
+        roaringIteratorSeek(&cursor->bitmap, value);
+        cursor->valid = cursor->bitmap.valid;
+    } else if (set->backend == SET_BACKEND_PACKED) {
+        size_t block = packedArrayFindBlock(set->packed, value);
+        cursor->valid = block < set->packed->blockCount;
+        if (cursor->valid) {
+            loadCursorBlock(cursor, block);
+            while (cursor->buffer[cursor->position] < value) {
+                cursor->position++;
+            }
+        }
+    } else if (set->backend == SET_BACKEND_SORTED_ARRAY) {
+        cursor->position = sortedArrayLowerBound(set->array, value);
+        cursor->valid = cursor->position < set->array->size;
+    } else {
+        size_t rank;
+        if (set->index) {
+            cursor->node = skipIndexLowerBound(set->index, set->list, value);
+        } else {
+            cursor->node = walkToLowerBound(set, value, &rank);
+        }
+        cursor->valid = cursor->node != NULL;
+    }
+}
+
+// Function to position a cursor on the smallest element
+/**
+ * @brief Positions a cursor on the smallest element of a set, or makes it invalid if the set is empty.
+ *
+ * @param cursor The cursor to position.
+ * @param set The set to move over.
+ */
+void setCursorFirst(SetCursor* cursor, const OrderedIntSet* set) {
+    cursor->set = set;
+    cursor->node = NULL;
+    cursor->position = 0;
+    if (set->backend == SET_BACKEND_BITMAP) {
+        roaringIteratorInit(&cursor->bitmap, set->bitmap);
+        cursor->valid = cursor->bitmap.valid;
+    } else if (set->backend == SET_BACKEND_PACKED) {
+        cursor->valid = set->packed->blockCount > 0;
+        if (cursor->valid) loadCursorBlock(cursor, 0);
+    } else if (set->backend == SET_BACKEND_SORTED_ARRAY) {
+        cursor->valid = set->array->size > 0;
+    } else {
+        cursor->node = set->list->head;
+        cursor->valid = cursor->node != NULL;
+    }
+}
+
+// Function to position a cursor on the largest element
+/**
+ * @brief Positions a cursor on the largest element of a set, or makes it invalid if the set is empty.
+ *
+ * @param cursor The cursor to position.
+ * @param set The set to move over.
+ */
+void setCursorLast(SetCursor* cursor, const OrderedIntSet* set) {
+    int last;
+    if (set->backend == SET_BACKEND_BITMAP) {
+        if (roaringSelect(set->bitmap, (size_t)set->count - 1, &last)) {
+            setCursorSeek(cursor, set, last);
+        } else {
+            setCursorFirst(cursor, set);
+        }
+        return;
+    }
+    cursor->set = set;
+    cursor->node = NULL;
+    cursor->position = 0;
+    if (set->backend == SET_BACKEND_PACKED) {
+        cursor->valid = set->packed->blockCount > 0;
+        if (cursor->valid) {
+            loadCursorBlock(cursor, set->packed->blockCount - 1);
+            cursor->position = (size_t)cursor->bufferCount - 1;
+        }
+    } else if (set->backend == SET_BACKEND_SORTED_ARRAY) {
+        cursor->valid = set->array->size > 0;
+        if (cursor->valid) cursor->position = set->array->size - 1;
+    } else {
+        cursor->node = set->list->tail;
+        cursor->valid = cursor->node != NULL;
+    }
+}
+
+// Function to check whether a cursor refers to an element
+/**
+ * @brief Checks whether a cursor refers to an element.
+ *
+ * @param cursor The cursor.
+ * @return int 1 if the cursor refers to an element, 0 once it has stepped off either end.
+ */
+int setCursorValid(const SetCursor* cursor) {
+    return cursor->valid;
+}
+
+// Function to read the element a cursor refers to
+/**
+ * @brief Returns the element a cursor refers to.
+ *
+ * @param cursor A valid cursor.
+ * @return int The current element.
+ */
+int setCursorValue(const SetCursor* cursor) {
+    if (cursor->node) return cursor->node->data;
+    if (cursor->set->backend == SET_BACKEND_BITMAP) return cursor->bitmap.value;
+    if (cursor->set->backend == SET_BACKEND_PACKED) return cursor->buffer[cursor->position];
+    return cursor->set->array->data[cursor->position];
+}
+
+// Function to move a cursor to the next element
+/**
+ * @brief Moves a cursor to the next larger element.
+ *
+ * @param cursor A valid cursor.
+ */
+void setCursorNext(SetCursor* cursor) {
+    if (cursor->node) {
+        cursor->node = cursor->node->next;
+        cursor->valid = cursor->node != NULL;
+    } else if (cursor->set->backend == SET_BACKEND_BITMAP) {
+        roaringIteratorAdvance(&cursor->bitmap);
+        cursor->valid = cursor->bitmap.valid;
+    } else if (cursor->set->backend == SET_BACKEND_PACKED) {
+        if (++cursor->position == (size_t)cursor->bufferCount) {
+            cursor->valid = cursor->block + 1 < cursor->set->packed->blockCount;
+            if (cursor->valid) {
+                loadCursorBlock(cursor, cursor->block + 1);
+                cursor->position = 0;
+            }
+        }
+    } else {
+        cursor->position++;
+        cursor->valid = cursor->position < cursor->set->array->size;
+    }
+}
+
+// Function to move a cursor to the previous element
+/**
+ * @brief Moves a cursor to the next smaller element.
+ *
+ * Lists follow the 'prev' link of the current node. Bitmaps have no backward links, so the
+ * predecessor of the current element is looked up and the forward iterator is placed on it.
+ * Packed sets decode the previous block when they step back past the start of the buffer.
+ *
+ * @param cursor A valid cursor.
+ */
+void setCursorPrev(SetCursor* cursor) {
+    if (cursor->node) {
+        cursor->node = cursor->node->prev;
+        cursor->valid = cursor->node != NULL;
+    } else if (cursor->set->backend == SET_BACKEND_BITMAP) {
+        int previous;
+        if (roaringPredecessor(cursor->set->bitmap, cursor->bitmap.value, &previous)) {
+            roaringIteratorInit(&cursor->bitmap, cursor->set->bitmap);
+            roaringIteratorSeek(&cursor->bitmap, previous);
+        } else {
+            cursor->valid = 0;
+        }
+    } else if (cursor->set->backend == SET_BACKEND_PACKED && cursor->position == 0) {
+        cursor->valid = cursor->block > 0;
+        if (cursor->valid) {
+            loadCursorBlock(cursor, cursor->block - 1);
+            cursor->position = (size_t)cursor->bufferCount - 1;
+        }
+    } else if (cursor->position > 0) {
+        cursor->position--;
+    } else {
+        cursor->valid = 0;
+    }
+}
+
+// Function to allocate the set structure
+/**
+ * @brief Allocates an ordered set structure with no storage attached and a count of 0.
+ *
+ * @param backend The storage engine the caller is going to attach.
+ *
+ * @return A pointer to the set or NULL if memory allocation fails.
+ */
+static OrderedIntSet* allocateSet(SetBackend backend) {
+    OrderedIntSet* set = (OrderedIntSet*)malloc(sizeof(OrderedIntSet));
+    if (!set) return NULL;
+    INSTR_COUNT_ALLOC(sizeof(OrderedIntSet));
+    set->list = NULL;
+    set->array = NULL;
+    set->index = NULL;
+    set->bitmap = NULL;
+    set->packed = NULL;
+    set->mapping = NULL;
+    set->hash = NULL;
+    set->backend = backend;
+    set->count = 0;
+    set->adaptive = 0;
+    set->mutations = 0;
+    set->lookups = 0;
+    set->conversions = 0;
+    return set;
+}
+
+// Function to allocate a set and its storage
+/**
+ * @brief Allocates an empty ordered set and the data structure selected by 'backend'.
+ *
+ * An adaptive set starts out as a sorted array.
+ *
+ * @param backend The storage engine for the new set.
+ * @param pool Node Pool for list based backends, or NULL to give the list a pool of its own.
+ *
+ * @return A pointer to the created ordered set or NULL if memory allocation fails.
+ */
+static OrderedIntSet* createSetStorage(SetBackend backend, struct NodePool* pool) {
+    int adaptive = backend == SET_BACKEND_ADAPTIVE;
+    if (adaptive) backend = SET_BACKEND_SORTED_ARRAY;
+    OrderedIntSet* set = allocateSet(backend);
+    if (!set) return NULL;
+    set->adaptive = adaptive;
+
+    if (backend == SET_BACKEND_BITMAP) {
+        set->bitmap = createRoaringBitmap();
+        if (!set->bitmap) {
+            free(set);
+            return NULL;
+        }
+    } else if (backend == SET_BACKEND_PACKED) {
+        set->packed = createPackedArray();
+        if (!set->packed) {
+            free(set);
+            return NULL;
+        }
+    } else if (backend == SET_BACKEND_SORTED_ARRAY) {
+        set->array = createSortedArray(0);
+        if (!set->array) {
+            free(set);
+            return NULL;
+        }
+    } else {
+        if (backend != SET_BACKEND_SKIP_LIST) set->backend = SET_BACKEND_LINKED_LIST;
+        set->list = pool ? createDoubleLinkedListWithPool(pool) : createDoubleLinkedList();
+        if (!set->list) {
+            free(set);
+            return NULL;
+        }
+        if (set->backend == SET_BACKEND_SKIP_LIST) {
+            set->index = createSkipIndex();
+            if (!set->index) {
+                deleteDoubleLinkedList(set->list);
+                free(set);
+                return NULL;
+            }
+        }
+    }
+    return set;
+}
 
 // Function to create an ordered set
 /**
@@ -38,232 +544,2254 @@
  * @return A pointer to the created ordered set or NULL if memory allocation fails.
  */
 OrderedIntSet* createOrderedSet() {
-    OrderedIntSet* set = (OrderedIntSet*)malloc(sizeof(OrderedIntSet));
-    if (!set) return NULL;
-    set->list = createDoubleLinkedList();
-    if (!set->list) {
-        free(set);
+    return createOrderedSetWithBackend(SET_BACKEND_LINKED_LIST);
+}
+
+// Function to create an ordered set with a chosen storage engine
+/**
+ * @brief Creates an empty ordered set stored in the given backend.
+ *
+ * This function allocates memory for an ordered set, initializes the data structure selected
+ * by 'backend' to be empty and sets the count of elements to 0. All other set functions work
+ * the same way whichever backend is chosen.
+ *
+ * @param backend The storage engine for the new set.
+ *
+ * @return A pointer to the created ordered set or NULL if memory allocation fails.
+ */
+OrderedIntSet* createOrderedSetWithBackend(SetBackend backend) {
+    return createSetStorage(backend, NULL);
+}
+
+// Function to create a list based ordered set on a shared node pool
+/**
+ * @brief Creates an empty list based ordered set that allocates its nodes from 'pool'.
+ *
+ * Several sets can share one pool so that nodes freed by one set are reused by another.
+ * The pool is not deleted with the set; the caller deletes it after the last set using it.
+ *
+ * @param backend SET_BACKEND_LINKED_LIST or SET_BACKEND_SKIP_LIST.
+ * @param pool The Node Pool to allocate from.
+ *
+ * @return A pointer to the created ordered set or NULL if the backend is not list based or memory allocation fails.
+ */
+OrderedIntSet* createOrderedSetWithNodePool(SetBackend backend, struct NodePool* pool) {
+    if (!pool || (backend != SET_BACKEND_LINKED_LIST && backend != SET_BACKEND_SKIP_LIST)) return NULL;
+    return createSetStorage(backend, pool);
+}
+
+// Function to create the result set of a set operation
+/**
+ * @brief Creates an empty set in the backend of 'model' with room for about 'capacity' elements.
+ *
+ * For the sorted array backend the buffer is reserved up front so that appending the
+ * result of a merge never reallocates. The result of an adaptive set is adaptive: it is
+ * built as a sorted array and gets its backend once it is finished.
+ *
+ * @param model The set whose backend the result takes.
+ * @param capacity Upper bound on the number of elements that will be appended.
+ *
+ * @return A pointer to the created ordered set or NULL if memory allocation fails.
+ */
+static OrderedIntSet* createResultSet(const OrderedIntSet* model, size_t capacity) {
+    OrderedIntSet* result = createOrderedSetWithBackend(model->adaptive ? SET_BACKEND_ADAPTIVE : model->backend);
+    if (!result) return NULL;
+    if (result->array && !reserveSortedArray(result->array, capacity)) {
+        deleteOrderedSet(result);
+        return NULL;
+    }
+    return result;
+}
+
+// Function to wrap the result of a bitmap operation in a set
+/**
+ * @brief Creates a bitmap backed set that takes ownership of 'bitmap'.
+ *
+ * @param bitmap The result of a roaring operation, or NULL if it failed.
+ * @param model The first operand; the result is adaptive if it is.
+ *
+ * @return A pointer to the created ordered set or NULL if 'bitmap' is NULL or memory allocation fails.
+ */
+static OrderedIntSet* createBitmapResultSet(struct RoaringBitmap* bitmap, const OrderedIntSet* model) {
+    if (!bitmap) return NULL;
+    OrderedIntSet* result = allocateSet(SET_BACKEND_BITMAP);
+    if (!result) {
+        deleteRoaringBitmap(bitmap);
+        return NULL;
+    }
+    result->bitmap = bitmap;
+    result->count = (int)roaringCardinality(bitmap);
+    result->adaptive = model->adaptive;
+    if (result->adaptive) adaptSet(result);
+    return result;
+}
+
+// Function to drop the membership hash of a list set
+/**
+ * @brief Frees the membership hash of a set. It is built again by the next lookup.
+ *
+ * Called when the hash cannot grow to take a new node, so a failed allocation in the
+ * hash never makes an operation on the set itself fail.
+ *
+ * @param set The ordered set.
+ */
+static void dropListHash(OrderedIntSet* set) {
+    deleteNodeHash(set->hash);
+    set->hash = NULL;
+}
+
+// Function to get the membership hash of a list set
+/**
+ * @brief Returns the hash from element to node of a plain linked list set, building it first
+ * if the set has reached the list hash threshold.
+ *
+ * Building walks the list once. A set that shrinks below the threshold keeps its hash, so a
+ * set whose size hovers around the threshold does not rebuild it over and over.
+ *
+ * @param set The ordered set.
+ *
+ * @return struct NodeHash* The hash, or NULL if the set is too small, not a plain linked list
+ *         set, hashing is disabled or memory allocation failed.
+ */
+static struct NodeHash* listHash(OrderedIntSet* set) {
+    if (set->hash) return set->hash;
+    if (set->backend != SET_BACKEND_LINKED_LIST || listHashThreshold == 0 ||
+        (size_t)set->count < listHashThreshold) {
+        return NULL;
+    }
+
+    set->hash = createNodeHash((size_t)set->count);
+    if (!set->hash) return NULL;
+    for (struct Node* node = set->list->head; node; node = node->next) {
+        if (!nodeHashInsert(set->hash, node)) {
+            dropListHash(set);
+            return NULL;
+        }
+    }
+    return set->hash;
+}
+
+// Function to set the size from which list sets build a membership hash
+/**
+ * @brief Sets the number of elements from which a linked list set builds a hash from element
+ * to node. Sets that already have a hash keep it.
+ *
+ * @param count The new threshold; 0 stops new hashes from being built.
+ */
+void setListHashThreshold(size_t count) {
+    listHashThreshold = count;
+}
+
+// Function to get the size from which list sets build a membership hash
+/**
+ * @brief Returns the number of elements from which a linked list set builds a hash from element to node.
+ *
+ * @return size_t The threshold, 0 if no hashes are built.
+ */
+size_t getListHashThreshold() {
+    return listHashThreshold;
+}
+
+// Function to append an element that is larger than every element of the set
+/**
+ * @brief Appends an element at the end of the set without searching for its position.
+ *
+ * The caller guarantees that 'elem' is greater than every element already in the set,
+ * which holds for the values a sorted merge emits. 'count' is not updated; the caller
+ * sets it once after the last append.
+ *
+ * @param set The ordered set to append to.
+ * @param elem The element to append.
+ *
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int appendElement(OrderedIntSet* set, int elem) {
+    if (set->backend == SET_BACKEND_SORTED_ARRAY) {
+        return sortedArrayAppend(set->array, elem);
+    }
+    if (set->backend == SET_BACKEND_BITMAP) {
+        return roaringAdd(set->bitmap, elem) >= 0;
+    }
+    if (set->backend == SET_BACKEND_PACKED) {
+        return packedArrayAppend(set->packed, elem);
+    }
+
+    struct Node* node = appendNode(set->list, elem);
+    if (!node) return 0;
+    if (set->index) skipIndexInsert(set->index, node);
+    return 1;
+}
+
+// Function to finish the result of a set operation
+/**
+ * @brief Stores the element count in a result set, or deletes it if an append failed.
+ *
+ * A packed result packs the elements still pending after the last append, and an adaptive
+ * result is moved to the backend that suits it.
+ *
+ * @param result The result set being built.
+ * @param count Number of elements appended to it.
+ * @param ok 0 if any append failed.
+ *
+ * @return The result set, or NULL if it was deleted.
+ */
+static OrderedIntSet* finishResultSet(OrderedIntSet* result, int count, int ok) {
+    if (ok && result->packed) ok = packedArrayFlush(result->packed);
+    if (!ok) {
+        deleteOrderedSet(result);
+        return NULL;
+    }
+    result->count = count;
+    if (result->adaptive) adaptSet(result);
+    return result;
+}
+
+// Function to build an ordered set from a buffer
+/**
+ * @brief Creates an ordered set from an unsorted buffer of integers.
+ *
+ * The values are sorted (radix sort), deduplicated and stored in a sorted array that is
+ * allocated once. Input that is already sorted skips the sort. This is much faster than
+ * calling addElement once per value.
+ *
+ * @param data The values to put in the set (may be unsorted and contain duplicates).
+ * @param n Number of values in 'data'.
+ *
+ * @return A pointer to the created ordered set or NULL if memory allocation fails.
+ */
+OrderedIntSet* createOrderedSetFromArray(const int* data, size_t n) {
+    return createOrderedSetFromArrayWithBackend(data, n, SET_BACKEND_SORTED_ARRAY);
+}
+
+// Function to build an ordered set from a buffer in a chosen backend
+/**
+ * @brief Creates an ordered set stored in 'backend' from an unsorted buffer of integers.
+ *
+ * The values are first sorted and deduplicated into a sorted array. For the list backends the
+ * sorted values are then appended to the list in order, so no insertion point is ever searched.
+ * For the bitmap backend every container is finally converted to its smallest representation.
+ * For the packed backend the values are packed a block at a time as they are appended. An
+ * adaptive set is built as a sorted array and then moved to the backend that suits it.
+ *
+ * @param data The values to put in the set (may be unsorted and contain duplicates).
+ * @param n Number of values in 'data'.
+ * @param backend The storage engine for the new set.
+ *
+ * @return A pointer to the created ordered set or NULL if memory allocation fails.
+ */
+OrderedIntSet* createOrderedSetFromArrayWithBackend(const int* data, size_t n, SetBackend backend) {
+    if (!data && n > 0) return NULL;
+
+    struct SortedArray* sorted = createSortedArrayFromInts(data, n);
+    if (!sorted) return NULL;
+
+    if (backend == SET_BACKEND_SORTED_ARRAY) return createOrderedSetFromSortedArray(sorted);
+    if (backend == SET_BACKEND_ADAPTIVE) {
+        OrderedIntSet* set = createOrderedSetFromSortedArray(sorted);
+        if (set) makeSetAdaptive(set);
+        return set;
+    }
+
+    OrderedIntSet* set = createOrderedSetWithBackend(backend);
+    if (!set) {
+        deleteSortedArray(sorted);
         return NULL;
     }
-    set->count = 0;
-    return set;
+    int ok = 1;
+    for (size_t i = 0; ok && i < sorted->size; i++) {
+        ok = appendElement(set, sorted->data[i]);
+    }
+    if (ok && set->bitmap) ok = roaringRunOptimize(set->bitmap);
+    int count = (int)sorted->size;
+    deleteSortedArray(sorted);
+    return finishResultSet(set, count, ok);
+}
+
+// Function to wrap a sorted array in a set
+/**
+ * @brief Creates a sorted array backed ordered set that takes ownership of 'array'.
+ *
+ * @param array Strictly ascending values; the array is deleted if the set cannot be created.
+ *
+ * @return A pointer to the created ordered set or NULL if 'array' is NULL or memory allocation fails.
+ */
+OrderedIntSet* createOrderedSetFromSortedArray(struct SortedArray* array) {
+    if (!array) return NULL;
+    OrderedIntSet* set = allocateSet(SET_BACKEND_SORTED_ARRAY);
+    if (!set) {
+        deleteSortedArray(array);
+        return NULL;
+    }
+    set->array = array;
+    set->count = (int)array->size;
+    return set;
+}
+
+// Function to give a memory mapped set storage of its own
+/**
+ * @brief Copies the elements of a set that reads them from a mapped snapshot into a heap buffer.
+ *
+ * Mapped sets are read-only, so this runs before the first change to one of them.
+ * Sets that are not mapped are left alone.
+ *
+ * @param set The ordered set about to be modified.
+ *
+ * @return int 1 on success, 0 if memory allocation failed (the set is left unchanged).
+ */
+static int detachMapping(OrderedIntSet* set) {
+    if (!set->mapping) return 1;
+
+    size_t size = set->array->size;
+    int* data = NULL;
+    if (size > 0) {
+        data = (int*)malloc(size * sizeof(int));
+        if (!data) return 0;
+        INSTR_COUNT_ALLOC(size * sizeof(int));
+        memcpy(data, set->array->data, size * sizeof(int));
+    }
+    set->array->data = data;
+    set->array->capacity = size;
+    releaseSetMapping(set->mapping);
+    set->mapping = NULL;
+    return 1;
+}
+
+// Function to exchange the storage of two sets
+/**
+ * @brief Swaps the data structures, backend and element count of two sets.
+ *
+ * The adaptive state ('adaptive' and the operation counters) stays with each set.
+ *
+ * @param a The first set.
+ * @param b The second set.
+ */
+static void swapStorage(OrderedIntSet* a, OrderedIntSet* b) {
+    OrderedIntSet saved = *a;
+    a->list = b->list;
+    a->array = b->array;
+    a->index = b->index;
+    a->bitmap = b->bitmap;
+    a->packed = b->packed;
+    a->mapping = b->mapping;
+    a->hash = b->hash;
+    a->backend = b->backend;
+    a->count = b->count;
+    b->list = saved.list;
+    b->array = saved.array;
+    b->index = saved.index;
+    b->bitmap = saved.bitmap;
+    b->packed = saved.packed;
+    b->mapping = saved.mapping;
+    b->hash = saved.hash;
+    b->backend = saved.backend;
+    b->count = saved.count;
+}
+
+// Function to move a set to another backend
+/**
+ * @brief Copies the elements of a set into a new data structure of 'backend' and swaps it in.
+ *
+ * The elements are appended in ascending order, so no insertion point is ever searched.
+ *
+ * @param set The set to convert.
+ * @param backend The backend to move to (not SET_BACKEND_ADAPTIVE).
+ *
+ * @return int 1 on success, 0 if memory allocation failed (the set is left unchanged).
+ */
+static int convertSet(OrderedIntSet* set, SetBackend backend) {
+    OrderedIntSet* converted = createOrderedSetWithBackend(backend);
+    if (!converted) return 0;
+    int ok = !converted->array || reserveSortedArray(converted->array, (size_t)set->count);
+    SetIterator it;
+    for (setIteratorInit(&it, set); ok && setIteratorValid(&it); setIteratorAdvance(&it)) {
+        ok = appendElement(converted, setIteratorValue(&it));
+    }
+    if (ok && converted->bitmap) ok = roaringRunOptimize(converted->bitmap);
+    converted = finishResultSet(converted, set->count, ok);
+    if (!converted) return 0;
+
+    swapStorage(set, converted);
+    deleteOrderedSet(converted);
+    set->conversions++;
+    return 1;
+}
+
+// Function to pick the backend of an adaptive set
+/**
+ * @brief Applies the adaptive thresholds to a set.
+ *
+ * The span is read from the smallest and largest element, which every backend of an
+ * adaptive set finds in O(log n).
+ *
+ * @param set The adaptive set.
+ * @param mutationPercent Percentage of the operations counted since the last check that changed the set,
+ *        or MUTATION_RATE_UNKNOWN if too few were counted. An unknown rate never moves a set to or
+ *        from the skip list or packed backend, which only pay off for a known workload.
+ *
+ * @return SetBackend The backend the set should be in.
+ */
+static SetBackend chooseBackend(const OrderedIntSet* set, size_t mutationPercent) {
+    const AdaptiveThresholds* limits = &adaptiveThresholds;
+    size_t count = (size_t)set->count;
+    if (count <= limits->smallCount) return SET_BACKEND_SORTED_ARRAY;
+
+    // The current backend is kept until its limit is missed by a factor of two
+    int first, last;
+    setSelect(set, 0, &first);
+    setSelect(set, count - 1, &last);
+    unsigned long long span = (unsigned long long)((long long)last - first) + 1;
+    unsigned long long bitmapSpan = (unsigned long long)limits->bitmapSpan * count;
+    if (set->backend == SET_BACKEND_BITMAP) bitmapSpan *= 2;
+    if (span <= bitmapSpan) return SET_BACKEND_BITMAP;
+
+    int isList = set->backend == SET_BACKEND_SKIP_LIST;
+    int isPacked = set->backend == SET_BACKEND_PACKED;
+    if (mutationPercent == MUTATION_RATE_UNKNOWN) return isList || isPacked ? set->backend : SET_BACKEND_SORTED_ARRAY;
+    if (limits->listCount > 0 && count >= (isList ? limits->listCount / 2 : limits->listCount) &&
+        mutationPercent >= (isList ? limits->listMutationPercent / 2 : limits->listMutationPercent)) {
+        return SET_BACKEND_SKIP_LIST;
+    }
+    if (limits->packedCount > 0 && count >= (isPacked ? limits->packedCount / 2 : limits->packedCount) &&
+        mutationPercent <= (isPacked ? 2 * limits->packedMutationPercent : limits->packedMutationPercent)) {
+        return SET_BACKEND_PACKED;
+    }
+    return SET_BACKEND_SORTED_ARRAY;
+}
+
+// Function to check the backend of an adaptive set
+/**
+ * @brief Moves an adaptive set to the backend the thresholds choose and resets its operation counters.
+ *
+ * A set that cannot be converted for lack of memory stays where it is.
+ *
+ * @param set The adaptive set.
+ */
+static void adaptSet(OrderedIntSet* set) {
+    size_t operations = set->mutations + set->lookups;
+    size_t mutationPercent = operations > 0 && operations >= adaptiveThresholds.checkInterval
+        ? set->mutations * 100 / operations : MUTATION_RATE_UNKNOWN;
+    set->mutations = 0;
+    set->lookups = 0;
+    SetBackend backend = chooseBackend(set, mutationPercent);
+    if (backend != set->backend) {
+        INSTR_BEGIN(probe, (size_t)set->count);
+        convertSet(set, backend);
+        INSTR_END(probe, INSTR_CONVERT);
+    }
+}
+
+// Function to count an operation on an adaptive set
+/**
+ * @brief Counts an operation and checks the backend of the set once enough have been counted.
+ *
+ * A check is due after 'checkInterval' operations, but never before a quarter of the size of
+ * the set, so converting a set costs O(1) amortised over the operations between checks.
+ *
+ * @param set The adaptive set.
+ * @param mutation 1 for an addition or removal, 0 for a lookup.
+ */
+static void countOperation(OrderedIntSet* set, int mutation) {
+    if (mutation) {
+        set->mutations++;
+    } else {
+        set->lookups++;
+    }
+    size_t operations = set->mutations + set->lookups;
+    if (adaptiveThresholds.checkInterval > 0 && operations >= adaptiveThresholds.checkInterval &&
+        operations >= (size_t)set->count / 4) {
+        adaptSet(set);
+    }
+}
+
+// Function to set the thresholds of adaptive sets
+/**
+ * @brief Sets the limits at which adaptive sets switch backend. Sets are moved at their next check.
+ *
+ * @param thresholds The new limits.
+ */
+void setAdaptiveThresholds(const AdaptiveThresholds* thresholds) {
+    if (thresholds) adaptiveThresholds = *thresholds;
+}
+
+// Function to get the thresholds of adaptive sets
+/**
+ * @brief Reads the limits at which adaptive sets switch backend.
+ *
+ * @param thresholds Receives the limits.
+ */
+void getAdaptiveThresholds(AdaptiveThresholds* thresholds) {
+    if (thresholds) *thresholds = adaptiveThresholds;
+}
+
+// Function to make a set adaptive
+/**
+ * @brief Makes a set follow the adaptive thresholds from now on and moves it to the backend they choose.
+ *
+ * Used for sets built outside this module, such as the results of the parallel set
+ * operations, so they behave like the results of the serial ones.
+ *
+ * @param set The ordered set.
+ */
+void makeSetAdaptive(OrderedIntSet* set) {
+    if (!set || set->adaptive) return;
+    set->adaptive = 1;
+    set->mutations = 0;
+    set->lookups = 0;
+    adaptSet(set);
+}
+
+// Function to name a backend
+/**
+ * @brief Returns the short name of a backend, as accepted by the create command of batch mode.
+ *
+ * @param backend The backend.
+ * @return const char* "list", "array", "skip", "bitmap", "packed", "adaptive" or "unknown".
+ */
+const char* setBackendName(SetBackend backend) {
+    static const char* names[] = { "list", "array", "skip", "bitmap", "packed", "adaptive" };
+    if (backend < SET_BACKEND_LINKED_LIST || backend > SET_BACKEND_ADAPTIVE) return "unknown";
+    return names[backend];
+}
+
+// Function to add an element to a list backed set that has a membership hash
+/**
+ * @brief Adds an element to a linked list set through its hash from element to node.
+ *
+ * A duplicate is found in the hash without touching the list, and an element beyond either
+ * end of the list is linked in directly. Any other element still walks the list to find its
+ * place, since the hash knows nothing about order.
+ *
+ * @param set The ordered set to add the element to (with a non-NULL 'hash').
+ * @param elem The element to be added to the set.
+ *
+ * @return SetStatus indicating whether the element was added, already in the set or an allocation error occurred.
+ */
+static SetStatus addToHashedList(OrderedIntSet* set, int elem) {
+    if (nodeHashFind(set->hash, elem)) {
+        return NUMBER_ALREADY_IN_SET;  // Element already exists
+    }
+
+    struct DoubleLinkedList* list = set->list;
+    struct Node* node;
+    if (!list->tail || list->tail->data < elem) {
+        node = appendNode(list, elem);
+    } else {
+        struct Node* next = list->head;
+        while (next->data < elem) {
+            next = next->next;
+            INSTR_COUNT_NODES(1);
+        }
+        node = insertBefore(list, next, elem);
+    }
+    if (!node) return ALLOCATION_ERROR;
+
+    if (!nodeHashInsert(set->hash, node)) dropListHash(set);
+    set->count++;
+    return NUMBER_ADDED;
+}
+
+// Function to add an element to a list backed set
+/**
+ * @brief Adds an element to an ordered set stored in a double linked list.
+ *
+ * @param set The ordered set to add the element to.
+ * @param elem The element to be added to the set.
+ *
+ * @return SetStatus indicating whether the element was added or already in the set, or ALLOCATION_ERROR.
+ */
+static SetStatus addToList(OrderedIntSet* set, int elem) {
+    if (listHash(set)) return addToHashedList(set, elem);
+
+    // If the list is empty, simply add the element at the head
+    if (!set->list->head) {
+        if (!appendNode(set->list, elem)) return ALLOCATION_ERROR;
+        set->count++;
+        return NUMBER_ADDED;
+    }
+
+    struct Node* current = set->list->head;
+    while (current) {
+        if (current->data == elem) {
+            return NUMBER_ALREADY_IN_SET;  // Element already exists
+        }
+        // If we find a node with a greater value, insert before it
+        if (current->data > elem) {
+            if (!insertBefore(set->list, current, elem)) return ALLOCATION_ERROR;
+            set->count++;
+            return NUMBER_ADDED;
+        }
+        current = current->next;
+        INSTR_COUNT_NODES(1);
+    }
+
+    // If the element is greater than all existing elements, append it at the end
+    if (!appendNode(set->list, elem)) return ALLOCATION_ERROR;
+    set->count++;
+    return NUMBER_ADDED;
+}
+
+// Function to add an element to an array backed set
+/**
+ * @brief Adds an element to an ordered set stored in a sorted array.
+ *
+ * The position is found by binary search, so only the shift of the later elements is linear.
+ *
+ * @param set The ordered set to add the element to.
+ * @param elem The element to be added to the set.
+ *
+ * @return SetStatus indicating whether the element was added, already in the set or an allocation error occurred.
+ */
+static SetStatus addToArray(OrderedIntSet* set, int elem) {
+    size_t pos = sortedArrayLowerBound(set->array, elem);
+    if (pos < set->array->size && set->array->data[pos] == elem) {
+        return NUMBER_ALREADY_IN_SET;  // Element already exists
+    }
+    if (!sortedArrayInsertAt(set->array, pos, elem)) return ALLOCATION_ERROR;
+    set->count++;
+    return NUMBER_ADDED;
+}
+
+// Function to add an element to a skip list backed set
+/**
+ * @brief Adds an element to an ordered set stored in an indexed double linked list.
+ *
+ * The insertion point is found through the skip index in O(log n) expected time and the
+ * new node is then offered a tower of its own.
+ *
+ * @param set The ordered set to add the element to.
+ * @param elem The element to be added to the set.
+ *
+ * @return SetStatus indicating whether the element was added, already in the set or an allocation error occurred.
+ */
+static SetStatus addToIndexedList(OrderedIntSet* set, int elem) {
+    struct SkipPath path;
+    struct Node* next = skipIndexFind(set->index, set->list, elem, &path);
+    if (next && next->data == elem) {
+        return NUMBER_ALREADY_IN_SET;  // Element already exists
+    }
+
+    struct Node* node;
+    if (next) {
+        node = insertBefore(set->list, next, elem);
+    } else {
+        node = appendNode(set->list, elem);
+    }
+    if (!node) return ALLOCATION_ERROR;
+
+    skipIndexInsertAt(set->index, node, &path);
+    set->count++;
+    return NUMBER_ADDED;
+}
+
+// Function to add an element to the ordered set
+/**
+ * @brief Adds an element to the ordered set.
+ *
+ * This function adds an element to the ordered set while ensuring that the set remains in ascending order
+ * and contains no duplicate elements.
+ *
+ * @param set The ordered set to add the element to.
+ * @param elem The element to be added to the set.
+ *
+ * @return SetStatus indicating whether the element was successfully added, already in the set or an allocation error occurred.
+ */
+static SetStatus runAddElement(OrderedIntSet* set, int elem) {
+    if (!set || !detachMapping(set)) return ALLOCATION_ERROR;
+    if (set->adaptive) countOperation(set, 1);
+
+    if (set->backend == SET_BACKEND_SORTED_ARRAY) return addToArray(set, elem);
+    if (set->backend == SET_BACKEND_SKIP_LIST) return addToIndexedList(set, elem);
+    if (set->backend == SET_BACKEND_BITMAP) {
+        int added = roaringAdd(set->bitmap, elem);
+        if (added < 0) return ALLOCATION_ERROR;
+        if (!added) return NUMBER_ALREADY_IN_SET;
+        set->count++;
+        return NUMBER_ADDED;
+    }
+    if (set->backend == SET_BACKEND_PACKED) {
+        int added = packedArrayInsert(set->packed, elem);
+        if (added < 0) return ALLOCATION_ERROR;
+        if (!added) return NUMBER_ALREADY_IN_SET;
+        set->count++;
+        return NUMBER_ADDED;
+    }
+    return addToList(set, elem);
+}
+
+// Function to add an element to the ordered set, recording the call
+/**
+ * @brief Adds an element to the ordered set (see runAddElement), adding the call to the instrumentation
+ * statistics when they are compiled in.
+ *
+ * @param set The ordered set to add the element to.
+ * @param elem The element to be added to the set.
+ *
+ * @return SetStatus as returned by runAddElement.
+ */
+SetStatus addElement(OrderedIntSet* set, int elem) {
+    INSTR_BEGIN(probe, set ? (size_t)set->count : 0);
+    SetStatus status = runAddElement(set, elem);
+    INSTR_END(probe, INSTR_ADD);
+    return status;
+}
+
+// Function to delete an ordered set
+/**
+ * @brief Deletes an ordered set.
+ *
+ * This function deallocates memory for the ordered set and its internal data structure.
+ *
+ * @param set The ordered set to be deleted.
+ */
+void deleteOrderedSet(OrderedIntSet* set) {
+    if (set) {
+        if (set->mapping) {
+            set->array->data = NULL;  // Borrowed from the mapping, not allocated
+            releaseSetMapping(set->mapping);
+        }
+        if (set->index) deleteSkipIndex(set->index);
+        if (set->hash) deleteNodeHash(set->hash);
+        if (set->list) deleteDoubleLinkedList(set->list);
+        if (set->array) deleteSortedArray(set->array);
+        if (set->bitmap) deleteRoaringBitmap(set->bitmap);
+        if (set->packed) deletePackedArray(set->packed);
+        free(set);
+    }
+}
+
+// Function to copy the elements of a set to a buffer
+/**
+ * @brief Writes the elements of the ordered set to 'out' in ascending order.
+ *
+ * Packed sets decode each block straight into its place in 'out'.
+ *
+ * @param set The ordered set.
+ * @param out Buffer with room for 'set->count' ints.
+ *
+ * @return size_t Number of elements written.
+ */
+size_t copyElements(const OrderedIntSet* set, int* out) {
+    if (!set || !out) return 0;
+
+    if (set->backend == SET_BACKEND_SORTED_ARRAY) {
+        if (set->array->size > 0) memcpy(out, set->array->data, set->array->size * sizeof(int));
+        return set->array->size;
+    }
+    if (set->backend == SET_BACKEND_PACKED) {
+        for (size_t b = 0; b < set->packed->blockCount; b++) {
+            packedArrayDecode(set->packed, b, INT_MIN, out + set->packed->blocks[b].start, NULL);
+        }
+        return set->packed->size;
+    }
+
+    size_t n = 0;
+    SetIterator it;
+    setIteratorInit(&it, set);
+    while (setIteratorValid(&it)) {
+        out[n++] = setIteratorValue(&it);
+        setIteratorAdvance(&it);
+    }
+    return n;
+}
+
+// Function to count the elements smaller than a value
+/**
+ * @brief Returns the rank of a value: the number of elements of the set smaller than it.
+ *
+ * Sorted arrays binary search, skip lists add up the spans passed while descending their
+ * index and bitmaps add up the cardinalities of the chunks below the value, all in
+ * O(log n); packed sets binary search their blocks and decode one from its nearest mark;
+ * plain lists walk from the nearer end.
+ *
+ * @param set The ordered set.
+ * @param value The value to rank (it need not be in the set).
+ * @return size_t Number of elements < value.
+ */
+size_t setRank(const OrderedIntSet* set, int value) {
+    if (!set || set->count == 0) return 0;
+
+    if (set->backend == SET_BACKEND_BITMAP) return roaringRank(set->bitmap, value);
+    if (set->backend == SET_BACKEND_SORTED_ARRAY) return sortedArrayLowerBound(set->array, value);
+    if (set->backend == SET_BACKEND_PACKED) return packedArrayRank(set->packed, value);
+    if (set->index) return skipIndexRank(set->index, set->list, value);
+
+    size_t rank;
+    walkToLowerBound(set, value, &rank);
+    return rank;
+}
+
+// Function to find the element at a position
+/**
+ * @brief Finds the k-th smallest element of a set, counting from 0.
+ *
+ * Sorted arrays index directly, skip lists follow the spans of their index, bitmaps skip
+ * whole chunks by cardinality and packed sets binary search the start positions of their
+ * blocks; plain lists walk from the nearer end.
+ *
+ * @param set The ordered set.
+ * @param k Position of the element.
+ * @param value Receives the element.
+ * @return int 1 if the set has more than k elements, 0 otherwise ('value' is not written).
+ */
+int setSelect(const OrderedIntSet* set, size_t k, int* value) {
+    if (!set || k >= (size_t)set->count) return 0;
+
+    if (set->backend == SET_BACKEND_BITMAP) return roaringSelect(set->bitmap, k, value);
+    if (set->backend == SET_BACKEND_PACKED) return packedArraySelect(set->packed, k, value);
+    if (set->backend == SET_BACKEND_SORTED_ARRAY) {
+        *value = set->array->data[k];
+        return 1;
+    }
+    if (set->index) {
+        *value = skipIndexSelect(set->index, set->list, k)->data;
+        return 1;
+    }
+
+    struct Node* current;
+    if (k < (size_t)set->count / 2) {
+        current = set->list->head;
+        for (size_t i = 0; i < k; i++) current = current->next;
+    } else {
+        current = set->list->tail;
+        for (size_t i = (size_t)set->count - 1; i > k; i--) current = current->prev;
+    }
+    *value = current->data;
+    return 1;
+}
+
+// Function to count the elements in a range
+/**
+ * @brief Counts the elements x of a set with lo <= x < hi, as the difference of two ranks.
+ *
+ * @param set The ordered set.
+ * @param lo Inclusive lower bound.
+ * @param hi Exclusive upper bound.
+ * @return size_t Number of elements in [lo, hi), 0 if hi <= lo.
+ */
+size_t rangeCount(const OrderedIntSet* set, int lo, int hi) {
+    if (!set || hi <= lo) return 0;
+    return setRank(set, hi) - setRank(set, lo);
+}
+
+// Function to copy the elements in a range
+/**
+ * @brief Writes the elements x of a set with lo <= x < hi to a buffer in ascending order.
+ *
+ * A cursor is positioned on the first element >= lo and stepped forward, so only the
+ * elements copied are visited. Pages of a range are read by passing the last element of the
+ * previous page plus one as 'lo'.
+ *
+ * @param set The ordered set.
+ * @param lo Inclusive lower bound.
+ * @param hi Exclusive upper bound.
+ * @param out Buffer with room for 'max' ints.
+ * @param max Largest number of elements to write.
+ * @return size_t Number of elements written.
+ */
+size_t rangeExtract(const OrderedIntSet* set, int lo, int hi, int* out, size_t max) {
+    if (!set || !out || hi <= lo) return 0;
+
+    size_t n = 0;
+    SetCursor cursor;
+    for (setCursorSeek(&cursor, set, lo); n < max && setCursorValid(&cursor); setCursorNext(&cursor)) {
+        int value = setCursorValue(&cursor);
+        if (value >= hi) break;
+        out[n++] = value;
+    }
+    return n;
+}
+
+// Function to print an ordered set
+/**
+ * @brief Prints the elements of the ordered set to the standard output.
+ *
+ * This function prints the elements of the ordered set in the format {elem1, elem2, ..., elemN}.
+ * If the set is empty, it prints "{}".
+ *
+ * @param set The ordered set to print.
+ */
+void printToStdout(OrderedIntSet* set) {
+    if (!set || set->count == 0) {
+        printf("{}\n");
+        return;
+    }
+
+    printf("{");
+    SetIterator it;
+    setIteratorInit(&it, set);
+    while (setIteratorValid(&it)) {
+        printf("%d", setIteratorValue(&it));
+        setIteratorAdvance(&it);
+        if (setIteratorValid(&it)) printf(", ");
+    }
+    printf("}\n");
+}
+
+// Function to remove an element from the ordered set
+/**
+ * @brief Removes an element from the ordered set.
+ *
+ * This function removes a specified element from the ordered set. If the element is not found, no changes are made.
+ *
+ * @param set The ordered set to remove the element from.
+ * @param elem The element to be removed from the set.
+ *
+ * @return SetStatus indicating whether the element was successfully removed or not found in the set.
+ */
+static SetStatus runRemoveElement(OrderedIntSet* set, int elem) {
+    if (!set) return ALLOCATION_ERROR;
+    if (set->adaptive) countOperation(set, 1);
+
+    if (set->backend == SET_BACKEND_SORTED_ARRAY) {
+        size_t pos = sortedArrayLowerBound(set->array, elem);
+        if (pos < set->array->size && set->array->data[pos] == elem) {
+            if (!detachMapping(set)) return ALLOCATION_ERROR;
+            sortedArrayRemoveAt(set->array, pos);
+            set->count--;
+            return NUMBER_REMOVED;
+        }
+        return NUMBER_NOT_IN_SET;
+    }
+
+    if (set->backend == SET_BACKEND_SKIP_LIST) {
+        struct SkipPath path;
+        struct Node* node = skipIndexFind(set->index, set->list, elem, &path);
+        if (node && node->data == elem) {
+            skipIndexRemoveAt(set->index, node, &path);  // Drop the tower before the node is freed
+            removeNode(set->list, node);
+            set->count--;
+            return NUMBER_REMOVED;
+        }
+        return NUMBER_NOT_IN_SET;
+    }
+
+    if (set->backend == SET_BACKEND_BITMAP) {
+        int removed = roaringRemove(set->bitmap, elem);
+        if (removed < 0) return ALLOCATION_ERROR;
+        if (!removed) return NUMBER_NOT_IN_SET;
+        set->count--;
+        return NUMBER_REMOVED;
+    }
+
+    if (set->backend == SET_BACKEND_PACKED) {
+        int removed = packedArrayRemove(set->packed, elem);
+        if (removed < 0) return ALLOCATION_ERROR;
+        if (!removed) return NUMBER_NOT_IN_SET;
+        set->count--;
+        return NUMBER_REMOVED;
+    }
+
+    if (listHash(set)) {
+        struct Node* node = nodeHashFind(set->hash, elem);
+        if (!node) return NUMBER_NOT_IN_SET;
+        nodeHashRemove(set->hash, elem);
+        removeNode(set->list, node);
+        set->count--;
+        return NUMBER_REMOVED;
+    }
+
+    struct Node* current = set->list->head;
+    while (current) {
+        if (current->data == elem) {
+            removeNode(set->list, current);
+            set->count--;
+            return NUMBER_REMOVED;
+        }
+        current = current->next;
+        INSTR_COUNT_NODES(1);
+    }
+    return NUMBER_NOT_IN_SET;
+}
+
+// Function to remove an element from the ordered set, recording the call
+/**
+ * @brief Removes an element from the ordered set (see runRemoveElement), adding the call to the instrumentation
+ * statistics when they are compiled in.
+ *
+ * @param set The ordered set to remove the element from.
+ * @param elem The element to be removed from the set.
+ *
+ * @return SetStatus as returned by runRemoveElement.
+ */
+SetStatus removeElement(OrderedIntSet* set, int elem) {
+    INSTR_BEGIN(probe, set ? (size_t)set->count : 0);
+    SetStatus status = runRemoveElement(set, elem);
+    INSTR_END(probe, INSTR_REMOVE);
+    return status;
+}
+
+// Function type of a roaring bitmap operation
+typedef struct RoaringBitmap* (*BitmapKernel)(const struct RoaringBitmap* a, const struct RoaringBitmap* b);
+
+// Function to check whether a set operation can run on bitmaps
+/**
+ * @brief Returns 1 if a set operation is best run as a bitmap operation: s1 is a bitmap, so the
+ * result is one too, or s1 is adaptive and s2 is a bitmap, so the result may well become one.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ * @return int 1 to combine the sets as bitmaps, 0 otherwise.
+ */
+static int combinesAsBitmaps(const OrderedIntSet* s1, const OrderedIntSet* s2) {
+    return s1->backend == SET_BACKEND_BITMAP || (s1->adaptive && s2->backend == SET_BACKEND_BITMAP);
+}
+
+// Function to build a bitmap of the elements of a set
+/**
+ * @brief Returns a new bitmap holding the elements of a set; they arrive in ascending order, so
+ * each one lands at the end of its chunk.
+ *
+ * @param set The ordered set.
+ * @return struct RoaringBitmap* The bitmap, or NULL if memory allocation fails.
+ */
+static struct RoaringBitmap* bitmapOf(const OrderedIntSet* set) {
+    struct RoaringBitmap* bitmap = createRoaringBitmap();
+    int ok = bitmap != NULL;
+    SetIterator it;
+    for (setIteratorInit(&it, set); ok && setIteratorValid(&it); setIteratorAdvance(&it)) {
+        ok = roaringAdd(bitmap, setIteratorValue(&it)) >= 0;
+    }
+    if (!ok) {
+        deleteRoaringBitmap(bitmap);
+        return NULL;
+    }
+    return bitmap;
+}
+
+// Function to combine two sets as bitmaps
+/**
+ * @brief Runs a roaring operation on two sets, building a temporary bitmap of an operand that is not one.
+ *
+ * The chunk by chunk operation handles a whole container, up to a 64-bit word of values, at a
+ * time, which beats merging the bitmap element by element even after paying for the copy.
+ *
+ * @param operation The roaring operation.
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return A new bitmap set holding the result or NULL if memory allocation fails.
+ */
+static OrderedIntSet* combineAsBitmaps(BitmapKernel operation, OrderedIntSet* s1, OrderedIntSet* s2) {
+    struct RoaringBitmap* temporary1 = NULL;
+    struct RoaringBitmap* temporary2 = NULL;
+    const struct RoaringBitmap* b1 = s1->bitmap ? s1->bitmap : (temporary1 = bitmapOf(s1));
+    const struct RoaringBitmap* b2 = s2->bitmap ? s2->bitmap : (temporary2 = bitmapOf(s2));
+    OrderedIntSet* result = b1 && b2 ? createBitmapResultSet(operation(b1, b2), s1) : NULL;
+    deleteRoaringBitmap(temporary1);
+    deleteRoaringBitmap(temporary2);
+    return result;
+}
+
+// Function type of a kernel combining two sorted buffers
+typedef size_t (*SortedKernel)(const int* a, size_t na, const int* b, size_t nb, int* out);
+
+// Function to check whether a set can be combined by a contiguous kernel
+/**
+ * @brief Returns 1 if the elements of the set are in, or decode cheaply to, one contiguous buffer.
+ *
+ * @param set The ordered set.
+ * @return int 1 for sorted array and packed sets, 0 otherwise.
+ */
+static int isContiguous(const OrderedIntSet* set) {
+    return set->backend == SET_BACKEND_SORTED_ARRAY || set->backend == SET_BACKEND_PACKED;
+}
+
+// Function to combine two contiguous sets with a sorted buffer kernel
+/**
+ * @brief Runs one of the vectorised kernels of setKernels.h over two sorted array or packed sets.
+ *
+ * A packed operand is decoded block by block into a scratch buffer first, which costs far
+ * less than merging it through an iterator. The kernel writes straight into the buffer of a
+ * sorted array result; any other result is appended from a scratch buffer.
+ *
+ * @param kernel The kernel computing the operation.
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ * @param capacity Upper bound on the number of elements of the result.
+ *
+ * @return A new ordered set holding the result or NULL if memory allocation fails.
+ */
+static OrderedIntSet* combineContiguous(SortedKernel kernel, OrderedIntSet* s1, OrderedIntSet* s2, size_t capacity) {
+    OrderedIntSet* result = createResultSet(s1, capacity);
+    if (!result) return NULL;
+
+    int* scratch1 = NULL;
+    int* scratch2 = NULL;
+    const int* a = s1->array ? s1->array->data : (scratch1 = malloc(((size_t)s1->count + 1) * sizeof(int)));
+    const int* b = s2->array ? s2->array->data : (scratch2 = malloc(((size_t)s2->count + 1) * sizeof(int)));
+    int* out = result->array ? result->array->data : malloc((capacity + 1) * sizeof(int));
+    int ok = (s1->array || scratch1) && (s2->array || scratch2) && (result->array || out);  // Empty arrays have no buffer
+    size_t n = 0;
+
+    if (ok) {
+        if (scratch1) INSTR_COUNT_ALLOC(((size_t)s1->count + 1) * sizeof(int));
+        if (scratch2) INSTR_COUNT_ALLOC(((size_t)s2->count + 1) * sizeof(int));
+        if (!result->array) INSTR_COUNT_ALLOC((capacity + 1) * sizeof(int));
+        if (scratch1) copyElements(s1, scratch1);
+        if (scratch2) copyElements(s2, scratch2);
+        n = kernel(a, (size_t)s1->count, b, (size_t)s2->count, out);
+        if (result->array) {
+            result->array->size = n;
+        } else {
+            for (size_t i = 0; ok && i < n; i++) {
+                ok = appendElement(result, out[i]);
+            }
+        }
+    }
+
+    free(scratch1);
+    free(scratch2);
+    if (!result->array) free(out);
+    return finishResultSet(result, (int)n, ok);
+}
+
+// Function to check whether an element is in the ordered set
+/**
+ * @brief Checks whether an element is in the ordered set.
+ *
+ * The sorted array backend uses binary search, the skip list backend its index, the bitmap
+ * backend a bit or container lookup and the packed backend a binary search of its blocks
+ * followed by decoding from the nearest mark; the plain linked list backend looks the element up in its
+ * hash once it has reached the list hash threshold and walks the list until it passes the
+ * element before that.
+ *
+ * @param set The ordered set to search.
+ * @param elem The element to look for.
+ *
+ * @return int 1 if the element is in the set, 0 otherwise.
+ */
+static int runContainsElement(OrderedIntSet* set, int elem) {
+    if (!set) return 0;
+    if (set->adaptive) countOperation(set, 0);
+
+    if (set->backend == SET_BACKEND_SORTED_ARRAY) {
+        size_t pos = sortedArrayLowerBound(set->array, elem);
+        return pos < set->array->size && set->array->data[pos] == elem;
+    }
+
+    if (set->backend == SET_BACKEND_SKIP_LIST) {
+        struct Node* node = skipIndexLowerBound(set->index, set->list, elem);
+        return node && node->data == elem;
+    }
+
+    if (set->backend == SET_BACKEND_BITMAP) {
+        return roaringContains(set->bitmap, elem);
+    }
+
+    if (set->backend == SET_BACKEND_PACKED) {
+        return packedArrayContains(set->packed, elem);
+    }
+
+    if (listHash(set)) return nodeHashFind(set->hash, elem) != NULL;
+
+    struct Node* current = set->list->head;
+    while (current && current->data < elem) {
+        current = current->next;
+        INSTR_COUNT_NODES(1);
+    }
+    return current && current->data == elem;
+}
+
+// Function to check whether an element is in the ordered set, recording the call
+/**
+ * @brief Checks whether an element is in the ordered set (see runContainsElement), adding the call to the instrumentation
+ * statistics when they are compiled in.
+ *
+ * @param set The ordered set to search.
+ * @param elem The element to look for.
+ *
+ * @return int 1 if the element is in the set, 0 otherwise.
+ */
+int containsElement(OrderedIntSet* set, int elem) {
+    INSTR_BEGIN(probe, set ? (size_t)set->count : 0);
+    int found = runContainsElement(set, elem);
+    INSTR_END(probe, INSTR_CONTAINS);
+    return found;
+}
+
+/**
+ * @brief Computes the intersection of two ordered sets.
+ *
+ * This function returns a new ordered set containing the elements that are common to both input sets.
+ * Neither of the input sets are modified. The result uses the same backend as s1.
+ * A bitmap s1, or an adaptive s1 with a bitmap s2, is combined as bitmaps. Sorted array
+ * and packed inputs, in any mix, go through the galloping kernel; other mixes leapfrog, each iterator seeking the current element of the other, so a small set
+ * intersected with a large array or bitmap skips over most of the large one.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return A new ordered set containing the intersection of s1 and s2 or NULL if memory allocation fails.
+ */
+static OrderedIntSet* runSetIntersection(OrderedIntSet* s1, OrderedIntSet* s2) {
+    if (!s1 || !s2) return NULL;
+
+    // A bitmap result: combine chunk by chunk, a 64-bit word at a time
+    if (combinesAsBitmaps(s1, s2)) {
+        return combineAsBitmaps(roaringAnd, s1, s2);
+    }
+
+    size_t capacity = (size_t)(s1->count < s2->count ? s1->count : s2->count);
+
+    // Contiguous inputs: use the vectorised / galloping kernel
+    if (isContiguous(s1) && isContiguous(s2)) {
+        return combineContiguous(intersectSortedInts, s1, s2, capacity);
+    }
+
+    OrderedIntSet* result = createResultSet(s1, capacity);
+    if (!result) return NULL;
+
+    SetIterator current1, current2;
+    setIteratorInit(&current1, s1);
+    setIteratorInit(&current2, s2);
+    int count = 0;
+    int ok = 1;
+
+    while (ok && setIteratorValid(&current1) && setIteratorValid(&current2)) {
+        int data1 = setIteratorValue(&current1);
+        int data2 = setIteratorValue(&current2);
+        if (data1 == data2) {
+            ok = appendElement(result, data1);  // Add the common element to the result
+            count++;
+            setIteratorAdvance(&current1);  // Move both iterators forward
+            setIteratorAdvance(&current2);
+        } else if (data1 < data2) {
+            setIteratorSeek(&current1, data2);  // Skip current1 ahead to data2
+        } else {
+            setIteratorSeek(&current2, data1);  // Skip current2 ahead to data1
+        }
+    }
+    return finishResultSet(result, count, ok);
+}
+
+// Function to compute the intersection of two ordered sets, recording the call
+/**
+ * @brief Computes the intersection of two ordered sets (see runSetIntersection), adding the call to the instrumentation
+ * statistics when they are compiled in.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return The result of runSetIntersection.
+ */
+OrderedIntSet* setIntersection(OrderedIntSet* s1, OrderedIntSet* s2) {
+    INSTR_BEGIN(probe, pairSize(s1, s2));
+    OrderedIntSet* result = runSetIntersection(s1, s2);
+    INSTR_END(probe, INSTR_INTERSECTION);
+    return result;
+}
+
+
+
+// Function to find the union of two ordered sets
+/**
+ * @brief Computes the union of two ordered sets.
+ *
+ * This function returns a new ordered set containing all unique elements from both input sets.
+ * Neither of the input sets are modified. The result uses the same backend as s1.
+ * The merge emits the elements in ascending order, so each one is appended at the end of the
+ * result and the whole operation runs in O(n + m). A bitmap s1, or an adaptive s1 with a
+ * bitmap s2, is combined as bitmaps; sorted array and packed inputs, in any mix, go through
+ * the vectorised merge kernel.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return A new ordered set containing the union of s1 and s2 or NULL if memory allocation fails.
+ */
+static OrderedIntSet* runSetUnion(OrderedIntSet* s1, OrderedIntSet* s2) {
+    if (!s1 || !s2) return NULL;
+
+    // A bitmap result: combine chunk by chunk, a 64-bit word at a time
+    if (combinesAsBitmaps(s1, s2)) {
+        return combineAsBitmaps(roaringOr, s1, s2);
+    }
+
+    // Contiguous inputs: use the vectorised merge kernel
+    if (isContiguous(s1) && isContiguous(s2)) {
+        return combineContiguous(unionSortedInts, s1, s2, (size_t)s1->count + s2->count);
+    }
+
+    OrderedIntSet* result = createResultSet(s1, (size_t)s1->count + s2->count);
+    if (!result) return NULL;
+
+    SetIterator current1, current2;
+    setIteratorInit(&current1, s1);
+    setIteratorInit(&current2, s2);
+    int count = 0;
+    int ok = 1;
+
+    while (ok && (setIteratorValid(&current1) || setIteratorValid(&current2))) {  // Continue while either set has elements
+        if (!setIteratorValid(&current2) ||
+            (setIteratorValid(&current1) && setIteratorValue(&current1) < setIteratorValue(&current2))) {
+            ok = appendElement(result, setIteratorValue(&current1));
+            setIteratorAdvance(&current1);  // Move current1 forward
+        } else if (!setIteratorValid(&current1) || setIteratorValue(&current2) < setIteratorValue(&current1)) {
+            ok = appendElement(result, setIteratorValue(&current2));
+            setIteratorAdvance(&current2);  // Move current2 forward
+        } else {
+            ok = appendElement(result, setIteratorValue(&current1));  // Both data are equal
+            setIteratorAdvance(&current1);
+            setIteratorAdvance(&current2);
+        }
+        count++;
+    }
+    return finishResultSet(result, count, ok);
+}
+
+// Function to compute the union of two ordered sets, recording the call
+/**
+ * @brief Computes the union of two ordered sets (see runSetUnion), adding the call to the instrumentation
+ * statistics when they are compiled in.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return The result of runSetUnion.
+ */
+OrderedIntSet* setUnion(OrderedIntSet* s1, OrderedIntSet* s2) {
+    INSTR_BEGIN(probe, pairSize(s1, s2));
+    OrderedIntSet* result = runSetUnion(s1, s2);
+    INSTR_END(probe, INSTR_UNION);
+    return result;
+}
+
+// Function to find the difference of two ordered sets (s1 - s2)
+/**
+ * @brief Computes the difference of two ordered sets (s1 - s2).
+ *
+ * This function returns a new ordered set containing all elements that are in s1 but not in s2.
+ * Neither of the input sets are modified. The result uses the same backend as s1.
+ * A bitmap s1, or an adaptive s1 with a bitmap s2, is combined as bitmaps. Sorted array
+ * and packed inputs, in any mix, go through the vectorised kernel; otherwise s2 seeks each
+ * element of s1, so a large array or bitmap s2 is mostly skipped over.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return A new ordered set containing the difference of s1 and s2 or NULL if memory allocation fails.
+ */
+static OrderedIntSet* runSetDifference(OrderedIntSet* s1, OrderedIntSet* s2) {
+    if (!s1 || !s2) return NULL;
+
+    // A bitmap result: combine chunk by chunk, a 64-bit word at a time
+    if (combinesAsBitmaps(s1, s2)) {
+        return combineAsBitmaps(roaringAndNot, s1, s2);
+    }
+
+    // Contiguous inputs: use the vectorised difference kernel
+    if (isContiguous(s1) && isContiguous(s2)) {
+        return combineContiguous(differenceSortedInts, s1, s2, (size_t)s1->count);
+    }
+
+    OrderedIntSet* result = createResultSet(s1, s1->count);
+    if (!result) return NULL;
+
+    SetIterator current1, current2;
+    setIteratorInit(&current1, s1);
+    setIteratorInit(&current2, s2);
+    int count = 0;
+    int ok = 1;
+
+    while (ok && setIteratorValid(&current1)) {
+        int data1 = setIteratorValue(&current1);
+        // Skip current2 ahead to data1, if current1's data is less add to result
+        setIteratorSeek(&current2, data1);
+        if (!setIteratorValid(&current2) || data1 < setIteratorValue(&current2)) {
+            ok = appendElement(result, data1);
+            count++;
+        } else if (data1 == setIteratorValue(&current2)) {
+            setIteratorAdvance(&current2);  // Skip matching elements
+        }
+        setIteratorAdvance(&current1);  // Move current1 forward
+    }
+    return finishResultSet(result, count, ok);
+}
+
+// Function to compute the difference of two ordered sets (s1 - s2), recording the call
+/**
+ * @brief Computes the difference of two ordered sets (s1 - s2) (see runSetDifference), adding the call to the instrumentation
+ * statistics when they are compiled in.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return The result of runSetDifference.
+ */
+OrderedIntSet* setDifference(OrderedIntSet* s1, OrderedIntSet* s2) {
+    INSTR_BEGIN(probe, pairSize(s1, s2));
+    OrderedIntSet* result = runSetDifference(s1, s2);
+    INSTR_END(probe, INSTR_DIFFERENCE);
+    return result;
+}
+
+// Loser tree entry structure
+/**
+ * @brief Structure holding one input of a k-way merge and its current element.
+ *
+ * - 'key': the current element, or LLONG_MAX once the input is exhausted, so exhausted
+ *   inputs lose every match.
+ * - 'input': index of the input.
+ */
+struct MergeEntry
+{
+    long long key;
+    size_t input;
+};
+
+// Function to read the key of a merge input
+/**
+ * @brief Returns the key of an iterator for a k-way merge.
+ *
+ * @param it The iterator over the input.
+ * @return long long The current element, or LLONG_MAX if the iterator is exhausted.
+ */
+static long long mergeKey(const SetIterator* it) {
+    return setIteratorValid(it) ? (long long)setIteratorValue(it) : LLONG_MAX;
+}
+
+// Function to build a loser tree
+/**
+ * @brief Plays the tournament of the inputs below 'node' and returns its winner.
+ *
+ * The tree has k - 1 inner nodes 1 .. k - 1 and the inputs as leaves k .. 2k - 1, with the
+ * children of node n at 2n and 2n + 1. Each inner node keeps the loser of the match played
+ * there together with its key, so after the winner moves on only the matches on its own
+ * path are replayed, without looking anything up in the inputs.
+ *
+ * @param losers Receives the loser of each inner node.
+ * @param inputs Iterators over the inputs.
+ * @param k Number of inputs.
+ * @param node The node whose subtree is played.
+ * @return struct MergeEntry The input with the smallest key below 'node'.
+ */
+static struct MergeEntry buildLoserTree(struct MergeEntry* losers, const SetIterator* inputs, size_t k, size_t node) {
+    if (node >= k) {
+        struct MergeEntry leaf = { mergeKey(&inputs[node - k]), node - k };
+        return leaf;
+    }
+    struct MergeEntry left = buildLoserTree(losers, inputs, k, 2 * node);
+    struct MergeEntry right = buildLoserTree(losers, inputs, k, 2 * node + 1);
+    if (right.key < left.key) {
+        losers[node] = left;
+        return right;
+    }
+    losers[node] = right;
+    return left;
+}
+
+// Function to bound the size of a union of many sets
+/**
+ * @brief Returns an upper bound on the number of elements of the union of k sets.
+ *
+ * The bound is the sum of the sizes, but never more than the number of values between the
+ * smallest first element and the largest last element, so many heavily overlapping sets do
+ * not reserve room for every copy. The last element of a bitmap is not known cheaply, so a
+ * bitmap input leaves the range open at the top; a packed input keeps its last element in
+ * its last block.
+ *
+ * @param sets The sets (none NULL).
+ * @param k Number of sets.
+ * @return size_t The bound.
+ */
+static size_t unionBound(OrderedIntSet** sets, size_t k) {
+    size_t total = 0;
+    long long low = LLONG_MAX;
+    long long high = LLONG_MIN;
+    for (size_t i = 0; i < k; i++) {
+        if (sets[i]->count == 0) continue;
+        total += (size_t)sets[i]->count;
+        SetIterator it;
+        setIteratorInit(&it, sets[i]);
+        if (setIteratorValue(&it) < low) low = setIteratorValue(&it);
+        long long last = INT_MAX;
+        if (sets[i]->backend == SET_BACKEND_SORTED_ARRAY) {
+            last = sets[i]->array->data[sets[i]->array->size - 1];
+        } else if (sets[i]->backend == SET_BACKEND_PACKED) {
+            last = sets[i]->packed->blocks[sets[i]->packed->blockCount - 1].last;
+        } else if (sets[i]->backend != SET_BACKEND_BITMAP) {
+            last = sets[i]->list->tail->data;
+        }
+        if (last > high) high = last;
+    }
+    if (total == 0) return 0;
+    return (unsigned long long)(high - low) + 1 < total ? (size_t)(high - low) + 1 : total;
+}
+
+// Function to collect the bitmaps of many bitmap sets
+/**
+ * @brief Returns a new array of the bitmaps of 'sets' if every set is a bitmap set.
+ *
+ * @return const struct RoaringBitmap** The bitmaps, or NULL if a set is not a bitmap set or
+ *         memory allocation fails.
+ */
+static const struct RoaringBitmap** collectBitmaps(OrderedIntSet** sets, size_t k) {
+    for (size_t i = 0; i < k; i++) {
+        if (sets[i]->backend != SET_BACKEND_BITMAP) return NULL;
+    }
+    const struct RoaringBitmap** bitmaps = (const struct RoaringBitmap**)malloc(k * sizeof(struct RoaringBitmap*));
+    if (!bitmaps) return NULL;
+    INSTR_COUNT_ALLOC(k * sizeof(struct RoaringBitmap*));
+    for (size_t i = 0; i < k; i++) {
+        bitmaps[i] = sets[i]->bitmap;
+    }
+    return bitmaps;
 }
 
-// Function to add an element to the ordered set
+// Function to compute the union of many sets
 /**
- * @brief Adds an element to the ordered set.
+ * @brief Computes the union of k ordered sets with one k-way merge.
  *
- * This function adds an element to the ordered set while ensuring that the set remains in ascending order
- * and contains no duplicate elements.
+ * The heads of the k inputs play a tournament in a loser tree, so each element costs
+ * O(log k) comparisons and every input is read once. Chaining setUnion instead reads the
+ * growing intermediate result again for every input and builds k - 1 sets that are thrown
+ * away. The result is allocated once (a sorted array result is reserved up front) and uses
+ * the same backend as sets[0]. When every set is a bitmap the chunks are merged instead,
+ * a whole container at a time. None of the input sets are modified.
  *
- * @param set The ordered set to add the element to.
- * @param elem The element to be added to the set.
+ * @param sets The sets to combine.
+ * @param k Number of sets.
  *
- * @return SetStatus indicating whether the element was successfully added, already in the set or an allocation error occurred.
+ * @return A new ordered set containing every element of any of the sets, or NULL if 'sets' or
+ *         one of its sets is NULL, k is 0 or memory allocation fails.
  */
-SetStatus addElement(OrderedIntSet* set, int elem) {
-    if (!set) return ALLOCATION_ERROR;
+static OrderedIntSet* runSetUnionMany(OrderedIntSet** sets, size_t k) {
+    if (!sets || k == 0) return NULL;
+    for (size_t i = 0; i < k; i++) {
+        if (!sets[i]) return NULL;
+    }
 
-    // If the list is empty, simply add the element at the head
-    if (!set->list->head) {
-        appendNode(set->list, elem);
-        set->count++;
-        return NUMBER_ADDED;
+    const struct RoaringBitmap** bitmaps = collectBitmaps(sets, k);
+    if (bitmaps) {
+        struct RoaringBitmap* bitmap = roaringOrMany(bitmaps, k);
+        free(bitmaps);
+        return createBitmapResultSet(bitmap, sets[0]);
     }
 
-    struct Node* current = set->list->head;
-    while (current) {
-        if (current->data == elem) {
-            return NUMBER_ALREADY_IN_SET;  // Element already exists
+    OrderedIntSet* result = createResultSet(sets[0], unionBound(sets, k));
+    SetIterator* inputs = (SetIterator*)malloc(k * sizeof(SetIterator));
+    struct MergeEntry* losers = (struct MergeEntry*)malloc(k * sizeof(struct MergeEntry));
+    int count = 0;
+    int ok = result && inputs && losers;
+
+    if (ok) {
+        INSTR_COUNT_ALLOC(k * (sizeof(SetIterator) + sizeof(struct MergeEntry)));
+        for (size_t i = 0; i < k; i++) {
+            setIteratorInit(&inputs[i], sets[i]);
         }
-        // If we find a node with a greater value, insert before it
-        if (current->data > elem) {
-            insertBefore(set->list, current, elem);
-            set->count++;
-            return NUMBER_ADDED;
+        struct MergeEntry winner = buildLoserTree(losers, inputs, k, 1);
+
+        long long last = LLONG_MIN;
+        while (ok && winner.key != LLONG_MAX) {
+            if (winner.key != last) {  // Equal heads of several inputs are emitted once
+                last = winner.key;
+                ok = appendElement(result, (int)last);
+                count++;
+            }
+            // Move the winner on and replay its matches on the way up to the root
+            size_t input = winner.input;
+            setIteratorAdvance(&inputs[input]);
+            winner.key = mergeKey(&inputs[input]);
+            for (size_t node = (input + k) / 2; node > 0; node /= 2) {
+                if (losers[node].key < winner.key) {
+                    struct MergeEntry loser = winner;
+                    winner = losers[node];
+                    losers[node] = loser;
+                }
+            }
         }
-        current = current->next;
     }
+    free(inputs);
+    free(losers);
+    if (!result) return NULL;
+    return finishResultSet(result, count, ok);
+}
 
-    // If the element is greater than all existing elements, append it at the end
-    appendNode(set->list, elem);
-    set->count++;
-    return NUMBER_ADDED;
+// Function to compute the union of k ordered sets, recording the call
+/**
+ * @brief Computes the union of k ordered sets (see runSetUnionMany), adding the call to the instrumentation
+ * statistics when they are compiled in.
+ *
+ * @param sets The sets to combine.
+ * @param k Number of sets.
+ *
+ * @return The result of runSetUnionMany.
+ */
+OrderedIntSet* setUnionMany(OrderedIntSet** sets, size_t k) {
+    INSTR_BEGIN(probe, totalSize(sets, k));
+    OrderedIntSet* result = runSetUnionMany(sets, k);
+    INSTR_END(probe, INSTR_UNION_MANY);
+    return result;
 }
 
-// Function to delete an ordered set
+// Function to order sets by size
 /**
- * @brief Deletes an ordered set.
+ * @brief qsort comparator putting smaller sets first.
+ */
+static int compareSetSizes(const void* a, const void* b) {
+    int countA = (*(OrderedIntSet* const*)a)->count;
+    int countB = (*(OrderedIntSet* const*)b)->count;
+    return (countA > countB) - (countA < countB);
+}
+
+// Function to keep the elements of a buffer that are in a set
+/**
+ * @brief Compacts a sorted buffer in place to the elements that are also in 'set'.
  *
- * This function deallocates memory for the ordered set and its internal double linked list.
+ * One iterator over the set seeks to each element in turn, so sorted arrays are galloped
+ * through, bitmaps skip whole chunks and lists are walked once.
  *
- * @param set The ordered set to be deleted.
+ * @param data The buffer.
+ * @param n Number of elements in 'data'.
+ * @param set The set to look the elements up in.
+ *
+ * @return size_t Number of elements kept at the front of 'data'.
  */
-void deleteOrderedSet(OrderedIntSet* set) {
-    if (set) {
-        deleteDoubleLinkedList(set->list);
-        free(set);
+static size_t keepElementsIn(int* data, size_t n, const OrderedIntSet* set) {
+    SetIterator it;
+    setIteratorInit(&it, set);
+    size_t kept = 0;
+    for (size_t i = 0; i < n; i++) {
+        setIteratorSeek(&it, data[i]);
+        if (!setIteratorValid(&it)) break;  // No later element can be in the set
+        if (setIteratorValue(&it) == data[i]) data[kept++] = data[i];
     }
+    return kept;
 }
 
-// Function to print an ordered set
+// Function to compute the intersection of many sets
 /**
- * @brief Prints the elements of the ordered set to the standard output.
+ * @brief Computes the intersection of k ordered sets, starting from the smallest of them.
  *
- * This function prints the elements of the ordered set in the format {elem1, elem2, ..., elemN}.
- * If the set is empty, it prints "{}".
+ * The sets are ordered by size. The two smallest are intersected first (with the vectorised
+ * kernel when both are sorted arrays) and each further set, next smallest first, then only
+ * keeps those candidates it holds: they are looked up with galloping seeks and compacted in
+ * place. The candidates never outnumber the smallest set, so they are written straight into
+ * the result when it is a sorted array; other results are filled from a scratch buffer. The
+ * pass stops early once no candidate is left. The result uses the same backend as sets[0]
+ * and none of the input sets are modified. When every set is a bitmap the chunks of the
+ * bitmap with the fewest chunks are intersected with the others a container at a time instead.
  *
- * @param set The ordered set to print.
+ * @param sets The sets to intersect.
+ * @param k Number of sets.
+ *
+ * @return A new ordered set containing the elements that are in every set, or NULL if 'sets' or
+ *         one of its sets is NULL, k is 0 or memory allocation fails.
  */
-void printToStdout(OrderedIntSet* set) {
-    if (!set || !set->list || !set->list->head) {
-        printf("{}\n");
-        return;
+static OrderedIntSet* runSetIntersectionMany(OrderedIntSet** sets, size_t k) {
+    if (!sets || k == 0) return NULL;
+    for (size_t i = 0; i < k; i++) {
+        if (!sets[i]) return NULL;
     }
 
-    printf("{");
-    struct Node* current = set->list->head;
-    while (current) {
-        printf("%d", current->data);
-        if (current->next) printf(", ");
-        current = current->next;
+    const struct RoaringBitmap** bitmaps = collectBitmaps(sets, k);
+    if (bitmaps) {
+        struct RoaringBitmap* bitmap = roaringAndMany(bitmaps, k);
+        free(bitmaps);
+        return createBitmapResultSet(bitmap, sets[0]);
     }
-    printf("}\n");
+
+    OrderedIntSet** bySize = (OrderedIntSet**)malloc(k * sizeof(OrderedIntSet*));
+    if (!bySize) return NULL;
+    INSTR_COUNT_ALLOC(k * sizeof(OrderedIntSet*));
+    memcpy(bySize, sets, k * sizeof(OrderedIntSet*));
+    qsort(bySize, k, sizeof(OrderedIntSet*), compareSetSizes);
+
+    size_t capacity = (size_t)bySize[0]->count;
+    OrderedIntSet* result = createResultSet(sets[0], capacity);
+    int* candidates = NULL;
+    if (result) {
+        candidates = result->array ? result->array->data : (int*)malloc((capacity > 0 ? capacity : 1) * sizeof(int));
+    }
+    if (!result || (!candidates && !result->array)) {
+        free(bySize);
+        deleteOrderedSet(result);
+        return NULL;
+    }
+    if (!result->array) INSTR_COUNT_ALLOC((capacity > 0 ? capacity : 1) * sizeof(int));
+
+    size_t n;
+    size_t next;
+    if (k > 1 && bySize[0]->backend == SET_BACKEND_SORTED_ARRAY && bySize[1]->backend == SET_BACKEND_SORTED_ARRAY) {
+        n = intersectSortedInts(bySize[0]->array->data, bySize[0]->array->size,
+                                bySize[1]->array->data, bySize[1]->array->size, candidates);
+        next = 2;
+    } else {
+        n = copyElements(bySize[0], candidates);
+        next = 1;
+    }
+    for (; n > 0 && next < k; next++) {
+        n = keepElementsIn(candidates, n, bySize[next]);
+    }
+    free(bySize);
+
+    if (result->array) {
+        result->array->size = n;
+        return finishResultSet(result, (int)n, 1);
+    }
+    int ok = 1;
+    for (size_t i = 0; ok && i < n; i++) {
+        ok = appendElement(result, candidates[i]);
+    }
+    free(candidates);
+    return finishResultSet(result, (int)n, ok);
 }
 
-// Function to remove an element from the ordered set
+// Function to compute the intersection of k ordered sets, recording the call
 /**
- * @brief Removes an element from the ordered set.
+ * @brief Computes the intersection of k ordered sets (see runSetIntersectionMany), adding the call to the instrumentation
+ * statistics when they are compiled in.
  *
- * This function removes a specified element from the ordered set. If the element is not found, no changes are made.
+ * @param sets The sets to combine.
+ * @param k Number of sets.
  *
- * @param set The ordered set to remove the element from.
- * @param elem The element to be removed from the set.
+ * @return The result of runSetIntersectionMany.
+ */
+OrderedIntSet* setIntersectionMany(OrderedIntSet** sets, size_t k) {
+    INSTR_BEGIN(probe, totalSize(sets, k));
+    OrderedIntSet* result = runSetIntersectionMany(sets, k);
+    INSTR_END(probe, INSTR_INTERSECTION_MANY);
+    return result;
+}
+
+// Function to count the elements two sets share
+/**
+ * @brief Walks two sets in step and counts their common elements, stopping once 'limit' are found.
  *
- * @return SetStatus indicating whether the element was successfully removed or not found in the set.
+ * The iterator that is behind seeks to the value of the other one, so sorted arrays and
+ * bitmaps skip runs of elements that cannot match instead of visiting each of them.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ * @param limit Number of common elements after which to stop.
+ *
+ * @return size_t The number of common elements found (at most 'limit').
  */
-SetStatus removeElement(OrderedIntSet* set, int elem) {
-    if (!set) return ALLOCATION_ERROR;
+static size_t countCommon(const OrderedIntSet* s1, const OrderedIntSet* s2, size_t limit) {
+    SetIterator current1, current2;
+    setIteratorInit(&current1, s1);
+    setIteratorInit(&current2, s2);
+    size_t count = 0;
 
-    struct Node* current = set->list->head;
-    while (current) {
-        if (current->data == elem) {
-            removeNode(set->list, current);
-            set->count--;
-            return NUMBER_REMOVED;
+    while (count < limit && setIteratorValid(&current1) && setIteratorValid(&current2)) {
+        int data1 = setIteratorValue(&current1);
+        int data2 = setIteratorValue(&current2);
+        if (data1 == data2) {
+            count++;
+            setIteratorAdvance(&current1);
+            setIteratorAdvance(&current2);
+        } else if (data1 < data2) {
+            setIteratorSeek(&current1, data2);
+        } else {
+            setIteratorSeek(&current2, data1);
         }
-        current = current->next;
     }
-    return NUMBER_NOT_IN_SET;
+    return count;
 }
 
+// Function to count the intersection of two ordered sets
 /**
- * @brief Computes the intersection of two ordered sets.
+ * @brief Computes the size of the intersection of s1 and s2 without building it.
  *
- * This function returns a new ordered set containing the elements that are common to both input sets.
- * Neither of the input sets are modified.
+ * Two bitmaps are compared chunk by chunk with a popcount of the common bits, two sorted
+ * arrays use the vectorised count kernel, and other backends are merged with iterators.
+ * Nothing is allocated.
  *
  * @param s1 The first ordered set.
  * @param s2 The second ordered set.
  *
- * @return A new ordered set containing the intersection of s1 and s2 or NULL if memory allocation fails.
+ * @return size_t The number of elements in both sets (0 if either set is NULL).
  */
-OrderedIntSet* setIntersection(OrderedIntSet* s1, OrderedIntSet* s2) {
-    if (!s1 || !s2) return NULL;
+size_t intersectionCount(const OrderedIntSet* s1, const OrderedIntSet* s2) {
+    if (!s1 || !s2) return 0;
+    if (s1->backend == SET_BACKEND_BITMAP && s2->backend == SET_BACKEND_BITMAP) {
+        return roaringAndCardinality(s1->bitmap, s2->bitmap);
+    }
+    if (s1->backend == SET_BACKEND_SORTED_ARRAY && s2->backend == SET_BACKEND_SORTED_ARRAY) {
+        return intersectCountSortedInts(s1->array->data, s1->array->size, s2->array->data, s2->array->size);
+    }
+    return countCommon(s1, s2, (size_t)-1);
+}
 
-    OrderedIntSet* result = createOrderedSet();
-    if (!result) return NULL;
+// Function to count the union of two ordered sets
+/**
+ * @brief Computes the size of the union of s1 and s2 as |s1| + |s2| - |intersection|, without building it.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return size_t The number of elements in either set (0 if either set is NULL).
+ */
+size_t unionCount(const OrderedIntSet* s1, const OrderedIntSet* s2) {
+    if (!s1 || !s2) return 0;
+    return (size_t)s1->count + (size_t)s2->count - intersectionCount(s1, s2);
+}
 
-    struct Node* current1 = s1->list->head;
-    struct Node* current2 = s2->list->head;
+// Function to count the difference of two ordered sets
+/**
+ * @brief Computes the size of s1 - s2 as |s1| - |intersection|, without building the difference.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return size_t The number of elements of s1 that are not in s2 (0 if either set is NULL).
+ */
+size_t differenceCount(const OrderedIntSet* s1, const OrderedIntSet* s2) {
+    if (!s1 || !s2) return 0;
+    return (size_t)s1->count - intersectionCount(s1, s2);
+}
 
-    while (current1 && current2) {
-        if (current1->data == current2->data) {
-            addElement(result, current1->data);  // Add the common element to the result
-            current1 = current1->next;  // Move both pointers forward
-            current2 = current2->next;
-        } else if (current1->data < current2->data) {
-            current1 = current1->next;  // Move current1 forward
-        } else {
-            current2 = current2->next;  // Move current2 forward
-        }
+// Function to check whether one ordered set is contained in another
+/**
+ * @brief Checks whether every element of s1 is also in s2.
+ *
+ * Each element of s1 is looked up by seeking forward in s2, and the check stops at the
+ * first element that is missing. A larger s1 is rejected from the counts alone.
+ *
+ * @param s1 The candidate subset.
+ * @param s2 The candidate superset.
+ *
+ * @return int 1 if s1 is a subset of s2, 0 otherwise (or if either set is NULL).
+ */
+int isSubset(const OrderedIntSet* s1, const OrderedIntSet* s2) {
+    if (!s1 || !s2) return 0;
+    if (s1->count > s2->count) return 0;
+    if (s1->backend == SET_BACKEND_BITMAP && s2->backend == SET_BACKEND_BITMAP) {
+        return roaringIsSubset(s1->bitmap, s2->bitmap);
     }
-    return result;
-}
 
+    SetIterator current1, current2;
+    setIteratorInit(&current1, s1);
+    setIteratorInit(&current2, s2);
+    for (; setIteratorValid(&current1); setIteratorAdvance(&current1)) {
+        int data1 = setIteratorValue(&current1);
+        setIteratorSeek(&current2, data1);
+        if (!setIteratorValid(&current2) || setIteratorValue(&current2) != data1) return 0;
+    }
+    return 1;
+}
 
+// Function to check whether two ordered sets have no element in common
+/**
+ * @brief Checks whether the intersection of s1 and s2 is empty, stopping at the first common element.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return int 1 if the sets share no element, 0 otherwise (or if either set is NULL).
+ */
+int isDisjoint(const OrderedIntSet* s1, const OrderedIntSet* s2) {
+    if (!s1 || !s2) return 0;
+    if (s1->backend == SET_BACKEND_BITMAP && s2->backend == SET_BACKEND_BITMAP) {
+        return !roaringIntersects(s1->bitmap, s2->bitmap);
+    }
+    return countCommon(s1, s2, 1) == 0;
+}
 
-// Function to find the union of two ordered sets
+// Function to check whether two ordered sets hold the same elements
 /**
- * @brief Computes the union of two ordered sets.
+ * @brief Checks whether s1 and s2 contain exactly the same elements, whatever their backends.
  *
- * This function returns a new ordered set containing all unique elements from both input sets.
- * Neither of the input sets are modified.
+ * Sets of different sizes are rejected from the counts; two sorted arrays are compared
+ * with memcmp, and otherwise the sets are walked in step until the first difference.
  *
  * @param s1 The first ordered set.
  * @param s2 The second ordered set.
  *
- * @return A new ordered set containing the union of s1 and s2 or NULL if memory allocation fails.
+ * @return int 1 if the sets are equal, 0 otherwise (or if either set is NULL).
  */
-OrderedIntSet* setUnion(OrderedIntSet* s1, OrderedIntSet* s2) {
-    if (!s1 || !s2) return NULL;
+int setEquals(const OrderedIntSet* s1, const OrderedIntSet* s2) {
+    if (!s1 || !s2) return 0;
+    if (s1->count != s2->count) return 0;
+    if (s1->backend == SET_BACKEND_SORTED_ARRAY && s2->backend == SET_BACKEND_SORTED_ARRAY) {
+        return s1->count == 0 || memcmp(s1->array->data, s2->array->data, (size_t)s1->count * sizeof(int)) == 0;
+    }
+    if (s1->backend == SET_BACKEND_BITMAP && s2->backend == SET_BACKEND_BITMAP) {
+        return roaringIsSubset(s1->bitmap, s2->bitmap);   // Equal sizes: a subset is the whole set
+    }
 
-    OrderedIntSet* result = createOrderedSet();
-    if (!result) return NULL;
+    SetIterator current1, current2;
+    setIteratorInit(&current1, s1);
+    setIteratorInit(&current2, s2);
+    while (setIteratorValid(&current1)) {
+        if (setIteratorValue(&current1) != setIteratorValue(&current2)) return 0;
+        setIteratorAdvance(&current1);
+        setIteratorAdvance(&current2);
+    }
+    return 1;
+}
+
+// Function to unlink a node from a list based set
+/**
+ * @brief Removes a node from the list of a set, dropping its skip index tower and hash entry first
+ * if there are any.
+ *
+ * 'count' is not updated.
+ */
+static void unlinkSetNode(OrderedIntSet* set, struct Node* node) {
+    if (set->index) skipIndexRemove(set->index, node);
+    if (set->hash) nodeHashRemove(set->hash, node->data);
+    removeNode(set->list, node);
+}
+
+// Function to replace the bitmap of a set
+/**
+ * @brief Swaps in 'bitmap' as the storage of a bitmap set and frees the old one.
+ *
+ * @return int 1 on success, 0 if 'bitmap' is NULL (the set is left unchanged).
+ */
+static int replaceBitmap(OrderedIntSet* set, struct RoaringBitmap* bitmap) {
+    if (!bitmap) return 0;
+    deleteRoaringBitmap(set->bitmap);
+    set->bitmap = bitmap;
+    set->count = (int)roaringCardinality(bitmap);
+    return 1;
+}
+
+// Function to replace the storage of a set
+/**
+ * @brief Moves the data structure of 'result' into 'set', frees the old one and deletes 'result'.
+ *
+ * Packed arrays are read-mostly, so the in-place operations on a packed set build the
+ * result with a merge into a new set and swap its storage in.
+ *
+ * @return int 1 on success, 0 if 'result' is NULL (the set is left unchanged).
+ */
+static int replaceStorage(OrderedIntSet* set, OrderedIntSet* result) {
+    if (!result) return 0;
+    swapStorage(set, result);
+    deleteOrderedSet(result);
+    return 1;
+}
+
+// Function to merge a set into a sorted array set
+/**
+ * @brief Adds the elements of src to an array set with one in-place merge.
+ *
+ * The array is grown at most once. A sorted array src is merged backwards from
+ * the end, so every element moves at most once. Any other src is read forwards: the
+ * elements of dst are first moved to the end of the buffer and merged from there to the
+ * front, which never overwrites an element that has not been read yet.
+ *
+ * @return int 1 on success, 0 if memory allocation failed (dst is unchanged).
+ */
+static int unionIntoArray(OrderedIntSet* dst, const OrderedIntSet* src) {
+    size_t n = dst->array->size;
+    size_t extra = (size_t)src->count - intersectionCount(dst, src);
+    if (extra == 0) return 1;
+    // When the array is full, grow it by at least half, so a loop that keeps adding to one set reallocates rarely
+    size_t capacity = dst->array->capacity;
+    if (capacity < n + extra) capacity += capacity / 2;
+    if (capacity < n + extra) capacity = n + extra;
+    if (!detachMapping(dst) || !reserveSortedArray(dst->array, capacity)) return 0;
+    int* data = dst->array->data;
+
+    if (src->backend == SET_BACKEND_SORTED_ARRAY) {
+        const int* other = src->array->data;
+        size_t i = n, j = src->array->size, w = n + extra;
+        while (j > 0) {
+            if (i > 0 && data[i - 1] > other[j - 1]) {
+                data[--w] = data[--i];
+            } else {
+                if (i > 0 && data[i - 1] == other[j - 1]) i--;  // Common element: keep one copy
+                data[--w] = other[--j];
+            }
+        }
+    } else {
+        memmove(data + extra, data, n * sizeof(int));
+        size_t r = extra, end = n + extra, w = 0;
+        SetIterator it;
+        for (setIteratorInit(&it, src); setIteratorValid(&it); setIteratorAdvance(&it)) {
+            int value = setIteratorValue(&it);
+            while (r < end && data[r] < value) data[w++] = data[r++];
+            if (r < end && data[r] == value) r++;
+            data[w++] = value;
+        }
+        // Every element of src has been written, so the rest of dst is already in place
+    }
+    dst->array->size = n + extra;
+    dst->count = (int)(n + extra);
+    return 1;
+}
+
+// Function to add the elements of one set to another in place
+/**
+ * @brief Replaces dst with the union of dst and src, reusing the storage of dst.
+ *
+ * Unlike setUnion no new set is created and the elements of dst are not copied. Sorted
+ * arrays are merged in place after growing the buffer once, list based sets get a node
+ * only for each element of src they did not already hold, and bitmaps add the elements
+ * of src (two bitmaps are combined chunk by chunk and swapped in). A packed dst is
+ * merged with src into new blocks that are swapped in. src is not modified.
+ *
+ * @param dst The set to add to.
+ * @param src The set whose elements are added.
+ *
+ * @return int 1 on success, 0 if a set is NULL or memory allocation failed. After a
+ *         failure dst is still a valid set, but may hold only some of the elements of src.
+ */
+static int runUnionInto(OrderedIntSet* dst, const OrderedIntSet* src) {
+    if (!dst || !src) return 0;
+    if (dst->adaptive) countOperation(dst, 1);
+    if (dst == src || src->count == 0) return 1;
 
-    struct Node* current1 = s1->list->head;
-    struct Node* current2 = s2->list->head;
+    if (dst->backend == SET_BACKEND_SORTED_ARRAY) return unionIntoArray(dst, src);
+    if (dst->backend == SET_BACKEND_PACKED) return replaceStorage(dst, setUnion(dst, (OrderedIntSet*)src));
 
-    while (current1 || current2) {  // Continue while either list has elements
-        if (!current2 || (current1 && current1->data < current2->data)) {
-            addElement(result, current1->data);
-            current1 = current1->next;  // Move current1 forward
-        } else if (!current1 || (current2 && current2->data < current1->data)) {
-            addElement(result, current2->data);
-            current2 = current2->next;  // Move current2 forward
+    SetIterator it;
+    if (dst->backend == SET_BACKEND_BITMAP) {
+        if (src->backend == SET_BACKEND_BITMAP) return replaceBitmap(dst, roaringOr(dst->bitmap, src->bitmap));
+        int ok = 1;
+        for (setIteratorInit(&it, src); ok && setIteratorValid(&it); setIteratorAdvance(&it)) {
+            ok = roaringAdd(dst->bitmap, setIteratorValue(&it)) >= 0;
+        }
+        dst->count = (int)roaringCardinality(dst->bitmap);
+        return ok;
+    }
+
+    // List based: one forward walk of dst, linking a node in for each element it lacks. The
+    // skip index path moves forward with the walk instead of descending for every node.
+    struct SkipPath path;
+    if (dst->index) skipIndexFind(dst->index, dst->list, INT_MIN, &path);
+    struct Node* current = dst->list->head;
+    for (setIteratorInit(&it, src); setIteratorValid(&it); setIteratorAdvance(&it)) {
+        int value = setIteratorValue(&it);
+        while (current && current->data < value) {
+            current = current->next;
+            INSTR_COUNT_NODES(1);
+        }
+        if (current && current->data == value) continue;
+
+        struct Node* node;
+        if (current) {
+            node = insertBefore(dst->list, current, value);
         } else {
-            addElement(result, current1->data);  // Both data are equal
-            current1 = current1->next;
-            current2 = current2->next;
+            node = appendNode(dst->list, value);
+        }
+        if (!node) return 0;
+        if (dst->index) {
+            skipIndexAdvance(dst->index, &path, value);
+            skipIndexInsertAt(dst->index, node, &path);
         }
+        if (dst->hash && !nodeHashInsert(dst->hash, node)) dropListHash(dst);
+        dst->count++;
     }
-    return result;
+    return 1;
 }
 
-// Function to find the difference of two ordered sets (s1 - s2)
+// Function to replace dst with the union of dst and src, recording the call
 /**
- * @brief Computes the difference of two ordered sets (s1 - s2).
+ * @brief Replaces dst with the union of dst and src (see runUnionInto), adding the call to the instrumentation
+ * statistics when they are compiled in.
  *
- * This function returns a new ordered set containing all elements that are in s1 but not in s2.
- * Neither of the input sets are modified.
+ * @param dst The set to add to.
+ * @param src The set whose elements are added.
  *
- * @param s1 The first ordered set.
- * @param s2 The second ordered set.
+ * @return int 1 on success, 0 if a set is NULL or memory allocation failed.
+ */
+int unionInto(OrderedIntSet* dst, const OrderedIntSet* src) {
+    INSTR_BEGIN(probe, pairSize(dst, src));
+    int ok = runUnionInto(dst, src);
+    INSTR_END(probe, INSTR_UNION_INTO);
+    return ok;
+}
+
+// Function to keep only the elements of a set that are (or are not) in another one
+/**
+ * @brief Shared body of intersectInto and subtractInto for every backend of dst but bitmaps
+ * and packed sets.
  *
- * @return A new ordered set containing the difference of s1 and s2 or NULL if memory allocation fails.
+ * dst is walked once while an iterator over src seeks to each of its elements. Arrays are
+ * compacted towards the front, lists unlink the nodes that are dropped.
+ *
+ * @param dst The set to filter.
+ * @param src The set to look the elements of dst up in.
+ * @param keepIfPresent 1 to keep the elements that are in src, 0 to keep those that are not.
+ *
+ * @return int 1 on success, 0 if memory allocation failed (dst is unchanged).
  */
-OrderedIntSet* setDifference(OrderedIntSet* s1, OrderedIntSet* s2) {
-    if (!s1 || !s2) return NULL;
+static int filterInto(OrderedIntSet* dst, const OrderedIntSet* src, int keepIfPresent) {
+    SetIterator it;
+    setIteratorInit(&it, src);
 
-    OrderedIntSet* result = createOrderedSet();
-    if (!result) return NULL;
+    if (dst->backend == SET_BACKEND_SORTED_ARRAY) {
+        if (!detachMapping(dst)) return 0;
+        int* data = dst->array->data;
+        size_t n = dst->array->size, w = 0;
+        for (size_t i = 0; i < n; i++) {
+            setIteratorSeek(&it, data[i]);
+            int present = setIteratorValid(&it) && setIteratorValue(&it) == data[i];
+            if (present == keepIfPresent) data[w++] = data[i];
+        }
+        dst->array->size = w;
+        dst->count = (int)w;
+        return 1;
+    }
 
-    struct Node* current1 = s1->list->head;
-    struct Node* current2 = s2->list->head;
+    struct Node* current = dst->list->head;
+    while (current) {
+        struct Node* next = current->next;
+        setIteratorSeek(&it, current->data);
+        int present = setIteratorValid(&it) && setIteratorValue(&it) == current->data;
+        if (present != keepIfPresent) {
+            unlinkSetNode(dst, current);
+            dst->count--;
+        }
+        current = next;
+    }
+    return 1;
+}
+
+// Function to keep only the elements two sets share, in place
+/**
+ * @brief Replaces dst with the intersection of dst and src, reusing the storage of dst.
+ *
+ * Sorted arrays are compacted in place and list based sets unlink the nodes of elements
+ * that are not in src, so nothing is allocated. Bitmap and packed dst sets are rebuilt.
+ * src is not modified.
+ *
+ * @param dst The set to filter.
+ * @param src The set to intersect with.
+ *
+ * @return int 1 on success, 0 if a set is NULL or memory allocation failed (dst is unchanged).
+ */
+static int runIntersectInto(OrderedIntSet* dst, const OrderedIntSet* src) {
+    if (!dst || !src) return 0;
+    if (dst->adaptive) countOperation(dst, 1);
+    if (dst == src) return 1;
 
-    while (current1) {
-        // Compare current1 to current2, if current1's data is less add to result
-        while (current2 && current1->data > current2->data) {
-            current2 = current2->next;
+    if (dst->backend == SET_BACKEND_PACKED) return replaceStorage(dst, setIntersection(dst, (OrderedIntSet*)src));
+    if (dst->backend != SET_BACKEND_BITMAP) return filterInto(dst, src, 1);
+    if (src->backend == SET_BACKEND_BITMAP) return replaceBitmap(dst, roaringAnd(dst->bitmap, src->bitmap));
+
+    struct RoaringBitmap* result = createRoaringBitmap();
+    if (!result) return 0;
+    SetIterator it;
+    for (setIteratorInit(&it, src); setIteratorValid(&it); setIteratorAdvance(&it)) {
+        int value = setIteratorValue(&it);
+        if (roaringContains(dst->bitmap, value) && roaringAdd(result, value) < 0) {
+            deleteRoaringBitmap(result);
+            return 0;
         }
-        if (!current2 || current1->data < current2->data) {
-            addElement(result, current1->data);
-        } else if (current1->data == current2->data) {
-            current2 = current2->next;  // Skip matching elements
+    }
+    return replaceBitmap(dst, result);
+}
+
+// Function to replace dst with the intersection of dst and src, recording the call
+/**
+ * @brief Replaces dst with the intersection of dst and src (see runIntersectInto), adding the call to the instrumentation
+ * statistics when they are compiled in.
+ *
+ * @param dst The set to keep elements of.
+ * @param src The set whose elements are kept.
+ *
+ * @return int 1 on success, 0 if a set is NULL or memory allocation failed.
+ */
+int intersectInto(OrderedIntSet* dst, const OrderedIntSet* src) {
+    INSTR_BEGIN(probe, pairSize(dst, src));
+    int ok = runIntersectInto(dst, src);
+    INSTR_END(probe, INSTR_INTERSECT_INTO);
+    return ok;
+}
+
+// Function to remove the elements of one set from another, in place
+/**
+ * @brief Replaces dst with dst - src, reusing the storage of dst.
+ *
+ * Sorted arrays are compacted in place, list based sets unlink the nodes of elements
+ * that are in src and bitmaps remove them. A packed dst is rebuilt. src is not modified.
+ *
+ * @param dst The set to remove elements from.
+ * @param src The set of elements to remove.
+ *
+ * @return int 1 on success, 0 if a set is NULL or memory allocation failed. After a
+ *         failure dst is still a valid set, but some elements of src may remain in it.
+ */
+static int runSubtractInto(OrderedIntSet* dst, const OrderedIntSet* src) {
+    if (!dst || !src) return 0;
+    if (dst->adaptive) countOperation(dst, 1);
+    if (src->count == 0) return 1;
+
+    if (dst == src) {
+        // Everything goes: empty the set without reading it while it changes
+        if (dst->backend == SET_BACKEND_BITMAP) return replaceBitmap(dst, createRoaringBitmap());
+        if (dst->backend == SET_BACKEND_PACKED) return replaceStorage(dst, createOrderedSetWithBackend(SET_BACKEND_PACKED));
+        if (dst->backend == SET_BACKEND_SORTED_ARRAY) {
+            if (!detachMapping(dst)) return 0;
+            dst->array->size = 0;
+        } else {
+            while (dst->list->head) unlinkSetNode(dst, dst->list->head);
         }
-        current1 = current1->next;  // Move current1 forward
+        dst->count = 0;
+        return 1;
     }
-    return result;
+
+    if (dst->backend == SET_BACKEND_PACKED) return replaceStorage(dst, setDifference(dst, (OrderedIntSet*)src));
+    if (dst->backend != SET_BACKEND_BITMAP) return filterInto(dst, src, 0);
+    if (src->backend == SET_BACKEND_BITMAP) return replaceBitmap(dst, roaringAndNot(dst->bitmap, src->bitmap));
+
+    int ok = 1;
+    SetIterator it;
+    for (setIteratorInit(&it, src); ok && setIteratorValid(&it); setIteratorAdvance(&it)) {
+        ok = roaringRemove(dst->bitmap, setIteratorValue(&it)) >= 0;
+    }
+    dst->count = (int)roaringCardinality(dst->bitmap);
+    return ok;
+}
+
+// Function to remove the elements of src from dst, recording the call
+/**
+ * @brief Removes the elements of src from dst (see runSubtractInto), adding the call to the instrumentation
+ * statistics when they are compiled in.
+ *
+ * @param dst The set to remove elements from.
+ * @param src The set whose elements are removed.
+ *
+ * @return int 1 on success, 0 if a set is NULL or memory allocation failed.
+ */
+int subtractInto(OrderedIntSet* dst, const OrderedIntSet* src) {
+    INSTR_BEGIN(probe, pairSize(dst, src));
+    int ok = runSubtractInto(dst, src);
+    INSTR_END(probe, INSTR_SUBTRACT_INTO);
+    return ok;
 }
 
+// Function to measure the memory used by a set
+/**
+ * @brief Returns the number of heap bytes allocated for a set and its data structure.
+ *
+ * A list that has a node pool of its own is charged for every slab of the pool, including
+ * nodes not handed out yet; a list on a shared pool is charged only for its own nodes. The
+ * elements of a set read in place from a mapped snapshot are not counted, since they live
+ * in the file mapping rather than on the heap.
+ *
+ * @param set The set to measure.
+ * @return size_t Bytes allocated, 0 if 'set' is NULL.
+ */
+size_t orderedSetMemoryUsage(const OrderedIntSet* set) {
+    if (!set) return 0;
+    size_t bytes = sizeof(OrderedIntSet);
 
+    if (set->list) {
+        bytes += sizeof(struct DoubleLinkedList);
+        if (set->list->ownsPool) {
+            bytes += sizeof(struct NodePool) + set->list->pool->bytesReserved;
+        } else {
+            bytes += (size_t)set->count * sizeof(struct Node);
+        }
+    }
+    if (set->index) {
+        bytes += sizeof(struct SkipIndex);
+        for (const struct SkipTower* tower = set->index->head; tower; tower = tower->forward[0]) {
+            bytes += sizeof(struct SkipTower) + (size_t)tower->height * (sizeof(struct SkipTower*) + sizeof(size_t));
+        }
+    }
+    if (set->array) {
+        bytes += sizeof(struct SortedArray);
+        if (!set->mapping) bytes += set->array->capacity * sizeof(int);
+    }
+    if (set->bitmap) bytes += roaringSizeInBytes(set->bitmap);
+    if (set->packed) bytes += packedArraySizeInBytes(set->packed);
+    bytes += nodeHashSizeInBytes(set->hash);
+    return bytes;
+}
@@ -8,8 +8,8 @@
  * @brief Header file for defining the Ordered Set data type and its operations.<br/>
  *
  * This header file defines the structures and function prototypes for implementing
- * and managing an Ordered Set of integers using a double linked list as the underlying
- * data structure. It includes functions for adding, removing, and performing operations
+ * and managing an Ordered Set of integers using a double linked list or a sorted array
+ * as the underlying data structure. It includes functions for adding, removing, and performing operations
  * like union, intersection and difference on sets.
  *
  * @author
@@ -26,6 +26,25 @@
 #define ORDERED_SET_H
 
 #include "doubleLinkedList.h"
+#include "sortedArray.h"
+#include "skipIndex.h"
+#include "roaringBitmap.h"
+#include "nodeHash.h"
+#include "packedArray.h"
+
+struct SetMapping;
+
+// Default number of elements from which a linked list set builds a membership hash
+#define LIST_HASH_THRESHOLD 64
+
+// Default thresholds of adaptive sets (see AdaptiveThresholds)
+#define ADAPTIVE_SMALL_COUNT 128
+#define ADAPTIVE_BITMAP_SPAN 16
+#define ADAPTIVE_PACKED_COUNT 4096
+#define ADAPTIVE_PACKED_MUTATIONS 2
+#define ADAPTIVE_LIST_COUNT 16384
+#define ADAPTIVE_LIST_MUTATIONS 25
+#define ADAPTIVE_CHECK_INTERVAL 1024
 
 // Enumeration for return values of set operations
 /**
@@ -41,22 +60,146 @@ typedef enum
     ALLOCATION_ERROR         // Memory allocation error
 } SetStatus;
 
+// Enumeration for the storage engine behind a set
+/**
+ * @enum SetBackend
+ * @brief Enum selecting the data structure that stores the elements of an ordered set.
+ */
+typedef enum
+{
+    SET_BACKEND_LINKED_LIST,   // Double linked list, one node per element (default)
+    SET_BACKEND_SORTED_ARRAY,  // Contiguous growable sorted array with binary search lookup
+    SET_BACKEND_SKIP_LIST,     // Double linked list with a skip list index for O(log n) lookup
+    SET_BACKEND_BITMAP,        // Compressed (roaring style) bitmap of array, bitmap and run containers
+    SET_BACKEND_PACKED,        // Read-mostly sorted array of delta encoded, bit packed blocks
+    SET_BACKEND_ADAPTIVE       // Any of the above, switched as the set changes (only passed to the create functions)
+} SetBackend;
+
+// Thresholds that decide the representation of adaptive sets
+/**
+ * @struct AdaptiveThresholds
+ * @brief Tunable limits at which an adaptive set switches to another backend.
+ *
+ * An adaptive set is checked once 'checkInterval' operations, and at least a quarter of its
+ * size, have been counted since the last check, and whenever it is built as a result. It
+ * becomes, in this order of preference:
+ * - a sorted array if it has at most 'smallCount' elements;
+ * - a bitmap if its span (largest minus smallest element plus one) is at most 'bitmapSpan'
+ *   times its size;
+ * - a skip list if it has at least 'listCount' elements and at least 'listMutationPercent'
+ *   percent of the operations counted changed it;
+ * - a packed array if it has at least 'packedCount' elements and at most
+ *   'packedMutationPercent' percent of the operations counted changed it;
+ * - a sorted array otherwise.
+ * A set already in a bitmap, skip list or packed array keeps it until the limit is missed by
+ * a factor of two, so a set near a limit does not switch back and forth. A 'bitmapSpan',
+ * 'listCount' or 'packedCount' of 0 never chooses that backend; a 'checkInterval' of 0 only
+ * chooses when a set is built.
+ */
+typedef struct
+{
+    size_t smallCount;
+    size_t bitmapSpan;
+    size_t packedCount;
+    size_t packedMutationPercent;
+    size_t listCount;
+    size_t listMutationPercent;
+    size_t checkInterval;
+} AdaptiveThresholds;
+
 // Structure for an ordered integer set
 /**
  * @struct OrderedIntSet
  * @brief Structure representing an ordered integer set.
+ *
+ * The linked list backend uses 'list', the sorted array backend uses 'array', the
+ * skip list backend uses 'list' together with 'index', the bitmap backend uses
+ * 'bitmap' and the packed backend uses 'packed'. Unused pointers are NULL. A linked list set that has grown to the list hash
+ * threshold also gets a 'hash' from each element to its node, which answers lookups
+ * without walking the list. Since even containsElement may build the hash, threads must not
+ * look elements up in the same linked list set at once. A sorted array set loaded from a snapshot with
+ * mapOrderedSet has a non-NULL 'mapping' and reads its elements straight from the mapped
+ * file; it gets a heap copy of them before it is first modified.
+ *
+ * A set created with SET_BACKEND_ADAPTIVE has 'adaptive' set, and 'backend' names the
+ * representation it has at the moment. Additions and removals count as 'mutations',
+ * lookups as 'lookups', until the next check of the adaptive thresholds resets them;
+ * 'conversions' counts the times the set has switched backend. As with the list hash,
+ * threads must not look elements up in the same adaptive set at once.
  */
 typedef struct
 {
     struct DoubleLinkedList* list;  // Pointer to a double linked list
+    struct SortedArray* array;      // Pointer to a sorted array
+    struct SkipIndex* index;        // Pointer to a skip list index over 'list'
+    struct RoaringBitmap* bitmap;   // Pointer to a compressed bitmap
+    struct PackedArray* packed;     // Pointer to a packed array
+    struct SetMapping* mapping;     // Mapped snapshot the elements of 'array' are read from, or NULL
+    struct NodeHash* hash;          // Hash from element to node of 'list', or NULL until the list is large
+    SetBackend backend;             // Storage engine the elements are in
     int count;                      // Number of elements in the set
+    int adaptive;                   // 1 if the backend follows the adaptive thresholds
+    size_t mutations;               // Additions and removals since the last adaptive check
+    size_t lookups;                 // Lookups since the last adaptive check
+    size_t conversions;             // Number of times the set switched backend
 } OrderedIntSet;
 
+// Iterator over the elements of a set in ascending order
+/**
+ * @struct SetIterator
+ * @brief Walks the elements of an ordered set regardless of its backend.
+ *
+ * For the linked list backend 'node' is the current node; for the sorted array
+ * backend 'data' points to the current element and 'end' one past the last one;
+ * for the bitmap backend 'useBitmap' is set and 'bitmap' walks the containers.
+ * The packed backend decodes one block at a time into 'buffer' and walks it like a
+ * sorted array; 'packed' is its array and 'block' the next block to decode. Since
+ * 'data' may point into the iterator itself, an iterator must not be copied once
+ * initialised. The set must not be modified while an iterator over it is in use.
+ */
+typedef struct
+{
+    struct Node* node;
+    const int* data;
+    const int* end;
+    int useBitmap;
+    struct RoaringIterator bitmap;
+    const struct PackedArray* packed;
+    size_t block;
+    int buffer[PACKED_BLOCK_SIZE];
+} SetIterator;
+
+// Cursor over the elements of a set that moves in both directions
+/**
+ * @struct SetCursor
+ * @brief Refers to one element of an ordered set and steps to the next or previous one.
+ *
+ * List backends follow the 'next' and 'prev' links of 'node', the sorted array backend keeps
+ * the index of the current element in 'position' and the bitmap backend walks forward with
+ * 'bitmap' and looks up the predecessor of the current element to step back. The packed
+ * backend decodes block 'block' into 'buffer' ('bufferCount' values) and keeps the index of
+ * the current element in the buffer in 'position'. Once a cursor has stepped off either end
+ * it stays invalid until it is positioned again. The set must not be modified while a cursor
+ * over it is in use.
+ */
+typedef struct
+{
+    const OrderedIntSet* set;
+    struct Node* node;
+    size_t position;
+    struct RoaringIterator bitmap;
+    size_t block;
+    int buffer[PACKED_BLOCK_SIZE];
+    int bufferCount;
+    int valid;
+} SetCursor;
+
 /**
  * @brief Functions for managing and manipulating ordered integer sets.
  *
  * This set of functions provides the ability to create, delete and manipulate
- * ordered sets of integers using a double linked list as the underlying data structure.
+ * ordered sets of integers using a double linked list or a sorted array as the underlying
+ * data structure.
  * The operations include adding and removing elements, performing set operations
  * (union, intersection, difference), and printing the contents of a set. The functions
  * ensure that the set remains ordered and does not contain duplicates.
@@ -65,6 +208,21 @@ typedef struct
 // Creates a new ordered integer set
 OrderedIntSet* createOrderedSet();
 
+// Creates a new ordered integer set stored in the given backend
+OrderedIntSet* createOrderedSetWithBackend(SetBackend backend);
+
+// Creates a new list based ordered integer set whose nodes come from a shared node pool
+OrderedIntSet* createOrderedSetWithNodePool(SetBackend backend, struct NodePool* pool);
+
+// Creates a new ordered integer set from an unsorted buffer of integers (sorted array backend)
+OrderedIntSet* createOrderedSetFromArray(const int* data, size_t n);
+
+// Creates a new ordered integer set from an unsorted buffer of integers in the given backend
+OrderedIntSet* createOrderedSetFromArrayWithBackend(const int* data, size_t n, SetBackend backend);
+
+// Creates a new sorted array based ordered integer set that takes ownership of 'array'
+OrderedIntSet* createOrderedSetFromSortedArray(struct SortedArray* array);
+
 // Deletes an ordered integer set and frees all associated memory
 void deleteOrderedSet(OrderedIntSet* set);
 
@@ -74,6 +232,9 @@ SetStatus addElement(OrderedIntSet* set, int elem);
 // Removes an element from the ordered set
 SetStatus removeElement(OrderedIntSet* set, int elem);
 
+// Checks whether an element is in the ordered set
+int containsElement(OrderedIntSet* set, int elem);
+
 // Computes the intersection of two ordered sets
 OrderedIntSet* setIntersection(OrderedIntSet* s1, OrderedIntSet* s2);
 
@@ -83,6 +244,111 @@ OrderedIntSet* setUnion(OrderedIntSet* s1, OrderedIntSet* s2);
 // Computes the difference of two ordered sets (s1 - s2)
 OrderedIntSet* setDifference(OrderedIntSet* s1, OrderedIntSet* s2);
 
+// Computes the union of k ordered sets with one k-way merge
+OrderedIntSet* setUnionMany(OrderedIntSet** sets, size_t k);
+
+// Computes the intersection of k ordered sets, probing the others from the smallest one
+OrderedIntSet* setIntersectionMany(OrderedIntSet** sets, size_t k);
+
+// Adds the elements of src to dst in place (dst = dst | src)
+int unionInto(OrderedIntSet* dst, const OrderedIntSet* src);
+
+// Keeps only the elements of dst that are in src (dst = dst & src)
+int intersectInto(OrderedIntSet* dst, const OrderedIntSet* src);
+
+// Removes the elements of src from dst in place (dst = dst - src)
+int subtractInto(OrderedIntSet* dst, const OrderedIntSet* src);
+
+// Counts the elements in both s1 and s2 without building the intersection
+size_t intersectionCount(const OrderedIntSet* s1, const OrderedIntSet* s2);
+
+// Counts the elements in s1 or s2 without building the union
+size_t unionCount(const OrderedIntSet* s1, const OrderedIntSet* s2);
+
+// Counts the elements of s1 - s2 without building the difference
+size_t differenceCount(const OrderedIntSet* s1, const OrderedIntSet* s2);
+
+// Checks whether every element of s1 is in s2
+int isSubset(const OrderedIntSet* s1, const OrderedIntSet* s2);
+
+// Checks whether s1 and s2 have no element in common
+int isDisjoint(const OrderedIntSet* s1, const OrderedIntSet* s2);
+
+// Checks whether s1 and s2 hold the same elements
+int setEquals(const OrderedIntSet* s1, const OrderedIntSet* s2);
+
+// Writes the elements of the ordered set to 'out' (room for 'count' ints) in ascending order
+size_t copyElements(const OrderedIntSet* set, int* out);
+
+// Positions an iterator on the smallest element of the set
+void setIteratorInit(SetIterator* it, const OrderedIntSet* set);
+
+// Checks whether an iterator still refers to an element
+int setIteratorValid(const SetIterator* it);
+
+// Returns the element an iterator refers to
+int setIteratorValue(const SetIterator* it);
+
+// Moves an iterator to the next element
+void setIteratorAdvance(SetIterator* it);
+
+// Moves an iterator forward to the first element >= value
+void setIteratorSeek(SetIterator* it, int value);
+
+// Positions a cursor on the smallest element of the set
+void setCursorFirst(SetCursor* cursor, const OrderedIntSet* set);
+
+// Positions a cursor on the largest element of the set
+void setCursorLast(SetCursor* cursor, const OrderedIntSet* set);
+
+// Positions a cursor on the first element >= value
+void setCursorSeek(SetCursor* cursor, const OrderedIntSet* set, int value);
+
+// Checks whether a cursor refers to an element
+int setCursorValid(const SetCursor* cursor);
+
+// Returns the element a cursor refers to
+int setCursorValue(const SetCursor* cursor);
+
+// Moves a cursor to the next larger element
+void setCursorNext(SetCursor* cursor);
+
+// Moves a cursor to the next smaller element
+void setCursorPrev(SetCursor* cursor);
+
+// Counts the elements of the set smaller than value (the rank of value)
+size_t setRank(const OrderedIntSet* set, int value);
+
+// Finds the element at 0-based position k in ascending order
+int setSelect(const OrderedIntSet* set, size_t k, int* value);
+
+// Counts the elements in [lo, hi)
+size_t rangeCount(const OrderedIntSet* set, int lo, int hi);
+
+// Writes up to 'max' elements in [lo, hi) to 'out' in ascending order
+size_t rangeExtract(const OrderedIntSet* set, int lo, int hi, int* out, size_t max);
+
+// Sets the number of elements from which linked list sets build a membership hash (0 disables it)
+void setListHashThreshold(size_t count);
+
+// Returns the number of elements from which linked list sets build a membership hash
+size_t getListHashThreshold();
+
+// Sets the thresholds at which adaptive sets switch backend
+void setAdaptiveThresholds(const AdaptiveThresholds* thresholds);
+
+// Reads the thresholds at which adaptive sets switch backend
+void getAdaptiveThresholds(AdaptiveThresholds* thresholds);
+
+// Makes a set follow the adaptive thresholds and moves it to the backend they choose
+void makeSetAdaptive(OrderedIntSet* set);
+
+// Returns the short name of a backend ("list", "array", "skip", "bitmap", "packed" or "adaptive")
+const char* setBackendName(SetBackend backend);
+
+// Returns the number of heap bytes allocated for the ordered set
+size_t orderedSetMemoryUsage(const OrderedIntSet* set);
+
 // Prints the elements of the ordered set to the standard output
 void printToStdout(OrderedIntSet* set);
 
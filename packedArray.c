@@ -0,0 +1,558 @@
+/**
+ * @file packedArray.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the compressed Packed Array data structure used in the Ordered Set.<br/>
+ *
+ * This file contains the functions to build a Packed Array by appending values in order, to
+ * decode its blocks, to search it and to insert and remove single values. A gap is read with
+ * groups of 32: a group of gaps of width w fills exactly w words, and each width has its own
+ * fully unrolled unpacker in which every shift and mask is a constant, so decoding a block
+ * is a straight run of loads, shifts and adds. Inserting or removing a value decodes and repacks
+ * only the block holding it; a full block is split in two.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// include module header files
+#include "packedArray.h"
+#include "logging.h"
+#include "instrumentation.h"
+
+// Smallest number of blocks allocated for a non-empty array
+#define PACKED_MIN_BLOCKS 4
+
+// Gaps unpacked at a time (PACKED_MARK_STRIDE is a multiple of it, so a mark starts a group)
+#define PACKED_GROUP 32
+
+// Function to get the size of the packed gaps of a block
+/**
+ * @brief Returns the words holding the gaps of a block, rounded up to whole groups.
+ *
+ * @param count Number of values of the block.
+ * @param width Bits per gap.
+ * @return size_t Number of 32-bit words.
+ */
+static size_t gapWords(int count, int width) {
+    return (size_t)((count - 1 + PACKED_GROUP - 1) / PACKED_GROUP) * (size_t)width;
+}
+
+// Unpacks gap 'j' of a group of width 'w' and adds it to 'value'; 'w' and 'j' are constants,
+// so the word, the shifts and whether the gap straddles two words are all known at compile time
+#define UNPACK_GAP(w, j) { \
+    const unsigned int bit = (j) * (w); \
+    uint32_t gap = in[bit >> 5] >> (bit & 31); \
+    if ((bit & 31) + (w) > 32) gap |= in[(bit >> 5) + 1] << ((32 - (bit & 31)) & 31); \
+    value += (gap & (uint32_t)(((uint64_t)1 << (w)) - 1)) + 1; \
+    out[j] = (int)value; \
+}
+
+// Defines unpackGroup<w>, which turns the group of 32 gaps of width 'w' at 'in' into the 32
+// values following 'value' and returns the last of them
+#define UNPACKER(w) \
+static uint32_t unpackGroup##w(const uint32_t* in, int* out, uint32_t value) { \
+    UNPACK_GAP(w, 0) UNPACK_GAP(w, 1) UNPACK_GAP(w, 2) UNPACK_GAP(w, 3) \
+    UNPACK_GAP(w, 4) UNPACK_GAP(w, 5) UNPACK_GAP(w, 6) UNPACK_GAP(w, 7) \
+    UNPACK_GAP(w, 8) UNPACK_GAP(w, 9) UNPACK_GAP(w, 10) UNPACK_GAP(w, 11) \
+    UNPACK_GAP(w, 12) UNPACK_GAP(w, 13) UNPACK_GAP(w, 14) UNPACK_GAP(w, 15) \
+    UNPACK_GAP(w, 16) UNPACK_GAP(w, 17) UNPACK_GAP(w, 18) UNPACK_GAP(w, 19) \
+    UNPACK_GAP(w, 20) UNPACK_GAP(w, 21) UNPACK_GAP(w, 22) UNPACK_GAP(w, 23) \
+    UNPACK_GAP(w, 24) UNPACK_GAP(w, 25) UNPACK_GAP(w, 26) UNPACK_GAP(w, 27) \
+    UNPACK_GAP(w, 28) UNPACK_GAP(w, 29) UNPACK_GAP(w, 30) UNPACK_GAP(w, 31) \
+    return value; \
+}
+
+UNPACKER(1) UNPACKER(2) UNPACKER(3) UNPACKER(4) UNPACKER(5) UNPACKER(6) UNPACKER(7) UNPACKER(8)
+UNPACKER(9) UNPACKER(10) UNPACKER(11) UNPACKER(12) UNPACKER(13) UNPACKER(14) UNPACKER(15) UNPACKER(16)
+UNPACKER(17) UNPACKER(18) UNPACKER(19) UNPACKER(20) UNPACKER(21) UNPACKER(22) UNPACKER(23) UNPACKER(24)
+UNPACKER(25) UNPACKER(26) UNPACKER(27) UNPACKER(28) UNPACKER(29) UNPACKER(30) UNPACKER(31) UNPACKER(32)
+
+// Group unpackers by gap width
+typedef uint32_t (*GroupUnpacker)(const uint32_t* in, int* out, uint32_t value);
+static const GroupUnpacker groupUnpackers[33] = {
+    NULL,
+    unpackGroup1, unpackGroup2, unpackGroup3, unpackGroup4, unpackGroup5, unpackGroup6, unpackGroup7, unpackGroup8,
+    unpackGroup9, unpackGroup10, unpackGroup11, unpackGroup12, unpackGroup13, unpackGroup14, unpackGroup15, unpackGroup16,
+    unpackGroup17, unpackGroup18, unpackGroup19, unpackGroup20, unpackGroup21, unpackGroup22, unpackGroup23, unpackGroup24,
+    unpackGroup25, unpackGroup26, unpackGroup27, unpackGroup28, unpackGroup29, unpackGroup30, unpackGroup31, unpackGroup32
+};
+
+// Function to pack a block
+/**
+ * @brief Packs 'count' ascending values into a block.
+ *
+ * The gap width is the number of bits of the largest gap. 'start' is left alone
+ * and the block is only written once the gap buffer has been allocated.
+ *
+ * @param block The block to fill.
+ * @param values Strictly ascending values.
+ * @param count Number of values, 1 to PACKED_BLOCK_SIZE.
+ * @return int 1 on success, 0 if memory allocation failed (the block is unchanged).
+ */
+static int encodeBlock(struct PackedBlock* block, const int* values, int count) {
+    uint32_t largest = 0;
+    for (int i = 1; i < count; i++) {
+        uint32_t gap = (uint32_t)values[i] - (uint32_t)values[i - 1] - 1;
+        if (gap > largest) largest = gap;
+    }
+    int width = 0;
+    while (width < 32 && (largest >> width) != 0) {
+        width++;
+    }
+
+    uint32_t* gaps = NULL;
+    if (width > 0) {
+        size_t words = gapWords(count, width);
+        gaps = (uint32_t*)calloc(words, sizeof(uint32_t));
+        if (!gaps) {
+            LOG_ERROR("Memory allocation failed.");
+            return 0;
+        }
+        INSTR_COUNT_ALLOC(words * sizeof(uint32_t));
+        size_t bit = 0;
+        for (int i = 1; i < count; i++) {
+            uint32_t gap = (uint32_t)values[i] - (uint32_t)values[i - 1] - 1;
+            unsigned int shift = (unsigned int)(bit & 31);
+            gaps[bit >> 5] |= gap << shift;
+            if (shift + width > 32) gaps[(bit >> 5) + 1] |= gap >> (32 - shift);
+            bit += (size_t)width;
+        }
+    }
+
+    for (int m = 0; m < PACKED_MARKS; m++) {
+        block->mark[m] = (m * PACKED_MARK_STRIDE < count) ? values[m * PACKED_MARK_STRIDE] : values[count - 1];
+    }
+    block->last = values[count - 1];
+    block->count = (uint16_t)count;
+    block->width = (uint8_t)width;
+    block->gaps = gaps;
+    return 1;
+}
+
+// Function to unpack part of a block
+/**
+ * @brief Decodes the values of a block from position 'from' to its end.
+ *
+ * @param block The block.
+ * @param from A multiple of PACKED_MARK_STRIDE smaller than the block count.
+ * @param out Receives count - from values.
+ * @return int Number of values written.
+ */
+static int decodeRange(const struct PackedBlock* block, int from, int* out) {
+    int n = block->count - from;
+    uint32_t value = (uint32_t)block->mark[from / PACKED_MARK_STRIDE];
+    out[0] = (int)value;
+
+    if (block->width == 0) {
+        for (int i = 1; i < n; i++) {
+            out[i] = (int)(value + (uint32_t)i);
+        }
+        return n;
+    }
+
+    // Whole groups go straight to 'out' while they fit, the last one through a buffer
+    GroupUnpacker unpack = groupUnpackers[block->width];
+    const uint32_t* words = block->gaps + (size_t)(from / PACKED_GROUP) * block->width;
+    int i = 1;
+    for (; i + PACKED_GROUP <= n; i += PACKED_GROUP) {
+        value = unpack(words, out + i, value);
+        words += block->width;
+    }
+    if (i < n) {
+        int rest[PACKED_GROUP];
+        unpack(words, rest, value);
+        memcpy(out + i, rest, (size_t)(n - i) * sizeof(int));
+    }
+    return n;
+}
+
+// Function to create an empty packed array
+/**
+ * @brief Creates a new empty Packed Array.
+ *
+ * @return struct PackedArray* Pointer to the new Packed Array or NULL if memory allocation fails.
+ */
+struct PackedArray* createPackedArray() {
+    struct PackedArray* array = (struct PackedArray*)malloc(sizeof(struct PackedArray));
+    if (!array) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    INSTR_COUNT_ALLOC(sizeof(struct PackedArray));
+    array->blocks = NULL;
+    array->blockCount = 0;
+    array->blockCapacity = 0;
+    array->size = 0;
+    array->pending = NULL;
+    array->pendingCount = 0;
+    return array;
+}
+
+// Function to delete a packed array
+/**
+ * @brief Deletes a Packed Array and frees its memory.
+ *
+ * @param array Pointer to the Packed Array to delete.
+ */
+void deletePackedArray(struct PackedArray* array) {
+    if (!array) return;
+    for (size_t b = 0; b < array->blockCount; b++) {
+        free(array->blocks[b].gaps);
+    }
+    free(array->blocks);
+    free(array->pending);
+    free(array);
+}
+
+// Function to make room for one more block
+/**
+ * @brief Doubles the block table of the Packed Array when it is full.
+ *
+ * @param array Pointer to the Packed Array.
+ * @return int 1 if there is room for one more block, 0 if memory allocation failed.
+ */
+static int growBlocks(struct PackedArray* array) {
+    if (array->blockCount < array->blockCapacity) return 1;
+    size_t capacity = array->blockCapacity ? array->blockCapacity * 2 : PACKED_MIN_BLOCKS;
+    struct PackedBlock* blocks = (struct PackedBlock*)realloc(array->blocks, capacity * sizeof(struct PackedBlock));
+    if (!blocks) {
+        LOG_ERROR("Memory allocation failed.");
+        return 0;
+    }
+    INSTR_COUNT_ALLOC((capacity - array->blockCapacity) * sizeof(struct PackedBlock));
+    array->blocks = blocks;
+    array->blockCapacity = capacity;
+    return 1;
+}
+
+// Function to pack the pending values
+/**
+ * @brief Packs the pending values into a new block at the end of the array.
+ *
+ * @param array Pointer to the Packed Array.
+ * @return int 1 on success, 0 if memory allocation failed (the values stay pending).
+ */
+static int packPending(struct PackedArray* array) {
+    if (array->pendingCount == 0) return 1;
+    if (!growBlocks(array)) return 0;
+
+    struct PackedBlock* block = &array->blocks[array->blockCount];
+    if (!encodeBlock(block, array->pending, array->pendingCount)) return 0;
+    block->start = array->size - (size_t)array->pendingCount;
+    array->blockCount++;
+    array->pendingCount = 0;
+    return 1;
+}
+
+// Function to append a value
+/**
+ * @brief Appends a value that is larger than every value of the array.
+ *
+ * Values are collected until a block is full and then packed together. When appending
+ * starts again after a flush, a last block that is not full is unpacked to collect more.
+ *
+ * @param array Pointer to the Packed Array.
+ * @param value The value to append.
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+int packedArrayAppend(struct PackedArray* array, int value) {
+    if (!array->pending) {
+        array->pending = (int*)malloc(PACKED_BLOCK_SIZE * sizeof(int));
+        if (!array->pending) {
+            LOG_ERROR("Memory allocation failed.");
+            return 0;
+        }
+        INSTR_COUNT_ALLOC(PACKED_BLOCK_SIZE * sizeof(int));
+        struct PackedBlock* last = array->blockCount ? &array->blocks[array->blockCount - 1] : NULL;
+        if (last && last->count < PACKED_BLOCK_SIZE) {
+            array->pendingCount = decodeRange(last, 0, array->pending);
+            free(last->gaps);
+            array->blockCount--;
+        }
+    }
+    if (array->pendingCount == PACKED_BLOCK_SIZE && !packPending(array)) return 0;
+
+    array->pending[array->pendingCount++] = value;
+    array->size++;
+    return 1;
+}
+
+// Function to finish a run of appends
+/**
+ * @brief Packs the values still pending after a run of appends and frees the pending buffer.
+ *
+ * @param array Pointer to the Packed Array.
+ * @return int 1 on success, 0 if memory allocation failed (the values stay pending).
+ */
+int packedArrayFlush(struct PackedArray* array) {
+    if (!packPending(array)) return 0;
+    free(array->pending);
+    array->pending = NULL;
+    return 1;
+}
+
+// Function to find the block a value belongs to
+/**
+ * @brief Binary searches the last values of the blocks.
+ *
+ * @param array Pointer to the Packed Array.
+ * @param value The value searched for.
+ * @return size_t Index of the first block whose last value is >= value, or blockCount if there is none.
+ */
+size_t packedArrayFindBlock(const struct PackedArray* array, int value) {
+    size_t low = 0;
+    size_t high = array->blockCount;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (array->blocks[mid].last < value) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Function to decode a block from a value on
+/**
+ * @brief Decodes a block starting from its last mark that is <= 'value'.
+ *
+ * @param array Pointer to the Packed Array.
+ * @param block Index of the block.
+ * @param value Values of the block below the last mark <= value are skipped (INT_MIN decodes all).
+ * @param out Receives the values (room for PACKED_BLOCK_SIZE ints).
+ * @param from Receives the position in the block of the first value written (may be NULL).
+ * @return int Number of values written.
+ */
+int packedArrayDecode(const struct PackedArray* array, size_t block, int value, int* out, int* from) {
+    const struct PackedBlock* b = &array->blocks[block];
+    int m = 0;
+    while (m + 1 < PACKED_MARKS && (m + 1) * PACKED_MARK_STRIDE < b->count && b->mark[m + 1] <= value) {
+        m++;
+    }
+    if (from) *from = m * PACKED_MARK_STRIDE;
+    return decodeRange(b, m * PACKED_MARK_STRIDE, out);
+}
+
+// Function to test a value
+/**
+ * @brief Checks whether a value is in the array, decoding at most PACKED_MARK_STRIDE values.
+ *
+ * @param array Pointer to the Packed Array.
+ * @param value The value to look for.
+ * @return int 1 if present, 0 otherwise.
+ */
+int packedArrayContains(const struct PackedArray* array, int value) {
+    size_t b = packedArrayFindBlock(array, value);
+    if (b == array->blockCount || value < array->blocks[b].mark[0]) return 0;
+
+    int values[PACKED_BLOCK_SIZE];
+    int n = packedArrayDecode(array, b, value, values, NULL);
+    for (int i = 0; i < n && values[i] <= value; i++) {
+        if (values[i] == value) return 1;
+    }
+    return 0;
+}
+
+// Function to count the values below a value
+/**
+ * @brief Returns the number of values of the array that are smaller than 'value'.
+ *
+ * @param array Pointer to the Packed Array.
+ * @param value The value to rank.
+ * @return size_t Number of values < value.
+ */
+size_t packedArrayRank(const struct PackedArray* array, int value) {
+    size_t b = packedArrayFindBlock(array, value);
+    if (b == array->blockCount) return array->size;
+
+    int values[PACKED_BLOCK_SIZE];
+    int from;
+    int n = packedArrayDecode(array, b, value, values, &from);
+    int i = 0;
+    while (i < n && values[i] < value) {
+        i++;
+    }
+    return array->blocks[b].start + (size_t)(from + i);
+}
+
+// Function to find the value at a position
+/**
+ * @brief Finds the value at 0-based position 'k' with a binary search of the block starts.
+ *
+ * @param array Pointer to the Packed Array.
+ * @param k Position of the value.
+ * @param value Receives the value.
+ * @return int 1 if the array holds more than k values, 0 otherwise ('value' is not written).
+ */
+int packedArraySelect(const struct PackedArray* array, size_t k, int* value) {
+    if (k >= array->size) return 0;
+
+    size_t low = 0;
+    size_t high = array->blockCount;
+    while (high - low > 1) {
+        size_t mid = low + (high - low) / 2;
+        if (array->blocks[mid].start <= k) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    const struct PackedBlock* block = &array->blocks[low];
+    int position = (int)(k - block->start);
+    int values[PACKED_BLOCK_SIZE];
+    int from = position / PACKED_MARK_STRIDE * PACKED_MARK_STRIDE;
+    decodeRange(block, from, values);
+    *value = values[position - from];
+    return 1;
+}
+
+// Function to move the block starts after an insert or remove
+/**
+ * @brief Adds 'delta' to the start of every block from 'first' on.
+ */
+static void shiftStarts(struct PackedArray* array, size_t first, int delta) {
+    for (size_t b = first; b < array->blockCount; b++) {
+        array->blocks[b].start += (size_t)(long)delta;
+    }
+}
+
+// Function to insert a value
+/**
+ * @brief Inserts a value by unpacking its block, adding the value and packing the block again.
+ *
+ * A value beyond the last full block starts a new block; a value for any other full block
+ * splits it into two halves.
+ *
+ * @param array Pointer to the Packed Array.
+ * @param value The value to insert.
+ * @return int 1 if the value was added, 0 if it was already present, -1 if memory allocation failed.
+ */
+int packedArrayInsert(struct PackedArray* array, int value) {
+    size_t b = packedArrayFindBlock(array, value);
+    if (b == array->blockCount) {
+        struct PackedBlock* last = b ? &array->blocks[b - 1] : NULL;
+        if (!last || last->count == PACKED_BLOCK_SIZE) {
+            // Start a new block of one value
+            if (!growBlocks(array)) return -1;
+            struct PackedBlock* block = &array->blocks[b];
+            if (!encodeBlock(block, &value, 1)) return -1;
+            block->start = array->size;
+            array->blockCount++;
+            array->size++;
+            return 1;
+        }
+        b--;
+    }
+
+    struct PackedBlock* block = &array->blocks[b];
+    int values[PACKED_BLOCK_SIZE + 1];
+    int n = decodeRange(block, 0, values);
+    int pos = 0;
+    while (pos < n && values[pos] < value) {
+        pos++;
+    }
+    if (pos < n && values[pos] == value) return 0;
+    memmove(values + pos + 1, values + pos, (size_t)(n - pos) * sizeof(int));
+    values[pos] = value;
+    n++;
+
+    uint32_t* oldGaps = block->gaps;
+    if (n <= PACKED_BLOCK_SIZE) {
+        if (!encodeBlock(block, values, n)) return -1;
+    } else {
+        // Split the full block: the upper half moves to a new block after it
+        if (!growBlocks(array)) return -1;
+        block = &array->blocks[b];
+        struct PackedBlock lower = *block;
+        struct PackedBlock upper;
+        int half = n / 2;
+        if (!encodeBlock(&lower, values, half)) return -1;
+        if (!encodeBlock(&upper, values + half, n - half)) {
+            free(lower.gaps);
+            return -1;
+        }
+        upper.start = block->start + (size_t)half;
+        memmove(block + 2, block + 1, (array->blockCount - b - 1) * sizeof(struct PackedBlock));
+        block[0] = lower;
+        block[1] = upper;
+        array->blockCount++;
+        b++;
+    }
+    free(oldGaps);
+    shiftStarts(array, b + 1, 1);
+    array->size++;
+    return 1;
+}
+
+// Function to remove a value
+/**
+ * @brief Removes a value by unpacking its block, dropping the value and packing the block again.
+ *
+ * A block left empty is removed from the table.
+ *
+ * @param array Pointer to the Packed Array.
+ * @param value The value to remove.
+ * @return int 1 if the value was removed, 0 if it was not present, -1 if memory allocation failed.
+ */
+int packedArrayRemove(struct PackedArray* array, int value) {
+    size_t b = packedArrayFindBlock(array, value);
+    if (b == array->blockCount || value < array->blocks[b].mark[0]) return 0;
+
+    struct PackedBlock* block = &array->blocks[b];
+    int values[PACKED_BLOCK_SIZE];
+    int n = decodeRange(block, 0, values);
+    int pos = 0;
+    while (pos < n && values[pos] < value) {
+        pos++;
+    }
+    if (pos == n || values[pos] != value) return 0;
+
+    if (n == 1) {
+        free(block->gaps);
+        memmove(block, block + 1, (array->blockCount - b - 1) * sizeof(struct PackedBlock));
+        array->blockCount--;
+        shiftStarts(array, b, -1);
+    } else {
+        memmove(values + pos, values + pos + 1, (size_t)(n - pos - 1) * sizeof(int));
+        uint32_t* oldGaps = block->gaps;
+        if (!encodeBlock(block, values, n - 1)) return -1;
+        free(oldGaps);
+        shiftStarts(array, b + 1, -1);
+    }
+    array->size--;
+    return 1;
+}
+
+// Function to get the memory used by a packed array
+/**
+ * @brief Returns the heap bytes used by a Packed Array.
+ *
+ * @param array Pointer to the Packed Array.
+ * @return size_t Bytes used by the structure, its block table, the packed gaps and the pending buffer.
+ */
+size_t packedArraySizeInBytes(const struct PackedArray* array) {
+    size_t bytes = sizeof(struct PackedArray) + array->blockCapacity * sizeof(struct PackedBlock);
+    for (size_t b = 0; b < array->blockCount; b++) {
+        const struct PackedBlock* block = &array->blocks[b];
+        if (block->gaps) bytes += gapWords(block->count, block->width) * sizeof(uint32_t);
+    }
+    if (array->pending) bytes += PACKED_BLOCK_SIZE * sizeof(int);
+    return bytes;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file packedArray.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the compressed Packed Array data structure used in the Ordered Set.<br/>
+ *
+ * This header file defines the structures and function prototypes for a read-mostly sorted
+ * sequence of distinct integers stored in blocks of up to PACKED_BLOCK_SIZE values. Each
+ * block keeps its first value and packs the gaps between consecutive values with the fewest
+ * bits that hold its largest gap, so dense or evenly spread values take one or two bytes each
+ * and a run of consecutive values takes none. The first and last value of every block, and
+ * every PACKED_MARK_STRIDE-th value inside it, stay uncompressed as a small skip index, so a
+ * search decodes at most PACKED_MARK_STRIDE values of a single block.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef PACKED_ARRAY_H
+#define PACKED_ARRAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Largest number of values in a block
+#define PACKED_BLOCK_SIZE 128
+
+// Distance between the values of a block kept uncompressed
+#define PACKED_MARK_STRIDE 32
+
+// Number of uncompressed values per block
+#define PACKED_MARKS (PACKED_BLOCK_SIZE / PACKED_MARK_STRIDE)
+
+// Packed block structure
+/**
+ * @brief Structure representing up to PACKED_BLOCK_SIZE consecutive values of a Packed Array.
+ *
+ * - 'mark': mark[m] is the value at position m * PACKED_MARK_STRIDE of the block (unused past 'count').
+ * - 'last': the largest value of the block.
+ * - 'count': number of values, 1 to PACKED_BLOCK_SIZE.
+ * - 'width': bits per gap, 0 to 32; 0 means the values are consecutive.
+ * - 'start': position of the first value of the block in the whole array.
+ * - 'gaps': gap i, the distance between values i and i + 1 minus one, in bits i * width to
+ *   (i + 1) * width - 1, padded to a whole number of groups of 32 gaps; NULL when 'width' is 0.
+ */
+struct PackedBlock
+{
+    int mark[PACKED_MARKS];
+    int last;
+    uint16_t count;
+    uint8_t width;
+    size_t start;
+    uint32_t* gaps;
+};
+
+// Packed array structure
+/**
+ * @brief Structure representing a sorted sequence of distinct integers in packed blocks.
+ *
+ * - 'blocks': 'blockCount' blocks in ascending order, room for 'blockCapacity'.
+ * - 'size': number of values, including the pending ones.
+ * - 'pending': values appended since the last full block, not yet packed (NULL if there are none).
+ * - 'pendingCount': number of pending values.
+ */
+struct PackedArray
+{
+    struct PackedBlock* blocks;
+    size_t blockCount;
+    size_t blockCapacity;
+    size_t size;
+    int* pending;
+    int pendingCount;
+};
+
+// Function declarations
+/**
+ * @brief Function declarations for Packed Array operations.
+ *
+ * - 'createPackedArray': Creates a new empty Packed Array.
+ * - 'deletePackedArray': Deletes a Packed Array and frees its memory.
+ * - 'packedArrayAppend': Appends a value larger than every value in the array; returns 0 if memory allocation fails.
+ * - 'packedArrayFlush': Packs the pending values after a run of appends; returns 0 if memory allocation fails.
+ * - 'packedArrayFindBlock': Finds the first block whose last value is >= 'value' (blockCount if there is none).
+ * - 'packedArrayDecode': Decodes a block into 'out' (room for PACKED_BLOCK_SIZE ints) from the last mark <= 'value'
+ *   (INT_MIN for the whole block); returns the number of values written and their first position in the block.
+ * - 'packedArrayContains': Checks whether a value is in the array.
+ * - 'packedArrayInsert' / 'packedArrayRemove': Return 1 if the array changed, 0 if not, -1 on allocation failure.
+ * - 'packedArrayRank': Number of values smaller than 'value'.
+ * - 'packedArraySelect': The value at a 0-based position; returns 0 if there are not enough values.
+ * - 'packedArraySizeInBytes': Heap bytes used by the array.
+ *
+ * All functions but packedArrayAppend and packedArrayFlush expect an array without pending values.
+ */
+struct PackedArray* createPackedArray();
+void deletePackedArray(struct PackedArray* array);
+int packedArrayAppend(struct PackedArray* array, int value);
+int packedArrayFlush(struct PackedArray* array);
+size_t packedArrayFindBlock(const struct PackedArray* array, int value);
+int packedArrayDecode(const struct PackedArray* array, size_t block, int value, int* out, int* from);
+int packedArrayContains(const struct PackedArray* array, int value);
+int packedArrayInsert(struct PackedArray* array, int value);
+int packedArrayRemove(struct PackedArray* array, int value);
+size_t packedArrayRank(const struct PackedArray* array, int value);
+int packedArraySelect(const struct PackedArray* array, size_t k, int* value);
+size_t packedArraySizeInBytes(const struct PackedArray* array);
+
+#endif // PACKED_ARRAY_H
@@ -0,0 +1,389 @@
+/**
+ * @file parallelSetOps.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the multi-threaded set operations.<br/>
+ *
+ * The inputs are split at merge-path positions: for the k-th of P partitions a binary
+ * search finds how many of the first k * (na + nb) / P merged elements come from each
+ * input, and the smallest value at that position becomes the splitter. Both inputs are
+ * then cut at the lower bound of each splitter, so equal values always land in the same
+ * partition and every partition holds about (na + nb) / P elements. Partitions are
+ * processed in two rounds on the Thread Pool: the kernel writes each partial result to
+ * its own slice of a scratch buffer, then, after a prefix sum over the partial sizes,
+ * every slice is copied to its final place. No serial merge of the partial results is needed.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// include module header files
+#include "parallelSetOps.h"
+#include "setKernels.h"
+#include "threadPool.h"
+#include "logging.h"
+
+// Signature shared by the set operation kernels
+typedef size_t (*SetKernel)(const int* a, size_t na, const int* b, size_t nb, int* out);
+
+// Enumeration for the parallel operations
+typedef enum
+{
+    PARALLEL_INTERSECTION,
+    PARALLEL_UNION,
+    PARALLEL_DIFFERENCE
+} ParallelOperation;
+
+// State of one parallel operation
+/**
+ * @brief Structure describing the partitions of one parallel set operation.
+ *
+ * Partition p covers a[aBounds[p] .. aBounds[p + 1]) and b[bBounds[p] .. bBounds[p + 1]).
+ * Its partial result is written at scratch + scratchOffsets[p], holds partSizes[p] elements
+ * and is copied to out + outOffsets[p].
+ */
+struct ParallelJob
+{
+    SetKernel kernel;
+    ParallelOperation operation;
+    const int* a;
+    const int* b;
+    size_t* aBounds;
+    size_t* bBounds;
+    size_t* scratchOffsets;
+    size_t* partSizes;
+    size_t* outOffsets;
+    int* scratch;
+    int* out;
+};
+
+static int parallelThreads = 0;                 // Configured thread count, 0 = automatic
+static struct ThreadPool* parallelPool = NULL;  // Pool shared by all parallel operations
+static int parallelPoolThreads = 0;             // Thread count 'parallelPool' was created with
+static ThreadMutex parallelLock;                // Guards the three above and every use of the pool
+static ThreadOnce parallelLockOnce = THREAD_ONCE_INIT;
+
+// Function to create the module lock
+static void initParallelLock() {
+    threadMutexInit(&parallelLock);
+}
+
+// Function to take the module lock
+/**
+ * @brief Locks 'parallelLock', creating it on first use.
+ *
+ * Held from fetching the pool to the end of its last batch, so a pool is never created
+ * twice, nor deleted or resized while an operation on another thread is using it.
+ */
+static void lockParallel() {
+    threadOnce(&parallelLockOnce, initParallelLock);
+    threadMutexLock(&parallelLock);
+}
+
+// Function to set the thread count
+/**
+ * @brief Sets the number of threads used by the parallel operations.
+ *
+ * A running pool with a different size is stopped and recreated on next use.
+ *
+ * @param threads Number of threads, or 0 for one per logical processor.
+ */
+void setParallelThreadCount(int threads) {
+    lockParallel();
+    parallelThreads = threads > 0 ? threads : 0;
+    if (parallelPool && parallelPoolThreads != getParallelThreadCount()) {
+        deleteThreadPool(parallelPool);
+        parallelPool = NULL;
+        parallelPoolThreads = 0;
+    }
+    threadMutexUnlock(&parallelLock);
+}
+
+// Function to read the thread count
+/**
+ * @brief Returns the number of threads the parallel operations will use.
+ */
+int getParallelThreadCount() {
+    return parallelThreads > 0 ? parallelThreads : threadHardwareConcurrency();
+}
+
+// Function to stop the worker threads
+/**
+ * @brief Deletes the Thread Pool used by the parallel operations.
+ */
+void shutdownParallelSetOps() {
+    lockParallel();
+    deleteThreadPool(parallelPool);
+    parallelPool = NULL;
+    parallelPoolThreads = 0;
+    threadMutexUnlock(&parallelLock);
+}
+
+// Function to get the shared thread pool
+/**
+ * @brief Returns the Thread Pool, creating it with the configured thread count on first use.
+ *
+ * The caller holds 'parallelLock'.
+ *
+ * @return struct ThreadPool* The pool, or NULL if it could not be created.
+ */
+static struct ThreadPool* getParallelPool() {
+    if (!parallelPool) {
+        parallelPoolThreads = getParallelThreadCount();
+        parallelPool = createThreadPool(parallelPoolThreads);
+    }
+    return parallelPool;
+}
+
+// Function to find the first position of a value in a sorted buffer
+/**
+ * @brief Returns the first index of a[0 .. n) whose element is >= 'value'.
+ */
+static size_t lowerBound(const int* a, size_t n, int value) {
+    size_t first = 0;
+    while (n > 0) {
+        size_t half = n / 2;
+        if (a[first + half] < value) {
+            first += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+    return first;
+}
+
+// Function to split a merge at a given rank
+/**
+ * @brief Finds how many of the first 'd' elements of the merge of a and b come from a.
+ *
+ * Ties are taken from 'a' first.
+ *
+ * @return size_t Number of elements taken from 'a'; the other d - i come from 'b'.
+ */
+static size_t coRank(const int* a, size_t na, const int* b, size_t nb, size_t d) {
+    size_t low = d > nb ? d - nb : 0;
+    size_t high = d < na ? d : na;
+    while (low < high) {
+        size_t i = low + (high - low) / 2;
+        if (a[i] <= b[d - i - 1]) {
+            low = i + 1;
+        } else {
+            high = i;
+        }
+    }
+    return low;
+}
+
+// Function to cut both inputs into partitions
+/**
+ * @brief Fills aBounds[0 .. partitions] and bBounds[0 .. partitions] with the partition limits.
+ */
+static void splitInputs(struct ParallelJob* job, size_t na, size_t nb, int partitions) {
+    job->aBounds[0] = 0;
+    job->bBounds[0] = 0;
+    for (int p = 1; p < partitions; p++) {
+        size_t d = (na + nb) * (size_t)p / (size_t)partitions;
+        size_t i = coRank(job->a, na, job->b, nb, d);
+        size_t j = d - i;
+
+        size_t aBound = na;
+        size_t bBound = nb;
+        if (i < na || j < nb) {
+            // Cut both inputs at the smallest value not yet merged
+            int splitter = (j == nb || (i < na && job->a[i] < job->b[j])) ? job->a[i] : job->b[j];
+            aBound = lowerBound(job->a, na, splitter);
+            bBound = lowerBound(job->b, nb, splitter);
+        }
+        job->aBounds[p] = aBound > job->aBounds[p - 1] ? aBound : job->aBounds[p - 1];
+        job->bBounds[p] = bBound > job->bBounds[p - 1] ? bBound : job->bBounds[p - 1];
+    }
+    job->aBounds[partitions] = na;
+    job->bBounds[partitions] = nb;
+}
+
+// Function to compute the partial result of one partition
+/**
+ * @brief Thread Pool task: runs the kernel on partition 'task' into its scratch slice.
+ */
+static void mergePartition(void* context, int task) {
+    struct ParallelJob* job = (struct ParallelJob*)context;
+    size_t a0 = job->aBounds[task];
+    size_t b0 = job->bBounds[task];
+    job->partSizes[task] = job->kernel(job->a + a0, job->aBounds[task + 1] - a0,
+                                       job->b + b0, job->bBounds[task + 1] - b0,
+                                       job->scratch + job->scratchOffsets[task]);
+}
+
+// Function to move the partial result of one partition into place
+/**
+ * @brief Thread Pool task: copies the scratch slice of partition 'task' to its final offset.
+ */
+static void copyPartition(void* context, int task) {
+    struct ParallelJob* job = (struct ParallelJob*)context;
+    if (job->partSizes[task] == 0) return;
+    memcpy(job->out + job->outOffsets[task], job->scratch + job->scratchOffsets[task],
+           job->partSizes[task] * sizeof(int));
+}
+
+// Function to bound the size of a partial result
+/**
+ * @brief Returns the largest number of elements the operation can produce from la and lb inputs.
+ */
+static size_t partitionCapacity(ParallelOperation operation, size_t la, size_t lb) {
+    if (operation == PARALLEL_UNION) return la + lb;
+    if (operation == PARALLEL_DIFFERENCE) return la;
+    return la < lb ? la : lb;
+}
+
+// Function to run a set operation in parallel
+/**
+ * @brief Computes a set operation of two sorted array sets on the Thread Pool.
+ *
+ * Falls back to the serial operation for other backends, for small inputs, when only one
+ * thread is configured, or when the pool cannot be started. Either way the result is
+ * adaptive if 's1' is.
+ *
+ * @return A new ordered set holding the result or NULL if memory allocation fails.
+ */
+static OrderedIntSet* runParallel(OrderedIntSet* s1, OrderedIntSet* s2, ParallelOperation operation) {
+    static const SetKernel kernels[] = { intersectSortedInts, unionSortedInts, differenceSortedInts };
+    static OrderedIntSet* (*const serial[])(OrderedIntSet*, OrderedIntSet*) = { setIntersection, setUnion, setDifference };
+
+    if (!s1 || !s2) return NULL;
+
+    size_t na = s1->backend == SET_BACKEND_SORTED_ARRAY ? s1->array->size : 0;
+    size_t nb = s2->backend == SET_BACKEND_SORTED_ARRAY ? s2->array->size : 0;
+    int threads = getParallelThreadCount();
+    if (s1->backend != SET_BACKEND_SORTED_ARRAY || s2->backend != SET_BACKEND_SORTED_ARRAY ||
+        threads < 2 || na + nb < PARALLEL_MIN_ELEMENTS) {
+        return serial[operation](s1, s2);
+    }
+    getSetKernelLevel();  // Select the kernels before the workers first call them
+
+    int partitions = threads * PARALLEL_PARTITIONS_PER_THREAD;
+    struct ParallelJob job;
+    job.kernel = kernels[operation];
+    job.operation = operation;
+    job.a = s1->array->data;
+    job.b = s2->array->data;
+    job.aBounds = (size_t*)malloc(sizeof(size_t) * (partitions + 1) * 5);
+    if (!job.aBounds) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    job.bBounds = job.aBounds + (partitions + 1);
+    job.scratchOffsets = job.bBounds + (partitions + 1);
+    job.partSizes = job.scratchOffsets + (partitions + 1);
+    job.outOffsets = job.partSizes + (partitions + 1);
+
+    splitInputs(&job, na, nb, partitions);
+
+    size_t scratchSize = 0;
+    for (int p = 0; p < partitions; p++) {
+        job.scratchOffsets[p] = scratchSize;
+        scratchSize += partitionCapacity(operation, job.aBounds[p + 1] - job.aBounds[p],
+                                         job.bBounds[p + 1] - job.bBounds[p]);
+    }
+    job.scratch = (int*)malloc(sizeof(int) * (scratchSize > 0 ? scratchSize : 1));
+    if (!job.scratch) {
+        LOG_ERROR("Memory allocation failed.");
+        free(job.aBounds);
+        return NULL;
+    }
+
+    lockParallel();
+    struct ThreadPool* pool = getParallelPool();
+    if (!pool) {
+        threadMutexUnlock(&parallelLock);
+        free(job.scratch);
+        free(job.aBounds);
+        return serial[operation](s1, s2);
+    }
+    threadPoolRun(pool, mergePartition, &job, partitions);
+
+    size_t total = 0;
+    for (int p = 0; p < partitions; p++) {
+        job.outOffsets[p] = total;
+        total += job.partSizes[p];
+    }
+
+    OrderedIntSet* result = createOrderedSetWithBackend(SET_BACKEND_SORTED_ARRAY);
+    if (result && !reserveSortedArray(result->array, total)) {
+        deleteOrderedSet(result);
+        result = NULL;
+    }
+    if (result) {
+        job.out = result->array->data;
+        threadPoolRun(pool, copyPartition, &job, partitions);
+    }
+    threadMutexUnlock(&parallelLock);
+    if (result) {
+        result->array->size = total;
+        result->count = (int)total;
+        if (s1->adaptive) makeSetAdaptive(result);  // Like the result of the serial operation
+    }
+
+    free(job.scratch);
+    free(job.aBounds);
+    return result;
+}
+
+// Function to find the intersection of two ordered sets in parallel
+/**
+ * @brief Computes the intersection of two ordered sets on several threads.
+ *
+ * Produces the same result as setIntersection.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return A new ordered set containing the intersection of s1 and s2 or NULL if memory allocation fails.
+ */
+OrderedIntSet* parallelSetIntersection(OrderedIntSet* s1, OrderedIntSet* s2) {
+    return runParallel(s1, s2, PARALLEL_INTERSECTION);
+}
+
+// Function to find the union of two ordered sets in parallel
+/**
+ * @brief Computes the union of two ordered sets on several threads.
+ *
+ * Produces the same result as setUnion.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return A new ordered set containing the union of s1 and s2 or NULL if memory allocation fails.
+ */
+OrderedIntSet* parallelSetUnion(OrderedIntSet* s1, OrderedIntSet* s2) {
+    return runParallel(s1, s2, PARALLEL_UNION);
+}
+
+// Function to find the difference of two ordered sets in parallel
+/**
+ * @brief Computes the difference of two ordered sets (s1 - s2) on several threads.
+ *
+ * Produces the same result as setDifference.
+ *
+ * @param s1 The first ordered set.
+ * @param s2 The second ordered set.
+ *
+ * @return A new ordered set containing the difference of s1 and s2 or NULL if memory allocation fails.
+ */
+OrderedIntSet* parallelSetDifference(OrderedIntSet* s1, OrderedIntSet* s2) {
+    return runParallel(s1, s2, PARALLEL_DIFFERENCE);
+}
@@ -0,0 +1,60 @@
+/**
+ * @file parallelSetOps.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the multi-threaded set operations.<br/>
+ *
+ * This header file declares parallel versions of set intersection, union and difference.
+ * Both inputs are cut into key ranges that hold about the same number of elements, each
+ * range is processed by the set operation kernels on a Thread Pool, and the partial results
+ * are copied side by side into the result. Sets that are not stored in sorted arrays, and
+ * inputs too small to be worth splitting, are handled by the serial operations.
+ *
+ * All functions may be called from several threads at once, like the serial operations on
+ * sets that no thread modifies. The worker threads are shared: parallel operations started
+ * on different threads at the same time run one after another, each on every worker.
+ * setParallelThreadCount and shutdownParallelSetOps wait for a running operation to finish.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef PARALLEL_SET_OPS_H
+#define PARALLEL_SET_OPS_H
+
+#include "orderedSet.h"
+
+// Smallest combined input size that is split across threads
+#define PARALLEL_MIN_ELEMENTS 262144
+
+// Number of partitions handed to each thread, so that uneven partitions balance out
+#define PARALLEL_PARTITIONS_PER_THREAD 4
+
+// Sets the number of threads used by the parallel operations (0 = one per logical processor)
+void setParallelThreadCount(int threads);
+
+// Returns the number of threads the parallel operations will use
+int getParallelThreadCount();
+
+// Computes the intersection of two ordered sets on several threads
+OrderedIntSet* parallelSetIntersection(OrderedIntSet* s1, OrderedIntSet* s2);
+
+// Computes the union of two ordered sets on several threads
+OrderedIntSet* parallelSetUnion(OrderedIntSet* s1, OrderedIntSet* s2);
+
+// Computes the difference of two ordered sets (s1 - s2) on several threads
+OrderedIntSet* parallelSetDifference(OrderedIntSet* s1, OrderedIntSet* s2);
+
+// Stops the worker threads of the parallel operations (they restart on next use)
+void shutdownParallelSetOps();
+
+#endif // PARALLEL_SET_OPS_H
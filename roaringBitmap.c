@@ -0,0 +1,1541 @@
+/**
+ * @file roaringBitmap.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the Roaring Bitmap data structure used in the Ordered Set.<br/>
+ *
+ * This file contains the functions to create and delete a Roaring Bitmap, to add and
+ * remove values, to combine two or more bitmaps and to iterate over the values. Chunks held
+ * as arrays are combined by merging; every other combination expands both containers
+ * to 1024 words and works one 64-bit word at a time, counting the result with popcount
+ * so the cardinality is known without a further pass. Each result container is then
+ * stored in whichever of the three representations is smallest.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// include module header files
+#include "roaringBitmap.h"
+#include "logging.h"
+#include "instrumentation.h"
+
+// Enumeration for the binary operations
+typedef enum
+{
+    OP_AND,
+    OP_OR,
+    OP_ANDNOT
+} RoaringOperation;
+
+// Function to count the bits of a word
+/**
+ * @brief Returns the number of set bits in a 64-bit word.
+ */
+static int popcount64(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return (int)__popcnt64(word);
+#elif defined(_MSC_VER)
+    return (int)(__popcnt((unsigned int)word) + __popcnt((unsigned int)(word >> 32)));
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+// Function to find the lowest set bit of a word
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero 64-bit word.
+ */
+static int trailingZeros64(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, (unsigned long)word)) return (int)index;
+    _BitScanForward(&index, (unsigned long)(word >> 32));
+    return (int)index + 32;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+// Function to find the highest set bit of a word
+/**
+ * @brief Returns the index of the highest set bit of a non-zero 64-bit word.
+ */
+static int highestBit64(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return (int)index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanReverse(&index, (unsigned long)(word >> 32))) return (int)index + 32;
+    _BitScanReverse(&index, (unsigned long)word);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(word);
+#endif
+}
+
+// Functions to map ints to unsigned keys and back, so that negative values sort first
+static uint32_t toKey(int value) {
+    return (uint32_t)value ^ 0x80000000u;
+}
+
+static int fromKey(uint32_t key) {
+    return (int)(key ^ 0x80000000u);
+}
+
+// Function to reset a container to an empty array container
+/**
+ * @brief Initialises a container as an empty array container without allocating.
+ */
+static void initContainer(struct RoaringContainer* c) {
+    c->type = ROARING_ARRAY;
+    c->cardinality = 0;
+    c->size = 0;
+    c->capacity = 0;
+    c->values = NULL;
+    c->words = NULL;
+    c->runs = NULL;
+}
+
+// Function to free the storage of a container
+/**
+ * @brief Frees whatever storage a container holds and makes it an empty array container.
+ */
+static void freeContainer(struct RoaringContainer* c) {
+    free(c->values);
+    free(c->words);
+    free(c->runs);
+    initContainer(c);
+}
+
+// Function to search an array container
+/**
+ * @brief Finds the first position of a sorted array of low bits whose value is >= 'low'.
+ */
+static int arrayLowerBound(const uint16_t* values, int n, uint16_t low) {
+    int first = 0;
+    int last = n;
+    while (first < last) {
+        int mid = first + (last - first) / 2;
+        if (values[mid] < low) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
+// Function to search a run container
+/**
+ * @brief Finds the last run whose start is <= 'low'.
+ *
+ * @return int Index of the run, or -1 if every run starts after 'low'.
+ */
+static int runFind(const struct RoaringRun* runs, int n, uint16_t low) {
+    int first = 0;
+    int last = n;
+    while (first < last) {
+        int mid = first + (last - first) / 2;
+        if (runs[mid].start <= low) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first - 1;
+}
+
+// Function to test a value in a container
+/**
+ * @brief Checks whether a container holds the low bits 'low'.
+ */
+static int containerContains(const struct RoaringContainer* c, uint16_t low) {
+    if (c->type == ROARING_BITMAP) {
+        return (int)((c->words[low >> 6] >> (low & 63)) & 1);
+    }
+    if (c->type == ROARING_RUN) {
+        int r = runFind(c->runs, c->size, low);
+        return r >= 0 && low <= c->runs[r].start + c->runs[r].length;
+    }
+    int pos = arrayLowerBound(c->values, c->size, low);
+    return pos < c->size && c->values[pos] == low;
+}
+
+// Function to set a range of bits
+/**
+ * @brief Sets bits 'start' to 'end' (inclusive) of a 1024 word bitmap.
+ */
+static void setBitRange(uint64_t* words, int start, int end) {
+    int first = start >> 6;
+    int last = end >> 6;
+    uint64_t firstMask = ~0ULL << (start & 63);
+    uint64_t lastMask = ~0ULL >> (63 - (end & 63));
+    if (first == last) {
+        words[first] |= firstMask & lastMask;
+        return;
+    }
+    words[first] |= firstMask;
+    for (int w = first + 1; w < last; w++) {
+        words[w] = ~0ULL;
+    }
+    words[last] |= lastMask;
+}
+
+// Function to expand a container into a plain bitmap
+/**
+ * @brief Writes the values of any container into a zeroed 1024 word bitmap.
+ */
+static void containerToWords(const struct RoaringContainer* c, uint64_t* words) {
+    if (c->type == ROARING_BITMAP) {
+        memcpy(words, c->words, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+        return;
+    }
+    memset(words, 0, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    if (c->type == ROARING_RUN) {
+        for (int r = 0; r < c->size; r++) {
+            setBitRange(words, c->runs[r].start, c->runs[r].start + c->runs[r].length);
+        }
+    } else {
+        for (int k = 0; k < c->size; k++) {
+            words[c->values[k] >> 6] |= 1ULL << (c->values[k] & 63);
+        }
+    }
+}
+
+// Function to count the runs of a bitmap
+/**
+ * @brief Counts the runs of consecutive set bits in a 1024 word bitmap.
+ *
+ * A run starts at every set bit whose lower neighbour is clear, so each word contributes
+ * popcount(w & ~(w << 1 | carry)), where carry is the top bit of the previous word.
+ */
+static int countRuns(const uint64_t* words) {
+    int runs = 0;
+    uint64_t carry = 0;
+    for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+        uint64_t word = words[w];
+        runs += popcount64(word & ~((word << 1) | carry));
+        carry = word >> 63;
+    }
+    return runs;
+}
+
+// Function to build a container from a plain bitmap
+/**
+ * @brief Stores the values of a bitmap in an empty container using its smallest representation.
+ *
+ * Array containers cost 2 bytes per value, run containers 4 bytes per run and bitmap
+ * containers a fixed 8 KiB.
+ *
+ * @param c An empty (initialised) container.
+ * @param words The values as a 1024 word bitmap.
+ * @param cardinality Number of set bits in 'words'.
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int containerFromWords(struct RoaringContainer* c, const uint64_t* words, int cardinality) {
+    int runs = countRuns(words);
+    size_t runBytes = (size_t)runs * sizeof(struct RoaringRun);
+    size_t arrayBytes = (size_t)cardinality * sizeof(uint16_t);
+    size_t bitmapBytes = ROARING_BITMAP_WORDS * sizeof(uint64_t);
+
+    c->cardinality = cardinality;
+    if (runBytes < bitmapBytes && (cardinality > ROARING_ARRAY_MAX || runBytes < arrayBytes)) {
+        c->type = ROARING_RUN;
+        c->runs = (struct RoaringRun*)malloc(runBytes);
+        if (!c->runs) return 0;
+        INSTR_COUNT_ALLOC(runBytes);
+        c->size = 0;
+        c->capacity = runs;
+        int bit = 0;
+        while (bit < ROARING_BITMAP_WORDS * 64) {
+            // Skip clear bits, then measure the run of set bits
+            uint64_t word = words[bit >> 6] >> (bit & 63);
+            if (word == 0) {
+                bit = (bit | 63) + 1;
+                continue;
+            }
+            bit += trailingZeros64(word);
+            int start = bit;
+            while (bit < ROARING_BITMAP_WORDS * 64) {
+                uint64_t rest = ~words[bit >> 6] >> (bit & 63);
+                if (rest == 0) {
+                    bit = (bit | 63) + 1;
+                    continue;
+                }
+                bit += trailingZeros64(rest);
+                break;
+            }
+            c->runs[c->size].start = (uint16_t)start;
+            c->runs[c->size].length = (uint16_t)(bit - 1 - start);
+            c->size++;
+        }
+        return 1;
+    }
+
+    if (cardinality <= ROARING_ARRAY_MAX) {
+        c->type = ROARING_ARRAY;
+        c->capacity = cardinality > 0 ? cardinality : 1;
+        c->values = (uint16_t*)malloc(c->capacity * sizeof(uint16_t));
+        if (!c->values) return 0;
+        INSTR_COUNT_ALLOC(c->capacity * sizeof(uint16_t));
+        c->size = 0;
+        for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+            uint64_t word = words[w];
+            while (word) {
+                c->values[c->size++] = (uint16_t)(w * 64 + trailingZeros64(word));
+                word &= word - 1;
+            }
+        }
+        return 1;
+    }
+
+    c->type = ROARING_BITMAP;
+    c->words = (uint64_t*)malloc(bitmapBytes);
+    if (!c->words) return 0;
+    INSTR_COUNT_ALLOC(bitmapBytes);
+    memcpy(c->words, words, bitmapBytes);
+    return 1;
+}
+
+// Function to copy a container
+/**
+ * @brief Makes 'dst' an independent copy of 'src'.
+ *
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int copyContainer(struct RoaringContainer* dst, const struct RoaringContainer* src) {
+    initContainer(dst);
+    dst->type = src->type;
+    dst->cardinality = src->cardinality;
+    dst->size = src->size;
+    dst->capacity = src->size > 0 ? src->size : 1;
+    if (src->type == ROARING_BITMAP) {
+        dst->words = (uint64_t*)malloc(ROARING_BITMAP_WORDS * sizeof(uint64_t));
+        if (!dst->words) return 0;
+        INSTR_COUNT_ALLOC(ROARING_BITMAP_WORDS * sizeof(uint64_t));
+        memcpy(dst->words, src->words, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    } else if (src->type == ROARING_RUN) {
+        dst->runs = (struct RoaringRun*)malloc(dst->capacity * sizeof(struct RoaringRun));
+        if (!dst->runs) return 0;
+        INSTR_COUNT_ALLOC(dst->capacity * sizeof(struct RoaringRun));
+        memcpy(dst->runs, src->runs, src->size * sizeof(struct RoaringRun));
+    } else {
+        dst->values = (uint16_t*)malloc(dst->capacity * sizeof(uint16_t));
+        if (!dst->values) return 0;
+        INSTR_COUNT_ALLOC(dst->capacity * sizeof(uint16_t));
+        memcpy(dst->values, src->values, src->size * sizeof(uint16_t));
+    }
+    return 1;
+}
+
+// Function to add a value to a run container
+/**
+ * @brief Adds 'low' to a run container by extending, merging or inserting a run.
+ *
+ * @return int 1 if added, 0 if already present, -1 on allocation failure.
+ */
+static int runContainerAdd(struct RoaringContainer* c, uint16_t low) {
+    int r = runFind(c->runs, c->size, low);
+    if (r >= 0 && low <= c->runs[r].start + c->runs[r].length) return 0;
+
+    int extendsPrevious = r >= 0 && low == c->runs[r].start + c->runs[r].length + 1;
+    int extendsNext = r + 1 < c->size && low + 1 == c->runs[r + 1].start;
+
+    if (extendsPrevious && extendsNext) {
+        // The value fills the gap between two runs: merge them
+        c->runs[r].length = (uint16_t)(c->runs[r].length + c->runs[r + 1].length + 2);
+        memmove(&c->runs[r + 1], &c->runs[r + 2], (c->size - r - 2) * sizeof(struct RoaringRun));
+        c->size--;
+    } else if (extendsPrevious) {
+        c->runs[r].length++;
+    } else if (extendsNext) {
+        c->runs[r + 1].start--;
+        c->runs[r + 1].length++;
+    } else {
+        if (c->size == c->capacity) {
+            int capacity = c->capacity * 2 + 1;
+            struct RoaringRun* runs = (struct RoaringRun*)realloc(c->runs, capacity * sizeof(struct RoaringRun));
+            if (!runs) return -1;
+            INSTR_COUNT_ALLOC((capacity - c->capacity) * sizeof(struct RoaringRun));
+            c->runs = runs;
+            c->capacity = capacity;
+        }
+        memmove(&c->runs[r + 2], &c->runs[r + 1], (c->size - r - 1) * sizeof(struct RoaringRun));
+        c->runs[r + 1].start = low;
+        c->runs[r + 1].length = 0;
+        c->size++;
+    }
+    c->cardinality++;
+    return 1;
+}
+
+// Function to remove a value from a run container
+/**
+ * @brief Removes 'low' from a run container by shrinking, splitting or deleting a run.
+ *
+ * @return int 1 if removed, 0 if not present, -1 on allocation failure.
+ */
+static int runContainerRemove(struct RoaringContainer* c, uint16_t low) {
+    int r = runFind(c->runs, c->size, low);
+    if (r < 0 || low > c->runs[r].start + c->runs[r].length) return 0;
+
+    struct RoaringRun* run = &c->runs[r];
+    int end = run->start + run->length;
+    if (run->length == 0) {
+        memmove(&c->runs[r], &c->runs[r + 1], (c->size - r - 1) * sizeof(struct RoaringRun));
+        c->size--;
+    } else if (low == run->start) {
+        run->start++;
+        run->length--;
+    } else if (low == end) {
+        run->length--;
+    } else {
+        // Split the run around the removed value
+        if (c->size == c->capacity) {
+            int capacity = c->capacity * 2 + 1;
+            struct RoaringRun* runs = (struct RoaringRun*)realloc(c->runs, capacity * sizeof(struct RoaringRun));
+            if (!runs) return -1;
+            INSTR_COUNT_ALLOC((capacity - c->capacity) * sizeof(struct RoaringRun));
+            c->runs = runs;
+            c->capacity = capacity;
+            run = &c->runs[r];
+        }
+        memmove(&c->runs[r + 2], &c->runs[r + 1], (c->size - r - 1) * sizeof(struct RoaringRun));
+        run->length = (uint16_t)(low - 1 - run->start);
+        c->runs[r + 1].start = (uint16_t)(low + 1);
+        c->runs[r + 1].length = (uint16_t)(end - low - 1);
+        c->size++;
+    }
+    c->cardinality--;
+    return 1;
+}
+
+// Function to add a value to a container
+/**
+ * @brief Adds 'low' to a container, turning a full array container into a bitmap container.
+ *
+ * @return int 1 if added, 0 if already present, -1 on allocation failure.
+ */
+static int containerAdd(struct RoaringContainer* c, uint16_t low) {
+    if (c->type == ROARING_RUN) return runContainerAdd(c, low);
+
+    if (c->type == ROARING_BITMAP) {
+        uint64_t bit = 1ULL << (low & 63);
+        if (c->words[low >> 6] & bit) return 0;
+        c->words[low >> 6] |= bit;
+        c->cardinality++;
+        return 1;
+    }
+
+    int pos = arrayLowerBound(c->values, c->size, low);
+    if (pos < c->size && c->values[pos] == low) return 0;
+
+    if (c->size == ROARING_ARRAY_MAX) {
+        // Array is full: switch to a bitmap container
+        uint64_t* words = (uint64_t*)calloc(ROARING_BITMAP_WORDS, sizeof(uint64_t));
+        if (!words) return -1;
+        INSTR_COUNT_ALLOC(ROARING_BITMAP_WORDS * sizeof(uint64_t));
+        for (int k = 0; k < c->size; k++) {
+            words[c->values[k] >> 6] |= 1ULL << (c->values[k] & 63);
+        }
+        words[low >> 6] |= 1ULL << (low & 63);
+        free(c->values);
+        c->values = NULL;
+        c->words = words;
+        c->type = ROARING_BITMAP;
+        c->size = 0;
+        c->capacity = 0;
+        c->cardinality++;
+        return 1;
+    }
+
+    if (c->size == c->capacity) {
+        int capacity = c->capacity ? c->capacity * 2 : 4;
+        if (capacity > ROARING_ARRAY_MAX) capacity = ROARING_ARRAY_MAX;
+        uint16_t* values = (uint16_t*)realloc(c->values, capacity * sizeof(uint16_t));
+        if (!values) return -1;
+        INSTR_COUNT_ALLOC((capacity - c->capacity) * sizeof(uint16_t));
+        c->values = values;
+        c->capacity = capacity;
+    }
+    memmove(&c->values[pos + 1], &c->values[pos], (c->size - pos) * sizeof(uint16_t));
+    c->values[pos] = low;
+    c->size++;
+    c->cardinality++;
+    return 1;
+}
+
+// Function to remove a value from a container
+/**
+ * @brief Removes 'low' from a container, turning a sparse bitmap container back into an array.
+ *
+ * @return int 1 if removed, 0 if not present, -1 on allocation failure.
+ */
+static int containerRemove(struct RoaringContainer* c, uint16_t low) {
+    if (c->type == ROARING_RUN) return runContainerRemove(c, low);
+
+    if (c->type == ROARING_BITMAP) {
+        uint64_t bit = 1ULL << (low & 63);
+        if (!(c->words[low >> 6] & bit)) return 0;
+        c->words[low >> 6] &= ~bit;
+        c->cardinality--;
+        if (c->cardinality <= ROARING_ARRAY_MAX) {
+            // Sparse again: switch back to an array container
+            uint16_t* values = (uint16_t*)malloc(ROARING_ARRAY_MAX * sizeof(uint16_t));
+            if (values) {
+                INSTR_COUNT_ALLOC(ROARING_ARRAY_MAX * sizeof(uint16_t));
+                int n = 0;
+                for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+                    uint64_t word = c->words[w];
+                    while (word) {
+                        values[n++] = (uint16_t)(w * 64 + trailingZeros64(word));
+                        word &= word - 1;
+                    }
+                }
+                free(c->words);
+                c->words = NULL;
+                c->values = values;
+                c->type = ROARING_ARRAY;
+                c->size = n;
+                c->capacity = ROARING_ARRAY_MAX;
+            }
+        }
+        return 1;
+    }
+
+    int pos = arrayLowerBound(c->values, c->size, low);
+    if (pos == c->size || c->values[pos] != low) return 0;
+    memmove(&c->values[pos], &c->values[pos + 1], (c->size - pos - 1) * sizeof(uint16_t));
+    c->size--;
+    c->cardinality--;
+    return 1;
+}
+
+// Function to find a chunk
+/**
+ * @brief Binary searches the chunk keys.
+ *
+ * @param bitmap The bitmap.
+ * @param key High 16 bits of the chunk.
+ * @param pos Receives the index of the chunk, or where it would be inserted.
+ * @return int 1 if the chunk exists, 0 otherwise.
+ */
+static int findChunk(const struct RoaringBitmap* bitmap, uint16_t key, int* pos) {
+    int first = 0;
+    int last = bitmap->size;
+    while (first < last) {
+        int mid = first + (last - first) / 2;
+        if (bitmap->keys[mid] < key) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    *pos = first;
+    return first < bitmap->size && bitmap->keys[first] == key;
+}
+
+// Function to insert an empty chunk
+/**
+ * @brief Inserts an empty array container for 'key' at index 'pos'.
+ *
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int insertChunk(struct RoaringBitmap* bitmap, int pos, uint16_t key) {
+    if (bitmap->size == bitmap->capacity) {
+        int capacity = bitmap->capacity ? bitmap->capacity * 2 : 4;
+        uint16_t* keys = (uint16_t*)realloc(bitmap->keys, capacity * sizeof(uint16_t));
+        if (!keys) return 0;
+        bitmap->keys = keys;
+        struct RoaringContainer* containers =
+            (struct RoaringContainer*)realloc(bitmap->containers, capacity * sizeof(struct RoaringContainer));
+        if (!containers) return 0;
+        INSTR_COUNT_ALLOC((capacity - bitmap->capacity) * (sizeof(uint16_t) + sizeof(struct RoaringContainer)));
+        bitmap->containers = containers;
+        bitmap->capacity = capacity;
+    }
+    memmove(&bitmap->keys[pos + 1], &bitmap->keys[pos], (bitmap->size - pos) * sizeof(uint16_t));
+    memmove(&bitmap->containers[pos + 1], &bitmap->containers[pos],
+            (bitmap->size - pos) * sizeof(struct RoaringContainer));
+    bitmap->keys[pos] = key;
+    initContainer(&bitmap->containers[pos]);
+    bitmap->size++;
+    return 1;
+}
+
+// Function to delete a chunk
+/**
+ * @brief Frees the container at index 'pos' and closes the gap.
+ */
+static void removeChunk(struct RoaringBitmap* bitmap, int pos) {
+    freeContainer(&bitmap->containers[pos]);
+    memmove(&bitmap->keys[pos], &bitmap->keys[pos + 1], (bitmap->size - pos - 1) * sizeof(uint16_t));
+    memmove(&bitmap->containers[pos], &bitmap->containers[pos + 1],
+            (bitmap->size - pos - 1) * sizeof(struct RoaringContainer));
+    bitmap->size--;
+}
+
+// Function to create an empty roaring bitmap
+/**
+ * @brief Creates a new empty Roaring Bitmap.
+ *
+ * @return struct RoaringBitmap* Pointer to the new bitmap or NULL if memory allocation fails.
+ */
+struct RoaringBitmap* createRoaringBitmap() {
+    struct RoaringBitmap* bitmap = (struct RoaringBitmap*)malloc(sizeof(struct RoaringBitmap));
+    if (!bitmap) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    INSTR_COUNT_ALLOC(sizeof(struct RoaringBitmap));
+    bitmap->keys = NULL;
+    bitmap->containers = NULL;
+    bitmap->size = 0;
+    bitmap->capacity = 0;
+    return bitmap;
+}
+
+// Function to delete a roaring bitmap
+/**
+ * @brief Deletes a Roaring Bitmap and all of its containers.
+ *
+ * @param bitmap Pointer to the bitmap to delete.
+ */
+void deleteRoaringBitmap(struct RoaringBitmap* bitmap) {
+    if (!bitmap) return;
+    for (int k = 0; k < bitmap->size; k++) {
+        freeContainer(&bitmap->containers[k]);
+    }
+    free(bitmap->keys);
+    free(bitmap->containers);
+    free(bitmap);
+}
+
+// Function to add a value to a roaring bitmap
+/**
+ * @brief Adds a value to the bitmap.
+ *
+ * @param bitmap The bitmap.
+ * @param value The value to add.
+ * @return int 1 if added, 0 if already present, -1 if memory allocation failed.
+ */
+int roaringAdd(struct RoaringBitmap* bitmap, int value) {
+    uint32_t key = toKey(value);
+    int pos;
+    if (!findChunk(bitmap, (uint16_t)(key >> 16), &pos)) {
+        if (!insertChunk(bitmap, pos, (uint16_t)(key >> 16))) {
+            LOG_ERROR("Memory allocation failed.");
+            return -1;
+        }
+    }
+    int added = containerAdd(&bitmap->containers[pos], (uint16_t)(key & 0xFFFF));
+    if (added < 0) {
+        LOG_ERROR("Memory allocation failed.");
+        if (bitmap->containers[pos].cardinality == 0) removeChunk(bitmap, pos);
+    }
+    return added;
+}
+
+// Function to add a range of values to a roaring bitmap
+/**
+ * @brief Adds every value in [low, high] to the bitmap.
+ *
+ * Each affected chunk is rebuilt from a word bitmap, so long ranges end up as run containers.
+ *
+ * @param bitmap The bitmap.
+ * @param low First value of the range.
+ * @param high Last value of the range (inclusive).
+ * @return int Number of values that were not already present, or -1 if memory allocation failed.
+ */
+int roaringAddRange(struct RoaringBitmap* bitmap, int low, int high) {
+    if (low > high) return 0;
+
+    uint32_t first = toKey(low);
+    uint32_t last = toKey(high);
+    int added = 0;
+    uint64_t words[ROARING_BITMAP_WORDS];
+
+    for (uint32_t chunk = first >> 16; chunk <= (last >> 16); chunk++) {
+        int start = (chunk == (first >> 16)) ? (int)(first & 0xFFFF) : 0;
+        int end = (chunk == (last >> 16)) ? (int)(last & 0xFFFF) : 0xFFFF;
+        int pos;
+        int before = 0;
+
+        if (findChunk(bitmap, (uint16_t)chunk, &pos)) {
+            containerToWords(&bitmap->containers[pos], words);
+            before = bitmap->containers[pos].cardinality;
+        } else {
+            if (!insertChunk(bitmap, pos, (uint16_t)chunk)) {
+                LOG_ERROR("Memory allocation failed.");
+                return -1;
+            }
+            memset(words, 0, sizeof(words));
+        }
+        setBitRange(words, start, end);
+
+        int cardinality = 0;
+        for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+            cardinality += popcount64(words[w]);
+        }
+        struct RoaringContainer rebuilt;
+        initContainer(&rebuilt);
+        if (!containerFromWords(&rebuilt, words, cardinality)) {
+            freeContainer(&rebuilt);
+            LOG_ERROR("Memory allocation failed.");
+            return -1;
+        }
+        freeContainer(&bitmap->containers[pos]);
+        bitmap->containers[pos] = rebuilt;
+        added += cardinality - before;
+    }
+    return added;
+}
+
+// Function to remove a value from a roaring bitmap
+/**
+ * @brief Removes a value from the bitmap, dropping its chunk once the chunk is empty.
+ *
+ * @param bitmap The bitmap.
+ * @param value The value to remove.
+ * @return int 1 if removed, 0 if not present, -1 if memory allocation failed.
+ */
+int roaringRemove(struct RoaringBitmap* bitmap, int value) {
+    uint32_t key = toKey(value);
+    int pos;
+    if (!findChunk(bitmap, (uint16_t)(key >> 16), &pos)) return 0;
+
+    int removed = containerRemove(&bitmap->containers[pos], (uint16_t)(key & 0xFFFF));
+    if (removed < 0) {
+        LOG_ERROR("Memory allocation failed.");
+    } else if (bitmap->containers[pos].cardinality == 0) {
+        removeChunk(bitmap, pos);
+    }
+    return removed;
+}
+
+// Function to test a value in a roaring bitmap
+/**
+ * @brief Checks whether a value is in the bitmap.
+ *
+ * @return int 1 if present, 0 otherwise.
+ */
+int roaringContains(const struct RoaringBitmap* bitmap, int value) {
+    uint32_t key = toKey(value);
+    int pos;
+    if (!findChunk(bitmap, (uint16_t)(key >> 16), &pos)) return 0;
+    return containerContains(&bitmap->containers[pos], (uint16_t)(key & 0xFFFF));
+}
+
+// Function to count the values of a roaring bitmap
+/**
+ * @brief Returns the number of values in the bitmap (the sum of the container cardinalities).
+ */
+size_t roaringCardinality(const struct RoaringBitmap* bitmap) {
+    size_t total = 0;
+    for (int k = 0; k < bitmap->size; k++) {
+        total += (size_t)bitmap->containers[k].cardinality;
+    }
+    return total;
+}
+
+// Function to count the values of a container below some low bits
+/**
+ * @brief Returns the number of values of a container that are smaller than 'low'.
+ *
+ * Bitmap containers count the words on whichever side of 'low' is shorter.
+ */
+static int containerRank(const struct RoaringContainer* c, uint16_t low) {
+    if (c->type == ROARING_BITMAP) {
+        int word = low >> 6;
+        uint64_t below = c->words[word] & (((uint64_t)1 << (low & 63)) - 1);
+        if (word < ROARING_BITMAP_WORDS / 2) {
+            int rank = popcount64(below);
+            for (int w = 0; w < word; w++) {
+                rank += popcount64(c->words[w]);
+            }
+            return rank;
+        }
+        int above = popcount64(c->words[word] & ~below);
+        for (int w = word + 1; w < ROARING_BITMAP_WORDS; w++) {
+            above += popcount64(c->words[w]);
+        }
+        return c->cardinality - above;
+    }
+    if (c->type == ROARING_RUN) {
+        int rank = 0;
+        for (int r = 0; r < c->size && c->runs[r].start < low; r++) {
+            int end = c->runs[r].start + c->runs[r].length;
+            rank += (end < low ? end : low - 1) - c->runs[r].start + 1;
+        }
+        return rank;
+    }
+    return arrayLowerBound(c->values, c->size, low);
+}
+
+// Function to find the value at a position of a container
+/**
+ * @brief Returns the low bits of the value at 0-based position 'k' (< cardinality) of a container.
+ *
+ * Bitmap containers count the words from whichever end is nearer to position 'k'.
+ */
+static uint16_t containerSelect(const struct RoaringContainer* c, int k) {
+    if (c->type == ROARING_BITMAP) {
+        int w = 0;
+        if (k < c->cardinality / 2) {
+            while (popcount64(c->words[w]) <= k) {
+                k -= popcount64(c->words[w++]);
+            }
+        } else {
+            // Count down from the last word: 'k' becomes the position within word w
+            int fromEnd = c->cardinality - 1 - k;
+            w = ROARING_BITMAP_WORDS - 1;
+            while (popcount64(c->words[w]) <= fromEnd) {
+                fromEnd -= popcount64(c->words[w--]);
+            }
+            k = popcount64(c->words[w]) - 1 - fromEnd;
+        }
+        uint64_t word = c->words[w];
+        while (k-- > 0) {
+            word &= word - 1;
+        }
+        return (uint16_t)(w * 64 + trailingZeros64(word));
+    }
+    if (c->type == ROARING_RUN) {
+        int r = 0;
+        while (c->runs[r].length < k) {
+            k -= c->runs[r++].length + 1;
+        }
+        return (uint16_t)(c->runs[r].start + k);
+    }
+    return c->values[k];
+}
+
+// Function to find the largest value of a container below some low bits
+/**
+ * @brief Finds the largest value of a container that is smaller than 'low'.
+ *
+ * 'low' may be 0x10000 to ask for the largest value of the container.
+ *
+ * @return int The low bits of that value, or -1 if there is none.
+ */
+static int containerPredecessor(const struct RoaringContainer* c, int low) {
+    if (low <= 0) return -1;
+    if (c->type == ROARING_BITMAP) {
+        int w = (low - 1) >> 6;
+        uint64_t word = c->words[w] & (~(uint64_t)0 >> (63 - ((low - 1) & 63)));
+        while (word == 0) {
+            if (--w < 0) return -1;
+            word = c->words[w];
+        }
+        return w * 64 + highestBit64(word);
+    }
+    if (c->type == ROARING_RUN) {
+        int r = runFind(c->runs, c->size, (uint16_t)(low - 1));
+        if (r < 0) return -1;
+        int end = c->runs[r].start + c->runs[r].length;
+        return end < low - 1 ? end : low - 1;
+    }
+    int pos = (low > 0xFFFF) ? c->size : arrayLowerBound(c->values, c->size, (uint16_t)low);
+    return (pos > 0) ? c->values[pos - 1] : -1;
+}
+
+// Function to count the values below a value
+/**
+ * @brief Returns the number of values of the bitmap that are smaller than 'value'.
+ *
+ * The cardinalities of the chunks below the value are added up and only the chunk of the
+ * value itself is looked into.
+ */
+size_t roaringRank(const struct RoaringBitmap* bitmap, int value) {
+    uint32_t key = toKey(value);
+    int pos;
+    int found = findChunk(bitmap, (uint16_t)(key >> 16), &pos);
+    size_t rank = 0;
+    for (int k = 0; k < pos; k++) {
+        rank += (size_t)bitmap->containers[k].cardinality;
+    }
+    if (found) rank += (size_t)containerRank(&bitmap->containers[pos], (uint16_t)(key & 0xFFFF));
+    return rank;
+}
+
+// Function to find the value at a position
+/**
+ * @brief Finds the value at 0-based position 'k' of the bitmap in ascending order.
+ *
+ * @param bitmap The bitmap.
+ * @param k Position of the value.
+ * @param value Receives the value.
+ * @return int 1 if the bitmap holds more than k values, 0 otherwise ('value' is not written).
+ */
+int roaringSelect(const struct RoaringBitmap* bitmap, size_t k, int* value) {
+    for (int pos = 0; pos < bitmap->size; pos++) {
+        const struct RoaringContainer* c = &bitmap->containers[pos];
+        if (k < (size_t)c->cardinality) {
+            uint32_t high = (uint32_t)bitmap->keys[pos] << 16;
+            *value = fromKey(high | containerSelect(c, (int)k));
+            return 1;
+        }
+        k -= (size_t)c->cardinality;
+    }
+    return 0;
+}
+
+// Function to find the largest value below a value
+/**
+ * @brief Finds the largest value of the bitmap that is smaller than 'value'.
+ *
+ * @param bitmap The bitmap.
+ * @param value The bound.
+ * @param predecessor Receives the value found.
+ * @return int 1 if there is such a value, 0 otherwise ('predecessor' is not written).
+ */
+int roaringPredecessor(const struct RoaringBitmap* bitmap, int value, int* predecessor) {
+    uint32_t key = toKey(value);
+    int pos;
+    int low = -1;
+    if (findChunk(bitmap, (uint16_t)(key >> 16), &pos)) {
+        low = containerPredecessor(&bitmap->containers[pos], (int)(key & 0xFFFF));
+    }
+    while (low < 0) {
+        if (--pos < 0) return 0;
+        low = containerPredecessor(&bitmap->containers[pos], 0x10000);
+    }
+    *predecessor = fromKey(((uint32_t)bitmap->keys[pos] << 16) | (uint32_t)low);
+    return 1;
+}
+
+// Function to filter an array container by membership of another container
+/**
+ * @brief Keeps the values of array container 'a' that are (or, for OP_ANDNOT, are not) in 'b'.
+ *
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int filterArray(const struct RoaringContainer* a, const struct RoaringContainer* b, int keepIfPresent,
+                       struct RoaringContainer* out) {
+    out->capacity = a->size > 0 ? a->size : 1;
+    out->values = (uint16_t*)malloc(out->capacity * sizeof(uint16_t));
+    if (!out->values) return 0;
+    INSTR_COUNT_ALLOC(out->capacity * sizeof(uint16_t));
+
+    if (b->type == ROARING_ARRAY) {
+        // Both sorted: merge
+        int i = 0, j = 0;
+        while (i < a->size) {
+            while (j < b->size && b->values[j] < a->values[i]) j++;
+            int present = j < b->size && b->values[j] == a->values[i];
+            if (present == keepIfPresent) out->values[out->size++] = a->values[i];
+            i++;
+        }
+    } else {
+        for (int i = 0; i < a->size; i++) {
+            if (containerContains(b, a->values[i]) == keepIfPresent) {
+                out->values[out->size++] = a->values[i];
+            }
+        }
+    }
+    out->cardinality = out->size;
+    return 1;
+}
+
+// Function to combine two containers
+/**
+ * @brief Computes 'a op b' for the containers of one chunk into an empty container.
+ *
+ * Array containers are merged or filtered. Anything else is expanded to words and combined
+ * one 64-bit word at a time while the result is counted with popcount.
+ *
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+static int combineContainers(const struct RoaringContainer* a, const struct RoaringContainer* b,
+                             RoaringOperation op, struct RoaringContainer* out) {
+    if (a->type == ROARING_ARRAY && op != OP_OR) {
+        return filterArray(a, b, op == OP_AND, out);
+    }
+    if (b->type == ROARING_ARRAY && op == OP_AND) {
+        return filterArray(b, a, 1, out);
+    }
+    if (a->type == ROARING_ARRAY && b->type == ROARING_ARRAY && a->size + b->size <= ROARING_ARRAY_MAX) {
+        out->capacity = a->size + b->size;
+        out->values = (uint16_t*)malloc(out->capacity * sizeof(uint16_t));
+        if (!out->values) return 0;
+        INSTR_COUNT_ALLOC(out->capacity * sizeof(uint16_t));
+        int i = 0, j = 0;
+        while (i < a->size || j < b->size) {
+            if (j == b->size || (i < a->size && a->values[i] < b->values[j])) {
+                out->values[out->size++] = a->values[i++];
+            } else if (i == a->size || b->values[j] < a->values[i]) {
+                out->values[out->size++] = b->values[j++];
+            } else {
+                out->values[out->size++] = a->values[i];
+                i++;
+                j++;
+            }
+        }
+        out->cardinality = out->size;
+        return 1;
+    }
+
+    uint64_t wordsA[ROARING_BITMAP_WORDS];
+    uint64_t wordsB[ROARING_BITMAP_WORDS];
+    containerToWords(a, wordsA);
+    containerToWords(b, wordsB);
+
+    int cardinality = 0;
+    for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+        uint64_t word;
+        if (op == OP_AND) {
+            word = wordsA[w] & wordsB[w];
+        } else if (op == OP_OR) {
+            word = wordsA[w] | wordsB[w];
+        } else {
+            word = wordsA[w] & ~wordsB[w];
+        }
+        wordsA[w] = word;
+        cardinality += popcount64(word);
+    }
+    return containerFromWords(out, wordsA, cardinality);
+}
+
+// Function to append a chunk to a bitmap being built
+/**
+ * @brief Appends a container for 'key' after the last chunk, taking ownership of its storage.
+ *
+ * @return int 1 on success, 0 if memory allocation failed (the container is freed).
+ */
+static int appendChunk(struct RoaringBitmap* bitmap, uint16_t key, struct RoaringContainer* c) {
+    if (!insertChunk(bitmap, bitmap->size, key)) {
+        freeContainer(c);
+        return 0;
+    }
+    bitmap->containers[bitmap->size - 1] = *c;
+    return 1;
+}
+
+// Function to combine two roaring bitmaps
+/**
+ * @brief Computes 'a op b' chunk by chunk into a new bitmap.
+ *
+ * @return struct RoaringBitmap* The new bitmap or NULL if memory allocation fails.
+ */
+static struct RoaringBitmap* combine(const struct RoaringBitmap* a, const struct RoaringBitmap* b, RoaringOperation op) {
+    struct RoaringBitmap* result = createRoaringBitmap();
+    if (!result) return NULL;
+
+    int i = 0, j = 0;
+    while (i < a->size || j < b->size) {
+        struct RoaringContainer c;
+        initContainer(&c);
+        uint16_t key;
+        int ok = 1;
+
+        if (j == b->size || (i < a->size && a->keys[i] < b->keys[j])) {
+            // Chunk only in a
+            key = a->keys[i];
+            if (op != OP_AND) ok = copyContainer(&c, &a->containers[i]);
+            i++;
+        } else if (i == a->size || b->keys[j] < a->keys[i]) {
+            // Chunk only in b
+            key = b->keys[j];
+            if (op == OP_OR) ok = copyContainer(&c, &b->containers[j]);
+            j++;
+        } else {
+            key = a->keys[i];
+            ok = combineContainers(&a->containers[i], &b->containers[j], op, &c);
+            i++;
+            j++;
+        }
+
+        if (ok && c.cardinality > 0) ok = appendChunk(result, key, &c);
+        else if (ok) freeContainer(&c);
+        if (!ok) {
+            freeContainer(&c);
+            deleteRoaringBitmap(result);
+            LOG_ERROR("Memory allocation failed.");
+            return NULL;
+        }
+        if (op == OP_AND && (i == a->size || j == b->size)) break;
+    }
+    return result;
+}
+
+// Function to intersect two roaring bitmaps
+/**
+ * @brief Returns a new bitmap with the values present in both 'a' and 'b'.
+ */
+struct RoaringBitmap* roaringAnd(const struct RoaringBitmap* a, const struct RoaringBitmap* b) {
+    return combine(a, b, OP_AND);
+}
+
+// Function to merge two roaring bitmaps
+/**
+ * @brief Returns a new bitmap with the values present in 'a' or 'b'.
+ */
+struct RoaringBitmap* roaringOr(const struct RoaringBitmap* a, const struct RoaringBitmap* b) {
+    return combine(a, b, OP_OR);
+}
+
+// Function to subtract one roaring bitmap from another
+/**
+ * @brief Returns a new bitmap with the values of 'a' that are not in 'b'.
+ */
+struct RoaringBitmap* roaringAndNot(const struct RoaringBitmap* a, const struct RoaringBitmap* b) {
+    return combine(a, b, OP_ANDNOT);
+}
+
+// Function to add the values of a container to a plain bitmap
+/**
+ * @brief ORs the values of any container into a 1024 word bitmap.
+ */
+static void containerOrWords(const struct RoaringContainer* c, uint64_t* words) {
+    if (c->type == ROARING_BITMAP) {
+        for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+            words[w] |= c->words[w];
+        }
+    } else if (c->type == ROARING_RUN) {
+        for (int r = 0; r < c->size; r++) {
+            setBitRange(words, c->runs[r].start, c->runs[r].start + c->runs[r].length);
+        }
+    } else {
+        for (int k = 0; k < c->size; k++) {
+            words[c->values[k] >> 6] |= 1ULL << (c->values[k] & 63);
+        }
+    }
+}
+
+// Function to merge many roaring bitmaps
+/**
+ * @brief Returns a new bitmap with the values present in any of 'k' bitmaps.
+ *
+ * The chunk keys of all bitmaps are merged in one pass. A chunk held by one bitmap only is
+ * copied; the containers of a chunk held by several are ORed into one 1024 word buffer,
+ * counted once and stored in their smallest representation. Unlike a chain of roaringOr,
+ * no intermediate bitmap is built.
+ *
+ * @return struct RoaringBitmap* The new bitmap or NULL if memory allocation fails.
+ */
+struct RoaringBitmap* roaringOrMany(const struct RoaringBitmap* const* bitmaps, size_t k) {
+    struct RoaringBitmap* result = createRoaringBitmap();
+    int* next = (int*)calloc(k > 0 ? k : 1, sizeof(int));
+    if (!result || !next) {
+        free(next);
+        deleteRoaringBitmap(result);
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    INSTR_COUNT_ALLOC((k > 0 ? k : 1) * sizeof(int));
+
+    uint64_t words[ROARING_BITMAP_WORDS];
+    int ok = 1;
+    while (ok) {
+        // Find the smallest chunk key not merged yet and the bitmaps that hold it
+        uint32_t key = 65536;
+        size_t holders = 0;
+        size_t holder = 0;
+        for (size_t i = 0; i < k; i++) {
+            if (next[i] == bitmaps[i]->size) continue;
+            uint16_t own = bitmaps[i]->keys[next[i]];
+            if (own < key) {
+                key = own;
+                holders = 1;
+                holder = i;
+            } else if (own == key) {
+                holders++;
+            }
+        }
+        if (holders == 0) break;
+
+        struct RoaringContainer c;
+        initContainer(&c);
+        if (holders == 1) {
+            ok = copyContainer(&c, &bitmaps[holder]->containers[next[holder]]);
+            next[holder]++;
+        } else {
+            memset(words, 0, sizeof(words));
+            for (size_t i = 0; i < k; i++) {
+                if (next[i] < bitmaps[i]->size && bitmaps[i]->keys[next[i]] == key) {
+                    containerOrWords(&bitmaps[i]->containers[next[i]], words);
+                    next[i]++;
+                }
+            }
+            int cardinality = 0;
+            for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+                cardinality += popcount64(words[w]);
+            }
+            ok = containerFromWords(&c, words, cardinality);
+        }
+        if (ok) ok = appendChunk(result, (uint16_t)key, &c);
+        else freeContainer(&c);
+    }
+    free(next);
+    if (!ok) {
+        deleteRoaringBitmap(result);
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    return result;
+}
+
+// Function to intersect many roaring bitmaps
+/**
+ * @brief Returns a new bitmap with the values present in all of 'k' bitmaps (k > 0).
+ *
+ * Only the chunks of the bitmap with the fewest chunks can be in the result. Each of them
+ * is looked up in the other bitmaps and ANDed with their containers one 64-bit word at a
+ * time, stopping as soon as a bitmap lacks the chunk or the words become empty.
+ *
+ * @return struct RoaringBitmap* The new bitmap or NULL if memory allocation fails.
+ */
+struct RoaringBitmap* roaringAndMany(const struct RoaringBitmap* const* bitmaps, size_t k) {
+    struct RoaringBitmap* result = createRoaringBitmap();
+    if (!result) return NULL;
+
+    size_t fewest = 0;
+    for (size_t i = 1; i < k; i++) {
+        if (bitmaps[i]->size < bitmaps[fewest]->size) fewest = i;
+    }
+    const struct RoaringBitmap* base = bitmaps[fewest];
+
+    uint64_t words[ROARING_BITMAP_WORDS];
+    uint64_t other[ROARING_BITMAP_WORDS];
+    int ok = 1;
+    for (int n = 0; ok && n < base->size; n++) {
+        containerToWords(&base->containers[n], words);
+        int cardinality = base->containers[n].cardinality;
+        for (size_t i = 0; cardinality > 0 && i < k; i++) {
+            int pos;
+            if (i == fewest) continue;
+            if (!findChunk(bitmaps[i], base->keys[n], &pos)) {
+                cardinality = 0;
+                break;
+            }
+            containerToWords(&bitmaps[i]->containers[pos], other);
+            cardinality = 0;
+            for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+                words[w] &= other[w];
+                cardinality += popcount64(words[w]);
+            }
+        }
+        if (cardinality == 0) continue;
+
+        struct RoaringContainer c;
+        initContainer(&c);
+        ok = containerFromWords(&c, words, cardinality);
+        if (ok) ok = appendChunk(result, base->keys[n], &c);
+        else freeContainer(&c);
+    }
+    if (!ok) {
+        deleteRoaringBitmap(result);
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    return result;
+}
+
+// Function to count the values two containers share
+/**
+ * @brief Returns |a AND b| for the containers of one chunk without building the result.
+ *
+ * An array container is probed value by value against the other container. Bitmap and run
+ * containers are compared as words, counting the common bits of each 64-bit word with popcount.
+ */
+static int containerAndCardinality(const struct RoaringContainer* a, const struct RoaringContainer* b) {
+    if (b->type == ROARING_ARRAY && a->type != ROARING_ARRAY) {
+        const struct RoaringContainer* t = a;
+        a = b;
+        b = t;
+    }
+    int count = 0;
+    if (a->type == ROARING_ARRAY) {
+        if (b->type == ROARING_ARRAY) {
+            int i = 0, j = 0;
+            while (i < a->size && j < b->size) {
+                uint16_t x = a->values[i];
+                uint16_t y = b->values[j];
+                count += (x == y);
+                i += (x <= y);
+                j += (y <= x);
+            }
+        } else {
+            for (int i = 0; i < a->size; i++) {
+                count += containerContains(b, a->values[i]);
+            }
+        }
+        return count;
+    }
+
+    uint64_t wordsA[ROARING_BITMAP_WORDS];
+    uint64_t wordsB[ROARING_BITMAP_WORDS];
+    const uint64_t* wa = a->words;
+    const uint64_t* wb = b->words;
+    if (a->type == ROARING_RUN) {
+        containerToWords(a, wordsA);
+        wa = wordsA;
+    }
+    if (b->type == ROARING_RUN) {
+        containerToWords(b, wordsB);
+        wb = wordsB;
+    }
+    for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+        count += popcount64(wa[w] & wb[w]);
+    }
+    return count;
+}
+
+// Function to count the values two roaring bitmaps share
+/**
+ * @brief Returns the number of values present in both 'a' and 'b', without allocating.
+ */
+size_t roaringAndCardinality(const struct RoaringBitmap* a, const struct RoaringBitmap* b) {
+    size_t total = 0;
+    int i = 0, j = 0;
+    while (i < a->size && j < b->size) {
+        if (a->keys[i] < b->keys[j]) {
+            i++;
+        } else if (b->keys[j] < a->keys[i]) {
+            j++;
+        } else {
+            total += (size_t)containerAndCardinality(&a->containers[i], &b->containers[j]);
+            i++;
+            j++;
+        }
+    }
+    return total;
+}
+
+// Function to test whether two roaring bitmaps share a value
+/**
+ * @brief Returns 1 if 'a' and 'b' have a value in common, stopping at the first chunk that does.
+ */
+int roaringIntersects(const struct RoaringBitmap* a, const struct RoaringBitmap* b) {
+    int i = 0, j = 0;
+    while (i < a->size && j < b->size) {
+        if (a->keys[i] < b->keys[j]) {
+            i++;
+        } else if (b->keys[j] < a->keys[i]) {
+            j++;
+        } else {
+            if (containerAndCardinality(&a->containers[i], &b->containers[j]) > 0) return 1;
+            i++;
+            j++;
+        }
+    }
+    return 0;
+}
+
+// Function to test whether one roaring bitmap is contained in another
+/**
+ * @brief Returns 1 if every value of 'a' is in 'b', stopping at the first chunk where one is not.
+ */
+int roaringIsSubset(const struct RoaringBitmap* a, const struct RoaringBitmap* b) {
+    int j = 0;
+    for (int i = 0; i < a->size; i++) {
+        const struct RoaringContainer* c = &a->containers[i];
+        while (j < b->size && b->keys[j] < a->keys[i]) j++;
+        if (j == b->size || b->keys[j] != a->keys[i]) return 0;
+        if (c->cardinality > b->containers[j].cardinality) return 0;
+        if (containerAndCardinality(c, &b->containers[j]) != c->cardinality) return 0;
+    }
+    return 1;
+}
+
+// Function to pick the smallest representation for every container
+/**
+ * @brief Converts each container to whichever of array, bitmap or run is smallest.
+ *
+ * @param bitmap The bitmap.
+ * @return int 1 on success, 0 if memory allocation failed (containers already converted stay converted).
+ */
+int roaringRunOptimize(struct RoaringBitmap* bitmap) {
+    uint64_t words[ROARING_BITMAP_WORDS];
+    for (int k = 0; k < bitmap->size; k++) {
+        struct RoaringContainer* c = &bitmap->containers[k];
+        containerToWords(c, words);
+
+        struct RoaringContainer optimised;
+        initContainer(&optimised);
+        if (!containerFromWords(&optimised, words, c->cardinality)) {
+            freeContainer(&optimised);
+            LOG_ERROR("Memory allocation failed.");
+            return 0;
+        }
+        freeContainer(c);
+        *c = optimised;
+    }
+    return 1;
+}
+
+// Function to measure the memory of a roaring bitmap
+/**
+ * @brief Returns the number of bytes allocated for the bitmap, its chunk index and containers.
+ */
+size_t roaringSizeInBytes(const struct RoaringBitmap* bitmap) {
+    size_t bytes = sizeof(struct RoaringBitmap);
+    bytes += (size_t)bitmap->capacity * (sizeof(uint16_t) + sizeof(struct RoaringContainer));
+    for (int k = 0; k < bitmap->size; k++) {
+        const struct RoaringContainer* c = &bitmap->containers[k];
+        if (c->type == ROARING_BITMAP) {
+            bytes += ROARING_BITMAP_WORDS * sizeof(uint64_t);
+        } else if (c->type == ROARING_RUN) {
+            bytes += (size_t)c->capacity * sizeof(struct RoaringRun);
+        } else {
+            bytes += (size_t)c->capacity * sizeof(uint16_t);
+        }
+    }
+    return bytes;
+}
+
+// Function to position an iterator at the start of its current container
+/**
+ * @brief Resets the in-container position of an iterator for container 'it->container'.
+ */
+static void iteratorEnterContainer(struct RoaringIterator* it) {
+    it->position = 0;
+    it->offset = 0;
+    it->word = 0;
+    if (it->container < it->bitmap->size) {
+        const struct RoaringContainer* c = &it->bitmap->containers[it->container];
+        if (c->type == ROARING_BITMAP) it->word = c->words[0];
+    }
+}
+
+// Function to take the next value from the current container
+/**
+ * @brief Reads the next low 16 bits from the current container.
+ *
+ * @return int 1 if a value was read into it->value, 0 if the container is exhausted.
+ */
+static int iteratorNextInContainer(struct RoaringIterator* it) {
+    const struct RoaringContainer* c = &it->bitmap->containers[it->container];
+    uint32_t high = (uint32_t)it->bitmap->keys[it->container] << 16;
+    int low;
+
+    if (c->type == ROARING_BITMAP) {
+        while (it->word == 0) {
+            if (++it->position >= ROARING_BITMAP_WORDS) return 0;
+            it->word = c->words[it->position];
+        }
+        low = it->position * 64 + trailingZeros64(it->word);
+        it->word &= it->word - 1;
+    } else if (c->type == ROARING_RUN) {
+        if (it->position >= c->size) return 0;
+        low = c->runs[it->position].start + it->offset;
+        if (++it->offset > c->runs[it->position].length) {
+            it->position++;
+            it->offset = 0;
+        }
+    } else {
+        if (it->position >= c->size) return 0;
+        low = c->values[it->position++];
+    }
+    it->value = fromKey(high | (uint32_t)low);
+    return 1;
+}
+
+// Function to move an iterator to the next value
+/**
+ * @brief Moves the iterator to the next larger value, clearing 'valid' after the last one.
+ *
+ * @param it The iterator.
+ */
+void roaringIteratorAdvance(struct RoaringIterator* it) {
+    while (it->container < it->bitmap->size) {
+        if (iteratorNextInContainer(it)) {
+            it->valid = 1;
+            return;
+        }
+        it->container++;
+        iteratorEnterContainer(it);
+    }
+    it->valid = 0;
+}
+
+// Function to move an iterator forward to a value
+/**
+ * @brief Moves the iterator to the first value >= 'value'; an iterator already there does not move.
+ *
+ * Whole chunks below the value are skipped with a binary search of the keys, and inside a
+ * container the iterator jumps straight to the position of the value.
+ *
+ * @param it The iterator.
+ * @param value The value to move to.
+ */
+void roaringIteratorSeek(struct RoaringIterator* it, int value) {
+    if (!it->valid || it->value >= value) return;
+
+    uint16_t key = (uint16_t)(toKey(value) >> 16);
+    uint16_t low = (uint16_t)(toKey(value) & 0xFFFF);
+    if (it->bitmap->keys[it->container] < key) {
+        int pos;
+        findChunk(it->bitmap, key, &pos);
+        it->container = pos;
+        iteratorEnterContainer(it);
+    }
+    if (it->container < it->bitmap->size && it->bitmap->keys[it->container] == key) {
+        const struct RoaringContainer* c = &it->bitmap->containers[it->container];
+        if (c->type == ROARING_ARRAY) {
+            int pos = arrayLowerBound(c->values, c->size, low);
+            if (pos > it->position) it->position = pos;
+        } else if (c->type == ROARING_BITMAP) {
+            int word = low >> 6;
+            if (word > it->position) {
+                it->position = word;
+                it->word = c->words[word];
+            }
+            if (word == it->position) it->word &= ~(uint64_t)0 << (low & 63);
+        } else {
+            int r = runFind(c->runs, c->size, low);
+            if (r >= 0 && low > c->runs[r].start + c->runs[r].length) r++;
+            if (r > it->position) {
+                it->position = r;
+                it->offset = 0;
+            }
+            if (r == it->position && r < c->size && low > c->runs[r].start + it->offset) {
+                it->offset = low - c->runs[r].start;
+            }
+        }
+    }
+    roaringIteratorAdvance(it);
+    while (it->valid && it->value < value) {
+        roaringIteratorAdvance(it);
+    }
+}
+
+// Function to start iterating over a roaring bitmap
+/**
+ * @brief Positions an iterator on the smallest value of the bitmap.
+ *
+ * @param it The iterator to initialise.
+ * @param bitmap The bitmap to iterate over.
+ */
+void roaringIteratorInit(struct RoaringIterator* it, const struct RoaringBitmap* bitmap) {
+    it->bitmap = bitmap;
+    it->valid = 0;
+    it->value = 0;
+    it->container = 0;
+    iteratorEnterContainer(it);
+    roaringIteratorAdvance(it);
+}
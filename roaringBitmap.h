@@ -0,0 +1,161 @@
+/**
+ * @file roaringBitmap.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the Roaring Bitmap data structure.<br/>
+ *
+ * This header file defines the structures and function prototypes for a compressed
+ * bitmap in the style of Roaring bitmaps. The 32-bit value space is split into chunks
+ * of 65536 values keyed by the high 16 bits. Each non-empty chunk is stored in the
+ * cheapest of three containers: a sorted array of the low 16 bits for sparse chunks,
+ * a 65536-bit bitmap for dense chunks, or a list of runs for chunks made of ranges.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef ROARING_BITMAP_H
+#define ROARING_BITMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Largest number of values held by an array container
+#define ROARING_ARRAY_MAX 4096
+
+// Number of 64-bit words in a bitmap container
+#define ROARING_BITMAP_WORDS 1024
+
+// Enumeration for container kinds
+/**
+ * @enum RoaringContainerType
+ * @brief Enum for the representation of one 65536 value chunk.
+ */
+typedef enum
+{
+    ROARING_ARRAY,    // Sorted array of low 16 bits, at most ROARING_ARRAY_MAX values
+    ROARING_BITMAP,   // ROARING_BITMAP_WORDS words, one bit per value
+    ROARING_RUN       // Sorted list of runs of consecutive values
+} RoaringContainerType;
+
+// Run structure
+/**
+ * @brief Structure representing the values start..start+length (inclusive) of a run container.
+ */
+struct RoaringRun
+{
+    uint16_t start;
+    uint16_t length;
+};
+
+// Container structure
+/**
+ * @brief Structure representing the values of one chunk.
+ *
+ * - 'type': which of 'values', 'words' or 'runs' holds the data (the others are NULL).
+ * - 'cardinality': number of values in the container.
+ * - 'size': entries used in 'values' (array) or 'runs' (run).
+ * - 'capacity': entries allocated in 'values' or 'runs'.
+ */
+struct RoaringContainer
+{
+    RoaringContainerType type;
+    int cardinality;
+    int size;
+    int capacity;
+    uint16_t* values;
+    uint64_t* words;
+    struct RoaringRun* runs;
+};
+
+// Roaring bitmap structure
+/**
+ * @brief Structure representing a Roaring Bitmap.
+ *
+ * - 'keys': high 16 bits of each chunk, ascending (values are offset so negative ints sort first).
+ * - 'containers': the container of each chunk, in the same order as 'keys'.
+ * - 'size': number of chunks in use.
+ * - 'capacity': number of chunks allocated.
+ */
+struct RoaringBitmap
+{
+    uint16_t* keys;
+    struct RoaringContainer* containers;
+    int size;
+    int capacity;
+};
+
+// Roaring iterator structure
+/**
+ * @brief Structure for walking the values of a Roaring Bitmap in ascending order.
+ *
+ * - 'valid': 1 while 'value' holds the current value.
+ * - 'container', 'position', 'offset', 'word': position inside the bitmap.
+ */
+struct RoaringIterator
+{
+    const struct RoaringBitmap* bitmap;
+    int valid;
+    int value;
+    int container;
+    int position;
+    int offset;
+    uint64_t word;
+};
+
+// Function declarations
+/**
+ * @brief Function declarations for Roaring Bitmap operations.
+ *
+ * - 'createRoaringBitmap' / 'deleteRoaringBitmap': create an empty bitmap, free a bitmap.
+ * - 'roaringAdd' / 'roaringRemove': return 1 if the bitmap changed, 0 if not, -1 on allocation failure.
+ * - 'roaringAddRange': adds every value in [low, high], stored as runs where that is smallest.
+ * - 'roaringContains': returns 1 if the value is in the bitmap.
+ * - 'roaringCardinality': number of values in the bitmap.
+ * - 'roaringRank': number of values smaller than a given value.
+ * - 'roaringSelect': the value at a 0-based position in ascending order; returns 0 if there are not enough values.
+ * - 'roaringPredecessor': the largest value smaller than a given value; returns 0 if there is none.
+ * - 'roaringAnd' / 'roaringOr' / 'roaringAndNot': new bitmap with the intersection, union or difference.
+ * - 'roaringOrMany' / 'roaringAndMany': new bitmap with the union or intersection of k bitmaps, combined chunk
+ *   by chunk in one pass.
+ * - 'roaringAndCardinality': size of the intersection, computed without building it.
+ * - 'roaringIntersects' / 'roaringIsSubset': 1 if the bitmaps share a value / if every value of 'a' is in 'b'.
+ * - 'roaringRunOptimize': converts every container to its smallest representation.
+ * - 'roaringSizeInBytes': bytes allocated for the bitmap and its containers.
+ * - 'roaringIteratorInit' / 'roaringIteratorAdvance': walk the values in ascending order.
+ * - 'roaringIteratorSeek': moves an iterator forward to the first value >= a given value.
+ */
+struct RoaringBitmap* createRoaringBitmap();
+void deleteRoaringBitmap(struct RoaringBitmap* bitmap);
+int roaringAdd(struct RoaringBitmap* bitmap, int value);
+int roaringAddRange(struct RoaringBitmap* bitmap, int low, int high);
+int roaringRemove(struct RoaringBitmap* bitmap, int value);
+int roaringContains(const struct RoaringBitmap* bitmap, int value);
+size_t roaringCardinality(const struct RoaringBitmap* bitmap);
+size_t roaringRank(const struct RoaringBitmap* bitmap, int value);
+int roaringSelect(const struct RoaringBitmap* bitmap, size_t k, int* value);
+int roaringPredecessor(const struct RoaringBitmap* bitmap, int value, int* predecessor);
+struct RoaringBitmap* roaringAnd(const struct RoaringBitmap* a, const struct RoaringBitmap* b);
+struct RoaringBitmap* roaringOr(const struct RoaringBitmap* a, const struct RoaringBitmap* b);
+struct RoaringBitmap* roaringAndNot(const struct RoaringBitmap* a, const struct RoaringBitmap* b);
+struct RoaringBitmap* roaringOrMany(const struct RoaringBitmap* const* bitmaps, size_t k);
+struct RoaringBitmap* roaringAndMany(const struct RoaringBitmap* const* bitmaps, size_t k);
+size_t roaringAndCardinality(const struct RoaringBitmap* a, const struct RoaringBitmap* b);
+int roaringIntersects(const struct RoaringBitmap* a, const struct RoaringBitmap* b);
+int roaringIsSubset(const struct RoaringBitmap* a, const struct RoaringBitmap* b);
+int roaringRunOptimize(struct RoaringBitmap* bitmap);
+size_t roaringSizeInBytes(const struct RoaringBitmap* bitmap);
+void roaringIteratorInit(struct RoaringIterator* it, const struct RoaringBitmap* bitmap);
+void roaringIteratorAdvance(struct RoaringIterator* it);
+void roaringIteratorSeek(struct RoaringIterator* it, int value);
+
+#endif // ROARING_BITMAP_H
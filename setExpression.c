@@ -0,0 +1,632 @@
+/**
+ * @file setExpression.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for lazy set expressions evaluated in one fused pass.<br/>
+ *
+ * This file contains the reference counted expression nodes, a parser for the text
+ * form used by batch mode, and the evaluator. The evaluator turns the expression into
+ * a tree of streams, one per use of a node, allocated in a single block. Each stream
+ * keeps its current value; an operator settles on its next value by comparing the
+ * values of its operands and advancing or seeking the smaller one. The root stream is
+ * drained into a buffer sized from an upper bound on the result, so evaluation makes
+ * one allocation for the streams and one for the result.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdlib.h>
+#include <limits.h>
+
+// include module header files
+#include "setExpression.h"
+#include "setKernels.h"
+#include "logging.h"
+
+// Largest number of streams an evaluation may use (a node shared by several operators counts once per use)
+#define SET_EXPR_MAX_STREAMS (1 << 20)
+
+// Deepest nesting of parentheses accepted by the parser
+#define SET_EXPR_MAX_DEPTH 256
+
+// Expression stream structure
+/**
+ * @brief Structure holding the evaluation state of one use of an expression node.
+ *
+ * - 'kind': the kind of the node.
+ * - 'valid' / 'value': whether the stream has a current element, and that element.
+ * - 'it': iterator over the set of a leaf.
+ * - 'left' / 'right': the operand streams of an operator.
+ */
+struct ExprStream
+{
+    SetExprKind kind;
+    int valid;
+    int value;
+    SetIterator it;
+    struct ExprStream* left;
+    struct ExprStream* right;
+};
+
+// Function to create an expression node
+/**
+ * @brief Allocates an expression node holding one reference.
+ *
+ * @return SetExpression* The node, or NULL if memory allocation fails (the operands are released).
+ */
+static SetExpression* createNode(SetExprKind kind, const OrderedIntSet* set,
+                                 SetExpression* left, SetExpression* right) {
+    SetExpression* expr = (SetExpression*)malloc(sizeof(SetExpression));
+    if (!expr) {
+        LOG_ERROR("Memory allocation failed.");
+        deleteSetExpression(left);
+        deleteSetExpression(right);
+        return NULL;
+    }
+    expr->kind = kind;
+    expr->set = set;
+    expr->left = left;
+    expr->right = right;
+    expr->references = 1;
+    return expr;
+}
+
+// Function to create a leaf expression
+/**
+ * @brief Creates an expression that stands for an existing set.
+ *
+ * @param set The set; it is borrowed, not copied, and must outlive the expression.
+ * @return SetExpression* The leaf, or NULL if 'set' is NULL or memory allocation fails.
+ */
+SetExpression* setExprLeaf(const OrderedIntSet* set) {
+    if (!set) return NULL;
+    return createNode(SET_EXPR_LEAF, set, NULL, NULL);
+}
+
+// Function to create an operator expression
+/**
+ * @brief Creates an operator node that takes over the caller's references to both operands.
+ *
+ * @return SetExpression* The node, or NULL if an operand is NULL or memory allocation fails.
+ */
+static SetExpression* createOperator(SetExprKind kind, SetExpression* left, SetExpression* right) {
+    if (!left || !right) {
+        deleteSetExpression(left);
+        deleteSetExpression(right);
+        return NULL;
+    }
+    return createNode(kind, NULL, left, right);
+}
+
+// Function to create an intersection expression
+/**
+ * @brief Creates an expression for the elements in both operands.
+ *
+ * @param left The first operand (its reference is taken over).
+ * @param right The second operand (its reference is taken over).
+ * @return SetExpression* The expression, or NULL if an operand is NULL or memory allocation fails.
+ */
+SetExpression* setExprIntersection(SetExpression* left, SetExpression* right) {
+    return createOperator(SET_EXPR_INTERSECTION, left, right);
+}
+
+// Function to create a union expression
+/**
+ * @brief Creates an expression for the elements in either operand.
+ *
+ * @param left The first operand (its reference is taken over).
+ * @param right The second operand (its reference is taken over).
+ * @return SetExpression* The expression, or NULL if an operand is NULL or memory allocation fails.
+ */
+SetExpression* setExprUnion(SetExpression* left, SetExpression* right) {
+    return createOperator(SET_EXPR_UNION, left, right);
+}
+
+// Function to create a difference expression
+/**
+ * @brief Creates an expression for the elements of 'left' that are not in 'right'.
+ *
+ * @param left The first operand (its reference is taken over).
+ * @param right The second operand (its reference is taken over).
+ * @return SetExpression* The expression, or NULL if an operand is NULL or memory allocation fails.
+ */
+SetExpression* setExprDifference(SetExpression* left, SetExpression* right) {
+    return createOperator(SET_EXPR_DIFFERENCE, left, right);
+}
+
+// Function to add a reference to an expression
+/**
+ * @brief Adds a reference to an expression, so it can be passed to a second operator.
+ *
+ * @param expr The expression (may be NULL).
+ * @return SetExpression* 'expr'.
+ */
+SetExpression* retainSetExpression(SetExpression* expr) {
+    if (expr) expr->references++;
+    return expr;
+}
+
+// Function to release an expression
+/**
+ * @brief Drops a reference to an expression, freeing it and releasing its operands with the last one.
+ *
+ * The leaf sets are not deleted.
+ *
+ * @param expr The expression (may be NULL).
+ */
+void deleteSetExpression(SetExpression* expr) {
+    while (expr && --expr->references == 0) {
+        SetExpression* right = expr->right;
+        deleteSetExpression(expr->left);
+        free(expr);
+        expr = right;   // Release the right operand in the loop, so long chains do not recurse
+    }
+}
+
+// Function to count the streams an expression needs
+/**
+ * @brief Counts the nodes of the expression tree, counting a shared node once per use.
+ *
+ * @return size_t The number of streams, or SET_EXPR_MAX_STREAMS + 1 if there are more than the limit.
+ */
+static size_t countStreams(const SetExpression* expr) {
+    if (expr->kind == SET_EXPR_LEAF) return 1;
+    size_t total = 1 + countStreams(expr->left);
+    if (total <= SET_EXPR_MAX_STREAMS) total += countStreams(expr->right);
+    return total <= SET_EXPR_MAX_STREAMS ? total : SET_EXPR_MAX_STREAMS + 1;
+}
+
+// Function to bound the size of an expression
+/**
+ * @brief Computes an upper bound on the number of elements of an expression.
+ *
+ * A leaf has exactly its count, an intersection at most its smaller operand, a union
+ * at most both operands together and a difference at most its left operand.
+ */
+static size_t sizeBound(const SetExpression* expr) {
+    size_t left, right;
+    switch (expr->kind) {
+    case SET_EXPR_LEAF:
+        return (size_t)expr->set->count;
+    case SET_EXPR_INTERSECTION:
+        left = sizeBound(expr->left);
+        right = sizeBound(expr->right);
+        return left < right ? left : right;
+    case SET_EXPR_UNION:
+        left = sizeBound(expr->left);
+        right = sizeBound(expr->right);
+        return left + right;
+    default:
+        return sizeBound(expr->left);
+    }
+}
+
+static void streamSeek(struct ExprStream* s, int value);
+static void streamAdvance(struct ExprStream* s);
+
+// Function to settle an operator stream on its next element
+/**
+ * @brief Moves the operands of an operator forward until they agree on the next element of its result.
+ *
+ * The operands must already be positioned; afterwards 'valid' and 'value' describe the result.
+ *
+ * @param s The operator stream.
+ */
+static void streamSettle(struct ExprStream* s) {
+    struct ExprStream* left = s->left;
+    struct ExprStream* right = s->right;
+
+    if (s->kind == SET_EXPR_UNION) {
+        s->valid = left->valid || right->valid;
+        if (!left->valid) s->value = right->value;
+        else if (!right->valid) s->value = left->value;
+        else s->value = left->value < right->value ? left->value : right->value;
+        return;
+    }
+
+    for (;;) {
+        if (!left->valid) {
+            s->valid = 0;
+            return;
+        }
+        if (s->kind == SET_EXPR_INTERSECTION) {
+            if (!right->valid) {
+                s->valid = 0;
+                return;
+            }
+            if (left->value == right->value) break;
+            // Skip every element of the smaller operand that is below the other one
+            if (left->value < right->value) streamSeek(left, right->value);
+            else streamSeek(right, left->value);
+        } else {
+            if (!right->valid || right->value > left->value) break;
+            if (right->value < left->value) {
+                streamSeek(right, left->value);
+            } else {
+                streamAdvance(left);   // Removed by the right operand
+                streamAdvance(right);
+            }
+        }
+    }
+    s->valid = 1;
+    s->value = left->value;
+}
+
+// Function to read the current element of a leaf stream
+/**
+ * @brief Copies the state of a leaf iterator into its stream.
+ */
+static void leafLoad(struct ExprStream* s) {
+    s->valid = setIteratorValid(&s->it);
+    if (s->valid) s->value = setIteratorValue(&s->it);
+}
+
+// Function to move a stream to its next element
+/**
+ * @brief Moves a valid stream past its current element.
+ *
+ * @param s The stream.
+ */
+static void streamAdvance(struct ExprStream* s) {
+    if (s->kind == SET_EXPR_LEAF) {
+        setIteratorAdvance(&s->it);
+        leafLoad(s);
+        return;
+    }
+    if (s->kind == SET_EXPR_UNION) {
+        int value = s->value;
+        if (s->left->valid && s->left->value == value) streamAdvance(s->left);
+        if (s->right->valid && s->right->value == value) streamAdvance(s->right);
+    } else {
+        streamAdvance(s->left);
+        if (s->kind == SET_EXPR_INTERSECTION) streamAdvance(s->right);
+    }
+    streamSettle(s);
+}
+
+// Function to move a stream forward to a value
+/**
+ * @brief Moves a stream to its first element >= 'value'; a stream already there does not move.
+ *
+ * @param s The stream.
+ * @param value The value to move to.
+ */
+static void streamSeek(struct ExprStream* s, int value) {
+    if (!s->valid || s->value >= value) return;
+    if (s->kind == SET_EXPR_LEAF) {
+        setIteratorSeek(&s->it, value);
+        leafLoad(s);
+        return;
+    }
+    streamSeek(s->left, value);
+    // A difference seeks its right operand lazily, only as far as the left one needs
+    if (s->kind != SET_EXPR_DIFFERENCE) streamSeek(s->right, value);
+    streamSettle(s);
+}
+
+// Function to build the streams of an expression
+/**
+ * @brief Lays out the streams for 'expr' in 'next' (depth first) and positions them on their first element.
+ *
+ * @param expr The expression.
+ * @param next The next free stream; advanced past the streams used.
+ * @return struct ExprStream* The stream for 'expr'.
+ */
+static struct ExprStream* buildStream(const SetExpression* expr, struct ExprStream** next) {
+    struct ExprStream* s = (*next)++;
+    s->kind = expr->kind;
+    s->left = NULL;
+    s->right = NULL;
+    if (expr->kind == SET_EXPR_LEAF) {
+        setIteratorInit(&s->it, expr->set);
+        leafLoad(s);
+        return s;
+    }
+    s->left = buildStream(expr->left, next);
+    s->right = buildStream(expr->right, next);
+    streamSettle(s);
+    return s;
+}
+
+// Function to open an expression for streaming
+/**
+ * @brief Allocates and positions the streams of an expression.
+ *
+ * @param expr The expression.
+ * @param root Receives the root stream.
+ * @return struct ExprStream* The block of streams to free afterwards, or NULL on failure.
+ */
+static struct ExprStream* openStreams(const SetExpression* expr, struct ExprStream** root) {
+    size_t count = countStreams(expr);
+    if (count > SET_EXPR_MAX_STREAMS) {
+        LOG_ERROR("Set expression is too large.");
+        return NULL;
+    }
+    struct ExprStream* streams = (struct ExprStream*)malloc(count * sizeof(struct ExprStream));
+    if (!streams) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    struct ExprStream* next = streams;
+    *root = buildStream(expr, &next);
+    return streams;
+}
+
+// Function to evaluate a set expression
+/**
+ * @brief Computes the elements of an expression as a new sorted array set.
+ *
+ * The result buffer is allocated once, with room for an upper bound on the result size,
+ * and filled by draining the fused stream. An operator directly over two sorted array
+ * sets uses the vectorised kernels instead, as setIntersection and friends do.
+ *
+ * @param expr The expression.
+ * @return OrderedIntSet* The result, or NULL if 'expr' is NULL or memory allocation fails.
+ */
+OrderedIntSet* evaluateSetExpression(const SetExpression* expr) {
+    if (!expr) return NULL;
+
+    struct SortedArray* array;
+    if (expr->kind == SET_EXPR_LEAF) {
+        if (!(array = createSortedArray((size_t)expr->set->count))) return NULL;
+        array->size = copyElements(expr->set, array->data);
+        return createOrderedSetFromSortedArray(array);
+    }
+
+    const OrderedIntSet* s1 = expr->left->set;
+    const OrderedIntSet* s2 = expr->right->set;
+    if (s1 && s2 && s1->backend == SET_BACKEND_SORTED_ARRAY && s2->backend == SET_BACKEND_SORTED_ARRAY) {
+        if (!(array = createSortedArray(sizeBound(expr)))) return NULL;
+        const int* a = s1->array->data;
+        const int* b = s2->array->data;
+        if (expr->kind == SET_EXPR_INTERSECTION) {
+            array->size = intersectSortedInts(a, s1->array->size, b, s2->array->size, array->data);
+        } else if (expr->kind == SET_EXPR_UNION) {
+            array->size = unionSortedInts(a, s1->array->size, b, s2->array->size, array->data);
+        } else {
+            array->size = differenceSortedInts(a, s1->array->size, b, s2->array->size, array->data);
+        }
+        return createOrderedSetFromSortedArray(array);
+    }
+
+    // Open the streams first: it rejects expressions too large to bound quickly
+    struct ExprStream* root;
+    struct ExprStream* streams = openStreams(expr, &root);
+    if (!streams) return NULL;
+    if (!(array = createSortedArray(sizeBound(expr)))) {
+        free(streams);
+        return NULL;
+    }
+    int* out = array->data;
+    while (root->valid) {
+        *out++ = root->value;
+        streamAdvance(root);
+    }
+    array->size = (size_t)(out - array->data);
+    free(streams);
+    return createOrderedSetFromSortedArray(array);
+}
+
+// Function to count the elements of a set expression
+/**
+ * @brief Computes the number of elements of an expression without storing them.
+ *
+ * @param expr The expression.
+ * @param count Receives the number of elements.
+ * @return int 1 on success, 0 if 'expr' is NULL or memory allocation fails.
+ */
+int countSetExpression(const SetExpression* expr, size_t* count) {
+    if (!expr || !count) return 0;
+    if (expr->kind == SET_EXPR_LEAF) {
+        *count = (size_t)expr->set->count;
+        return 1;
+    }
+
+    struct ExprStream* root;
+    struct ExprStream* streams = openStreams(expr, &root);
+    if (!streams) return 0;
+    size_t total = 0;
+    while (root->valid) {
+        total++;
+        streamAdvance(root);
+    }
+    free(streams);
+    *count = total;
+    return 1;
+}
+
+// Expression parser structure
+/**
+ * @brief Structure holding the state of the expression parser.
+ *
+ * - 'text': the next unread character.
+ * - 'sets' / 'maxSets': the set slots that numbers refer to, when 'lookup' is NULL.
+ * - 'lookup' / 'context': resolve set names, when not NULL.
+ * - 'depth': current nesting of parentheses.
+ * - 'error': description of the first error, or NULL.
+ */
+struct ExprParser
+{
+    const char* text;
+    OrderedIntSet** sets;
+    int maxSets;
+    SetNameLookup lookup;
+    void* context;
+    int depth;
+    const char* error;
+};
+
+// Function to skip spaces in an expression
+/**
+ * @brief Skips blanks and returns the next character of the expression.
+ */
+static char parserPeek(struct ExprParser* parser) {
+    while (*parser->text == ' ' || *parser->text == '\t') parser->text++;
+    return *parser->text;
+}
+
+// Function to record a parse error
+/**
+ * @brief Records the first parse error.
+ *
+ * @return SetExpression* Always NULL, so callers can return it.
+ */
+static SetExpression* parserError(struct ExprParser* parser, const char* message) {
+    if (!parser->error) parser->error = message;
+    return NULL;
+}
+
+static SetExpression* parseUnion(struct ExprParser* parser);
+
+// Function to check for a character of a set name
+/**
+ * @brief Returns 1 if 'c' may appear in a set name of an expression.
+ */
+static int isNameChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '_' || c == '.' || c == ':';
+}
+
+// Function to parse a set index or a parenthesised expression
+/**
+ * @brief Parses primary := index | name | '(' expression ')'.
+ */
+static SetExpression* parsePrimary(struct ExprParser* parser) {
+    char c = parserPeek(parser);
+    if (c == '(') {
+        if (++parser->depth > SET_EXPR_MAX_DEPTH) return parserError(parser, "Expression nested too deeply.");
+        parser->text++;
+        SetExpression* expr = parseUnion(parser);
+        parser->depth--;
+        if (!expr) return NULL;
+        if (parserPeek(parser) != ')') {
+            deleteSetExpression(expr);
+            return parserError(parser, "Expected ')'.");
+        }
+        parser->text++;
+        return expr;
+    }
+    if (parser->lookup) {
+        if (!isNameChar(c)) return parserError(parser, "Expected a set name or '('.");
+        const char* name = parser->text;
+        while (isNameChar(*parser->text)) parser->text++;
+        OrderedIntSet* set = parser->lookup(parser->context, name, (size_t)(parser->text - name));
+        if (!set) return parserError(parser, "No set has this name.");
+        SetExpression* leaf = setExprLeaf(set);
+        return leaf ? leaf : parserError(parser, "Memory allocation failed.");
+    }
+    if (c < '0' || c > '9') return parserError(parser, "Expected a set index or '('.");
+
+    long long index = 0;
+    while (*parser->text >= '0' && *parser->text <= '9') {
+        if (index <= INT_MAX) index = index * 10 + (*parser->text - '0');
+        parser->text++;
+    }
+    if (index >= parser->maxSets) return parserError(parser, "Invalid index.");
+    if (!parser->sets[index]) return parserError(parser, "No set exists at this index.");
+    SetExpression* leaf = setExprLeaf(parser->sets[index]);
+    return leaf ? leaf : parserError(parser, "Memory allocation failed.");
+}
+
+// Function to parse a chain of intersections
+/**
+ * @brief Parses intersection := primary ('&' primary)*.
+ */
+static SetExpression* parseIntersection(struct ExprParser* parser) {
+    SetExpression* expr = parsePrimary(parser);
+    while (expr && parserPeek(parser) == '&') {
+        parser->text++;
+        SetExpression* right = parsePrimary(parser);
+        if (!right) {
+            deleteSetExpression(expr);
+            return NULL;
+        }
+        expr = setExprIntersection(expr, right);
+        if (!expr) return parserError(parser, "Memory allocation failed.");
+    }
+    return expr;
+}
+
+// Function to parse a chain of unions and differences
+/**
+ * @brief Parses expression := intersection (('|' | '-') intersection)*.
+ */
+static SetExpression* parseUnion(struct ExprParser* parser) {
+    SetExpression* expr = parseIntersection(parser);
+    char c;
+    while (expr && ((c = parserPeek(parser)) == '|' || c == '-')) {
+        parser->text++;
+        SetExpression* right = parseIntersection(parser);
+        if (!right) {
+            deleteSetExpression(expr);
+            return NULL;
+        }
+        expr = c == '|' ? setExprUnion(expr, right) : setExprDifference(expr, right);
+        if (!expr) return parserError(parser, "Memory allocation failed.");
+    }
+    return expr;
+}
+
+// Function to parse a whole expression
+/**
+ * @brief Parses the text of a parser and checks that nothing follows the expression.
+ *
+ * @return SetExpression* The expression, or NULL with '*error' set (if 'error' is not NULL).
+ */
+static SetExpression* parseText(struct ExprParser* parser, const char** error) {
+    SetExpression* expr = parseUnion(parser);
+    if (expr && parserPeek(parser) != '\0') {
+        deleteSetExpression(expr);
+        expr = parserError(parser, "Unexpected text after the expression.");
+    }
+    if (!expr && error) *error = parser->error;
+    return expr;
+}
+
+// Function to parse a set expression
+/**
+ * @brief Builds an expression from its text form.
+ *
+ * Numbers are indices into 'sets'; '&' is intersection, '|' union and '-' difference.
+ * '&' binds tighter than '|' and '-', operators of the same precedence are left
+ * associative and parentheses group as usual, so "0 | 1 & 2 - 3" means (0 | (1 & 2)) - 3.
+ *
+ * @param text The expression.
+ * @param sets The set slots.
+ * @param maxSets Number of set slots.
+ * @param error Receives a description of the problem on failure (may be NULL).
+ * @return SetExpression* The expression, or NULL if the text is invalid or memory allocation fails.
+ */
+SetExpression* parseSetExpression(const char* text, OrderedIntSet** sets, int maxSets, const char** error) {
+    struct ExprParser parser = { text, sets, maxSets, NULL, NULL, 0, NULL };
+    return parseText(&parser, error);
+}
+
+// Function to parse a set expression over named sets
+/**
+ * @brief Builds an expression from its text form, where operands are set names.
+ *
+ * A name is a run of letters, digits, '_', '.' and ':'; 'lookup' maps it to a set. The
+ * operators and their precedence are those of parseSetExpression.
+ *
+ * @param text The expression.
+ * @param lookup Returns the set with a given name, or NULL if there is none.
+ * @param context Passed to 'lookup'.
+ * @param error Receives a description of the problem on failure (may be NULL).
+ * @return SetExpression* The expression, or NULL if the text is invalid or memory allocation fails.
+ */
+SetExpression* parseNamedSetExpression(const char* text, SetNameLookup lookup, void* context, const char** error) {
+    struct ExprParser parser = { text, NULL, 0, lookup, context, 0, NULL };
+    return parseText(&parser, error);
+}
@@ -0,0 +1,108 @@
+/**
+ * @file setExpression.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for lazy set expressions evaluated in one fused pass.<br/>
+ *
+ * This header file declares an expression type that describes a combination of
+ * intersections, unions and differences of ordered sets, such as (A | B) & (C - D),
+ * without computing anything. Evaluating the expression runs one streaming merge over
+ * iterators of the leaf sets: every operator pulls ascending values from its operands,
+ * so no intermediate set is built and the leaves are read once. Intersections and
+ * differences move their operands forward with seeks, which skip runs of elements that
+ * cannot be in the result. An expression can also be counted without storing its elements.
+ *
+ * Expressions borrow their leaf sets, which must stay alive and unchanged while the
+ * expression is in use. Nodes are reference counted, so one sub-expression can be used
+ * by several operators; each use is streamed separately.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef SET_EXPRESSION_H
+#define SET_EXPRESSION_H
+
+#include <stddef.h>
+
+#include "orderedSet.h"
+
+// Enumeration for expression node kinds
+/**
+ * @enum SetExprKind
+ * @brief Enum for the kind of a node in a set expression.
+ */
+typedef enum
+{
+    SET_EXPR_LEAF,           // An existing ordered set
+    SET_EXPR_INTERSECTION,   // Elements in both operands
+    SET_EXPR_UNION,          // Elements in either operand
+    SET_EXPR_DIFFERENCE      // Elements of the left operand that are not in the right one
+} SetExprKind;
+
+// Set expression structure
+/**
+ * @brief Structure representing one node of a set expression.
+ *
+ * - 'kind': what the node computes.
+ * - 'set': the borrowed set of a leaf, NULL otherwise.
+ * - 'left' / 'right': the operands of an operator, NULL for a leaf.
+ * - 'references': number of owners (callers and parent nodes); the node is freed with the last one.
+ */
+typedef struct SetExpression
+{
+    SetExprKind kind;
+    const OrderedIntSet* set;
+    struct SetExpression* left;
+    struct SetExpression* right;
+    int references;
+} SetExpression;
+
+// Set name lookup function
+/**
+ * @brief Function returning the set called name[0 .. length), or NULL if there is none.
+ *
+ * The name is not NUL terminated; 'context' is the pointer given to parseNamedSetExpression.
+ */
+typedef OrderedIntSet* (*SetNameLookup)(void* context, const char* name, size_t length);
+
+// Function declarations
+/**
+ * @brief Function declarations for set expressions.
+ *
+ * - 'setExprLeaf': creates a leaf for an existing set.
+ * - 'setExprIntersection' / 'setExprUnion' / 'setExprDifference': create an operator node. The node takes
+ *   over the caller's reference to each operand; if an operand is NULL or allocation fails, the other
+ *   operand is released and NULL is returned, so calls can be nested without checking each one.
+ * - 'retainSetExpression': adds a reference, for using a node as the operand of a second operator.
+ * - 'deleteSetExpression': drops a reference, freeing the node and its operands with the last one.
+ * - 'evaluateSetExpression': computes the expression as a new sorted array set.
+ * - 'countSetExpression': computes only the number of elements of the expression.
+ * - 'parseSetExpression': builds an expression from text such as "(0 | 1) & (2 - 3)", where numbers are
+ *   indices into 'sets'. '&' binds tighter than '|' and '-', which are left associative.
+ * - 'parseNamedSetExpression': like parseSetExpression, but operands are names such as "users.active",
+ *   resolved by 'lookup'.
+ *
+ * Functions returning int return 1 on success and 0 if memory allocation failed.
+ */
+SetExpression* setExprLeaf(const OrderedIntSet* set);
+SetExpression* setExprIntersection(SetExpression* left, SetExpression* right);
+SetExpression* setExprUnion(SetExpression* left, SetExpression* right);
+SetExpression* setExprDifference(SetExpression* left, SetExpression* right);
+SetExpression* retainSetExpression(SetExpression* expr);
+void deleteSetExpression(SetExpression* expr);
+OrderedIntSet* evaluateSetExpression(const SetExpression* expr);
+int countSetExpression(const SetExpression* expr, size_t* count);
+SetExpression* parseSetExpression(const char* text, OrderedIntSet** sets, int maxSets, const char** error);
+SetExpression* parseNamedSetExpression(const char* text, SetNameLookup lookup, void* context, const char** error);
+
+#endif // SET_EXPRESSION_H
@@ -0,0 +1,933 @@
+/**
+ * @file setKernels.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the set operation kernels over sorted int buffers.<br/>
+ *
+ * This file contains the scalar, SSE4.2 and AVX2 kernels, the CPU feature detection
+ * and the dispatch between them, a table of kernels published with an atomic pointer
+ * store so that threads may make their first kernel call at the same time. The vector intersection and difference compare a
+ * block of one buffer against every rotation of a block of the other, so one compare
+ * instruction tests many pairs at once without data dependent branches. The vector
+ * union merges blocks with a bitonic merge network built from min/max instructions.
+ * The scalar kernels advance their pointers by comparison results instead of
+ * branching. When one buffer is much smaller than the other, an intersection locates
+ * each of its elements in the larger one by galloping (exponential) search instead.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// include module header file
+#include "setKernels.h"
+
+// Vector kernels are only built for x86 compilers
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SET_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define SET_KERNELS_X86 0
+#endif
+
+// GCC and Clang need the target instruction set on each vector function; MSVC does not
+#if SET_KERNELS_X86 && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE42 __attribute__((target("sse4.2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE42
+#define TARGET_AVX2
+#endif
+
+// Use galloping search when one buffer is this many times larger than the other
+#define GALLOP_RATIO 32
+
+// Function to find the lowest set bit of a mask
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero mask.
+ *
+ * @param mask A non-zero bit mask.
+ * @return int Index of the lowest set bit.
+ */
+static int lowestBit(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Function to count the set bits of a mask
+/**
+ * @brief Returns the number of set bits in a lane mask.
+ */
+static int bitCount(unsigned int mask) {
+#if defined(_MSC_VER)
+    return (int)__popcnt(mask);
+#else
+    return __builtin_popcount(mask);
+#endif
+}
+
+// Function to find the first element not smaller than a value, starting from a position
+/**
+ * @brief Galloping search: finds the first position >= 'start' whose value is >= 'value'.
+ *
+ * The search probes start+1, start+2, start+4, ... until it passes 'value' and then
+ * binary searches the last gap, so it costs O(log d) where d is the distance moved.
+ *
+ * @param data Sorted buffer.
+ * @param n Number of elements in the buffer.
+ * @param start Position to search from.
+ * @param value The value searched for.
+ * @return size_t The position found, or 'n' if every remaining element is smaller.
+ */
+static size_t gallop(const int* data, size_t n, size_t start, int value) {
+    if (start >= n || data[start] >= value) return start;
+
+    size_t low = start;   // data[low] < value
+    size_t step = 1;
+    while (low + step < n && data[low + step] < value) {
+        low += step;
+        step *= 2;
+    }
+    size_t high = (low + step < n) ? low + step : n;  // data[high] >= value or high == n
+
+    while (low + 1 < high) {
+        size_t mid = low + (high - low) / 2;
+        if (data[mid] < value) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return high;
+}
+
+// Function to intersect a small buffer with a much larger one
+/**
+ * @brief Intersects two sorted buffers by galloping through the larger one.
+ *
+ * @param small The smaller sorted buffer.
+ * @param ns Number of elements in 'small'.
+ * @param large The larger sorted buffer.
+ * @param nl Number of elements in 'large'.
+ * @param out Receives the common elements.
+ * @return size_t Number of elements written.
+ */
+static size_t intersectGalloping(const int* small, size_t ns, const int* large, size_t nl, int* out) {
+    size_t n = 0;
+    size_t j = 0;
+    for (size_t i = 0; i < ns && j < nl; i++) {
+        j = gallop(large, nl, j, small[i]);
+        if (j < nl && large[j] == small[i]) {
+            out[n++] = small[i];
+            j++;
+        }
+    }
+    return n;
+}
+
+// Function to count the common elements of a small buffer and a much larger one
+/**
+ * @brief Counts the elements two sorted buffers share by galloping through the larger one.
+ */
+static size_t intersectCountGalloping(const int* small, size_t ns, const int* large, size_t nl) {
+    size_t n = 0;
+    size_t j = 0;
+    for (size_t i = 0; i < ns && j < nl; i++) {
+        j = gallop(large, nl, j, small[i]);
+        if (j < nl && large[j] == small[i]) {
+            n++;
+            j++;
+        }
+    }
+    return n;
+}
+
+// Function to intersect two sorted buffers in portable C
+/**
+ * @brief Intersects two sorted buffers with a branch free two pointer merge.
+ *
+ * Every step writes the current element of 'a' and only keeps it when it matches, and the
+ * pointers advance by the results of comparisons, so the loop has no unpredictable branch.
+ *
+ * @param a First sorted buffer.
+ * @param na Number of elements in 'a'.
+ * @param b Second sorted buffer.
+ * @param nb Number of elements in 'b'.
+ * @param out Receives the common elements.
+ * @return size_t Number of elements written.
+ */
+static size_t intersectScalar(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    size_t i = 0, j = 0, n = 0;
+    while (i < na && j < nb) {
+        int x = a[i];
+        int y = b[j];
+        out[n] = x;
+        n += (x == y);
+        i += (x <= y);
+        j += (y <= x);
+    }
+    return n;
+}
+
+// Function to count the common elements of two sorted buffers in portable C
+/**
+ * @brief Counts the elements two sorted buffers share with the branch free merge of intersectScalar.
+ */
+static size_t intersectCountScalar(const int* a, size_t na, const int* b, size_t nb) {
+    size_t i = 0, j = 0, n = 0;
+    while (i < na && j < nb) {
+        int x = a[i];
+        int y = b[j];
+        n += (x == y);
+        i += (x <= y);
+        j += (y <= x);
+    }
+    return n;
+}
+
+// Function to finish an intersection after a vector kernel
+/**
+ * @brief Intersects the tails left over by a vector kernel, writing only common elements.
+ *
+ * Unlike intersectScalar this never writes past the last common element. That matters
+ * because the tail of 'a' may start inside a block that already produced output.
+ */
+static size_t intersectTail(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    size_t i = 0, j = 0, n = 0;
+    while (i < na && j < nb) {
+        if (a[i] == b[j]) {
+            out[n++] = a[i];
+            i++;
+            j++;
+        } else if (a[i] < b[j]) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    return n;
+}
+
+// Function to merge two sorted buffers in portable C
+/**
+ * @brief Computes the union of two sorted buffers with a branch free merge.
+ *
+ * Each step writes the smaller of the two current elements and advances every pointer
+ * whose element was written; equal elements therefore advance both and appear once.
+ *
+ * @param a First sorted buffer.
+ * @param na Number of elements in 'a'.
+ * @param b Second sorted buffer.
+ * @param nb Number of elements in 'b'.
+ * @param out Receives the union.
+ * @return size_t Number of elements written.
+ */
+static size_t unionScalar(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    size_t i = 0, j = 0, n = 0;
+    while (i < na && j < nb) {
+        int x = a[i];
+        int y = b[j];
+        out[n++] = (x < y) ? x : y;
+        i += (x <= y);
+        j += (y <= x);
+    }
+    while (i < na) out[n++] = a[i++];
+    while (j < nb) out[n++] = b[j++];
+    return n;
+}
+
+// Function to subtract one sorted buffer from another in portable C
+/**
+ * @brief Computes the elements of 'a' not in 'b' with a branch free merge.
+ *
+ * Each step writes the current element of 'a' and only keeps it when it is smaller than
+ * the current element of 'b', which means 'b' cannot contain it.
+ *
+ * @param a Sorted buffer to subtract from.
+ * @param na Number of elements in 'a'.
+ * @param b Sorted buffer of elements to remove.
+ * @param nb Number of elements in 'b'.
+ * @param out Receives the difference.
+ * @return size_t Number of elements written.
+ */
+static size_t differenceScalar(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    size_t i = 0, j = 0, n = 0;
+    while (i < na && j < nb) {
+        int x = a[i];
+        int y = b[j];
+        out[n] = x;
+        n += (x < y);
+        i += (x <= y);
+        j += (y <= x);
+    }
+    while (i < na) out[n++] = a[i++];
+    return n;
+}
+
+// Function to finish a vector union
+/**
+ * @brief Merges the three sorted runs left over by a vector union, skipping duplicates.
+ *
+ * @param c Sorted buffer of the values still held in the merge register.
+ * @param nc Number of elements in 'c'.
+ * @param a Remaining part of the first input.
+ * @param na Number of elements in 'a'.
+ * @param b Remaining part of the second input.
+ * @param nb Number of elements in 'b'.
+ * @param out Receives the merged values after the 'n' already written.
+ * @param n Number of values already written to 'out' (the last one is used to skip duplicates).
+ * @return size_t Total number of values in 'out'.
+ */
+static size_t unionTail(const int* c, size_t nc, const int* a, size_t na, const int* b, size_t nb,
+                        int* out, size_t n) {
+    size_t k = 0, i = 0, j = 0;
+    while (k < nc || i < na || j < nb) {
+        int value = (k < nc) ? c[k] : (i < na) ? a[i] : b[j];
+        if (i < na && a[i] < value) value = a[i];
+        if (j < nb && b[j] < value) value = b[j];
+
+        if (n == 0 || out[n - 1] != value) out[n++] = value;
+        if (k < nc && c[k] == value) k++;
+        if (i < na && a[i] == value) i++;
+        if (j < nb && b[j] == value) j++;
+    }
+    return n;
+}
+
+// Function to finish a vector difference
+/**
+ * @brief Subtracts the tail of 'b' from the tail of 'a', skipping lanes already found in 'b'.
+ *
+ * @param a Remaining part of the buffer to subtract from.
+ * @param na Number of elements in 'a'.
+ * @param b Remaining part of the buffer of elements to remove.
+ * @param nb Number of elements in 'b'.
+ * @param matched Bit k set when a[k] was already found in an earlier block of 'b'.
+ * @param out Receives the difference.
+ * @return size_t Number of elements written.
+ */
+static size_t differenceTail(const int* a, size_t na, const int* b, size_t nb, unsigned int matched, int* out) {
+    size_t i = 0, j = 0, n = 0;
+    for (; i < na; i++) {
+        if (i < 8 && ((matched >> i) & 1)) continue;
+        while (j < nb && b[j] < a[i]) j++;
+        if (j == nb || b[j] != a[i]) out[n++] = a[i];
+    }
+    return n;
+}
+
+#if SET_KERNELS_X86
+// Function to intersect two sorted buffers four elements at a time
+/**
+ * @brief Intersects two sorted buffers with 128-bit compares of 4x4 element blocks.
+ *
+ * A block of 'a' is compared against the four rotations of a block of 'b'; the lanes of
+ * 'a' that matched are written out, and the block with the smaller last element is
+ * replaced by the next one. The tails are finished in scalar code.
+ */
+TARGET_SSE42 static size_t intersectSse42(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    size_t i = 0, j = 0, n = 0;
+    size_t na4 = na & ~(size_t)3;
+    size_t nb4 = nb & ~(size_t)3;
+
+    while (i < na4 && j < nb4) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+
+        __m128i m0 = _mm_cmpeq_epi32(va, vb);
+        __m128i m1 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)));
+        __m128i m2 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2)));
+        __m128i m3 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)));
+        __m128i match = _mm_or_si128(_mm_or_si128(m0, m1), _mm_or_si128(m2, m3));
+
+        unsigned int mask = (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(match));
+        while (mask) {
+            out[n++] = a[i + lowestBit(mask)];
+            mask &= mask - 1;
+        }
+
+        int lastA = a[i + 3];
+        int lastB = b[j + 3];
+        i += (lastA <= lastB) ? 4 : 0;
+        j += (lastB <= lastA) ? 4 : 0;
+    }
+    return n + intersectTail(a + i, na - i, b + j, nb - j, out + n);
+}
+
+// Function to count the common elements of two sorted buffers four elements at a time
+/**
+ * @brief Counts the elements two sorted buffers share with the block compares of intersectSse42.
+ *
+ * Nothing is written: the matches of each block are counted with a popcount of the lane mask.
+ */
+TARGET_SSE42 static size_t intersectCountSse42(const int* a, size_t na, const int* b, size_t nb) {
+    size_t i = 0, j = 0, n = 0;
+    size_t na4 = na & ~(size_t)3;
+    size_t nb4 = nb & ~(size_t)3;
+
+    while (i < na4 && j < nb4) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+
+        __m128i m0 = _mm_cmpeq_epi32(va, vb);
+        __m128i m1 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)));
+        __m128i m2 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2)));
+        __m128i m3 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)));
+        __m128i match = _mm_or_si128(_mm_or_si128(m0, m1), _mm_or_si128(m2, m3));
+        n += (size_t)bitCount((unsigned int)_mm_movemask_ps(_mm_castsi128_ps(match)));
+
+        int lastA = a[i + 3];
+        int lastB = b[j + 3];
+        i += (lastA <= lastB) ? 4 : 0;
+        j += (lastB <= lastA) ? 4 : 0;
+    }
+    return n + intersectCountScalar(a + i, na - i, b + j, nb - j);
+}
+
+// Function to sort a bitonic vector of four ints
+/**
+ * @brief Sorts a bitonic sequence of four ints with half cleaners at distance 2 and 1.
+ */
+TARGET_SSE42 static __m128i bitonicSort4(__m128i v) {
+    __m128i x = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    v = _mm_blend_epi16(_mm_min_epi32(v, x), _mm_max_epi32(v, x), 0xF0);
+    x = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+    v = _mm_blend_epi16(_mm_min_epi32(v, x), _mm_max_epi32(v, x), 0xCC);
+    return v;
+}
+
+// Function to write the lanes of a vector selected by a mask
+/**
+ * @brief Appends the lanes of 'values' whose bit is set in 'mask' to 'out'.
+ *
+ * @return size_t Number of lanes written.
+ */
+static size_t emitLanes(const int* values, unsigned int mask, int* out) {
+    size_t n = 0;
+    while (mask) {
+        out[n++] = values[lowestBit(mask)];
+        mask &= mask - 1;
+    }
+    return n;
+}
+
+// Function to merge two sorted buffers four elements at a time
+/**
+ * @brief Computes the union of two sorted buffers with a 4+4 bitonic merge network.
+ *
+ * The register 'high' always holds the four largest values merged so far. Each round
+ * loads the next block from the input whose next element is smaller, merges it with
+ * 'high', and writes the lower four values, dropping any that repeat the previous value.
+ */
+TARGET_SSE42 static size_t unionSse42(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    if (na < 4 || nb < 4) return unionScalar(a, na, b, nb, out);
+
+    size_t i = 4, j = 4, n = 0;
+    __m128i low = _mm_loadu_si128((const __m128i*)a);
+    __m128i high = _mm_loadu_si128((const __m128i*)b);
+    int last = 0;
+    int lanes[4];
+
+    for (;;) {
+        // Merge: reversed high makes a bitonic sequence with low
+        __m128i reversed = _mm_shuffle_epi32(high, _MM_SHUFFLE(0, 1, 2, 3));
+        __m128i mn = bitonicSort4(_mm_min_epi32(low, reversed));
+        high = bitonicSort4(_mm_max_epi32(low, reversed));
+
+        // Write the lower half, skipping values equal to their predecessor
+        __m128i previous = _mm_alignr_epi8(mn, _mm_set1_epi32(last), 12);
+        unsigned int keep = ~(unsigned int)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(mn, previous))) & 0xF;
+        if (n == 0) keep |= 1;
+        _mm_storeu_si128((__m128i*)lanes, mn);
+        if (keep == 0xF) {
+            _mm_storeu_si128((__m128i*)(out + n), mn);
+            n += 4;
+        } else {
+            n += emitLanes(lanes, keep, out + n);
+        }
+        last = lanes[3];
+
+        if (i + 4 > na || j + 4 > nb) break;
+        if (a[i] < b[j]) {
+            low = _mm_loadu_si128((const __m128i*)(a + i));
+            i += 4;
+        } else {
+            low = _mm_loadu_si128((const __m128i*)(b + j));
+            j += 4;
+        }
+    }
+
+    _mm_storeu_si128((__m128i*)lanes, high);
+    return unionTail(lanes, 4, a + i, na - i, b + j, nb - j, out, n);
+}
+
+// Function to subtract one sorted buffer from another four elements at a time
+/**
+ * @brief Computes the elements of 'a' not in 'b' with 128-bit compares of 4x4 blocks.
+ *
+ * Matches against every block of 'b' that overlaps the current block of 'a' are collected
+ * in a mask; once the block of 'b' reaches past the block of 'a', the unmatched lanes are
+ * written out.
+ */
+TARGET_SSE42 static size_t differenceSse42(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    size_t i = 0, j = 0, n = 0;
+    size_t na4 = na & ~(size_t)3;
+    size_t nb4 = nb & ~(size_t)3;
+    unsigned int matched = 0;
+
+    while (i < na4 && j < nb4) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+
+        __m128i m0 = _mm_cmpeq_epi32(va, vb);
+        __m128i m1 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)));
+        __m128i m2 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2)));
+        __m128i m3 = _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)));
+        __m128i match = _mm_or_si128(_mm_or_si128(m0, m1), _mm_or_si128(m2, m3));
+        matched |= (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(match));
+
+        int lastA = a[i + 3];
+        int lastB = b[j + 3];
+        if (lastA <= lastB) {
+            unsigned int keep = ~matched & 0xF;
+            if (keep == 0xF) {
+                _mm_storeu_si128((__m128i*)(out + n), va);
+                n += 4;
+            } else {
+                n += emitLanes(a + i, keep, out + n);
+            }
+            matched = 0;
+            i += 4;
+        }
+        if (lastB <= lastA) j += 4;
+    }
+    return n + differenceTail(a + i, na - i, b + j, nb - j, matched, out + n);
+}
+
+// Function to intersect two sorted buffers eight elements at a time
+/**
+ * @brief Intersects two sorted buffers with 256-bit compares of 8x8 element blocks.
+ *
+ * Same scheme as the SSE4.2 kernel, comparing a block of 'a' against the eight rotations
+ * of a block of 'b'.
+ */
+TARGET_AVX2 static size_t intersectAvx2(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    size_t i = 0, j = 0, n = 0;
+    size_t na8 = na & ~(size_t)7;
+    size_t nb8 = nb & ~(size_t)7;
+    const __m256i rotate1 = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    const __m256i rotate2 = _mm256_setr_epi32(2, 3, 4, 5, 6, 7, 0, 1);
+    const __m256i rotate3 = _mm256_setr_epi32(3, 4, 5, 6, 7, 0, 1, 2);
+
+    while (i < na8 && j < nb8) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + j));
+
+        // Rotations by 4 stay within a lane pair, the others are built independently
+        __m256i vb4 = _mm256_permute2x128_si256(vb, vb, 1);
+        __m256i m0 = _mm256_or_si256(_mm256_cmpeq_epi32(va, vb), _mm256_cmpeq_epi32(va, vb4));
+        __m256i m1 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate1)),
+                                     _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb4, rotate1)));
+        __m256i m2 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate2)),
+                                     _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb4, rotate2)));
+        __m256i m3 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate3)),
+                                     _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb4, rotate3)));
+        __m256i match = _mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3));
+
+        unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(match));
+        while (mask) {
+            out[n++] = a[i + lowestBit(mask)];
+            mask &= mask - 1;
+        }
+
+        int lastA = a[i + 7];
+        int lastB = b[j + 7];
+        i += (lastA <= lastB) ? 8 : 0;
+        j += (lastB <= lastA) ? 8 : 0;
+    }
+    return n + intersectTail(a + i, na - i, b + j, nb - j, out + n);
+}
+
+// Function to count the common elements of two sorted buffers eight elements at a time
+/**
+ * @brief Counts the elements two sorted buffers share with the block compares of intersectAvx2.
+ */
+TARGET_AVX2 static size_t intersectCountAvx2(const int* a, size_t na, const int* b, size_t nb) {
+    size_t i = 0, j = 0, n = 0;
+    size_t na8 = na & ~(size_t)7;
+    size_t nb8 = nb & ~(size_t)7;
+    const __m256i rotate1 = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    const __m256i rotate2 = _mm256_setr_epi32(2, 3, 4, 5, 6, 7, 0, 1);
+    const __m256i rotate3 = _mm256_setr_epi32(3, 4, 5, 6, 7, 0, 1, 2);
+
+    while (i < na8 && j < nb8) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + j));
+
+        __m256i vb4 = _mm256_permute2x128_si256(vb, vb, 1);
+        __m256i m0 = _mm256_or_si256(_mm256_cmpeq_epi32(va, vb), _mm256_cmpeq_epi32(va, vb4));
+        __m256i m1 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate1)),
+                                     _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb4, rotate1)));
+        __m256i m2 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate2)),
+                                     _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb4, rotate2)));
+        __m256i m3 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate3)),
+                                     _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb4, rotate3)));
+        __m256i match = _mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3));
+        n += (size_t)bitCount((unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(match)));
+
+        int lastA = a[i + 7];
+        int lastB = b[j + 7];
+        i += (lastA <= lastB) ? 8 : 0;
+        j += (lastB <= lastA) ? 8 : 0;
+    }
+    return n + intersectCountScalar(a + i, na - i, b + j, nb - j);
+}
+
+// Function to sort a bitonic vector of eight ints
+/**
+ * @brief Sorts a bitonic sequence of eight ints with half cleaners at distance 4, 2 and 1.
+ */
+TARGET_AVX2 static __m256i bitonicSort8(__m256i v) {
+    __m256i x = _mm256_permute2x128_si256(v, v, 1);
+    v = _mm256_blend_epi32(_mm256_min_epi32(v, x), _mm256_max_epi32(v, x), 0xF0);
+    x = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    v = _mm256_blend_epi32(_mm256_min_epi32(v, x), _mm256_max_epi32(v, x), 0xCC);
+    x = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+    v = _mm256_blend_epi32(_mm256_min_epi32(v, x), _mm256_max_epi32(v, x), 0xAA);
+    return v;
+}
+
+// Function to merge two sorted buffers eight elements at a time
+/**
+ * @brief Computes the union of two sorted buffers with an 8+8 bitonic merge network.
+ *
+ * Same scheme as the SSE4.2 union with eight lanes per block.
+ */
+TARGET_AVX2 static size_t unionAvx2(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    if (na < 8 || nb < 8) return unionScalar(a, na, b, nb, out);
+
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i shiftUp = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+    size_t i = 8, j = 8, n = 0;
+    __m256i low = _mm256_loadu_si256((const __m256i*)a);
+    __m256i high = _mm256_loadu_si256((const __m256i*)b);
+    int last = 0;
+    int lanes[8];
+
+    for (;;) {
+        // Merge: reversed high makes a bitonic sequence with low
+        __m256i reversed = _mm256_permutevar8x32_epi32(high, reverse);
+        __m256i mn = bitonicSort8(_mm256_min_epi32(low, reversed));
+        high = bitonicSort8(_mm256_max_epi32(low, reversed));
+
+        // Write the lower half, skipping values equal to their predecessor
+        __m256i previous = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(mn, shiftUp), _mm256_set1_epi32(last), 0x01);
+        unsigned int keep = ~(unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(mn, previous))) & 0xFF;
+        if (n == 0) keep |= 1;
+        _mm256_storeu_si256((__m256i*)lanes, mn);
+        if (keep == 0xFF) {
+            _mm256_storeu_si256((__m256i*)(out + n), mn);
+            n += 8;
+        } else {
+            n += emitLanes(lanes, keep, out + n);
+        }
+        last = lanes[7];
+
+        if (i + 8 > na || j + 8 > nb) break;
+        if (a[i] < b[j]) {
+            low = _mm256_loadu_si256((const __m256i*)(a + i));
+            i += 8;
+        } else {
+            low = _mm256_loadu_si256((const __m256i*)(b + j));
+            j += 8;
+        }
+    }
+
+    _mm256_storeu_si256((__m256i*)lanes, high);
+    return unionTail(lanes, 8, a + i, na - i, b + j, nb - j, out, n);
+}
+
+// Function to subtract one sorted buffer from another eight elements at a time
+/**
+ * @brief Computes the elements of 'a' not in 'b' with 256-bit compares of 8x8 blocks.
+ *
+ * Same scheme as the SSE4.2 difference with eight lanes per block.
+ */
+TARGET_AVX2 static size_t differenceAvx2(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    size_t i = 0, j = 0, n = 0;
+    size_t na8 = na & ~(size_t)7;
+    size_t nb8 = nb & ~(size_t)7;
+    const __m256i rotate1 = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    const __m256i rotate2 = _mm256_setr_epi32(2, 3, 4, 5, 6, 7, 0, 1);
+    const __m256i rotate3 = _mm256_setr_epi32(3, 4, 5, 6, 7, 0, 1, 2);
+    unsigned int matched = 0;
+
+    while (i < na8 && j < nb8) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + j));
+
+        __m256i vb4 = _mm256_permute2x128_si256(vb, vb, 1);
+        __m256i m0 = _mm256_or_si256(_mm256_cmpeq_epi32(va, vb), _mm256_cmpeq_epi32(va, vb4));
+        __m256i m1 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate1)),
+                                     _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb4, rotate1)));
+        __m256i m2 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate2)),
+                                     _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb4, rotate2)));
+        __m256i m3 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rotate3)),
+                                     _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb4, rotate3)));
+        __m256i match = _mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3));
+        matched |= (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(match));
+
+        int lastA = a[i + 7];
+        int lastB = b[j + 7];
+        if (lastA <= lastB) {
+            unsigned int keep = ~matched & 0xFF;
+            if (keep == 0xFF) {
+                _mm256_storeu_si256((__m256i*)(out + n), va);
+                n += 8;
+            } else {
+                n += emitLanes(a + i, keep, out + n);
+            }
+            matched = 0;
+            i += 8;
+        }
+        if (lastB <= lastA) j += 8;
+    }
+    return n + differenceTail(a + i, na - i, b + j, nb - j, matched, out + n);
+}
+#endif
+
+// Function to detect the vector instruction sets of the CPU
+/**
+ * @brief Returns the best kernel level this CPU (and operating system) supports.
+ *
+ * @return SetKernelLevel SET_KERNEL_AVX2, SET_KERNEL_SSE42 or SET_KERNEL_SCALAR.
+ */
+SetKernelLevel detectSetKernelLevel() {
+#if SET_KERNELS_X86 && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    int sse42 = (info[2] >> 20) & 1;
+    int osxsave = (info[2] >> 27) & 1;
+    int avx = (info[2] >> 28) & 1;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6) {
+        __cpuidex(info, 7, 0);
+        if ((info[1] >> 5) & 1) return SET_KERNEL_AVX2;
+    }
+    return sse42 ? SET_KERNEL_SSE42 : SET_KERNEL_SCALAR;
+#elif SET_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SET_KERNEL_AVX2;
+    if (__builtin_cpu_supports("sse4.2")) return SET_KERNEL_SSE42;
+    return SET_KERNEL_SCALAR;
+#else
+    return SET_KERNEL_SCALAR;
+#endif
+}
+
+// Kernel signature shared by all implementations of an operation
+typedef size_t (*SetKernel)(const int* a, size_t na, const int* b, size_t nb, int* out);
+
+// Signature of the implementations of the intersection count
+typedef size_t (*SetCountKernel)(const int* a, size_t na, const int* b, size_t nb);
+
+// Kernels of one level
+/**
+ * @brief Structure holding the implementations of every operation for one kernel level.
+ */
+struct KernelTable
+{
+    SetKernelLevel level;
+    SetKernel intersectKernel;
+    SetKernel unionKernel;
+    SetKernel differenceKernel;
+    SetCountKernel intersectCountKernel;
+};
+
+// Kernels of every level this compiler builds
+static const struct KernelTable kernelTables[] = {
+    { SET_KERNEL_SCALAR, intersectScalar, unionScalar, differenceScalar, intersectCountScalar },
+#if SET_KERNELS_X86
+    { SET_KERNEL_SSE42, intersectSse42, unionSse42, differenceSse42, intersectCountSse42 },
+    { SET_KERNEL_AVX2, intersectAvx2, unionAvx2, differenceAvx2, intersectCountAvx2 },
+#endif
+};
+
+// Kernels in use, NULL until the first kernel call; read and written atomically
+static const struct KernelTable* volatile activeKernels = NULL;
+
+// Function to publish the kernels of a level
+/**
+ * @brief Points the dispatch at the implementations for 'level' with a release store.
+ *
+ * Threads that make their first kernel call at the same time may all detect the CPU and
+ * store; they store the same table, so whichever store lands last is correct.
+ *
+ * @param level A level supported by the CPU.
+ * @return const struct KernelTable* The table now in use.
+ */
+static const struct KernelTable* selectKernels(SetKernelLevel level) {
+    const struct KernelTable* table = &kernelTables[0];
+    for (size_t i = 0; i < sizeof(kernelTables) / sizeof(kernelTables[0]); i++) {
+        if (kernelTables[i].level == level) table = &kernelTables[i];
+    }
+#if defined(_MSC_VER)
+    _ReadWriteBarrier();
+    activeKernels = table;
+#else
+    __atomic_store_n(&activeKernels, table, __ATOMIC_RELEASE);
+#endif
+    return table;
+}
+
+// Function to get the kernels in use
+/**
+ * @brief Returns the kernels in use, selecting the best supported ones on the first call.
+ *
+ * @return const struct KernelTable* The table in use.
+ */
+static const struct KernelTable* getKernels() {
+#if defined(_MSC_VER)
+    const struct KernelTable* table = activeKernels;
+    _ReadWriteBarrier();
+#else
+    const struct KernelTable* table = __atomic_load_n(&activeKernels, __ATOMIC_ACQUIRE);
+#endif
+    return table ? table : selectKernels(detectSetKernelLevel());
+}
+
+// Function to read the kernel level
+/**
+ * @brief Returns the kernel level currently in use.
+ *
+ * @return SetKernelLevel The level in use.
+ */
+SetKernelLevel getSetKernelLevel() {
+    return getKernels()->level;
+}
+
+// Function to choose the kernel level
+/**
+ * @brief Selects the kernel level, for example to compare implementations in benchmarks.
+ *
+ * Kernel calls already running on other threads finish with the kernels they started with.
+ *
+ * @param level The requested level; levels the CPU cannot run are lowered to the best supported one.
+ * @return SetKernelLevel The level now in use.
+ */
+SetKernelLevel setSetKernelLevel(SetKernelLevel level) {
+    SetKernelLevel supported = detectSetKernelLevel();
+    return selectKernels(level > supported ? supported : level)->level;
+}
+
+// Function to name a kernel level
+/**
+ * @brief Returns a printable name for a kernel level.
+ *
+ * @param level The level.
+ * @return const char* "scalar", "sse4.2" or "avx2".
+ */
+const char* setKernelLevelName(SetKernelLevel level) {
+    switch (level) {
+    case SET_KERNEL_SSE42: return "sse4.2";
+    case SET_KERNEL_AVX2: return "avx2";
+    default: return "scalar";
+    }
+}
+
+// Function to intersect two sorted buffers
+/**
+ * @brief Computes the intersection of two strictly ascending buffers.
+ *
+ * Uses galloping search when one buffer is more than GALLOP_RATIO times larger than the
+ * other, and otherwise the best block compare kernel the CPU supports.
+ *
+ * @param a First sorted buffer.
+ * @param na Number of elements in 'a'.
+ * @param b Second sorted buffer.
+ * @param nb Number of elements in 'b'.
+ * @param out Receives the common elements in ascending order; must have room for min(na, nb) ints.
+ * @return size_t Number of elements written to 'out'.
+ */
+size_t intersectSortedInts(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    if (na == 0 || nb == 0) return 0;
+    if (na * GALLOP_RATIO < nb) return intersectGalloping(a, na, b, nb, out);
+    if (nb * GALLOP_RATIO < na) return intersectGalloping(b, nb, a, na, out);
+
+    return getKernels()->intersectKernel(a, na, b, nb, out);
+}
+
+// Function to merge two sorted buffers
+/**
+ * @brief Computes the union of two strictly ascending buffers with the best supported kernel.
+ *
+ * @param a First sorted buffer.
+ * @param na Number of elements in 'a'.
+ * @param b Second sorted buffer.
+ * @param nb Number of elements in 'b'.
+ * @param out Receives the union in ascending order; must have room for na + nb ints.
+ * @return size_t Number of elements written to 'out'.
+ */
+size_t unionSortedInts(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    return getKernels()->unionKernel(a, na, b, nb, out);
+}
+
+// Function to subtract one sorted buffer from another
+/**
+ * @brief Computes the elements of 'a' that are not in 'b' with the best supported kernel.
+ *
+ * @param a Sorted buffer to subtract from.
+ * @param na Number of elements in 'a'.
+ * @param b Sorted buffer of elements to remove.
+ * @param nb Number of elements in 'b'.
+ * @param out Receives the difference in ascending order; must have room for na ints.
+ * @return size_t Number of elements written to 'out'.
+ */
+size_t differenceSortedInts(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    if (nb == 0 || na == 0) {
+        for (size_t i = 0; i < na; i++) out[i] = a[i];
+        return na;
+    }
+    return getKernels()->differenceKernel(a, na, b, nb, out);
+}
+
+// Function to count the common elements of two sorted buffers
+/**
+ * @brief Computes the size of the intersection of two strictly ascending buffers without writing it.
+ *
+ * Chooses between galloping search and the block compare kernels like intersectSortedInts.
+ *
+ * @param a First sorted buffer.
+ * @param na Number of elements in 'a'.
+ * @param b Second sorted buffer.
+ * @param nb Number of elements in 'b'.
+ * @return size_t Number of elements in both buffers.
+ */
+size_t intersectCountSortedInts(const int* a, size_t na, const int* b, size_t nb) {
+    if (na == 0 || nb == 0) return 0;
+    if (na * GALLOP_RATIO < nb) return intersectCountGalloping(a, na, b, nb);
+    if (nb * GALLOP_RATIO < na) return intersectCountGalloping(b, nb, a, na);
+
+    return getKernels()->intersectCountKernel(a, na, b, nb);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file setKernels.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the set operation kernels over sorted int buffers.<br/>
+ *
+ * This header file declares the kernels that compute set operations directly on
+ * contiguous, strictly ascending int buffers, as used by the sorted array backend.
+ * Each operation has a scalar implementation and, on x86, SSE4.2 and AVX2
+ * implementations; the fastest one the CPU supports is chosen at run time.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef SET_KERNELS_H
+#define SET_KERNELS_H
+
+#include <stddef.h>
+
+// Enumeration for kernel instruction set levels
+/**
+ * @enum SetKernelLevel
+ * @brief Enum for the instruction set used by the set operation kernels.
+ */
+typedef enum
+{
+    SET_KERNEL_SCALAR,   // Portable C
+    SET_KERNEL_SSE42,    // 128-bit SSE up to SSE4.2
+    SET_KERNEL_AVX2      // 256-bit AVX2
+} SetKernelLevel;
+
+// Returns the best kernel level supported by this CPU
+SetKernelLevel detectSetKernelLevel();
+
+// Returns the kernel level currently in use
+SetKernelLevel getSetKernelLevel();
+
+// Selects the kernel level to use (clamped to what the CPU supports); returns the level in effect
+SetKernelLevel setSetKernelLevel(SetKernelLevel level);
+
+// Returns a printable name for a kernel level
+const char* setKernelLevelName(SetKernelLevel level);
+
+// Writes the intersection of two sorted buffers to 'out' (room for min(na, nb) ints); returns its length
+size_t intersectSortedInts(const int* a, size_t na, const int* b, size_t nb, int* out);
+
+// Returns the number of elements two sorted buffers share, without writing them
+size_t intersectCountSortedInts(const int* a, size_t na, const int* b, size_t nb);
+
+// Writes the union of two sorted buffers to 'out' (room for na + nb ints); returns its length
+size_t unionSortedInts(const int* a, size_t na, const int* b, size_t nb, int* out);
+
+// Writes the elements of 'a' that are not in 'b' to 'out' (room for na ints); returns its length
+size_t differenceSortedInts(const int* a, size_t na, const int* b, size_t nb, int* out);
+
+#endif // SET_KERNELS_H
@@ -0,0 +1,598 @@
+/**
+ * @file setRegistry.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the registry of Ordered Sets addressed by name or id.<br/>
+ *
+ * This file contains the chunked entry store, the name hash table with its incremental
+ * resize, and the snapshot functions that save and load a whole registry.
+ *
+ * A resize is started by the registration that would fill the table beyond three quarters
+ * (counting slots of dropped names). Its new table is allocated earlier, once the current
+ * one is half full, and cleared a few slots per registration or drop, so that it is ready
+ * when the resize starts. From then on 'migrateStep' is chosen so that the old table is
+ * empty well before the new one can fill up. Moved slots of the old table are marked as
+ * deleted rather than empty, so probe sequences of the names still waiting in it stay intact.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+
+// include module header files
+#include "setRegistry.h"
+#include "orderedSet.h"
+#include "setSnapshot.h"
+#include "logging.h"
+
+// Function to hash a set name
+/**
+ * @brief Computes the 32-bit FNV-1a hash of name[0 .. length).
+ */
+static unsigned int hashName(const char* name, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Function to find the entry of an id
+/**
+ * @brief Returns the entry of an id below 'nextId'.
+ */
+static struct RegistryEntry* entryAt(const SetRegistry* registry, int id) {
+    return &registry->chunks[id / REGISTRY_CHUNK_SIZE][id % REGISTRY_CHUNK_SIZE];
+}
+
+// Function to look a name up in one hash table
+/**
+ * @brief Probes a table for the slot holding name[0 .. length).
+ *
+ * @param registry The registry owning the table.
+ * @param table The table to probe (may have no slots).
+ * @param name The name, not necessarily NUL terminated.
+ * @param length Length of the name.
+ * @param hash Hash of the name.
+ * @return struct RegistrySlot* The slot, or NULL if the name is not in the table.
+ */
+static struct RegistrySlot* probeTable(const SetRegistry* registry, const struct RegistryTable* table,
+                                       const char* name, size_t length, unsigned int hash) {
+    if (!table->slots) return NULL;
+    size_t mask = table->capacity - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        struct RegistrySlot* slot = &table->slots[i];
+        if (slot->entry == REGISTRY_EMPTY) return NULL;
+        if (slot->entry > 0 && slot->hash == hash) {
+            const char* candidate = entryAt(registry, slot->entry - 1)->name;
+            if (strncmp(candidate, name, length) == 0 && candidate[length] == '\0') return slot;
+        }
+    }
+}
+
+// Function to look a name up in the registry
+/**
+ * @brief Finds the slot of a name in the current table or, during a resize, in the old one.
+ *
+ * @param owner If not NULL, receives the table the slot belongs to.
+ * @return struct RegistrySlot* The slot, or NULL if the name is not registered.
+ */
+static struct RegistrySlot* findSlot(const SetRegistry* registry, const char* name, size_t length,
+                                     unsigned int hash, const struct RegistryTable** owner) {
+    struct RegistrySlot* slot = probeTable(registry, &registry->table, name, length, hash);
+    if (owner) *owner = &registry->table;
+    if (!slot && registry->old.slots) {
+        slot = probeTable(registry, &registry->old, name, length, hash);
+        if (owner) *owner = &registry->old;
+    }
+    return slot;
+}
+
+// Function to insert an id into a hash table
+/**
+ * @brief Stores an id in the first free slot of its probe sequence; the name must not be in the table.
+ */
+static void insertSlot(struct RegistryTable* table, unsigned int hash, int id) {
+    size_t mask = table->capacity - 1;
+    size_t i = hash & mask;
+    while (table->slots[i].entry > 0) i = (i + 1) & mask;
+    if (table->slots[i].entry == REGISTRY_DELETED) table->deleted--;
+    table->slots[i].hash = hash;
+    table->slots[i].entry = id + 1;
+    table->used++;
+}
+
+// Function to continue a resize
+/**
+ * @brief Moves up to 'steps' slots of the old table to the current one, freeing the old table once it is empty.
+ */
+static void migrateSlots(SetRegistry* registry, size_t steps) {
+    while (registry->old.slots && steps > 0) {
+        struct RegistrySlot* slot = &registry->old.slots[registry->migrated++];
+        if (slot->entry > 0) {
+            insertSlot(&registry->table, slot->hash, slot->entry - 1);
+            slot->entry = REGISTRY_DELETED;
+            registry->old.used--;
+            registry->old.deleted++;
+        }
+        steps--;
+        if (registry->migrated == registry->old.capacity) {
+            free(registry->old.slots);
+            memset(&registry->old, 0, sizeof(registry->old));
+            registry->migrated = 0;
+        }
+    }
+}
+
+// Function to prepare the next table
+/**
+ * @brief Allocates the table of the next resize once the current table is half full.
+ *
+ * The table is sized for every name the current table can still take before the resize
+ * starts, and 'clearStep' is chosen so that it is cleared by then. If the allocation fails,
+ * a later call tries again (and startResize allocates the table itself as a last resort).
+ */
+static void prepareResize(SetRegistry* registry) {
+    const struct RegistryTable* table = &registry->table;
+    size_t load = table->used + table->deleted;
+    if (registry->next.slots || registry->old.slots || load * 2 < table->capacity) return;
+
+    size_t limit = table->capacity / 4 * 3;
+    size_t remaining = limit > load ? limit - load : 0;
+    size_t live = registry->count + remaining + 1;
+    size_t capacity = REGISTRY_MIN_CAPACITY;
+    while (capacity < live * 2) capacity *= 2;
+
+    struct RegistrySlot* slots = (struct RegistrySlot*)malloc(capacity * sizeof(struct RegistrySlot));
+    if (!slots) return;
+    registry->next.slots = slots;
+    registry->next.capacity = capacity;
+    registry->next.used = 0;
+    registry->next.deleted = 0;
+    registry->cleared = 0;
+    size_t step = capacity / (remaining + 1) + 1;
+    registry->clearStep = step > REGISTRY_MIGRATE_STEP ? step : REGISTRY_MIGRATE_STEP;
+}
+
+// Function to clear part of the next table
+/**
+ * @brief Marks up to 'steps' more slots of the next table as REGISTRY_EMPTY.
+ */
+static void clearSlots(SetRegistry* registry, size_t steps) {
+    if (!registry->next.slots) return;
+    size_t left = registry->next.capacity - registry->cleared;
+    size_t n = steps < left ? steps : left;
+    memset(registry->next.slots + registry->cleared, 0, n * sizeof(struct RegistrySlot));
+    registry->cleared += n;
+}
+
+// Function to do the resize work of one registration or drop
+/**
+ * @brief Moves a few slots of the old table, and prepares and clears the table of the next resize.
+ */
+static void resizeStep(SetRegistry* registry) {
+    migrateSlots(registry, registry->migrateStep);
+    prepareResize(registry);
+    clearSlots(registry, registry->clearStep);
+}
+
+// Function to start a resize
+/**
+ * @brief Replaces the current table with the prepared empty one; the old one is emptied gradually.
+ *
+ * Whatever work of the previous resize or of clearing the new table is left is done first.
+ * With the steps chosen here that only happens when a small table grows, or if the new table
+ * could not be allocated in advance.
+ *
+ * @return int 1 on success, 0 if memory allocation failed (the tables are unchanged).
+ */
+static int startResize(SetRegistry* registry) {
+    migrateSlots(registry, SIZE_MAX);
+    size_t live = registry->count + 1;
+
+    if (!registry->next.slots || registry->next.capacity < live * 2) {
+        free(registry->next.slots);
+        size_t capacity = REGISTRY_MIN_CAPACITY;
+        while (capacity < live * 2) capacity *= 2;
+        registry->next.slots = (struct RegistrySlot*)malloc(capacity * sizeof(struct RegistrySlot));
+        registry->next.capacity = capacity;
+        registry->cleared = 0;
+        if (!registry->next.slots) {
+            memset(&registry->next, 0, sizeof(registry->next));
+            LOG_ERROR("Memory allocation failed.");
+            return 0;
+        }
+    }
+    clearSlots(registry, SIZE_MAX);
+
+    // Empty the old table within half of the registrations the new one can take before it is three quarters full
+    size_t capacity = registry->next.capacity;
+    size_t headroom = capacity / 4 * 3 - live;
+    size_t step = 2 * registry->table.capacity / (headroom > 0 ? headroom : 1) + 1;
+    registry->migrateStep = step > REGISTRY_MIGRATE_STEP ? step : REGISTRY_MIGRATE_STEP;
+
+    registry->old = registry->table;
+    registry->migrated = 0;
+    registry->table = registry->next;
+    registry->table.used = 0;
+    registry->table.deleted = 0;
+    memset(&registry->next, 0, sizeof(registry->next));
+    if (!registry->old.slots) memset(&registry->old, 0, sizeof(registry->old));
+    return 1;
+}
+
+// Function to take an unused id
+/**
+ * @brief Returns a free id, or a new one, allocating another chunk of entries when needed.
+ *
+ * @return int The id, or -1 if memory allocation failed or every id is in use.
+ */
+static int takeId(SetRegistry* registry) {
+    if (registry->freeId >= 0) {
+        int id = registry->freeId;
+        registry->freeId = entryAt(registry, id)->nextFree;
+        return id;
+    }
+    if (registry->nextId == INT_MAX) return -1;
+
+    if (registry->nextId == registry->chunkCount * REGISTRY_CHUNK_SIZE) {
+        struct RegistryEntry** chunks = (struct RegistryEntry**)realloc(
+            registry->chunks, ((size_t)registry->chunkCount + 1) * sizeof(struct RegistryEntry*));
+        if (!chunks) {
+            LOG_ERROR("Memory allocation failed.");
+            return -1;
+        }
+        registry->chunks = chunks;
+        chunks[registry->chunkCount] = (struct RegistryEntry*)malloc(REGISTRY_CHUNK_SIZE * sizeof(struct RegistryEntry));
+        if (!chunks[registry->chunkCount]) {
+            LOG_ERROR("Memory allocation failed.");
+            return -1;
+        }
+        registry->chunkCount++;
+    }
+    return registry->nextId++;
+}
+
+// Function to create a set registry
+/**
+ * @brief Creates an empty registry. Its hash table is allocated by the first registration.
+ *
+ * @return SetRegistry* The registry, or NULL if memory allocation fails.
+ */
+SetRegistry* createSetRegistry() {
+    SetRegistry* registry = (SetRegistry*)calloc(1, sizeof(SetRegistry));
+    if (!registry) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    registry->migrateStep = REGISTRY_MIGRATE_STEP;
+    registry->clearStep = REGISTRY_MIGRATE_STEP;
+    registry->freeId = -1;
+    return registry;
+}
+
+// Function to delete a set registry
+/**
+ * @brief Deletes every registered set and frees the registry.
+ *
+ * @param registry The registry (may be NULL).
+ */
+void deleteSetRegistry(SetRegistry* registry) {
+    if (!registry) return;
+    for (int id = 0; id < registry->nextId; id++) {
+        struct RegistryEntry* entry = entryAt(registry, id);
+        if (entry->set) {
+            deleteOrderedSet(entry->set);
+            free(entry->name);
+        }
+    }
+    for (int i = 0; i < registry->chunkCount; i++) free(registry->chunks[i]);
+    free(registry->chunks);
+    free(registry->table.slots);
+    free(registry->old.slots);
+    free(registry->next.slots);
+    free(registry);
+}
+
+// Function to register a set
+/**
+ * @brief Adds a set under a new name. The registry takes ownership of the set.
+ *
+ * @param registry The registry.
+ * @param name The name, 1 to REGISTRY_MAX_NAME characters.
+ * @param set The set to register.
+ * @return int The id of the set, or -1 if the name is invalid or taken or memory allocation failed
+ *             (the set then still belongs to the caller).
+ */
+int registerSet(SetRegistry* registry, const char* name, OrderedIntSet* set) {
+    if (!registry || !name || !set) return -1;
+    size_t length = strlen(name);
+    if (length == 0 || length > REGISTRY_MAX_NAME) return -1;
+    unsigned int hash = hashName(name, length);
+    if (findSlot(registry, name, length, hash, NULL)) return -1;
+
+    struct RegistryTable* table = &registry->table;
+    if ((table->used + table->deleted + 1) * 4 > table->capacity * 3 && !startResize(registry)) return -1;
+
+    char* copy = (char*)malloc(length + 1);
+    if (!copy) {
+        LOG_ERROR("Memory allocation failed.");
+        return -1;
+    }
+    memcpy(copy, name, length + 1);
+    int id = takeId(registry);
+    if (id < 0) {
+        free(copy);
+        return -1;
+    }
+
+    struct RegistryEntry* entry = entryAt(registry, id);
+    entry->name = copy;
+    entry->set = set;
+    entry->hash = hash;
+    entry->nextFree = -1;
+    insertSlot(&registry->table, hash, id);
+    registry->count++;
+    resizeStep(registry);
+    return id;
+}
+
+// Function to find the id of a name
+/**
+ * @brief Returns the id registered under a name.
+ *
+ * @return int The id, or -1 if no set has this name.
+ */
+int findSetId(const SetRegistry* registry, const char* name) {
+    if (!registry || !name) return -1;
+    size_t length = strlen(name);
+    struct RegistrySlot* slot = findSlot(registry, name, length, hashName(name, length), NULL);
+    return slot ? slot->entry - 1 : -1;
+}
+
+// Function to find the set of a name
+/**
+ * @brief Returns the set registered under a name.
+ *
+ * @return OrderedIntSet* The set, or NULL if no set has this name.
+ */
+OrderedIntSet* findSet(const SetRegistry* registry, const char* name) {
+    return getSetById(registry, findSetId(registry, name));
+}
+
+// Function to find the set of an id
+/**
+ * @brief Returns the set registered under an id.
+ *
+ * @return OrderedIntSet* The set, or NULL if the id is not in use.
+ */
+OrderedIntSet* getSetById(const SetRegistry* registry, int id) {
+    if (!registry || id < 0 || id >= registry->nextId) return NULL;
+    return entryAt(registry, id)->set;
+}
+
+// Function to find the name of an id
+/**
+ * @brief Returns the name registered under an id; it stays valid until the set is dropped.
+ *
+ * @return const char* The name, or NULL if the id is not in use.
+ */
+const char* getSetName(const SetRegistry* registry, int id) {
+    if (!registry || id < 0 || id >= registry->nextId) return NULL;
+    return entryAt(registry, id)->name;
+}
+
+// Function to drop the set of an id
+/**
+ * @brief Deletes the set registered under an id and frees its name; the id becomes free.
+ *
+ * @return int 1 if the id was in use, 0 otherwise.
+ */
+int dropSetById(SetRegistry* registry, int id) {
+    if (!getSetById(registry, id)) return 0;
+    struct RegistryEntry* entry = entryAt(registry, id);
+
+    const struct RegistryTable* owner;
+    struct RegistrySlot* slot = findSlot(registry, entry->name, strlen(entry->name), entry->hash, &owner);
+    struct RegistryTable* table = owner == &registry->table ? &registry->table : &registry->old;
+    slot->entry = REGISTRY_DELETED;
+    table->used--;
+    table->deleted++;
+
+    deleteOrderedSet(entry->set);
+    free(entry->name);
+    entry->set = NULL;
+    entry->name = NULL;
+    entry->nextFree = registry->freeId;
+    registry->freeId = id;
+    registry->count--;
+    resizeStep(registry);
+    return 1;
+}
+
+// Function to drop the set of a name
+/**
+ * @brief Deletes the set registered under a name.
+ *
+ * @return int 1 if a set had this name, 0 otherwise.
+ */
+int dropSet(SetRegistry* registry, const char* name) {
+    return dropSetById(registry, findSetId(registry, name));
+}
+
+// Function to drop every set whose name starts with a prefix
+/**
+ * @brief Deletes every set whose name starts with 'prefix'.
+ *
+ * When the registry ends up empty, its entry store and hash tables are freed as well,
+ * so dropping everything gives all the memory back.
+ *
+ * @param registry The registry.
+ * @param prefix The prefix; "" matches every name.
+ * @return size_t Number of sets dropped.
+ */
+size_t dropSetsWithPrefix(SetRegistry* registry, const char* prefix) {
+    if (!registry || !prefix) return 0;
+    size_t length = strlen(prefix);
+    size_t dropped = 0;
+    for (int id = 0; id < registry->nextId; id++) {
+        struct RegistryEntry* entry = entryAt(registry, id);
+        if (entry->set && strncmp(entry->name, prefix, length) == 0) {
+            dropSetById(registry, id);
+            dropped++;
+        }
+    }
+
+    if (registry->count == 0 && registry->nextId > 0) {
+        for (int i = 0; i < registry->chunkCount; i++) free(registry->chunks[i]);
+        free(registry->chunks);
+        free(registry->table.slots);
+        free(registry->old.slots);
+        free(registry->next.slots);
+        memset(registry, 0, sizeof(SetRegistry));
+        registry->migrateStep = REGISTRY_MIGRATE_STEP;
+        registry->clearStep = REGISTRY_MIGRATE_STEP;
+        registry->freeId = -1;
+    }
+    return dropped;
+}
+
+// Function to count the registered sets
+/**
+ * @brief Returns the number of registered sets.
+ */
+size_t registryCount(const SetRegistry* registry) {
+    return registry ? registry->count : 0;
+}
+
+// Function to walk the ids in use
+/**
+ * @brief Returns the first id in use after 'id', in ascending order.
+ *
+ * @param registry The registry.
+ * @param id The previous id, or -1 for the first one.
+ * @return int The next id, or -1 if there is none.
+ */
+int registryNextId(const SetRegistry* registry, int id) {
+    if (!registry) return -1;
+    for (id = id < 0 ? 0 : id + 1; id < registry->nextId; id++) {
+        if (entryAt(registry, id)->set) return id;
+    }
+    return -1;
+}
+
+// Function to measure the memory used by one registered set
+/**
+ * @brief Returns the heap bytes used by the set of an id and by its name.
+ *
+ * @return size_t Bytes, 0 if the id is not in use.
+ */
+size_t registrySetMemory(const SetRegistry* registry, int id) {
+    OrderedIntSet* set = getSetById(registry, id);
+    if (!set) return 0;
+    return orderedSetMemoryUsage(set) + strlen(entryAt(registry, id)->name) + 1;
+}
+
+// Function to measure the memory used by a registry
+/**
+ * @brief Returns the heap bytes used by the registry: its sets and names, entry store and hash tables.
+ *
+ * @return size_t Bytes, 0 if 'registry' is NULL.
+ */
+size_t registryMemoryUsage(const SetRegistry* registry) {
+    if (!registry) return 0;
+    size_t bytes = sizeof(SetRegistry);
+    bytes += (registry->table.capacity + registry->old.capacity + registry->next.capacity) * sizeof(struct RegistrySlot);
+    bytes += (size_t)registry->chunkCount * (sizeof(struct RegistryEntry*) +
+                                             REGISTRY_CHUNK_SIZE * sizeof(struct RegistryEntry));
+    for (int id = registryNextId(registry, -1); id >= 0; id = registryNextId(registry, id)) {
+        bytes += registrySetMemory(registry, id);
+    }
+    return bytes;
+}
+
+// Function to save a registry
+/**
+ * @brief Writes every registered set and its name to a named snapshot file.
+ *
+ * @param registry The registry.
+ * @param path The file to write.
+ * @param encoding The payload encoding of every set.
+ * @return int 1 on success, 0 on failure.
+ */
+int saveSetRegistry(const SetRegistry* registry, const char* path, SnapshotEncoding encoding) {
+    if (!registry) return 0;
+    size_t slots = registry->nextId > 0 ? (size_t)registry->nextId : 1;
+    OrderedIntSet** sets = (OrderedIntSet**)malloc(slots * sizeof(OrderedIntSet*));
+    const char** names = (const char**)malloc(slots * sizeof(const char*));
+    if (!sets || !names) {
+        LOG_ERROR("Memory allocation failed.");
+        free(sets);
+        free(names);
+        return 0;
+    }
+    for (int id = 0; id < registry->nextId; id++) {
+        sets[id] = entryAt(registry, id)->set;
+        names[id] = entryAt(registry, id)->name;
+    }
+    int ok = saveNamedSetsSnapshot(names, sets, registry->nextId, path, encoding);
+    free(sets);
+    free(names);
+    return ok;
+}
+
+// Function to register a set read from a snapshot
+/**
+ * @brief Store callback of loadNamedSetsSnapshot that registers a set in the registry given as context.
+ *
+ * @return int 1 on success, 0 if the name is invalid or repeated or memory allocation failed.
+ */
+static int registerLoadedSet(void* context, const char* name, OrderedIntSet* set) {
+    if (registerSet((SetRegistry*)context, name, set) >= 0) return 1;
+    LOG_ERROR("Snapshot set name \"%s\" is invalid or repeated.", name);
+    return 0;
+}
+
+// Function to load a registry
+/**
+ * @brief Replaces every set of the registry with the sets of a snapshot.
+ *
+ * The snapshot is loaded into a new registry first, so the current sets are only deleted
+ * if the whole snapshot loads. Sets are given new ids in the order they appear in the file.
+ * A snapshot without names (version 1) names its sets by their slot index.
+ *
+ * @param registry The registry.
+ * @param path The snapshot file.
+ * @param mapped 1 to use raw payloads in place from the mapped file, 0 to copy them.
+ * @return int 1 on success, 0 on failure (the registry is then unchanged).
+ */
+int loadSetRegistry(SetRegistry* registry, const char* path, int mapped) {
+    if (!registry) return 0;
+    SetRegistry* loaded = createSetRegistry();
+    if (!loaded) return 0;
+    if (!loadNamedSetsSnapshot(path, mapped, registerLoadedSet, loaded)) {
+        deleteSetRegistry(loaded);
+        return 0;
+    }
+
+    SetRegistry previous = *registry;
+    *registry = *loaded;
+    *loaded = previous;
+    deleteSetRegistry(loaded);
+    return 1;
+}
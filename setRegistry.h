@@ -0,0 +1,170 @@
+/**
+ * @file setRegistry.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for a registry of Ordered Sets addressed by name or id.<br/>
+ *
+ * This header file declares a growable collection of named sets. Every set gets a
+ * small integer id when it is registered, and can be found in O(1) by either. Names
+ * are kept in an open addressing hash table with linear probing. When the table
+ * fills up, a table of the new size is allocated and the entries are moved over a
+ * few at a time by the following registrations and drops, so no single call stops
+ * to rehash the whole table; until the move is complete lookups probe both tables.
+ * The new table itself is allocated and cleared in steps ahead of time.
+ * Entries are stored in fixed size chunks indexed by id, which never move.
+ *
+ * The registry owns its sets: dropping a name deletes its set. Sets can be dropped
+ * one at a time or all those whose names start with a prefix, and the memory used by
+ * each set and by the whole registry can be queried.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef SET_REGISTRY_H
+#define SET_REGISTRY_H
+
+#include <stddef.h>
+
+#include "orderedSet.h"
+#include "setSnapshot.h"
+
+// Longest set name
+#define REGISTRY_MAX_NAME 255
+
+// Smallest number of slots of the hash table
+#define REGISTRY_MIN_CAPACITY 16
+
+// Fewest slots moved to the new table, or cleared in it, by each registration or drop during a resize
+#define REGISTRY_MIGRATE_STEP 8
+
+// Number of entries in each chunk of the entry store
+#define REGISTRY_CHUNK_SIZE 1024
+
+// Registry entry structure
+/**
+ * @brief Structure representing the set registered under one id.
+ *
+ * - 'name': heap copy of the name, NULL while the id is free.
+ * - 'set': the registered set, NULL while the id is free.
+ * - 'hash': hash of the name.
+ * - 'nextFree': next free id while the id is free, -1 at the end of the list.
+ */
+struct RegistryEntry
+{
+    char* name;
+    OrderedIntSet* set;
+    unsigned int hash;
+    int nextFree;
+};
+
+// Hash table slot structure
+/**
+ * @brief Structure representing one slot of the name hash table.
+ *
+ * - 'hash': hash of the name, compared before the names themselves.
+ * - 'entry': id of the entry plus one, REGISTRY_EMPTY for a slot never used or REGISTRY_DELETED
+ *   for a slot whose entry was dropped (probing continues past it).
+ */
+struct RegistrySlot
+{
+    unsigned int hash;
+    int entry;
+};
+
+// Markers for unused hash table slots
+#define REGISTRY_EMPTY 0
+#define REGISTRY_DELETED -1
+
+// Hash table structure
+/**
+ * @brief Structure representing an open addressing hash table of ids.
+ *
+ * - 'slots': 'capacity' slots, a power of two (NULL for a table not in use).
+ * - 'used': slots holding an id.
+ * - 'deleted': slots marked REGISTRY_DELETED.
+ */
+struct RegistryTable
+{
+    struct RegistrySlot* slots;
+    size_t capacity;
+    size_t used;
+    size_t deleted;
+};
+
+// Set registry structure
+/**
+ * @brief Structure representing a registry of named sets.
+ *
+ * - 'table': the hash table new names are inserted into.
+ * - 'old': the table being emptied into 'table' during a resize (no slots otherwise).
+ * - 'migrated': slots of 'old' already moved; 'migrateStep': slots moved per registration or drop.
+ * - 'next': the table of the next resize, allocated once 'table' is half full (no slots otherwise).
+ * - 'cleared': slots of 'next' already marked empty; 'clearStep': slots cleared per registration or drop.
+ * - 'chunks' / 'chunkCount': the entry store; the entry of id i is chunks[i / REGISTRY_CHUNK_SIZE][i % REGISTRY_CHUNK_SIZE].
+ * - 'nextId': number of ids handed out so far; 'freeId': first free id below 'nextId', or -1.
+ * - 'count': number of registered sets.
+ */
+typedef struct SetRegistry
+{
+    struct RegistryTable table;
+    struct RegistryTable old;
+    size_t migrated;
+    size_t migrateStep;
+    struct RegistryTable next;
+    size_t cleared;
+    size_t clearStep;
+    struct RegistryEntry** chunks;
+    int chunkCount;
+    int nextId;
+    int freeId;
+    size_t count;
+} SetRegistry;
+
+// Function declarations
+/**
+ * @brief Function declarations for set registry operations.
+ *
+ * - 'createSetRegistry' / 'deleteSetRegistry': create an empty registry, free a registry and all its sets.
+ * - 'registerSet': adds a set under a new name and returns its id; the registry takes ownership of the set.
+ *   Returns -1 (and does not take the set) if the name is empty, too long or taken, or memory allocation fails.
+ * - 'findSet' / 'findSetId': the set or id registered under a name, NULL or -1 if there is none.
+ * - 'getSetById' / 'getSetName': the set or name registered under an id, NULL if the id is not in use.
+ * - 'dropSet' / 'dropSetById': delete one set; return 1 if it existed, 0 otherwise.
+ * - 'dropSetsWithPrefix': deletes every set whose name starts with 'prefix' ("" drops all) and returns how many.
+ * - 'registryCount': number of registered sets.
+ * - 'registryNextId': first id in use after 'id' (pass -1 to start), -1 after the last one.
+ * - 'registrySetMemory': heap bytes used by the set of an id and its name.
+ * - 'registryMemoryUsage': heap bytes used by the registry and all its sets.
+ * - 'saveSetRegistry': writes every set and its name to a snapshot file.
+ * - 'loadSetRegistry': replaces the contents of the registry with a snapshot; unchanged if loading fails.
+ *
+ * Names are NUL terminated strings of 1 to REGISTRY_MAX_NAME characters. Ids of dropped sets are reused.
+ */
+SetRegistry* createSetRegistry();
+void deleteSetRegistry(SetRegistry* registry);
+int registerSet(SetRegistry* registry, const char* name, OrderedIntSet* set);
+OrderedIntSet* findSet(const SetRegistry* registry, const char* name);
+int findSetId(const SetRegistry* registry, const char* name);
+OrderedIntSet* getSetById(const SetRegistry* registry, int id);
+const char* getSetName(const SetRegistry* registry, int id);
+int dropSet(SetRegistry* registry, const char* name);
+int dropSetById(SetRegistry* registry, int id);
+size_t dropSetsWithPrefix(SetRegistry* registry, const char* prefix);
+size_t registryCount(const SetRegistry* registry);
+int registryNextId(const SetRegistry* registry, int id);
+size_t registrySetMemory(const SetRegistry* registry, int id);
+size_t registryMemoryUsage(const SetRegistry* registry);
+int saveSetRegistry(const SetRegistry* registry, const char* path, SnapshotEncoding encoding);
+int loadSetRegistry(SetRegistry* registry, const char* path, int mapped);
+
+#endif // SET_REGISTRY_H
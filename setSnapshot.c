@@ -0,0 +1,729 @@
+/**
+ * @file setSnapshot.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for saving and loading Ordered Sets as binary snapshots.<br/>
+ *
+ * This file contains the snapshot writer, the reader that parses a memory-mapped
+ * snapshot, the delta varint codec, the CRC-32 checksum and the wrappers over mmap
+ * and the Win32 file mapping API. Raw sections that are loaded with mapping enabled
+ * become sorted array sets whose buffer points into the mapping; the mapping is
+ * reference counted and unmapped when the last of those sets is deleted or modified.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// include module header files
+#include "setSnapshot.h"
+#include "sortedArray.h"
+#include "logging.h"
+
+// Magic bytes at the start of every snapshot
+#define SNAPSHOT_MAGIC "OSETSNAP"
+
+// Size of the file header: magic, version, number of slots
+#define SNAPSHOT_FILE_HEADER 16
+
+// Size of a section header: present, encoding, count, payload size, checksum, byte order
+#define SNAPSHOT_SECTION_HEADER 32
+
+// Written in native byte order; reads back differently on a machine with the other byte order
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+
+// Longest LEB128 encoding of a 32-bit value
+#define SNAPSHOT_VARINT_MAX 5
+
+static uint32_t crcTable[256];
+static int crcTableReady = 0;
+
+// Function to compute a CRC-32 checksum
+/**
+ * @brief Computes the CRC-32 (IEEE 802.3 polynomial) of a buffer.
+ *
+ * @param data The bytes to check.
+ * @param length Number of bytes.
+ * @return unsigned int The checksum.
+ */
+unsigned int snapshotChecksum(const void* data, size_t length) {
+    if (!crcTableReady) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            crcTable[i] = c;
+        }
+        crcTableReady = 1;
+    }
+
+    const unsigned char* bytes = (const unsigned char*)data;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc = crcTable[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// Function to map a file into memory
+/**
+ * @brief Maps a whole file read-only into memory.
+ *
+ * @param path The file to map.
+ * @return struct SetMapping* The mapping with one reference, or NULL if the file cannot be mapped.
+ */
+static struct SetMapping* mapFile(const char* path) {
+    struct SetMapping* mapping = (struct SetMapping*)malloc(sizeof(struct SetMapping));
+    if (!mapping) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    mapping->references = 1;
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER size;
+    HANDLE view = NULL;
+    const void* base = NULL;
+    if (file != INVALID_HANDLE_VALUE && GetFileSizeEx(file, &size) && size.QuadPart >= SNAPSHOT_FILE_HEADER &&
+        (unsigned long long)size.QuadPart <= (size_t)-1) {
+        view = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (view) base = MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (!base) {
+        LOG_ERROR("Cannot map snapshot %s.", path);
+        if (view) CloseHandle(view);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        free(mapping);
+        return NULL;
+    }
+    mapping->file = file;
+    mapping->view = view;
+    mapping->base = (const unsigned char*)base;
+    mapping->length = (size_t)size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    struct stat info;
+    void* base = MAP_FAILED;
+    if (fd >= 0 && fstat(fd, &info) == 0 && info.st_size >= SNAPSHOT_FILE_HEADER &&
+        (unsigned long long)info.st_size <= (size_t)-1) {
+        base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    if (fd >= 0) close(fd);  // The mapping stays valid after the descriptor is closed
+    if (base == MAP_FAILED) {
+        LOG_ERROR("Cannot map snapshot %s.", path);
+        free(mapping);
+        return NULL;
+    }
+    mapping->base = (const unsigned char*)base;
+    mapping->length = (size_t)info.st_size;
+#endif
+    return mapping;
+}
+
+// Function to release a mapping
+/**
+ * @brief Drops one reference to a mapping and unmaps the file when none is left.
+ *
+ * @param mapping The mapping (NULL is ignored).
+ */
+void releaseSetMapping(struct SetMapping* mapping) {
+    if (!mapping || --mapping->references > 0) return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(mapping->base);
+    CloseHandle((HANDLE)mapping->view);
+    CloseHandle((HANDLE)mapping->file);
+#else
+    munmap((void*)mapping->base, mapping->length);
+#endif
+    free(mapping);
+}
+
+// Function to delta encode sorted values
+/**
+ * @brief Encodes strictly ascending values as LEB128 varints of the gaps between them.
+ *
+ * Values are offset by 2^31 so that they ascend as unsigned numbers; the first value is
+ * stored as its gap from 0.
+ *
+ * @param values The values.
+ * @param n Number of values.
+ * @param out Buffer with room for n * SNAPSHOT_VARINT_MAX bytes.
+ * @return size_t Number of bytes written.
+ */
+static size_t encodeVarints(const int* values, size_t n, unsigned char* out) {
+    size_t length = 0;
+    uint32_t previous = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t key = (uint32_t)values[i] ^ 0x80000000u;
+        uint32_t gap = key - previous;
+        previous = key;
+        while (gap >= 0x80) {
+            out[length++] = (unsigned char)(gap | 0x80);
+            gap >>= 7;
+        }
+        out[length++] = (unsigned char)gap;
+    }
+    return length;
+}
+
+// Function to decode delta encoded values
+/**
+ * @brief Decodes the output of encodeVarints, checking that it holds exactly 'n' ascending values.
+ *
+ * @param in The encoded bytes.
+ * @param length Number of encoded bytes.
+ * @param n Number of values expected.
+ * @param out Buffer with room for 'n' values.
+ * @return int 1 on success, 0 if the bytes are not a valid encoding of 'n' ascending values.
+ */
+static int decodeVarints(const unsigned char* in, size_t length, size_t n, int* out) {
+    size_t pos = 0;
+    uint64_t previous = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t gap = 0;
+        int shift = 0;
+        for (;;) {
+            if (pos == length || shift > 28) return 0;
+            unsigned char byte = in[pos++];
+            gap |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+            shift += 7;
+        }
+        if (i > 0 && gap == 0) return 0;  // Elements must strictly ascend
+        previous += gap;
+        if (previous > 0xFFFFFFFFu) return 0;
+        out[i] = (int)((uint32_t)previous ^ 0x80000000u);
+    }
+    return pos == length;
+}
+
+// Function to write bytes to a snapshot
+/**
+ * @brief Writes 'length' bytes followed by zero padding up to a multiple of 8 bytes.
+ *
+ * @return int 1 on success, 0 on a write error.
+ */
+static int writePadded(FILE* file, const void* data, size_t length) {
+    static const unsigned char zeros[8] = { 0 };
+    if (length > 0 && fwrite(data, 1, length, file) != length) return 0;
+    size_t padding = (8 - length % 8) % 8;
+    return padding == 0 || fwrite(zeros, 1, padding, file) == padding;
+}
+
+// Function to write the section of one slot
+/**
+ * @brief Writes the section header and payload of one set slot.
+ *
+ * @param file The snapshot being written.
+ * @param set The set, or NULL for an empty slot.
+ * @param encoding The payload encoding.
+ * @return int 1 on success, 0 on a write error or if memory allocation failed.
+ */
+static int writeSection(FILE* file, const OrderedIntSet* set, SnapshotEncoding encoding) {
+    unsigned char header[SNAPSHOT_SECTION_HEADER] = { 0 };
+    uint32_t present = set != NULL;
+    uint32_t encodingField = (uint32_t)encoding;
+    uint64_t count = set ? (uint64_t)set->count : 0;
+    uint64_t payloadBytes = 0;
+    uint32_t checksum = 0;
+    uint32_t byteOrder = SNAPSHOT_BYTE_ORDER;
+
+    // Sorted arrays are written straight from their buffer; other backends are copied out first
+    const int* values = NULL;
+    int* copy = NULL;
+    unsigned char* encoded = NULL;
+    const void* payload = NULL;
+    if (set && set->count > 0) {
+        if (set->backend == SET_BACKEND_SORTED_ARRAY) {
+            values = set->array->data;
+        } else {
+            copy = (int*)malloc((size_t)set->count * sizeof(int));
+            if (!copy) {
+                LOG_ERROR("Memory allocation failed.");
+                return 0;
+            }
+            copyElements(set, copy);
+            values = copy;
+        }
+
+        if (encoding == SNAPSHOT_DELTA_VARINT) {
+            encoded = (unsigned char*)malloc((size_t)set->count * SNAPSHOT_VARINT_MAX);
+            if (!encoded) {
+                LOG_ERROR("Memory allocation failed.");
+                free(copy);
+                return 0;
+            }
+            payloadBytes = encodeVarints(values, (size_t)set->count, encoded);
+            payload = encoded;
+        } else {
+            payloadBytes = (uint64_t)set->count * sizeof(int);
+            payload = values;
+        }
+        checksum = snapshotChecksum(payload, (size_t)payloadBytes);
+    }
+
+    memcpy(header, &present, 4);
+    memcpy(header + 4, &encodingField, 4);
+    memcpy(header + 8, &count, 8);
+    memcpy(header + 16, &payloadBytes, 8);
+    memcpy(header + 24, &checksum, 4);
+    memcpy(header + 28, &byteOrder, 4);
+
+    int ok = fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+             writePadded(file, payload, (size_t)payloadBytes);
+    free(encoded);
+    free(copy);
+    return ok;
+}
+
+// Function to write the name of one slot
+/**
+ * @brief Writes the name record of a named snapshot: the name length as 8 bytes, then the padded name.
+ *
+ * @param file The snapshot being written.
+ * @param name The name, or NULL for an empty slot.
+ * @return int 1 on success, 0 on a write error.
+ */
+static int writeName(FILE* file, const char* name) {
+    uint64_t length = name ? strlen(name) : 0;
+    return fwrite(&length, 1, 8, file) == 8 && writePadded(file, name, (size_t)length);
+}
+
+// Function to write a snapshot
+/**
+ * @brief Writes the file header and one section per slot, each preceded by its name when 'names' is not NULL.
+ *
+ * Snapshots without names are written as version SNAPSHOT_VERSION, so older readers can load them.
+ *
+ * @return int 1 on success, 0 on failure.
+ */
+static int saveSnapshot(const OrderedIntSet* const* sets, const char* const* names, int count,
+                        const char* path, SnapshotEncoding encoding) {
+    if (!sets || count < 0 || !path || (encoding != SNAPSHOT_RAW && encoding != SNAPSHOT_DELTA_VARINT)) return 0;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        LOG_ERROR("Cannot create snapshot %s.", path);
+        return 0;
+    }
+
+    unsigned char header[SNAPSHOT_FILE_HEADER];
+    uint32_t version = names ? SNAPSHOT_NAMED_VERSION : SNAPSHOT_VERSION;
+    uint32_t slots = (uint32_t)count;
+    memcpy(header, SNAPSHOT_MAGIC, 8);
+    memcpy(header + 8, &version, 4);
+    memcpy(header + 12, &slots, 4);
+
+    int ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    for (int i = 0; ok && i < count; i++) {
+        if (names) ok = writeName(file, sets[i] ? names[i] : NULL);
+        if (ok) ok = writeSection(file, sets[i], encoding);
+    }
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) LOG_ERROR("Cannot write snapshot %s.", path);
+    return ok;
+}
+
+// Function to check that raw values ascend
+/**
+ * @brief Returns 1 if values[0 .. n) strictly ascend.
+ */
+static int valuesAscend(const int* values, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        if (values[i - 1] >= values[i]) return 0;
+    }
+    return 1;
+}
+
+// Function to read the section of one slot
+/**
+ * @brief Parses the section at 'offset' and builds its set.
+ *
+ * @param mapping The mapped snapshot.
+ * @param offset Position of the section; moved past it on success.
+ * @param mapped 1 to use a raw payload in place, 0 to copy it.
+ * @param set Receives the set, or NULL for an empty slot.
+ * @return int 1 on success, 0 if the section is invalid or memory allocation failed.
+ */
+static int readSection(struct SetMapping* mapping, size_t* offset, int mapped, OrderedIntSet** set) {
+    const unsigned char* section = mapping->base + *offset;
+    uint32_t present, encoding, checksum, byteOrder;
+    uint64_t count, payloadBytes;
+
+    *set = NULL;
+    if (mapping->length - *offset < SNAPSHOT_SECTION_HEADER) return 0;
+    memcpy(&present, section, 4);
+    memcpy(&encoding, section + 4, 4);
+    memcpy(&count, section + 8, 8);
+    memcpy(&payloadBytes, section + 16, 8);
+    memcpy(&checksum, section + 24, 4);
+    memcpy(&byteOrder, section + 28, 4);
+
+    if (byteOrder != SNAPSHOT_BYTE_ORDER) {
+        LOG_ERROR("Snapshot was written on a machine with a different byte order.");
+        return 0;
+    }
+    size_t available = mapping->length - *offset - SNAPSHOT_SECTION_HEADER;
+    uint64_t padded = (payloadBytes + 7) & ~(uint64_t)7;
+    if (count > INT_MAX || payloadBytes > available || padded > available ||
+        (encoding == SNAPSHOT_RAW && payloadBytes != count * sizeof(int)) ||
+        (encoding != SNAPSHOT_RAW && encoding != SNAPSHOT_DELTA_VARINT) || (!present && count > 0)) {
+        LOG_ERROR("Snapshot section header is invalid.");
+        return 0;
+    }
+    const unsigned char* payload = section + SNAPSHOT_SECTION_HEADER;
+    if (snapshotChecksum(payload, (size_t)payloadBytes) != checksum) {
+        LOG_ERROR("Snapshot checksum mismatch.");
+        return 0;
+    }
+    *offset += SNAPSHOT_SECTION_HEADER + (size_t)padded;
+    if (!present) return 1;
+
+    size_t n = (size_t)count;
+    struct SortedArray* array;
+    if (encoding == SNAPSHOT_RAW && !valuesAscend((const int*)payload, n)) {
+        LOG_ERROR("Snapshot elements are not in ascending order.");
+        return 0;
+    }
+
+    if (encoding == SNAPSHOT_RAW && mapped) {
+        // Borrow the payload: the array header is the only allocation
+        array = createSortedArray(0);
+        if (!array) return 0;
+        array->data = (int*)payload;
+        array->size = n;
+        *set = createOrderedSetFromSortedArray(array);
+        if (!*set) return 0;
+        (*set)->mapping = mapping;
+        mapping->references++;
+        return 1;
+    }
+
+    array = createSortedArray(n);
+    if (!array) return 0;
+    if (encoding == SNAPSHOT_RAW) {
+        if (n > 0) memcpy(array->data, payload, n * sizeof(int));
+    } else if (!decodeVarints(payload, (size_t)payloadBytes, n, array->data)) {
+        LOG_ERROR("Snapshot payload is not a valid varint encoding.");
+        deleteSortedArray(array);
+        return 0;
+    }
+    array->size = n;
+    *set = createOrderedSetFromSortedArray(array);
+    return *set != NULL;
+}
+
+// Function to read the name of one slot
+/**
+ * @brief Parses the name record at 'offset' of a named snapshot.
+ *
+ * @param mapping The mapped snapshot.
+ * @param offset Position of the record; moved past it on success.
+ * @param name Receives a heap copy of the name, or NULL if the record is empty.
+ * @return int 1 on success, 0 if the record is invalid or memory allocation failed.
+ */
+static int readName(const struct SetMapping* mapping, size_t* offset, char** name) {
+    uint64_t length;
+
+    *name = NULL;
+    if (mapping->length - *offset < 8) return 0;
+    memcpy(&length, mapping->base + *offset, 8);
+    size_t available = mapping->length - *offset - 8;
+    uint64_t padded = (length + 7) & ~(uint64_t)7;
+    if (length > available || padded > available) {
+        LOG_ERROR("Snapshot name record is invalid.");
+        return 0;
+    }
+    const char* text = (const char*)mapping->base + *offset + 8;
+    if (length > 0 && memchr(text, '\0', (size_t)length)) {
+        LOG_ERROR("Snapshot name record is invalid.");
+        return 0;
+    }
+    *offset += 8 + (size_t)padded;
+    if (length == 0) return 1;
+
+    *name = (char*)malloc((size_t)length + 1);
+    if (!*name) {
+        LOG_ERROR("Memory allocation failed.");
+        return 0;
+    }
+    memcpy(*name, text, (size_t)length);
+    (*name)[length] = '\0';
+    return 1;
+}
+
+// Function to read every slot of a snapshot
+/**
+ * @brief Maps a snapshot and builds the set (and name, for a named snapshot) of every slot.
+ *
+ * @param path The snapshot file.
+ * @param mapped 1 to use raw payloads in place from the mapped file, 0 to copy them.
+ * @param slots Receives the number of slots.
+ * @param sets Receives a new array of 'slots' sets, NULL for empty slots.
+ * @param names If not NULL, receives a new array of 'slots' names. Slots of a version 1 snapshot are
+ *              named by their index.
+ * @return int 1 on success, 0 on failure (nothing is returned).
+ */
+static int readSnapshot(const char* path, int mapped, uint32_t* slots, OrderedIntSet*** sets, char*** names) {
+    struct SetMapping* mapping = mapFile(path);
+    if (!mapping) return 0;
+
+    uint32_t version;
+    memcpy(&version, mapping->base + 8, 4);
+    memcpy(slots, mapping->base + 12, 4);
+    if (memcmp(mapping->base, SNAPSHOT_MAGIC, 8) != 0 ||
+        (version != SNAPSHOT_VERSION && version != SNAPSHOT_NAMED_VERSION)) {
+        LOG_ERROR("%s is not a version %d or %d snapshot.", path, SNAPSHOT_VERSION, SNAPSHOT_NAMED_VERSION);
+        releaseSetMapping(mapping);
+        return 0;
+    }
+    // Every slot takes at least a section header, which bounds a corrupt slot count
+    if (*slots > (mapping->length - SNAPSHOT_FILE_HEADER) / SNAPSHOT_SECTION_HEADER) {
+        LOG_ERROR("Snapshot %s is truncated.", path);
+        releaseSetMapping(mapping);
+        return 0;
+    }
+
+    size_t n = *slots > 0 ? (size_t)*slots : 1;
+    OrderedIntSet** loaded = (OrderedIntSet**)calloc(n, sizeof(OrderedIntSet*));
+    char** loadedNames = names ? (char**)calloc(n, sizeof(char*)) : NULL;
+    if (!loaded || (names && !loadedNames)) {
+        LOG_ERROR("Memory allocation failed.");
+        free(loaded);
+        free(loadedNames);
+        releaseSetMapping(mapping);
+        return 0;
+    }
+
+    size_t offset = SNAPSHOT_FILE_HEADER;
+    int ok = 1;
+    for (uint32_t slot = 0; ok && slot < *slots; slot++) {
+        char* name = NULL;
+        if (version == SNAPSHOT_NAMED_VERSION) ok = readName(mapping, &offset, &name);
+        if (ok) ok = readSection(mapping, &offset, mapped, &loaded[slot]);
+        if (ok && loaded[slot] && version == SNAPSHOT_NAMED_VERSION && !name) {
+            LOG_ERROR("Snapshot %s has a set without a name.", path);
+            ok = 0;
+        }
+        if (ok && loaded[slot] && names && !name) {
+            name = (char*)malloc(16);
+            if (name) snprintf(name, 16, "%u", slot);
+            else ok = 0;
+        }
+        if (names) loadedNames[slot] = name;
+        else free(name);
+    }
+
+    releaseSetMapping(mapping);  // The loaded sets keep their own references
+    if (!ok) {
+        for (uint32_t slot = 0; slot < *slots; slot++) {
+            deleteOrderedSet(loaded[slot]);
+            if (names) free(loadedNames[slot]);
+        }
+        free(loaded);
+        free(loadedNames);
+        LOG_ERROR("Cannot load snapshot %s.", path);
+        return 0;
+    }
+    *sets = loaded;
+    if (names) *names = loadedNames;
+    return 1;
+}
+
+// Function to load a snapshot
+/**
+ * @brief Loads every slot of a snapshot and replaces sets[0 .. count) with them.
+ *
+ * Nothing is replaced unless the whole snapshot loads. Slots the snapshot does not have
+ * become NULL; a snapshot with a non-empty slot at or beyond 'count' is rejected. The
+ * names of a named snapshot are ignored.
+ *
+ * @return int 1 on success, 0 on failure.
+ */
+static int loadSnapshot(OrderedIntSet** sets, int count, const char* path, int mapped) {
+    if (!sets || count < 0 || !path) return 0;
+
+    uint32_t slots;
+    OrderedIntSet** loaded;
+    if (!readSnapshot(path, mapped, &slots, &loaded, NULL)) return 0;
+
+    int ok = 1;
+    for (uint32_t slot = (uint32_t)count; slot < slots; slot++) {
+        if (loaded[slot]) ok = 0;
+    }
+    if (!ok) LOG_ERROR("Snapshot %s has more sets than there are slots.", path);
+
+    for (uint32_t slot = 0; slot < slots || slot < (uint32_t)count; slot++) {
+        OrderedIntSet* set = slot < slots ? loaded[slot] : NULL;
+        if (ok) {
+            deleteOrderedSet(sets[slot]);
+            sets[slot] = set;
+        } else {
+            deleteOrderedSet(set);
+        }
+    }
+    free(loaded);
+    return ok;
+}
+
+// Function to save one set
+/**
+ * @brief Writes one ordered set to a snapshot file.
+ *
+ * @param set The set to save (any backend).
+ * @param path The file to write.
+ * @param encoding SNAPSHOT_RAW to allow zero copy mapping, SNAPSHOT_DELTA_VARINT for a smaller file.
+ *
+ * @return int 1 on success, 0 on failure.
+ */
+int saveOrderedSet(const OrderedIntSet* set, const char* path, SnapshotEncoding encoding) {
+    if (!set) return 0;
+    return saveSnapshot(&set, NULL, 1, path, encoding);
+}
+
+// Function to load one set
+/**
+ * @brief Reads a snapshot of one set into a new sorted array set.
+ *
+ * @param path The snapshot file.
+ *
+ * @return A new ordered set or NULL if the file is missing, invalid or memory allocation fails.
+ */
+OrderedIntSet* loadOrderedSet(const char* path) {
+    OrderedIntSet* set = NULL;
+    loadSnapshot(&set, 1, path, 0);
+    return set;
+}
+
+// Function to map one set
+/**
+ * @brief Loads a snapshot of one set, using a raw payload in place from the mapped file.
+ *
+ * The returned set can be queried and used in set operations without its elements ever
+ * being copied. It is copied to the heap the first time it is modified. Delta varint
+ * snapshots are decoded into a sorted array, as with loadOrderedSet.
+ *
+ * @param path The snapshot file.
+ *
+ * @return A new ordered set or NULL if the file is missing, invalid or memory allocation fails.
+ */
+OrderedIntSet* mapOrderedSet(const char* path) {
+    OrderedIntSet* set = NULL;
+    loadSnapshot(&set, 1, path, 1);
+    return set;
+}
+
+// Function to save an array of sets
+/**
+ * @brief Writes 'count' set slots, for example the whole SetsArray, to one snapshot file.
+ *
+ * @param sets The slots; NULL entries are saved as empty slots.
+ * @param count Number of slots.
+ * @param path The file to write.
+ * @param encoding The payload encoding of every set.
+ *
+ * @return int 1 on success, 0 on failure.
+ */
+int saveSetsSnapshot(OrderedIntSet** sets, int count, const char* path, SnapshotEncoding encoding) {
+    return saveSnapshot((const OrderedIntSet* const*)sets, NULL, count, path, encoding);
+}
+
+// Function to load an array of sets
+/**
+ * @brief Replaces sets[0 .. count) with the slots of a snapshot written by saveSetsSnapshot.
+ *
+ * The existing sets are deleted only once the whole snapshot has loaded.
+ *
+ * @param sets The slots to fill.
+ * @param count Number of slots.
+ * @param path The snapshot file.
+ * @param mapped 1 to use raw payloads in place from the mapped file, 0 to copy them.
+ *
+ * @return int 1 on success, 0 on failure (the slots are then unchanged).
+ */
+int loadSetsSnapshot(OrderedIntSet** sets, int count, const char* path, int mapped) {
+    return loadSnapshot(sets, count, path, mapped);
+}
+
+// Function to save named sets
+/**
+ * @brief Writes 'count' set slots and their names to one snapshot file (version SNAPSHOT_NAMED_VERSION).
+ *
+ * @param names The name of each slot; names[i] is only read when sets[i] is not NULL.
+ * @param sets The slots; NULL entries are saved as empty slots.
+ * @param count Number of slots.
+ * @param path The file to write.
+ * @param encoding The payload encoding of every set.
+ *
+ * @return int 1 on success, 0 on failure.
+ */
+int saveNamedSetsSnapshot(const char* const* names, OrderedIntSet** sets, int count, const char* path,
+                          SnapshotEncoding encoding) {
+    if (!names) return 0;
+    return saveSnapshot((const OrderedIntSet* const*)sets, names, count, path, encoding);
+}
+
+// Function to load named sets
+/**
+ * @brief Loads every set of a snapshot and hands each one with its name to 'store'.
+ *
+ * Nothing is handed over unless the whole snapshot loads. 'store' takes ownership of the set;
+ * the name is only valid during the call. If 'store' returns 0 it has not taken the set, which is
+ * deleted along with the remaining ones, and loading fails. The sets of a version 1 snapshot are named by their slot index.
+ *
+ * @param path The snapshot file.
+ * @param mapped 1 to use raw payloads in place from the mapped file, 0 to copy them.
+ * @param store Receives each set; returns 1 on success, 0 on failure.
+ * @param context Passed to 'store'.
+ *
+ * @return int 1 on success, 0 on failure.
+ */
+int loadNamedSetsSnapshot(const char* path, int mapped,
+                          int (*store)(void* context, const char* name, OrderedIntSet* set), void* context) {
+    if (!path || !store) return 0;
+
+    uint32_t slots;
+    OrderedIntSet** loaded;
+    char** names;
+    if (!readSnapshot(path, mapped, &slots, &loaded, &names)) return 0;
+
+    int ok = 1;
+    for (uint32_t slot = 0; slot < slots; slot++) {
+        if (loaded[slot] && ok) {
+            ok = store(context, names[slot], loaded[slot]);
+            if (!ok) deleteOrderedSet(loaded[slot]);
+        } else {
+            deleteOrderedSet(loaded[slot]);
+        }
+        free(names[slot]);
+    }
+    free(loaded);
+    free(names);
+    return ok;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file setSnapshot.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for saving and loading Ordered Sets as binary snapshots.<br/>
+ *
+ * This header file declares the functions that write one set, or a whole array of
+ * set slots, to a versioned binary file and read it back. A snapshot starts with a
+ * file header (magic "OSETSNAP", version, number of slots) followed by one section
+ * per slot: a section header (present flag, encoding, element count, payload size,
+ * CRC-32 of the payload, byte order marker) and the payload, padded to 8 bytes.
+ * The payload holds the sorted elements either as raw ints or as delta encoded
+ * LEB128 varints. In a named snapshot (version 2) every section is preceded by a
+ * name record: the length of the name as 8 bytes and the name, padded to 8 bytes.
+ * Files use the byte order of the machine that wrote them.
+ *
+ * Loading memory-maps the file. With mapOrderedSet and a raw snapshot the set reads
+ * its elements in place from the mapping, without copying or allocating per element.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef SET_SNAPSHOT_H
+#define SET_SNAPSHOT_H
+
+#include <stddef.h>
+
+#include "orderedSet.h"
+
+// Version written to new snapshots
+#define SNAPSHOT_VERSION 1
+
+// Version written to snapshots that store a name for every set
+#define SNAPSHOT_NAMED_VERSION 2
+
+// Enumeration for payload encodings
+/**
+ * @enum SnapshotEncoding
+ * @brief Enum for the way the elements of a set are stored in a snapshot.
+ */
+typedef enum
+{
+    SNAPSHOT_RAW,            // 4 bytes per element, can be used in place when mapped
+    SNAPSHOT_DELTA_VARINT    // Gaps between consecutive elements as LEB128 varints, decoded on load
+} SnapshotEncoding;
+
+// Mapped file structure
+/**
+ * @brief Structure representing a read-only memory mapping of a snapshot file.
+ *
+ * - 'base' / 'length': the mapped bytes.
+ * - 'references': number of sets reading from the mapping, plus one while it is being loaded.
+ *   The file is unmapped when the last reference is released.
+ */
+struct SetMapping
+{
+    const unsigned char* base;
+    size_t length;
+    int references;
+#if defined(_WIN32)
+    void* file;
+    void* view;
+#endif
+};
+
+// Function declarations
+/**
+ * @brief Function declarations for snapshot operations.
+ *
+ * - 'saveOrderedSet': writes one set (any backend) to a snapshot file.
+ * - 'loadOrderedSet': reads a one set snapshot into a new sorted array set.
+ * - 'mapOrderedSet': like loadOrderedSet, but a raw snapshot is used in place from the mapped file.
+ * - 'saveSetsSnapshot': writes 'count' set slots, some of which may be NULL, to one file.
+ * - 'loadSetsSnapshot': replaces sets[0 .. count) with the slots of a snapshot (mapped in place if 'mapped').
+ * - 'saveNamedSetsSnapshot': like saveSetsSnapshot, but also stores the name of every set.
+ * - 'loadNamedSetsSnapshot': loads every set of a snapshot and passes it with its name to 'store', which takes
+ *   ownership of it. Nothing is passed on unless the whole snapshot loads.
+ * - 'releaseSetMapping': drops one reference to a mapping, unmapping the file with the last one.
+ * - 'snapshotChecksum': CRC-32 of a buffer, as stored in the section headers.
+ *
+ * Functions returning int return 1 on success and 0 on failure (the cause is logged). Loading checks
+ * the magic, version, byte order, sizes and checksum of every section, and that the elements ascend.
+ */
+int saveOrderedSet(const OrderedIntSet* set, const char* path, SnapshotEncoding encoding);
+OrderedIntSet* loadOrderedSet(const char* path);
+OrderedIntSet* mapOrderedSet(const char* path);
+int saveSetsSnapshot(OrderedIntSet** sets, int count, const char* path, SnapshotEncoding encoding);
+int loadSetsSnapshot(OrderedIntSet** sets, int count, const char* path, int mapped);
+int saveNamedSetsSnapshot(const char* const* names, OrderedIntSet** sets, int count, const char* path,
+                          SnapshotEncoding encoding);
+int loadNamedSetsSnapshot(const char* path, int mapped,
+                          int (*store)(void* context, const char* name, OrderedIntSet* set), void* context);
+void releaseSetMapping(struct SetMapping* mapping);
+unsigned int snapshotChecksum(const void* data, size_t length);
+
+#endif // SET_SNAPSHOT_H
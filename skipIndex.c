@@ -0,0 +1,395 @@
+/**
+ * @file skipIndex.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the Skip Index layered over a Double Linked List.<br/>
+ *
+ * This file contains the functions to create and delete a skip list index and to
+ * keep it in step with the sorted Double Linked List it indexes. Roughly one node
+ * in SKIP_INDEX_FANOUT gets a tower; every tower level above that is kept with the
+ * same probability, so a search descends the towers and then finishes with a short
+ * walk along the list. Counting the spans passed on the way down gives the rank of
+ * the value searched for.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+
+// include module header files
+#include "skipIndex.h"
+#include "logging.h"
+#include "instrumentation.h"
+
+// One node in SKIP_INDEX_FANOUT is promoted to each next level
+#define SKIP_INDEX_FANOUT 4
+
+// Function to allocate a tower
+/**
+ * @brief Allocates a tower with 'height' forward pointers, all set to NULL, and their spans.
+ *
+ * @param node The list node the tower belongs to (NULL for the sentinel).
+ * @param height Number of forward pointers.
+ * @return struct SkipTower* The new tower or NULL if memory allocation fails.
+ */
+static struct SkipTower* createTower(struct Node* node, int height) {
+    struct SkipTower* tower = (struct SkipTower*)malloc(sizeof(struct SkipTower) + height * (sizeof(struct SkipTower*) + sizeof(size_t)));
+    if (!tower) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    INSTR_COUNT_ALLOC(sizeof(struct SkipTower) + height * (sizeof(struct SkipTower*) + sizeof(size_t)));
+    tower->node = node;
+    tower->height = height;
+    tower->span = (size_t*)(tower->forward + height);
+    for (int l = 0; l < height; l++) {
+        tower->forward[l] = NULL;
+        tower->span[l] = 1;
+    }
+    return tower;
+}
+
+// Function to choose the height of a new tower
+/**
+ * @brief Draws a random tower height, 0 meaning the node is not indexed at all.
+ *
+ * @param index Pointer to the Skip Index (its generator state is advanced).
+ * @return int A height in 0..SKIP_INDEX_MAX_LEVEL.
+ */
+static int randomHeight(struct SkipIndex* index) {
+    int height = 0;
+    while (height < SKIP_INDEX_MAX_LEVEL) {
+        // xorshift32
+        index->seed ^= index->seed << 13;
+        index->seed ^= index->seed >> 17;
+        index->seed ^= index->seed << 5;
+        if (index->seed % SKIP_INDEX_FANOUT != 0) break;
+        height++;
+    }
+    return height;
+}
+
+// Function to create an empty skip index
+/**
+ * @brief Creates a new empty Skip Index.
+ *
+ * @return struct SkipIndex* Pointer to the new Skip Index or NULL if memory allocation fails.
+ */
+struct SkipIndex* createSkipIndex() {
+    struct SkipIndex* index = (struct SkipIndex*)malloc(sizeof(struct SkipIndex));
+    if (!index) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    INSTR_COUNT_ALLOC(sizeof(struct SkipIndex));
+    index->head = createTower(NULL, SKIP_INDEX_MAX_LEVEL);
+    if (!index->head) {
+        free(index);
+        return NULL;
+    }
+    index->level = 0;
+    for (int l = 0; l < SKIP_INDEX_MAX_LEVEL; l++) {
+        index->last[l] = index->head;
+    }
+    index->size = 0;
+    index->seed = 2463534242u;
+    return index;
+}
+
+// Function to delete a skip index
+/**
+ * @brief Deletes a Skip Index and frees all of its towers.
+ *
+ * The list nodes referenced by the towers belong to the list and are not freed.
+ *
+ * @param index Pointer to the Skip Index to delete.
+ */
+void deleteSkipIndex(struct SkipIndex* index) {
+    if (!index) return;
+
+    struct SkipTower* current = index->head->forward[0];
+    while (current) {
+        struct SkipTower* next = current->forward[0];
+        free(current);
+        current = next;
+    }
+    free(index->head);
+    free(index);
+}
+
+// Function to descend the towers towards a value
+/**
+ * @brief Finds, on every level, the last tower whose node holds data < value, and its position.
+ *
+ * @param index Pointer to the Skip Index.
+ * @param value The value searched for.
+ * @param path Receives the tower and position for each of the SKIP_INDEX_MAX_LEVEL levels (may be NULL).
+ * @param position Receives the position of the node of the returned tower (may be NULL).
+ * @return struct SkipTower* The last tower on level 0 before 'value' (the sentinel if none).
+ */
+static struct SkipTower* descend(struct SkipIndex* index, int value, struct SkipPath* path, size_t* position) {
+    struct SkipTower* current = index->head;
+    size_t passed = 0;
+
+    for (int l = SKIP_INDEX_MAX_LEVEL - 1; l >= index->level; l--) {
+        if (path) {
+            path->update[l] = index->head;
+            path->position[l] = 0;
+        }
+    }
+    for (int l = index->level - 1; l >= 0; l--) {
+        while (current->forward[l] && current->forward[l]->node->data < value) {
+            passed += current->span[l];
+            current = current->forward[l];
+            INSTR_COUNT_NODES(1);
+        }
+        if (path) {
+            path->update[l] = current;
+            path->position[l] = passed;
+        }
+    }
+    if (position) *position = passed;
+    return current;
+}
+
+// Function to find the first node not smaller than a value
+/**
+ * @brief Finds the first node of the list whose data is greater than or equal to 'value'.
+ *
+ * @param index Pointer to the Skip Index of the list.
+ * @param list Pointer to the sorted Double Linked List.
+ * @param value The value searched for.
+ * @return struct Node* The first node with data >= value or NULL if all nodes are smaller.
+ */
+struct Node* skipIndexLowerBound(struct SkipIndex* index, struct DoubleLinkedList* list, int value) {
+    return skipIndexFind(index, list, value, NULL);
+}
+
+// Function to find the first node not smaller than a value and the path to it
+/**
+ * @brief Finds the first node of the list whose data is >= 'value' and records the descent.
+ *
+ * @param index Pointer to the Skip Index of the list.
+ * @param list Pointer to the sorted Double Linked List.
+ * @param value The value searched for.
+ * @param path Receives the last tower before 'value' on every level (may be NULL).
+ * @return struct Node* The first node with data >= value or NULL if all nodes are smaller.
+ */
+struct Node* skipIndexFind(struct SkipIndex* index, struct DoubleLinkedList* list, int value, struct SkipPath* path) {
+    struct SkipTower* before = descend(index, value, path, NULL);
+    struct Node* current = (before == index->head) ? list->head : before->node->next;
+
+    // Finish with a short walk along the list between two towers
+    while (current && current->data < value) {
+        current = current->next;
+        INSTR_COUNT_NODES(1);
+    }
+    return current;
+}
+
+// Function to move a path forward to a larger value
+/**
+ * @brief Moves a path recorded for a smaller value forward to 'value'.
+ *
+ * Each level continues from its own tower or from the tower reached on the level above,
+ * whichever lies further along, so a run of ascending values is indexed in one pass.
+ *
+ * @param index Pointer to the Skip Index.
+ * @param path A path for a value <= 'value', still valid for the index.
+ * @param value The value to move to.
+ */
+void skipIndexAdvance(struct SkipIndex* index, struct SkipPath* path, int value) {
+    for (int l = index->level - 1; l >= 0; l--) {
+        if (l + 1 < SKIP_INDEX_MAX_LEVEL && path->position[l + 1] > path->position[l]) {
+            path->update[l] = path->update[l + 1];
+            path->position[l] = path->position[l + 1];
+        }
+        struct SkipTower* current = path->update[l];
+        while (current->forward[l] && current->forward[l]->node->data < value) {
+            path->position[l] += current->span[l];
+            current = current->forward[l];
+            INSTR_COUNT_NODES(1);
+        }
+        path->update[l] = current;
+    }
+}
+
+// Function to index a newly linked node
+/**
+ * @brief Gives a node that has just been linked into the list a tower, with some probability,
+ * and counts it in the spans passing over it.
+ *
+ * A node appended at the tail comes after every tower, and a NULL forward pointer spans
+ * the rest of the list, so its path is read from 'last' without a descent.
+ *
+ * @param index Pointer to the Skip Index of the list.
+ * @param node The node that was inserted.
+ * @return int 1 on success, 0 if memory allocation failed (the node then stays unindexed, which is harmless).
+ */
+int skipIndexInsert(struct SkipIndex* index, struct Node* node) {
+    struct SkipPath path;
+    if (!node->next) {
+        for (int l = 0; l < SKIP_INDEX_MAX_LEVEL; l++) {
+            path.update[l] = index->last[l];
+            path.position[l] = index->size + 1 - path.update[l]->span[l];
+        }
+    } else {
+        descend(index, node->data, &path, NULL);
+    }
+    return skipIndexInsertAt(index, node, &path);
+}
+
+// Function to index a newly linked node along a known path
+/**
+ * @brief Like skipIndexInsert, for a node whose path has already been found.
+ *
+ * The position of the node is found by walking back along its 'prev' links to the node of
+ * the last tower before it, a few steps on average. Afterwards the path leads to the new
+ * node, so it can be advanced to a larger value for the next insertion.
+ *
+ * @param index Pointer to the Skip Index of the list.
+ * @param node The node that was inserted.
+ * @param path The path for node->data, found before the node was linked in.
+ * @return int 1 on success, 0 if memory allocation failed (the node then stays unindexed, which is harmless).
+ */
+int skipIndexInsertAt(struct SkipIndex* index, struct Node* node, struct SkipPath* path) {
+    struct SkipTower** update = path->update;
+    size_t* position = path->position;
+    int height = randomHeight(index);
+    int result = 1;
+
+    struct SkipTower* tower = NULL;
+    if (height > 0) {
+        tower = createTower(node, height);
+        if (!tower) {
+            result = 0;
+            height = 0;
+        }
+    }
+    if (height > 0) {
+        size_t nodePosition = position[0] + 1;
+        for (struct Node* walk = node->prev; walk != update[0]->node; walk = walk->prev) {
+            nodePosition++;
+        }
+        for (int l = 0; l < height; l++) {
+            tower->forward[l] = update[l]->forward[l];
+            tower->span[l] = position[l] + update[l]->span[l] + 1 - nodePosition;
+            update[l]->forward[l] = tower;
+            update[l]->span[l] = nodePosition - position[l];
+            if (!tower->forward[l]) index->last[l] = tower;
+            update[l] = tower;
+            position[l] = nodePosition;
+        }
+        if (height > index->level) index->level = height;
+    }
+    for (int l = height; l < SKIP_INDEX_MAX_LEVEL; l++) {
+        update[l]->span[l]++;
+    }
+    index->size++;
+    return result;
+}
+
+// Function to unindex a node before it is removed
+/**
+ * @brief Removes the tower of a node, if it has one, and the node from the spans passing
+ * over it, before the node is unlinked from the list.
+ *
+ * @param index Pointer to the Skip Index of the list.
+ * @param node The node about to be removed.
+ */
+void skipIndexRemove(struct SkipIndex* index, struct Node* node) {
+    struct SkipPath path;
+    descend(index, node->data, &path, NULL);
+    skipIndexRemoveAt(index, node, &path);
+}
+
+// Function to unindex a node along a known path
+/**
+ * @brief Like skipIndexRemove, for a node whose path has already been found.
+ *
+ * @param index Pointer to the Skip Index of the list.
+ * @param node The node about to be removed.
+ * @param path The path for node->data.
+ */
+void skipIndexRemoveAt(struct SkipIndex* index, struct Node* node, const struct SkipPath* path) {
+    struct SkipTower* const* update = path->update;
+    struct SkipTower* tower = update[0]->forward[0];
+    int height = (tower && tower->node == node) ? tower->height : 0;
+
+    for (int l = 0; l < height; l++) {
+        update[l]->forward[l] = tower->forward[l];
+        update[l]->span[l] += tower->span[l] - 1;
+        if (index->last[l] == tower) index->last[l] = update[l];
+    }
+    for (int l = height; l < SKIP_INDEX_MAX_LEVEL; l++) {
+        update[l]->span[l]--;
+    }
+    index->size--;
+    if (height == 0) return;  // The node has no tower
+    free(tower);
+
+    while (index->level > 0 && !index->head->forward[index->level - 1]) {
+        index->level--;
+    }
+}
+
+// Function to count the nodes smaller than a value
+/**
+ * @brief Returns the rank of a value: the number of nodes of the list with data < value.
+ *
+ * @param index Pointer to the Skip Index of the list.
+ * @param list Pointer to the sorted Double Linked List.
+ * @param value The value to rank.
+ * @return size_t Number of nodes holding a smaller value.
+ */
+size_t skipIndexRank(struct SkipIndex* index, struct DoubleLinkedList* list, int value) {
+    size_t rank;
+    struct SkipTower* before = descend(index, value, NULL, &rank);
+    struct Node* current = (before == index->head) ? list->head : before->node->next;
+
+    while (current && current->data < value) {
+        rank++;
+        current = current->next;
+    }
+    return rank;
+}
+
+// Function to find the node at a position
+/**
+ * @brief Finds the node at a 0-based position of the list by following the spans.
+ *
+ * @param index Pointer to the Skip Index of the list.
+ * @param list Pointer to the sorted Double Linked List.
+ * @param position Position of the node, smaller than the length of the list.
+ * @return struct Node* The node at 'position'.
+ */
+struct Node* skipIndexSelect(struct SkipIndex* index, struct DoubleLinkedList* list, size_t position) {
+    struct SkipTower* current = index->head;
+    size_t target = position + 1;
+    size_t passed = 0;
+
+    for (int l = index->level - 1; l >= 0; l--) {
+        while (current->forward[l] && passed + current->span[l] <= target) {
+            passed += current->span[l];
+            current = current->forward[l];
+        }
+    }
+    struct Node* node = (current == index->head) ? list->head : current->node;
+    if (current == index->head) passed = 1;
+    for (; passed < target; passed++) {
+        node = node->next;
+    }
+    return node;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file skipIndex.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the Skip Index layered over a Double Linked List.<br/>
+ *
+ * This header file defines the structures and function prototypes for a skip list
+ * index whose bottom level is the existing chain of 'struct Node' of a sorted
+ * Double Linked List. Only some nodes get a tower of forward pointers, so searching,
+ * inserting and removing take O(log n) expected time while in-order iteration still
+ * simply follows the 'next' pointers of the list. Every forward pointer also records how
+ * many list nodes it passes over, so the position of a value (its rank) and the node at a
+ * given position can be found in O(log n) expected time as well.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef SKIP_INDEX_H
+#define SKIP_INDEX_H
+
+#include <stddef.h>
+
+#include "doubleLinkedList.h"
+
+// Maximum number of levels a tower can have
+#define SKIP_INDEX_MAX_LEVEL 16
+
+// Skip tower structure
+/**
+ * @brief Structure representing the tower of forward pointers of one indexed node.
+ *
+ * - 'node': the list node this tower belongs to.
+ * - 'height': the number of forward pointers in the tower.
+ * - 'span': span[l] is the number of list nodes passed by following forward[l], the node of
+ *   forward[l] included. A NULL forward pointer passes the rest of the list plus one, as if
+ *   the list ended in a node after its last one.
+ * - 'forward': forward[l] points to the next tower of height > l, or NULL.
+ *
+ * Towers are allocated with exactly 'height' forward pointers, followed by 'height' spans.
+ */
+struct SkipTower
+{
+    struct Node* node;
+    int height;
+    size_t* span;
+    struct SkipTower* forward[];
+};
+
+// Skip index structure
+/**
+ * @brief Structure representing a skip list index over a sorted Double Linked List.
+ *
+ * - 'head': sentinel tower of height SKIP_INDEX_MAX_LEVEL that precedes every node.
+ * - 'level': number of levels currently in use.
+ * - 'last': last[l] is the last tower of height > l, or 'head'; nodes appended at the tail of the
+ *   list are linked in after these without a descent.
+ * - 'size': number of nodes in the list.
+ * - 'seed': state of the random generator that chooses tower heights.
+ */
+struct SkipIndex
+{
+    struct SkipTower* head;
+    int level;
+    struct SkipTower* last[SKIP_INDEX_MAX_LEVEL];
+    size_t size;
+    unsigned int seed;
+};
+
+// Skip path structure
+/**
+ * @brief Structure recording where a descent towards a value left each level.
+ *
+ * - 'update': update[l] is the last tower of height > l whose node holds data < the value (or 'head').
+ * - 'position': position[l] is the 1-based list position of the node of update[l], 0 for 'head'.
+ *
+ * A path stays valid while only nodes after the value are linked in or removed.
+ */
+struct SkipPath
+{
+    struct SkipTower* update[SKIP_INDEX_MAX_LEVEL];
+    size_t position[SKIP_INDEX_MAX_LEVEL];
+};
+
+// Function declarations
+/**
+ * @brief Function declarations for Skip Index operations.
+ *
+ * - 'createSkipIndex': Creates a new empty Skip Index.
+ * - 'deleteSkipIndex': Deletes a Skip Index and all of its towers (the list nodes are not touched).
+ * - 'skipIndexLowerBound': Finds the first node of the list with data >= value.
+ * - 'skipIndexInsert': Indexes a node that has just been linked into the list.
+ * - 'skipIndexRemove': Unindexes a node that is about to be removed from the list.
+ * - 'skipIndexFind': Like skipIndexLowerBound, also recording the path to the value.
+ * - 'skipIndexAdvance': Moves a path forward to a larger value.
+ * - 'skipIndexInsertAt' / 'skipIndexRemoveAt': Like skipIndexInsert and skipIndexRemove, reusing the path to
+ *   the value of the node; skipIndexInsertAt leaves the path leading to the new node.
+ * - 'skipIndexRank': Counts the nodes of the list with data < value.
+ * - 'skipIndexSelect': Finds the node at a 0-based position of the list (which must be smaller than its length).
+ *
+ * Every node linked into or removed from the list must be passed to skipIndexInsert or
+ * skipIndexRemove, whether or not it has a tower, so that the spans stay correct.
+ */
+struct SkipIndex* createSkipIndex();
+void deleteSkipIndex(struct SkipIndex* index);
+struct Node* skipIndexLowerBound(struct SkipIndex* index, struct DoubleLinkedList* list, int value);
+int skipIndexInsert(struct SkipIndex* index, struct Node* node);
+void skipIndexRemove(struct SkipIndex* index, struct Node* node);
+struct Node* skipIndexFind(struct SkipIndex* index, struct DoubleLinkedList* list, int value, struct SkipPath* path);
+void skipIndexAdvance(struct SkipIndex* index, struct SkipPath* path, int value);
+int skipIndexInsertAt(struct SkipIndex* index, struct Node* node, struct SkipPath* path);
+void skipIndexRemoveAt(struct SkipIndex* index, struct Node* node, const struct SkipPath* path);
+size_t skipIndexRank(struct SkipIndex* index, struct DoubleLinkedList* list, int value);
+struct Node* skipIndexSelect(struct SkipIndex* index, struct DoubleLinkedList* list, size_t position);
+
+#endif // SKIP_INDEX_H
@@ -0,0 +1,341 @@
+/**
+ * @file sortedArray.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the Sorted Array data structure used in the Ordered Set.<br/>
+ *
+ * This file contains a set of functions to manage a contiguous, growable array of
+ * integers kept in ascending order, including creating, deleting, searching and
+ * inserting or removing elements at a position.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// include module header files
+#include "sortedArray.h"
+#include "logging.h"
+#include "instrumentation.h"
+
+// Smallest buffer allocated for a non-empty array
+#define SORTED_ARRAY_MIN_CAPACITY 16
+
+// Below this many elements insertion sort beats the radix sort passes
+#define RADIX_SORT_THRESHOLD 64
+
+// Function to create an empty sorted array
+/**
+ * @brief Creates a new empty Sorted Array.
+ *
+ * @param capacity Number of elements to reserve up front (0 defers allocation to the first insert).
+ * @return struct SortedArray* Pointer to the newly created Sorted Array or NULL if memory allocation fails.
+ */
+struct SortedArray* createSortedArray(size_t capacity) {
+    struct SortedArray* array = (struct SortedArray*)malloc(sizeof(struct SortedArray));
+    if (!array) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    INSTR_COUNT_ALLOC(sizeof(struct SortedArray));
+    array->data = NULL;
+    array->size = 0;
+    array->capacity = 0;
+    if (capacity > 0 && !reserveSortedArray(array, capacity)) {
+        free(array);
+        return NULL;
+    }
+    return array;
+}
+
+// Function to delete a sorted array
+/**
+ * @brief Deletes a Sorted Array and frees its memory.
+ *
+ * @param array Pointer to the Sorted Array to delete.
+ */
+void deleteSortedArray(struct SortedArray* array) {
+    if (!array) return;
+    free(array->data);
+    free(array);
+}
+
+// Function to grow the buffer of a sorted array
+/**
+ * @brief Makes sure the Sorted Array can hold at least 'capacity' elements.
+ *
+ * @param array Pointer to the Sorted Array.
+ * @param capacity Minimum number of elements the buffer must be able to hold.
+ * @return int 1 on success, 0 if memory allocation failed (the array is left unchanged).
+ */
+int reserveSortedArray(struct SortedArray* array, size_t capacity) {
+    if (!array) return 0;
+    if (capacity <= array->capacity) return 1;
+
+    int* data = (int*)realloc(array->data, capacity * sizeof(int));
+    if (!data) {
+        LOG_ERROR("Memory allocation failed.");
+        return 0;
+    }
+    INSTR_COUNT_ALLOC((capacity - array->capacity) * sizeof(int));
+    array->data = data;
+    array->capacity = capacity;
+    return 1;
+}
+
+// Function to grow the buffer geometrically before adding one more element
+/**
+ * @brief Doubles the capacity of the Sorted Array when it is full.
+ *
+ * @param array Pointer to the Sorted Array.
+ * @return int 1 if there is room for one more element, 0 if memory allocation failed.
+ */
+static int growSortedArray(struct SortedArray* array) {
+    if (array->size < array->capacity) return 1;
+    size_t capacity = array->capacity ? array->capacity * 2 : SORTED_ARRAY_MIN_CAPACITY;
+    return reserveSortedArray(array, capacity);
+}
+
+// Function to find where a value is or would be stored
+/**
+ * @brief Finds the first position whose value is greater than or equal to 'value'.
+ *
+ * @param array Pointer to the Sorted Array.
+ * @param value The value to search for.
+ * @return size_t Position of the first element >= value, or 'size' if every element is smaller.
+ */
+size_t sortedArrayLowerBound(const struct SortedArray* array, int value) {
+    size_t low = 0;
+    size_t high = array->size;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (array->data[mid] < value) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Function to insert a value at a given position
+/**
+ * @brief Inserts a value at position 'pos', moving later elements one place up.
+ *
+ * @param array Pointer to the Sorted Array.
+ * @param pos Position to insert at (0 to size). The caller keeps the array ordered.
+ * @param value The value to insert.
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+int sortedArrayInsertAt(struct SortedArray* array, size_t pos, int value) {
+    if (!array || pos > array->size) return 0;
+    if (!growSortedArray(array)) return 0;
+
+    memmove(&array->data[pos + 1], &array->data[pos], (array->size - pos) * sizeof(int));
+    array->data[pos] = value;
+    array->size++;
+    return 1;
+}
+
+// Function to remove the value at a given position
+/**
+ * @brief Removes the value at position 'pos', moving later elements one place down.
+ *
+ * @param array Pointer to the Sorted Array.
+ * @param pos Position of the element to remove.
+ */
+void sortedArrayRemoveAt(struct SortedArray* array, size_t pos) {
+    if (!array || pos >= array->size) {
+        LOG_ERROR("Invalid position or array.");
+        return;
+    }
+    memmove(&array->data[pos], &array->data[pos + 1], (array->size - pos - 1) * sizeof(int));
+    array->size--;
+}
+
+// Function to append a value to the end of the array
+/**
+ * @brief Appends a value to the end of the Sorted Array.
+ *
+ * @param array Pointer to the Sorted Array.
+ * @param value The value to append. It must be greater than the current last element.
+ * @return int 1 on success, 0 if memory allocation failed.
+ */
+int sortedArrayAppend(struct SortedArray* array, int value) {
+    if (!array) return 0;
+    if (!growSortedArray(array)) return 0;
+
+    array->data[array->size++] = value;
+    return 1;
+}
+
+// Function to sort a small buffer in place
+/**
+ * @brief Sorts a buffer of ints in ascending order using insertion sort.
+ *
+ * @param data The buffer to sort.
+ * @param n Number of elements in the buffer.
+ */
+static void insertionSortInts(int* data, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        int value = data[i];
+        size_t j = i;
+        while (j > 0 && data[j - 1] > value) {
+            data[j] = data[j - 1];
+            j--;
+        }
+        data[j] = value;
+    }
+}
+
+// Function to radix sort a buffer of ints
+/**
+ * @brief Sorts a buffer of 32-bit ints in ascending order with an LSD radix sort.
+ *
+ * The keys are processed one byte at a time (four counting passes over the data). The sign
+ * bit is flipped so negative numbers sort before positive ones, and passes where every key
+ * has the same byte are skipped. Small buffers fall back to insertion sort.
+ *
+ * @param data The buffer to sort; it holds the sorted result on return.
+ * @param scratch A buffer of at least 'n' ints used between passes (unused for small inputs).
+ * @param n Number of elements in the buffer.
+ */
+void radixSortInts(int* data, int* scratch, size_t n) {
+    if (n < RADIX_SORT_THRESHOLD || !scratch) {
+        insertionSortInts(data, n);
+        return;
+    }
+
+    size_t counts[4][256] = { { 0 } };
+    for (size_t i = 0; i < n; i++) {
+        unsigned int key = (unsigned int)data[i] ^ 0x80000000u;
+        counts[0][key & 0xFF]++;
+        counts[1][(key >> 8) & 0xFF]++;
+        counts[2][(key >> 16) & 0xFF]++;
+        counts[3][key >> 24]++;
+    }
+
+    unsigned int* from = (unsigned int*)data;
+    unsigned int* to = (unsigned int*)scratch;
+    for (int pass = 0; pass < 4; pass++) {
+        int shift = pass * 8;
+        size_t* count = counts[pass];
+
+        // Skip the pass when every key has the same byte here
+        unsigned int first = (((unsigned int)from[0] ^ 0x80000000u) >> shift) & 0xFF;
+        if (count[first] == n) continue;
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            unsigned int key = (from[i] ^ 0x80000000u) >> shift;
+            to[count[key & 0xFF]++] = from[i];
+        }
+
+        unsigned int* swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != (unsigned int*)data) {
+        memcpy(data, from, n * sizeof(int));
+    }
+}
+
+// Function to drop duplicates from a sorted buffer
+/**
+ * @brief Removes adjacent duplicates from a sorted buffer in place.
+ *
+ * @param data The sorted buffer.
+ * @param n Number of elements in the buffer.
+ * @return size_t Number of distinct elements now at the front of the buffer.
+ */
+size_t removeDuplicateInts(int* data, size_t n) {
+    if (n == 0) return 0;
+
+    size_t kept = 1;
+    for (size_t i = 1; i < n; i++) {
+        if (data[i] != data[kept - 1]) {
+            data[kept++] = data[i];
+        }
+    }
+    return kept;
+}
+
+// Function to release the unused part of a sorted array buffer
+/**
+ * @brief Shrinks the buffer of a Sorted Array to its size once at least half of it is unused.
+ *
+ * The array is left as it is if the reallocation fails.
+ *
+ * @param array Pointer to the Sorted Array.
+ */
+static void shrinkSortedArray(struct SortedArray* array) {
+    if (array->size == 0 || array->size > array->capacity / 2) return;
+    int* data = (int*)realloc(array->data, array->size * sizeof(int));
+    if (!data) return;
+    array->data = data;
+    array->capacity = array->size;
+}
+
+// Function to build a sorted array from an unsorted buffer
+/**
+ * @brief Creates a Sorted Array holding the distinct values of an unsorted buffer.
+ *
+ * The element storage is allocated once. Input that is already in ascending order is
+ * copied (and deduplicated) in a single pass into room for 'n' values; anything else gets
+ * room for 2 * n values, radix sorted in the first half with the second half as scratch,
+ * and is then deduplicated. The buffer is shrunk to the result if that leaves at least
+ * half of it unused, which drops the scratch half and the room taken by duplicates.
+ *
+ * @param data The values to store (not modified, may contain duplicates).
+ * @param n Number of values in 'data'.
+ * @return struct SortedArray* The new Sorted Array or NULL if memory allocation fails.
+ */
+struct SortedArray* createSortedArrayFromInts(const int* data, size_t n) {
+    if (n == 0) return createSortedArray(0);
+
+    // Fast path: already sorted input only needs copying and deduplication
+    size_t i = 1;
+    while (i < n && data[i - 1] <= data[i]) {
+        i++;
+    }
+    int sorted = i == n;
+    int radix = !sorted && n >= RADIX_SORT_THRESHOLD;
+    struct SortedArray* array = createSortedArray(radix ? 2 * n : n);
+    if (!array) return NULL;
+
+    if (sorted) {
+        array->data[0] = data[0];
+        array->size = 1;
+        for (i = 1; i < n; i++) {
+            if (data[i] != array->data[array->size - 1]) {
+                array->data[array->size++] = data[i];
+            }
+        }
+    } else {
+        memcpy(array->data, data, n * sizeof(int));
+        radixSortInts(array->data, radix ? array->data + n : NULL, n);
+        array->size = removeDuplicateInts(array->data, n);
+    }
+    shrinkSortedArray(array);
+    return array;
+}
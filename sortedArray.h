@@ -0,0 +1,74 @@
+/**
+ * @file sortedArray.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the Sorted Array data structure.<br/>
+ *
+ * This header file defines the structure and function prototypes for a contiguous,
+ * growable array of integers kept in ascending order. It is used as an alternative
+ * storage engine for the Ordered Set where cache friendly scans and binary search
+ * lookups matter more than cheap insertion in the middle.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef SORTED_ARRAY_H
+#define SORTED_ARRAY_H
+
+#include <stddef.h>
+
+// Sorted Array structure
+/**
+ * @brief Structure representing a growable sorted array of integers.
+ *
+ * This structure holds:
+ * - 'data': points to the first element of the contiguous buffer.
+ * - 'size': the number of elements currently stored.
+ * - 'capacity': the number of elements the buffer can hold before it must grow.
+ */
+struct SortedArray
+{
+    int* data;
+    size_t size;
+    size_t capacity;
+};
+
+// Function declarations
+/**
+ * @brief Function declarations for Sorted Array operations.
+ *
+ * - 'createSortedArray': Creates a new empty Sorted Array with an initial capacity.
+ * - 'deleteSortedArray': Deletes a Sorted Array and frees its memory.
+ * - 'reserveSortedArray': Grows the buffer so it can hold at least 'capacity' elements.
+ * - 'sortedArrayLowerBound': Binary search for the first position holding a value >= 'value'.
+ * - 'sortedArrayInsertAt': Inserts a value at a given position, shifting later elements up.
+ * - 'sortedArrayRemoveAt': Removes the value at a given position, shifting later elements down.
+ * - 'sortedArrayAppend': Appends a value to the end of the Sorted Array.
+ * - 'createSortedArrayFromInts': Builds a Sorted Array from an unsorted buffer that may contain duplicates.
+ * - 'radixSortInts': Sorts a buffer of ints in ascending order using a scratch buffer of the same size.
+ * - 'removeDuplicateInts': Removes adjacent duplicates from a sorted buffer and returns the new length.
+ *
+ * Functions that may allocate return 1 on success and 0 if memory allocation failed.
+ */
+struct SortedArray* createSortedArray(size_t capacity);
+void deleteSortedArray(struct SortedArray* array);
+int reserveSortedArray(struct SortedArray* array, size_t capacity);
+size_t sortedArrayLowerBound(const struct SortedArray* array, int value);
+int sortedArrayInsertAt(struct SortedArray* array, size_t pos, int value);
+void sortedArrayRemoveAt(struct SortedArray* array, size_t pos);
+int sortedArrayAppend(struct SortedArray* array, int value);
+struct SortedArray* createSortedArrayFromInts(const int* data, size_t n);
+void radixSortInts(int* data, int* scratch, size_t n);
+size_t removeDuplicateInts(int* data, size_t n);
+
+#endif // SORTED_ARRAY_H
@@ -0,0 +1,305 @@
+/**
+ * @file threadPool.c
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Source file for the portable threading wrappers and the Thread Pool.<br/>
+ *
+ * This file maps the threading wrappers onto POSIX threads or the Win32 API and
+ * implements the Thread Pool. Workers sleep on a condition variable between batches;
+ * within a batch every thread, including the caller, repeatedly claims the next task
+ * number until none are left.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+ // include system header files
+#include <stdio.h>
+#include <stdlib.h>
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+// include module header files
+#include "threadPool.h"
+#include "logging.h"
+
+// Start routine and argument handed to a new thread
+/**
+ * @brief Structure carrying a ThreadStart and its argument into the platform thread entry point.
+ */
+struct ThreadStartInfo
+{
+    ThreadStart start;
+    void* arg;
+};
+
+#if defined(_WIN32)
+
+void threadMutexInit(ThreadMutex* mutex) { InitializeCriticalSection(mutex); }
+void threadMutexDestroy(ThreadMutex* mutex) { DeleteCriticalSection(mutex); }
+void threadMutexLock(ThreadMutex* mutex) { EnterCriticalSection(mutex); }
+void threadMutexUnlock(ThreadMutex* mutex) { LeaveCriticalSection(mutex); }
+void threadConditionInit(ThreadCondition* condition) { InitializeConditionVariable(condition); }
+void threadConditionDestroy(ThreadCondition* condition) { (void)condition; }
+void threadConditionWait(ThreadCondition* condition, ThreadMutex* mutex) { SleepConditionVariableCS(condition, mutex, INFINITE); }
+void threadConditionSignal(ThreadCondition* condition) { WakeConditionVariable(condition); }
+void threadConditionBroadcast(ThreadCondition* condition) { WakeAllConditionVariable(condition); }
+
+// Function to run a ThreadOnceFunction from InitOnceExecuteOnce
+static BOOL CALLBACK threadOnceEntry(PINIT_ONCE once, PVOID param, PVOID* context) {
+    (void)once;
+    (void)context;
+    (*(ThreadOnceFunction*)param)();
+    return TRUE;
+}
+
+// Function to run an initialisation exactly once
+void threadOnce(ThreadOnce* once, ThreadOnceFunction function) {
+    InitOnceExecuteOnce(once, threadOnceEntry, &function, NULL);
+}
+
+// Function to run a ThreadStart on a Win32 thread
+static DWORD WINAPI threadEntry(LPVOID param) {
+    struct ThreadStartInfo info = *(struct ThreadStartInfo*)param;
+    free(param);
+    info.start(info.arg);
+    return 0;
+}
+
+// Function to start a thread
+/**
+ * @brief Starts a thread running start(arg).
+ *
+ * @return int 1 on success, 0 if the thread could not be created.
+ */
+int threadCreate(ThreadHandle* thread, ThreadStart start, void* arg) {
+    struct ThreadStartInfo* info = (struct ThreadStartInfo*)malloc(sizeof(struct ThreadStartInfo));
+    if (!info) return 0;
+    info->start = start;
+    info->arg = arg;
+    *thread = CreateThread(NULL, 0, threadEntry, info, 0, NULL);
+    if (!*thread) {
+        free(info);
+        return 0;
+    }
+    return 1;
+}
+
+// Function to wait for a thread to finish
+void threadJoin(ThreadHandle thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+// Function to count the logical processors
+int threadHardwareConcurrency() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+}
+
+#else
+
+void threadMutexInit(ThreadMutex* mutex) { pthread_mutex_init(mutex, NULL); }
+void threadMutexDestroy(ThreadMutex* mutex) { pthread_mutex_destroy(mutex); }
+void threadMutexLock(ThreadMutex* mutex) { pthread_mutex_lock(mutex); }
+void threadMutexUnlock(ThreadMutex* mutex) { pthread_mutex_unlock(mutex); }
+void threadConditionInit(ThreadCondition* condition) { pthread_cond_init(condition, NULL); }
+void threadConditionDestroy(ThreadCondition* condition) { pthread_cond_destroy(condition); }
+void threadConditionWait(ThreadCondition* condition, ThreadMutex* mutex) { pthread_cond_wait(condition, mutex); }
+void threadConditionSignal(ThreadCondition* condition) { pthread_cond_signal(condition); }
+void threadConditionBroadcast(ThreadCondition* condition) { pthread_cond_broadcast(condition); }
+void threadOnce(ThreadOnce* once, ThreadOnceFunction function) { pthread_once(once, function); }
+
+// Function to run a ThreadStart on a POSIX thread
+static void* threadEntry(void* param) {
+    struct ThreadStartInfo info = *(struct ThreadStartInfo*)param;
+    free(param);
+    info.start(info.arg);
+    return NULL;
+}
+
+// Function to start a thread
+/**
+ * @brief Starts a thread running start(arg).
+ *
+ * @return int 1 on success, 0 if the thread could not be created.
+ */
+int threadCreate(ThreadHandle* thread, ThreadStart start, void* arg) {
+    struct ThreadStartInfo* info = (struct ThreadStartInfo*)malloc(sizeof(struct ThreadStartInfo));
+    if (!info) return 0;
+    info->start = start;
+    info->arg = arg;
+    if (pthread_create(thread, NULL, threadEntry, info) != 0) {
+        free(info);
+        return 0;
+    }
+    return 1;
+}
+
+// Function to wait for a thread to finish
+void threadJoin(ThreadHandle thread) {
+    pthread_join(thread, NULL);
+}
+
+// Function to count the logical processors
+int threadHardwareConcurrency() {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+#endif
+
+// Function to run the claimed tasks of the current batch
+/**
+ * @brief Claims and runs tasks of the current batch until none are left.
+ *
+ * Called with the pool lock held; returns with it held.
+ *
+ * @param pool The Thread Pool.
+ */
+static void runClaimedTasks(struct ThreadPool* pool) {
+    while (pool->nextTask < pool->taskCount) {
+        int task = pool->nextTask++;
+        threadMutexUnlock(&pool->lock);
+        pool->task(pool->context, task);
+        threadMutexLock(&pool->lock);
+        if (++pool->finishedTasks == pool->taskCount) {
+            threadConditionSignal(&pool->workDone);
+        }
+    }
+}
+
+// Function run by each worker thread
+/**
+ * @brief Worker loop: sleep until a batch has unclaimed tasks, run them, repeat until shutdown.
+ *
+ * @param arg The Thread Pool.
+ */
+static void workerMain(void* arg) {
+    struct ThreadPool* pool = (struct ThreadPool*)arg;
+    threadMutexLock(&pool->lock);
+    while (!pool->shuttingDown) {
+        if (pool->nextTask < pool->taskCount) {
+            runClaimedTasks(pool);
+        } else {
+            threadConditionWait(&pool->workReady, &pool->lock);
+        }
+    }
+    threadMutexUnlock(&pool->lock);
+}
+
+// Function to create a thread pool
+/**
+ * @brief Creates a Thread Pool that runs batches on 'threads' threads.
+ *
+ * The thread calling threadPoolRun takes part in every batch, so 'threads - 1' workers are started.
+ *
+ * @param threads Total number of threads, at least 1.
+ * @return struct ThreadPool* Pointer to the new pool or NULL if memory allocation or thread creation fails.
+ */
+struct ThreadPool* createThreadPool(int threads) {
+    if (threads < 1) threads = 1;
+
+    struct ThreadPool* pool = (struct ThreadPool*)malloc(sizeof(struct ThreadPool));
+    if (!pool) {
+        LOG_ERROR("Memory allocation failed.");
+        return NULL;
+    }
+    pool->threads = (ThreadHandle*)malloc(sizeof(ThreadHandle) * threads);
+    if (!pool->threads) {
+        LOG_ERROR("Memory allocation failed.");
+        free(pool);
+        return NULL;
+    }
+    threadMutexInit(&pool->runLock);
+    threadMutexInit(&pool->lock);
+    threadConditionInit(&pool->workReady);
+    threadConditionInit(&pool->workDone);
+    pool->threadCount = 0;
+    pool->task = NULL;
+    pool->context = NULL;
+    pool->taskCount = 0;
+    pool->nextTask = 0;
+    pool->finishedTasks = 0;
+    pool->shuttingDown = 0;
+
+    for (int t = 0; t < threads - 1; t++) {
+        if (!threadCreate(&pool->threads[t], workerMain, pool)) {
+            LOG_ERROR("Thread creation failed.");
+            deleteThreadPool(pool);
+            return NULL;
+        }
+        pool->threadCount++;
+    }
+    LOG_INFO("Thread pool created with %d threads.", threads);
+    return pool;
+}
+
+// Function to run a batch of tasks
+/**
+ * @brief Runs task(context, 0) .. task(context, taskCount - 1) on the pool and waits for them.
+ *
+ * Tasks are handed out in order to whichever thread is free, so a batch may have more tasks
+ * than threads. Only one batch runs at a time: a caller that arrives while another batch runs
+ * waits for it to finish. The pool must not be used from inside a task.
+ *
+ * @param pool The Thread Pool.
+ * @param task Function run once per task number.
+ * @param context Passed unchanged to every task.
+ * @param taskCount Number of tasks in the batch.
+ */
+void threadPoolRun(struct ThreadPool* pool, ThreadTask task, void* context, int taskCount) {
+    if (taskCount <= 0) return;
+
+    threadMutexLock(&pool->runLock);
+    threadMutexLock(&pool->lock);
+    pool->task = task;
+    pool->context = context;
+    pool->taskCount = taskCount;
+    pool->nextTask = 0;
+    pool->finishedTasks = 0;
+    if (taskCount > 1) threadConditionBroadcast(&pool->workReady);
+
+    runClaimedTasks(pool);
+    while (pool->finishedTasks < pool->taskCount) {
+        threadConditionWait(&pool->workDone, &pool->lock);
+    }
+    threadMutexUnlock(&pool->lock);
+    threadMutexUnlock(&pool->runLock);
+}
+
+// Function to delete a thread pool
+/**
+ * @brief Stops and joins the worker threads and frees the pool.
+ *
+ * @param pool The Thread Pool, or NULL.
+ */
+void deleteThreadPool(struct ThreadPool* pool) {
+    if (!pool) return;
+
+    threadMutexLock(&pool->lock);
+    pool->shuttingDown = 1;
+    threadConditionBroadcast(&pool->workReady);
+    threadMutexUnlock(&pool->lock);
+
+    for (int t = 0; t < pool->threadCount; t++) {
+        threadJoin(pool->threads[t]);
+    }
+    threadConditionDestroy(&pool->workReady);
+    threadConditionDestroy(&pool->workDone);
+    threadMutexDestroy(&pool->lock);
+    threadMutexDestroy(&pool->runLock);
+    free(pool->threads);
+    free(pool);
+}
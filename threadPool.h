@@ -0,0 +1,112 @@
+/**
+ * @file threadPool.h
+ *
+ * <b>CE4703 Computer Software 3</b>
+ * <b>Assignment 2</b><br/>
+ * <b>Data Type "Ordered Set" (Group Project)</b></br>
+ *
+ * @brief Header file for the portable threading wrappers and the Thread Pool.<br/>
+ *
+ * This header file declares thin wrappers over POSIX threads and the Win32 thread API
+ * (mutexes, condition variables, one-time initialisation, threads) and a fixed size Thread
+ * Pool that runs a batch of numbered tasks and waits for all of them to finish. Several
+ * threads may run batches on the same pool; the batches run one after another.
+ *
+ * @author
+ *  - Lewis Ubebe (23327944)
+ *  - Rasel Raju (23366028)
+ *  - Darragh Motihar (23381388)
+ *  - Karyna Enato (23329831)
+ *  - Simran Rajesh Paunikar (23122668)
+ *
+ * @date 25.11.2024
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef CRITICAL_SECTION ThreadMutex;
+typedef CONDITION_VARIABLE ThreadCondition;
+typedef HANDLE ThreadHandle;
+typedef INIT_ONCE ThreadOnce;
+#define THREAD_ONCE_INIT INIT_ONCE_STATIC_INIT
+#else
+#include <pthread.h>
+typedef pthread_mutex_t ThreadMutex;
+typedef pthread_cond_t ThreadCondition;
+typedef pthread_t ThreadHandle;
+typedef pthread_once_t ThreadOnce;
+#define THREAD_ONCE_INIT PTHREAD_ONCE_INIT
+#endif
+
+// Entry point of a thread
+typedef void (*ThreadStart)(void* arg);
+
+// Function run exactly once by threadOnce
+typedef void (*ThreadOnceFunction)(void);
+
+// One task of a batch: 'task' is its number in [0, taskCount)
+typedef void (*ThreadTask)(void* context, int task);
+
+// Thread Pool structure
+/**
+ * @brief Structure representing a Thread Pool.
+ *
+ * - 'runLock': held by threadPoolRun for a whole batch, so batches of different callers do not mix.
+ * - 'threads' / 'threadCount': the worker threads (the thread calling threadPoolRun works too).
+ * - 'task' / 'context' / 'taskCount': the batch being run.
+ * - 'nextTask': number of the next task nobody has claimed yet.
+ * - 'finishedTasks': number of tasks of the batch that have completed.
+ * - 'shuttingDown': set when the pool is deleted to stop the workers.
+ */
+struct ThreadPool
+{
+    ThreadMutex runLock;
+    ThreadMutex lock;
+    ThreadCondition workReady;
+    ThreadCondition workDone;
+    ThreadHandle* threads;
+    int threadCount;
+    ThreadTask task;
+    void* context;
+    int taskCount;
+    int nextTask;
+    int finishedTasks;
+    int shuttingDown;
+};
+
+// Function declarations
+/**
+ * @brief Function declarations for the threading wrappers and the Thread Pool.
+ *
+ * - 'threadMutex*' / 'threadCondition*': lock, wait and wake on the platform primitives.
+ * - 'threadOnce': runs 'function' the first time it is called on 'once' (initialised with THREAD_ONCE_INIT);
+ *   every other caller waits until that run has finished.
+ * - 'threadCreate' / 'threadJoin': start a thread (returns 1 on success, 0 on failure) and wait for it.
+ * - 'threadHardwareConcurrency': number of logical processors (at least 1).
+ * - 'createThreadPool': pool running batches on 'threads' threads including the caller; NULL on failure.
+ * - 'threadPoolRun': runs task(context, 0) .. task(context, taskCount - 1) and returns when all have finished;
+ *   a caller whose batch arrives while another runs waits for it.
+ * - 'deleteThreadPool': stops and joins the workers and frees the pool.
+ */
+void threadMutexInit(ThreadMutex* mutex);
+void threadMutexDestroy(ThreadMutex* mutex);
+void threadMutexLock(ThreadMutex* mutex);
+void threadMutexUnlock(ThreadMutex* mutex);
+void threadConditionInit(ThreadCondition* condition);
+void threadConditionDestroy(ThreadCondition* condition);
+void threadConditionWait(ThreadCondition* condition, ThreadMutex* mutex);
+void threadConditionSignal(ThreadCondition* condition);
+void threadConditionBroadcast(ThreadCondition* condition);
+void threadOnce(ThreadOnce* once, ThreadOnceFunction function);
+int threadCreate(ThreadHandle* thread, ThreadStart start, void* arg);
+void threadJoin(ThreadHandle thread);
+int threadHardwareConcurrency();
+
+struct ThreadPool* createThreadPool(int threads);
+void threadPoolRun(struct ThreadPool* pool, ThreadTask task, void* context, int taskCount);
+void deleteThreadPool(struct ThreadPool* pool);
+
+#endif // THREAD_POOL_H